@@ -21,6 +21,9 @@
 #include <random>
 #include <chrono>
 #include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
 #include <stdexcept>
 #include <sys/stat.h>
 
@@ -31,10 +34,16 @@
   //#include <atlstr.h>
 #else
   #include <sys/mman.h>
+  #include <fcntl.h>
   #include <sys/wait.h>
   #include <unistd.h>
   #include <dlfcn.h>
   #include <poll.h>
+  #include <signal.h>
+  #include <setjmp.h>
+  #include <sys/time.h>
+  #include <sys/socket.h>
+  #include <sys/un.h>
 #endif
 
 //#pragma FENV_ACCESS ON
@@ -51,7 +51,20 @@ enum class CmdOption:int{
   StartUnits,      
   ChunkUnits,      
   LockMemory,      
+  SlabLimit,       
+  LazyRelease,     
+  StackReserveKB,  
+  Jit,             
+  Aot,             
   BenchMark,       
+  Profiler,        
+  CallTimming,     
+  ImageCache,      
+  ServeSocket,     
+  SnapshotFile,    
+  RestoreFile,     
+  BatchFile,       
+  Workers,         
   IncludePath,     
   LibraryPath,     
   TmpLibPath,      
@@ -89,7 +102,7 @@ struct CmdOptionTable{
 };
 
 //Command line option table (order of entries must match order of enum class CmdOption)
-const int _OptNr=27;
+const int _OptNr=40;
 #define DEF_INC_PATH String(GetHostSystem()==HostSystem::Windows?".\\":"./")
 #define DEF_LIB_PATH String(GetHostSystem()==HostSystem::Windows?".\\src\\lib\\":"./src/lib/")
 #define DEF_TMP_PATH String(GetHostSystem()==HostSystem::Windows?".\\":"./")
@@ -107,15 +120,28 @@ CmdOptionTable _Opt[_OptNr]={
 /*PassOnWarnings  */ { CmdOptionKind::Coded, OptionType::Boolean, ""        , "-pw", false,   false, false, OptValue(false       ), DUNC_APPID+DUNS_APPID           , OPSCOM|OPSCNR       , "compiler.passonwarnings", "pass on warnings"    , "Ignore warnings when generating binaries (default:<defvalue>)" },
 /*LibrInfo        */ { CmdOptionKind::Coded, OptionType::String , ""        , "-lf", false,   true , false, OptValue(""          ), DUNC_APPID+DUNS_APPID           , OPSLIF              , ""                       , "library file"        , "Show information on library file (*"+String(LIBRARY_EXT)+")" },
 /*ExecInfo        */ { CmdOptionKind::Coded, OptionType::String , ""        , "-xf", false,   true , false, OptValue(""          ), DUNC_APPID+DUNS_APPID           , OPSXIF              , ""                       , "executable file"     , "Show information on executable file (*"+String(EXECUTABLE_EXT)+")" },
-/*MemoryUnit      */ { CmdOptionKind::Coded, OptionType::Number , ""        , "-mu", false,   false, false, OptValue(64L         ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR       , "runtime.memoryunitkb"   , "memory unit"         , "Memory unit size in KB (default:<defvalue>KB)" },
-/*StartUnits      */ { CmdOptionKind::Coded, OptionType::Number , ""        , "-ms", false,   false, false, OptValue(512L        ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR       , "runtime.startunits"     , "start units"         , "Starting memory units (default:<defvalue>)" },
-/*ChunkUnits      */ { CmdOptionKind::Coded, OptionType::Number , ""        , "-mc", false,   false, false, OptValue(64L         ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR       , "runtime.chunkunits"     , "chunk units"         , "Increase size of memory units (default:<defvalue>)" },
-/*LockMemory      */ { CmdOptionKind::Coded, OptionType::Boolean, ""        , "-ml", false,   false, false, OptValue(false       ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR       , "runtime.lockmemory"     , "lock memory pages"   , "Lock memory pages to prevent page faults and increase performance (default: <defvalue>)" },
-/*BenchMark       */ { CmdOptionKind::Coded, OptionType::Number , ""        , "-bm", false,   false, false, OptValue(0L          ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR       , ""                       , "benchmark"           , "Benchmark mode: 0=Disabled, 1=Execution time, 2=Plus instr. count, 3=Plus instr. timming (default:<defvalue>)" },
+/*MemoryUnit      */ { CmdOptionKind::Coded, OptionType::Number , ""        , "-mu", false,   false, false, OptValue(64L         ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR|OPSBAT, "runtime.memoryunitkb"   , "memory unit"         , "Memory unit size in KB (default:<defvalue>KB)" },
+/*StartUnits      */ { CmdOptionKind::Coded, OptionType::Number , ""        , "-ms", false,   false, false, OptValue(512L        ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR|OPSBAT, "runtime.startunits"     , "start units"         , "Starting memory units (default:<defvalue>)" },
+/*ChunkUnits      */ { CmdOptionKind::Coded, OptionType::Number , ""        , "-mc", false,   false, false, OptValue(64L         ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR|OPSBAT, "runtime.chunkunits"     , "chunk units"         , "Increase size of memory units (default:<defvalue>)" },
+/*LockMemory      */ { CmdOptionKind::Coded, OptionType::Boolean, ""        , "-ml", false,   false, false, OptValue(false       ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR|OPSBAT, "runtime.lockmemory"     , "lock memory pages"   , "Lock memory pages to prevent page faults and increase performance (default: <defvalue>)" },
+/*SlabLimit       */ { CmdOptionKind::Coded, OptionType::Number , ""        , "-msl", false,  false, false, OptValue(256L        ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR|OPSBAT, "runtime.slablimit"      , "slab limit"          , "Memory requests up to this size in bytes are served from size class slabs instead of chained block lists, 0=Disabled, max=512 (default:<defvalue>)" },
+/*LazyRelease     */ { CmdOptionKind::Coded, OptionType::Boolean, ""        , "-mlz", false,  false, false, OptValue(false       ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR|OPSBAT, "runtime.lazyrelease"    , "lazy release"        , "Do not release strings and dynamic arrays when functions return, leave them to zombie block reclaim (default: <defvalue>)" },
+/*StackReserveKB  */ { CmdOptionKind::Coded, OptionType::Number , ""        , "-sr", false,   false, false, OptValue(0L          ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR       , "runtime.stackreservekb" , "stack reserve"       , "Reserve fixed virtual memory for stack in KB with guard page, 0=Growable stack (default:<defvalue>KB)" },
+/*Jit             */ { CmdOptionKind::Coded, OptionType::Boolean, ""        , "-jit", false,  false, false, OptValue(false       ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR|OPSBAT, "runtime.jit"            , "jit compiler"        , "Translate sequences of arithmetic, compare and jump instructions to native code (x86-64 linux only) (default: <defvalue>)" },
+/*Aot             */ { CmdOptionKind::Coded, OptionType::Boolean, ""        , "-aot", false,  false, false, OptValue(false       ), DUNC_APPID+DUNR_APPID+DUNS_APPID, OPSCOM|OPSRUN|OPSCNR, "system.aot"             , "native library"      , "Compiler: Translate executable to C++ and build native library with g++, Runtime: Execute translated code from native library (default: <defvalue>)" },
+/*BenchMark       */ { CmdOptionKind::Coded, OptionType::Number , ""        , "-bm", false,   false, false, OptValue(0L          ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR       , ""                       , "benchmark"           , "Benchmark mode: 0=Disabled, 1=Execution time, 2=Plus instr. count, 3=Plus instr. timming, 4=Plus instr. sequences (default:<defvalue>)" },
+/*Profiler        */ { CmdOptionKind::Coded, OptionType::Boolean, ""        , "-prof", false, false, false, OptValue(false       ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR       , ""                       , "profiler"            , "Sampling profiler: Output time spent by function and source line and write folded call stacks file (*"+String(PROF_FOLDED_EXT)+") (default:<defvalue>)" },
+/*CallTimming     */ { CmdOptionKind::Coded, OptionType::Boolean, ""        , "-ct", false,   false, false, OptValue(false       ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR       , ""                       , "call timming"        , "Call timming mode: Output number of calls, inclusive and exclusive time for each function (default:<defvalue>)" },
+/*ImageCache      */ { CmdOptionKind::Coded, OptionType::Boolean, ""        , "-ic", false,   false, false, OptValue(false       ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR       , "runtime.imagecache"     , "code image cache"    , "Save decoded code buffer next to executable (*"+String(CODE_IMAGE_EXT)+") and reuse it on next executions to start faster (default: <defvalue>)" },
+/*ServeSocket     */ { CmdOptionKind::Coded, OptionType::String , ""        , "-serve", false,false, false, OptValue(""          ), DUNR_APPID                      , OPSRUN              , ""                       , "server socket"       , "Load program once and run it for each request received on local socket (requests are sent with dunq client)" },
+/*SnapshotFile    */ { CmdOptionKind::Coded, OptionType::String , ""        , "-snapshot", false,false, false, OptValue(""     ), DUNR_APPID                      , OPSRUN              , ""                       , "snapshot file"       , "Run initialization routines, save process state on snapshot file and exit without running main()" },
+/*RestoreFile     */ { CmdOptionKind::Coded, OptionType::String , ""        , "-restore", false,false, false, OptValue(""      ), DUNR_APPID                      , OPSRUN              , ""                       , "restore file"        , "Restore process state from snapshot file and start running on main() without running initialization routines" },
+/*BatchFile       */ { CmdOptionKind::Coded, OptionType::String , ""        , "-batch", false,true , false, OptValue(""          ), DUNR_APPID                      , OPSBAT              , ""                       , "batch file"          , "Run jobs of batch file concurrently on worker threads (one job per line: executable file (*"+String(EXECUTABLE_EXT)+") and its arguments)" },
+/*Workers         */ { CmdOptionKind::Coded, OptionType::Number , ""        , "-wk", false,   false, false, OptValue(0L          ), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR|OPSBAT, "runtime.workers"        , "workers"             , "Number of worker threads for batch execution and parallel walk loops, 0=One for each cpu core (default:<defvalue>)" },
 /*IncludePath     */ { CmdOptionKind::Coded, OptionType::String , ""        , "-in", false,   false, false, OptValue(DEF_INC_PATH), DUNC_APPID+DUNS_APPID           , OPSCOM|OPSCNR       , "compiler.includepath"   , "include path"        , "Default path for included files (*"+String(SOURCE_EXT)+") (default:<defvalue>)" },
 /*LibraryPath     */ { CmdOptionKind::Coded, OptionType::String , ""        , "-li", false,   false, false, OptValue(DEF_LIB_PATH), DUNC_APPID+DUNS_APPID           , OPSCOM|OPSCNR       , "compiler.librarypath"   , "library path"        , "Default path for dynamic libraries (*"+String(LIBRARY_EXT)+") (default:<defvalue>)" },
-/*TmpLibPath      */ { CmdOptionKind::Coded, OptionType::String , ""        , "-tm", false,   false, false, OptValue(DEF_TMP_PATH), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR       , "runtime.tmplibpath"     , "tmp lib path"        , "Default temporary path for copying user dynamic libraries (default:<defvalue>)" },
-/*DynLibPath      */ { CmdOptionKind::Coded, OptionType::String , ""        , "-ld", false,   false, false, OptValue(DEF_DYN_PATH), DUNC_APPID+DUNR_APPID+DUNS_APPID, OPSCOM|OPSRUN|OPSCNR, "system.dynlibpath"      , "dyn lib path"        , "Default path for dynamic libraries (*"+String(DYNLIB_EXT)+") (default:<defvalue>)" },
+/*TmpLibPath      */ { CmdOptionKind::Coded, OptionType::String , ""        , "-tm", false,   false, false, OptValue(DEF_TMP_PATH), DUNR_APPID+DUNS_APPID           , OPSRUN|OPSCNR|OPSBAT, "runtime.tmplibpath"     , "tmp lib path"        , "Default temporary path for copying user dynamic libraries (default:<defvalue>)" },
+/*DynLibPath      */ { CmdOptionKind::Coded, OptionType::String , ""        , "-ld", false,   false, false, OptValue(DEF_DYN_PATH), DUNC_APPID+DUNR_APPID+DUNS_APPID, OPSCOM|OPSRUN|OPSCNR|OPSBAT, "system.dynlibpath"      , "dyn lib path"        , "Default path for dynamic libraries (*"+String(DYNLIB_EXT)+") (default:<defvalue>)" },
 /*DisassembleFile */ { CmdOptionKind::Coded, OptionType::String , ""        , "-da", false,   true , false, OptValue(""          ), DUNR_APPID+DUNS_APPID           , OPSDIS              , ""                       , "disassemble file"    , "Disassemble executable file (*"+String(EXECUTABLE_EXT)+")" },
 /*VersionInfo     */ { CmdOptionKind::Coded, OptionType::Boolean, ""        , "-ve", false,   true , false, OptValue(false       ), DUNC_APPID+DUNR_APPID+DUNS_APPID, OPSVER              , ""                       , "version info"        , "Show version information" },
 /*DebugLevelIds   */ { CmdOptionKind::Coded, OptionType::String , ""        , "-dl", false,   false, true , OptValue(""          ), DUNC_APPID+DUNR_APPID+DUNS_APPID, OPSCOM|OPSRUN|OPSCNR, ""                       , "debug level ids"     , "Enable debug log messages (see available levels with -dh option)" },
@@ -208,12 +234,42 @@ bool ConfigParser::_Check(int OptionSet,bool PackageMode,ConfigOptions& CfgOpt){
       return false;
     }
 
-    //Benchmark mode must be between 0 and 3
-    if(CfgOpt.BenchMark<0 || CfgOpt.BenchMark>3){
+    //Benchmark mode must be between 0 and 4
+    if(CfgOpt.BenchMark<0 || CfgOpt.BenchMark>4){
       SysMessage(357).Print(CfgOpt.DynLibPath);
       return false;
     }
 
+    //Profiler needs fast execution mode
+    if(CfgOpt.Profiler && CfgOpt.BenchMark>=2){
+      SysMessage(586).Print();
+      return false;
+    }
+
+    //Call timming needs fast execution mode
+    if(CfgOpt.CallTimming && CfgOpt.BenchMark>=2){
+      SysMessage(590).Print();
+      return false;
+    }
+
+    //Stack reservation cannot be negative
+    if(CfgOpt.StackReserveKB<0){
+      SysMessage(579).Print();
+      return false;
+    }
+
+    //Number of workers cannot be negative
+    if(CfgOpt.Workers<0){
+      SysMessage(598).Print();
+      return false;
+    }
+
+    //Slab limit cannot be negative
+    if(CfgOpt.SlabLimit<0){
+      SysMessage(619).Print();
+      return false;
+    }
+
   }
 
   //Checks for runtime
@@ -240,12 +296,54 @@ bool ConfigParser::_Check(int OptionSet,bool PackageMode,ConfigOptions& CfgOpt){
         return false;
       }
     
-      //Benchmark mode must be between 0 and 3
-      if(CfgOpt.BenchMark<0 || CfgOpt.BenchMark>3){
+      //Benchmark mode must be between 0 and 4
+      if(CfgOpt.BenchMark<0 || CfgOpt.BenchMark>4){
         SysMessage(357).Print(CfgOpt.DynLibPath);
         return false;
       }
 
+      //Profiler needs fast execution mode
+      if(CfgOpt.Profiler && CfgOpt.BenchMark>=2){
+        SysMessage(586).Print();
+        return false;
+      }
+
+      //Call timming needs fast execution mode
+      if(CfgOpt.CallTimming && CfgOpt.BenchMark>=2){
+        SysMessage(590).Print();
+        return false;
+      }
+
+      //Runtime server is only available on linux
+      if(CfgOpt.ServeSocket.Length()!=0 && GetHostSystem()==HostSystem::Windows){
+        SysMessage(595).Print();
+        return false;
+      }
+
+      //Snapshot is saved by a normal execution (it cannot be combined with restore or runtime server)
+      if(CfgOpt.SnapshotFile.Length()!=0 && (CfgOpt.RestoreFile.Length()!=0 || CfgOpt.ServeSocket.Length()!=0)){
+        SysMessage(616).Print();
+        return false;
+      }
+
+    }
+
+    //Stack reservation cannot be negative
+    if(CfgOpt.StackReserveKB<0){
+      SysMessage(579).Print();
+      return false;
+    }
+
+    //Number of workers cannot be negative
+    if(CfgOpt.Workers<0){
+      SysMessage(598).Print();
+      return false;
+    }
+
+    //Slab limit cannot be negative
+    if(CfgOpt.SlabLimit<0){
+      SysMessage(619).Print();
+      return false;
     }
 
     //Dyn lib path must exist
@@ -261,6 +359,41 @@ bool ConfigParser::_Check(int OptionSet,bool PackageMode,ConfigOptions& CfgOpt){
 
   }
 
+  //Checks for batch execution
+  if(OptionSet==OPSBAT){
+
+    //Check batch file is given
+    if(CfgOpt.BatchFile.Length()==0){
+      SysMessage(597).Print();
+      return false;
+    }
+
+    //Number of workers cannot be negative
+    if(CfgOpt.Workers<0){
+      SysMessage(598).Print();
+      return false;
+    }
+
+    //Slab limit cannot be negative
+    if(CfgOpt.SlabLimit<0){
+      SysMessage(619).Print();
+      return false;
+    }
+
+    //Dyn lib path must exist
+    if(CfgOpt.DynLibPath.Length()!=0 && !_Stl->FileSystem.DirExists(CfgOpt.DynLibPath)){
+      SysMessage(272).Print(CfgOpt.DynLibPath);
+      return false;
+    }
+
+    //Temporary dyn lib path must exist
+    if(CfgOpt.TmpLibPath.Length()!=0 && !_Stl->FileSystem.DirExists(CfgOpt.TmpLibPath)){
+      SysMessage(271).Print(CfgOpt.TmpLibPath);
+      return false;
+    }
+
+  }
+
   //Checks for library info
   if(OptionSet==OPSLIF){
 
@@ -481,6 +614,43 @@ bool ConfigParser::_ParseConfigFile(const String& ModuleName,const char *ConfigF
       }
       _Opt[OptIndex].Default.Bol=(Value=="true"?true:false);
     }
+    else if(OptIndex==(int)CmdOption::SlabLimit){ 
+      IntValue=Value.ToInt(Error);
+      if(Error){
+        SysMessage(313).Print(ConfigFileName,Option); 
+        return false; 
+      }
+      _Opt[OptIndex].Default.Num=IntValue;
+    }
+    else if(OptIndex==(int)CmdOption::LazyRelease){ 
+      if(Value!="true" && Value!="false"){
+        SysMessage(303).Print(ConfigFileName,Option); 
+        return false; 
+      }
+      _Opt[OptIndex].Default.Bol=(Value=="true"?true:false);
+    }
+    else if(OptIndex==(int)CmdOption::StackReserveKB){ 
+      IntValue=Value.ToInt(Error);
+      if(Error){
+        SysMessage(313).Print(ConfigFileName,Option); 
+        return false; 
+      }
+      _Opt[OptIndex].Default.Num=IntValue;
+    }
+    else if(OptIndex==(int)CmdOption::Jit){ 
+      if(Value!="true" && Value!="false"){
+        SysMessage(303).Print(ConfigFileName,Option); 
+        return false; 
+      }
+      _Opt[OptIndex].Default.Bol=(Value=="true"?true:false);
+    }
+    else if(OptIndex==(int)CmdOption::Aot){ 
+      if(Value!="true" && Value!="false"){
+        SysMessage(303).Print(ConfigFileName,Option); 
+        return false; 
+      }
+      _Opt[OptIndex].Default.Bol=(Value=="true"?true:false);
+    }
     else if(OptIndex==(int)CmdOption::IncludePath){ 
       _Opt[OptIndex].Default.Str=Value.Trim();
     }
@@ -625,7 +795,20 @@ bool ConfigParser::GetCmdLineOptions(const String& ExecPath,int ArgNr,char *Arg[
   CfgOpt.StartUnits=Opt[(int)CmdOption::StartUnits].Num;
   CfgOpt.ChunkUnits=Opt[(int)CmdOption::ChunkUnits].Num;
   CfgOpt.LockMemory=Opt[(int)CmdOption::LockMemory].Bol;
+  CfgOpt.SlabLimit=Opt[(int)CmdOption::SlabLimit].Num;
+  CfgOpt.LazyRelease=Opt[(int)CmdOption::LazyRelease].Bol;
+  CfgOpt.StackReserveKB=Opt[(int)CmdOption::StackReserveKB].Num;
+  CfgOpt.Jit=Opt[(int)CmdOption::Jit].Bol;
+  CfgOpt.Aot=Opt[(int)CmdOption::Aot].Bol;
   CfgOpt.BenchMark=Opt[(int)CmdOption::BenchMark].Num;
+  CfgOpt.Profiler=Opt[(int)CmdOption::Profiler].Bol;
+  CfgOpt.CallTimming=Opt[(int)CmdOption::CallTimming].Bol;
+  CfgOpt.ImageCache=Opt[(int)CmdOption::ImageCache].Bol;
+  CfgOpt.ServeSocket=Opt[(int)CmdOption::ServeSocket].Str;
+  CfgOpt.SnapshotFile=Opt[(int)CmdOption::SnapshotFile].Str;
+  CfgOpt.RestoreFile=Opt[(int)CmdOption::RestoreFile].Str;
+  CfgOpt.BatchFile=Opt[(int)CmdOption::BatchFile].Str;
+  CfgOpt.Workers=Opt[(int)CmdOption::Workers].Num;
   CfgOpt.IncludePath=Opt[(int)CmdOption::IncludePath].Str;
   CfgOpt.LibraryPath=Opt[(int)CmdOption::LibraryPath].Str;
   CfgOpt.TmpLibPath=Opt[(int)CmdOption::TmpLibPath].Str;
@@ -674,6 +857,7 @@ void ConfigParser::PrintHelp(const String& ModuleName,const String& AppId){
   String ExecInfoOptions;
   String DisassemOptions;
   String VersInfoOptions;
+  String BatchExeOptions;
   int CompilerOptLen;
   int RuntimeOptLen;
   int CompnRunOptLen;
@@ -681,6 +865,7 @@ void ConfigParser::PrintHelp(const String& ModuleName,const String& AppId){
   int ExecInfoOptLen;
   int DisassemOptLen;
   int VersInfoOptLen;
+  int BatchExeOptLen;
   String OptionList;
   String ModuleFile;
 
@@ -710,6 +895,7 @@ void ConfigParser::PrintHelp(const String& ModuleName,const String& AppId){
   ExecInfoOptLen=0;
   DisassemOptLen=0;
   VersInfoOptLen=0;
+  BatchExeOptLen=0;
   CompilerOptions=ModuleFile+" ";
   RuntimeOptions =ModuleFile+" ";
   CompnRunOptions=ModuleFile+" ";
@@ -717,6 +903,7 @@ void ConfigParser::PrintHelp(const String& ModuleName,const String& AppId){
   ExecInfoOptions=ModuleFile+" ";
   DisassemOptions=ModuleFile+" ";
   VersInfoOptions=ModuleFile+" ";
+  BatchExeOptions=ModuleFile+" ";
   for(i=0;i<_OptNr;i++){
     OptStr=Options[i];
     if(!_Opt[i].IsMandatory){ OptStr="["+OptStr+"]"; }
@@ -748,6 +935,10 @@ void ConfigParser::PrintHelp(const String& ModuleName,const String& AppId){
       if(VersInfoOptLen+OptStr.Length()+1>OptMaxLen){ VersInfoOptions+="\n"+String(OptLeftJust,' ')+OptStr+" "; VersInfoOptLen=0; }
       else{ VersInfoOptions+=OptStr+" "; VersInfoOptLen+=OptStr.Length()+1; }
     }
+    if((_Opt[i].EnabledSets&OPSBAT) && (!_Opt[i].DevelVersOnly || IsDevelopmentVersion())){ 
+      if(BatchExeOptLen+OptStr.Length()+1>OptMaxLen){ BatchExeOptions+="\n"+String(OptLeftJust,' ')+OptStr+" "; BatchExeOptLen=0; }
+      else{ BatchExeOptions+=OptStr+" "; BatchExeOptLen+=OptStr.Length()+1; }
+    }
   }
   
   //Add program arguments into runtime and compile&run option sets
@@ -777,9 +968,10 @@ void ConfigParser::PrintHelp(const String& ModuleName,const String& AppId){
     OptionList+="Version info   : "+VersInfoOptions;
   }
   else if(AppId==DUNR_APPID){
-    OptionSets=OPSRUN|OPSDIS|OPSVER;
+    OptionSets=OPSRUN|OPSBAT|OPSDIS|OPSVER;
     Title=MASTER_NAME " runtime environment";
     OptionList+="Execute binary : "+RuntimeOptions+"\n";
+    OptionList+="Batch execute  : "+BatchExeOptions+"\n";
     OptionList+="Disassemble    : "+DisassemOptions+"\n";
     OptionList+="Version info   : "+VersInfoOptions;
   }
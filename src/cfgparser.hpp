@@ -13,6 +13,7 @@
 #define OPSXIF 16 //Executable info
 #define OPSDIS 32 //Disasemble binary
 #define OPSVER 64 //Version info
+#define OPSBAT 128 //Batch execution
 
 //Name of configuration file
 #define CONFIG_FILE "ds.config"
@@ -43,7 +44,20 @@ struct ConfigOptions{
   long StartUnits;
   long ChunkUnits;
   bool LockMemory;
+  long SlabLimit;
+  bool LazyRelease;
+  long StackReserveKB;
+  bool Jit;
+  bool Aot;
   long BenchMark;
+  bool Profiler;
+  bool CallTimming;
+  bool ImageCache;
+  String ServeSocket;
+  String SnapshotFile;
+  String RestoreFile;
+  String BatchFile;
+  long Workers;
   String IncludePath;
   String LibraryPath;
   String TmpLibPath;
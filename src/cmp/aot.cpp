@@ -0,0 +1,480 @@
+//aot.cpp: Ahead-of-time translator to C++
+#include "bas/basedefs.hpp"
+#include "bas/allocator.hpp"
+#include "bas/array.hpp"
+#include "bas/stack.hpp"
+#include "bas/buffer.hpp"
+#include "bas/string.hpp"
+#include "sys/sysdefs.hpp"
+#include "sys/system.hpp"
+#include "sys/stl.hpp"
+#include "sys/msgout.hpp"
+#include "cmp/aot.hpp"
+
+//Minimun number of instructions in a run to translate it
+#define AOT_MIN_RUN_INSTS 2
+
+//Operand read from code buffer
+#define AOT_ARGADR(n) (*(CpuAdr *)(_CodePtr+IP+_Inst[(int)InstCode].Offset[n]))
+
+//Instruction templates
+//($n is replaced by operand n, guard is checked before instruction and when true native code returns to interpreter
+//to execute the instruction, so that interpreter raises the exception)
+struct AotTemplate{
+  CpuInstCode InstCode; //Instruction code
+  const char *Body;     //Statement (same semantics as INST_* macro in runtime)
+  const char *Guard;    //Exception condition (null if instruction cannot fail)
+};
+
+//Template families by data type
+#define AOT_BCWILF(op,body,guard) \
+  {CpuInstCode::op##b,body,guard},{CpuInstCode::op##c,body,guard},{CpuInstCode::op##w,body,guard}, \
+  {CpuInstCode::op##i,body,guard},{CpuInstCode::op##l,body,guard},{CpuInstCode::op##f,body,guard}
+#define AOT_CWILF(op,body,guard) \
+  {CpuInstCode::op##c,body,guard},{CpuInstCode::op##w,body,guard},{CpuInstCode::op##i,body,guard}, \
+  {CpuInstCode::op##l,body,guard},{CpuInstCode::op##f,body,guard}
+#define AOT_CWIL(op,body,guard) \
+  {CpuInstCode::op##c,body,guard},{CpuInstCode::op##w,body,guard},{CpuInstCode::op##i,body,guard}, \
+  {CpuInstCode::op##l,body,guard}
+
+//Template table
+const AotTemplate _AotTemplate[]={
+  {CpuInstCode::NOP,"",nullptr},
+  AOT_CWILF(NEG,"$1=-$2;",nullptr),
+  AOT_CWILF(ADD,"$1=$2+$3;",nullptr),
+  AOT_CWILF(SUB,"$1=$2-$3;",nullptr),
+  AOT_CWILF(MUL,"$1=$2*$3;",nullptr),
+  AOT_CWILF(DIV,"$1=$2/$3;","$3==0"),
+  AOT_CWIL(MOD,"$1=MOD($2,$3);","$3==0"),
+  AOT_CWILF(INC,"$1++;",nullptr),
+  AOT_CWILF(DEC,"$1--;",nullptr),
+  AOT_CWILF(PINC,"$1=$2; $2++;",nullptr),
+  AOT_CWILF(PDEC,"$1=$2; $2--;",nullptr),
+  {CpuInstCode::LNOT,"$1=!$2;",nullptr},
+  {CpuInstCode::LAND,"$1=$2&&$3;",nullptr},
+  {CpuInstCode::LOR,"$1=$2||$3;",nullptr},
+  AOT_CWIL(BNOT,"$1=~$2;",nullptr),
+  AOT_CWIL(BAND,"$1=$2&$3;",nullptr),
+  AOT_CWIL(BOR,"$1=$2|$3;",nullptr),
+  AOT_CWIL(BXOR,"$1=$2^$3;",nullptr),
+  AOT_CWIL(SHL,"$1=$2<<$3;",nullptr),
+  AOT_CWIL(SHR,"$1=$2>>$3;",nullptr),
+  AOT_BCWILF(LES,"$1=$2<$3;",nullptr),
+  AOT_BCWILF(LEQ,"$1=$2<=$3;",nullptr),
+  AOT_BCWILF(GRE,"$1=$2>$3;",nullptr),
+  AOT_BCWILF(GEQ,"$1=$2>=$3;",nullptr),
+  AOT_BCWILF(EQU,"$1=$2==$3;",nullptr),
+  AOT_BCWILF(DIS,"$1=$2!=$3;",nullptr),
+  AOT_BCWILF(MV,"$1=$2;",nullptr),
+  AOT_BCWILF(LOAD,"$1=$2;",nullptr),
+  AOT_CWILF(MVAD,"$1+=$2;",nullptr),
+  AOT_CWILF(MVSU,"$1-=$2;",nullptr),
+  AOT_CWILF(MVMU,"$1*=$2;",nullptr),
+  AOT_CWILF(MVDI,"$1/=$2;","$2==0"),
+  AOT_CWIL(MVMO,"$1=MOD($1,$2);","$2==0"),
+  AOT_CWIL(MVSL,"$1<<=$2;",nullptr),
+  AOT_CWIL(MVSR,"$1>>=$2;",nullptr),
+  AOT_CWIL(MVAN,"$1&=$2;",nullptr),
+  AOT_CWIL(MVOR,"$1|=$2;",nullptr),
+  AOT_CWIL(MVXO,"$1^=$2;",nullptr),
+  {CpuInstCode::BO2CH,"if($2){ $1=1; } else{ $1=0; }",nullptr},
+  {CpuInstCode::BO2SH,"if($2){ $1=1; } else{ $1=0; }",nullptr},
+  {CpuInstCode::BO2IN,"if($2){ $1=1; } else{ $1=0; }",nullptr},
+  {CpuInstCode::BO2LO,"if($2){ $1=1; } else{ $1=0; }",nullptr},
+  {CpuInstCode::BO2FL,"if($2){ $1=1; } else{ $1=0; }",nullptr},
+  {CpuInstCode::CH2BO,"if($2!=0){ $1=true; } else{ $1=false; }",nullptr},
+  {CpuInstCode::CH2SH,"$1=(CpuShr)$2;",nullptr},
+  {CpuInstCode::CH2IN,"$1=(CpuInt)$2;",nullptr},
+  {CpuInstCode::CH2LO,"$1=(CpuLon)$2;",nullptr},
+  {CpuInstCode::CH2FL,"$1=(CpuFlo)$2;",nullptr},
+  {CpuInstCode::SH2BO,"if($2!=0){ $1=true; } else{ $1=false; }",nullptr},
+  {CpuInstCode::SH2CH,"$1=(CpuChr)$2;",nullptr},
+  {CpuInstCode::SH2IN,"$1=(CpuInt)$2;",nullptr},
+  {CpuInstCode::SH2LO,"$1=(CpuLon)$2;",nullptr},
+  {CpuInstCode::SH2FL,"$1=(CpuFlo)$2;",nullptr},
+  {CpuInstCode::IN2BO,"if($2!=0){ $1=true; } else{ $1=false; }",nullptr},
+  {CpuInstCode::IN2CH,"$1=(CpuChr)$2;",nullptr},
+  {CpuInstCode::IN2SH,"$1=(CpuShr)$2;",nullptr},
+  {CpuInstCode::IN2LO,"$1=(CpuLon)$2;",nullptr},
+  {CpuInstCode::IN2FL,"$1=(CpuFlo)$2;",nullptr},
+  {CpuInstCode::LO2BO,"if($2!=0){ $1=true; } else{ $1=false; }",nullptr},
+  {CpuInstCode::LO2CH,"$1=(CpuChr)$2;",nullptr},
+  {CpuInstCode::LO2SH,"$1=(CpuShr)$2;",nullptr},
+  {CpuInstCode::LO2IN,"$1=(CpuInt)$2;",nullptr},
+  {CpuInstCode::LO2FL,"$1=(CpuFlo)$2;",nullptr},
+  {CpuInstCode::FL2BO,"if($2!=0){ $1=true; } else{ $1=false; }",nullptr},
+  {CpuInstCode::FL2CH,"$1=(CpuChr)$2;","$2<MIN_CHR || $2>MAX_CHR"},
+  {CpuInstCode::FL2SH,"$1=(CpuShr)$2;","$2<MIN_SHR || $2>MAX_SHR"},
+  {CpuInstCode::FL2IN,"$1=(CpuInt)$2;","$2<MIN_INT || $2>MAX_INT"},
+  {CpuInstCode::FL2LO,"$1=(CpuLon)$2;","$2<MIN_LON || $2>MAX_LON"}
+};
+const int _AotTemplateNr=sizeof(_AotTemplate)/sizeof(AotTemplate);
+
+//Generated source header
+//(entry point table layout must match Runtime::AotEntry and table function arguments must match Runtime::LoadNativeLibrary(),
+//address type placeholder is replaced by the one of the target architecture when header is emitted)
+const char *_AotHeader=
+"#include <cstdint>\n"
+"#include <cstring>\n"
+"\n"
+"//Cpu data types\n"
+"typedef int8_t  CpuBol;\n"
+"typedef int8_t  CpuChr;\n"
+"typedef int16_t CpuShr;\n"
+"typedef int32_t CpuInt;\n"
+"typedef int64_t CpuLon;\n"
+"typedef double  CpuFlo;\n"
+"typedef %ADRTYPE% CpuAdr;\n"
+"\n"
+"//Export declaration\n"
+"#ifdef _WIN32\n"
+"  #define EXPORT extern \"C\" __declspec(dllexport)\n"
+"#else\n"
+"  #define EXPORT extern \"C\"\n"
+"#endif\n"
+"\n"
+"//Limits and operations (same as virtual machine)\n"
+"#define MAX_CHR +127\n"
+"#define MIN_CHR -127\n"
+"#define MAX_SHR +32767\n"
+"#define MIN_SHR -32767\n"
+"#define MAX_INT +2147483647L\n"
+"#define MIN_INT -2147483647L\n"
+"#define MAX_LON +9223372036854775807LL\n"
+"#define MIN_LON -9223372036854775807LL\n"
+"#define MOD(a,b) ((((a)%(b))+(b))%(b))\n"
+"\n"
+"//Local variable access (Frm is frame pointer)\n"
+"#define B(o) (*(CpuBol *)(Frm+(o)))\n"
+"#define C(o) (*(CpuChr *)(Frm+(o)))\n"
+"#define W(o) (*(CpuShr *)(Frm+(o)))\n"
+"#define I(o) (*(CpuInt *)(Frm+(o)))\n"
+"#define L(o) (*(CpuLon *)(Frm+(o)))\n"
+"#define F(o) (*(CpuFlo *)(Frm+(o)))\n"
+"\n"
+"//Floating point litteral value from bits\n"
+"static inline CpuFlo FLIT(uint64_t Bits){ CpuFlo Value; memcpy(&Value,&Bits,sizeof(Value)); return Value; }\n"
+"\n"
+"//Native function type and entry point table\n"
+"typedef CpuAdr (*AotFunction)(char *Frm,CpuAdr IP);\n"
+"struct AotEntry{ CpuAdr Address; AotFunction Function; };\n";
+
+//Get translation template for instruction
+const char *AotTranslator::_Template(CpuInstCode InstCode,const char **Guard){
+  for(int i=0;i<_AotTemplateNr;i++){
+    if(_AotTemplate[i].InstCode==InstCode){
+      *Guard=_AotTemplate[i].Guard;
+      return _AotTemplate[i].Body;
+    }
+  }
+  *Guard=nullptr;
+  return nullptr;
+}
+
+//Check operands are local variables or litteral values of master data types
+bool AotTranslator::_OperandsFit(CpuAdr IP,CpuInstCode InstCode){
+  for(int i=0;i<_Inst[(int)InstCode].ArgNr;i++){
+    if(_Inst[(int)InstCode].AdrMode[i]==CpuAdrMode::Indirection){ return false; }
+    if((int)_Inst[(int)InstCode].Type[i]<(int)CpuDataType::Boolean || (int)_Inst[(int)InstCode].Type[i]>(int)CpuDataType::Float){ return false; }
+    if(_Inst[(int)InstCode].AdrMode[i]==CpuAdrMode::Address && AOT_ARGADR(i)<0){ return false; }
+  }
+  return true;
+}
+
+//Get C++ expression for operand
+String AotTranslator::_Operand(CpuAdr IP,CpuInstCode InstCode,int ArgIndex){
+
+  //Variables
+  String Result;
+  CpuLon Value;
+  const char *Pnt;
+  CpuDataType Type;
+
+  //Local variable
+  Type=_Inst[(int)InstCode].Type[ArgIndex];
+  Pnt=_CodePtr+IP+_Inst[(int)InstCode].Offset[ArgIndex];
+  if(_Inst[(int)InstCode].AdrMode[ArgIndex]==CpuAdrMode::Address){
+    switch(Type){
+      case CpuDataType::Boolean: Result="B"; break;
+      case CpuDataType::Char   : Result="C"; break;
+      case CpuDataType::Short  : Result="W"; break;
+      case CpuDataType::Integer: Result="I"; break;
+      case CpuDataType::Long   : Result="L"; break;
+      case CpuDataType::Float  : Result="F"; break;
+      default: break;
+    }
+    return Result+"("+ToString((long long)*(CpuAdr *)Pnt)+")";
+  }
+
+  //Litteral value (emitted from its bit pattern so that it is exactly the same value)
+  switch(Type){
+    case CpuDataType::Boolean: Value=*(CpuBol *)Pnt; Result="((CpuBol)"+ToString((long long)Value)+")"; break;
+    case CpuDataType::Char   : Value=*(CpuChr *)Pnt; Result="((CpuChr)"+ToString((long long)Value)+")"; break;
+    case CpuDataType::Short  : Value=*(CpuShr *)Pnt; Result="((CpuShr)"+ToString((long long)Value)+")"; break;
+    case CpuDataType::Integer: Value=*(CpuInt *)Pnt; Result="((CpuInt)"+ToString((long long)Value)+")"; break;
+    case CpuDataType::Long   : Value=*(CpuLon *)Pnt; Result="((CpuLon)"+ToString((long long)Value,"0x%llXULL")+")"; break;
+    case CpuDataType::Float  : Value=*(CpuLon *)Pnt; Result="FLIT("+ToString((long long)Value,"0x%llXULL")+")"; break;
+    default: break;
+  }
+  return Result;
+
+}
+
+//Expand template for instruction
+String AotTranslator::_Expand(const char *Template,CpuAdr IP,CpuInstCode InstCode){
+  String Result=String(Template);
+  for(int i=0;i<_Inst[(int)InstCode].ArgNr;i++){
+    Result=Result.Replace("$"+ToString(i+1),_Operand(IP,InstCode,i));
+  }
+  return Result;
+}
+
+//Label for code address
+String AotTranslator::_Label(CpuAdr Address){
+  return "L"+ToString((long long)Address);
+}
+
+//Jump statement (jump inside function when target is translated in same segment, otherwise return to interpreter)
+String AotTranslator::_Jump(CpuAdr Target,const AotSegment& Seg){
+  if(Target>=Seg.BegAddress && Target<Seg.EndAddress && (_Flags[Target]&AotFlag::Entry)){
+    return "goto "+_Label(Target)+";";
+  }
+  return "return "+ToString((long long)Target)+";";
+}
+
+//Scan code buffer to find instruction starts, jump targets, translatable instructions and entry points
+//(instructions programmed by decoder instructions are not translated, as decoder modes are set at run time)
+void AotTranslator::_ScanCode(){
+
+  //Variables
+  int Count;
+  bool Prefixed;
+  CpuAdr IP;
+  CpuAdr RunBeg;
+  CpuAdr RunEnd;
+  CpuAdr Target;
+  CpuInstCode InstCode;
+  const char *Guard;
+
+  //Flag instructions
+  _Flags=Buffer(_CodeLength,0);
+  Prefixed=false;
+  for(IP=0;IP<_CodeLength;IP+=_Inst[(int)InstCode].Length){
+    InstCode=(CpuInstCode)(*(CpuIcd *)(_CodePtr+IP));
+    if((int)InstCode<0 || (int)InstCode>=_InstructionNr){ _Flags=Buffer(_CodeLength,0); return; }
+    _Flags[IP]|=AotFlag::InstStart;
+    if(InstCode>=CpuInstCode::DAGV1 && InstCode<=CpuInstCode::DALI4){ Prefixed=true; continue; }
+    if(InstCode==CpuInstCode::JMP || InstCode==CpuInstCode::JMPTR || InstCode==CpuInstCode::JMPFL){
+      Target=IP+AOT_ARGADR(InstCode==CpuInstCode::JMP?0:1);
+      if(Target>=0 && Target<_CodeLength){ _Flags[Target]|=AotFlag::JumpTarget; }
+      if(!Prefixed){ _Flags[IP]|=AotFlag::Native; }
+    }
+    else if(!Prefixed && _Template(InstCode,&Guard)!=nullptr && _OperandsFit(IP,InstCode)){
+      _Flags[IP]|=AotFlag::Native;
+    }
+    Prefixed=false;
+  }
+
+  //Runs of translatable instructions (run start and jump targets inside are entry points)
+  IP=0;
+  while(IP<_CodeLength){
+    if(!(_Flags[IP]&AotFlag::Native)){ IP+=_Inst[(int)(CpuInstCode)(*(CpuIcd *)(_CodePtr+IP))].Length; continue; }
+    RunBeg=IP;
+    RunEnd=IP;
+    Count=0;
+    while(RunEnd<_CodeLength && (_Flags[RunEnd]&AotFlag::Native)){ RunEnd+=_Inst[(int)(CpuInstCode)(*(CpuIcd *)(_CodePtr+RunEnd))].Length; Count++; }
+    for(IP=RunBeg;IP<RunEnd;IP+=_Inst[(int)(CpuInstCode)(*(CpuIcd *)(_CodePtr+IP))].Length){
+      if(Count<AOT_MIN_RUN_INSTS){ _Flags[IP]&=~AotFlag::Native; }
+      else if(IP==RunBeg || (_Flags[IP]&AotFlag::JumpTarget)){ _Flags[IP]|=AotFlag::Entry; }
+    }
+  }
+
+}
+
+//Output source line
+void AotTranslator::_Out(const String& Line){
+  _Lines.Add(Line+"\n");
+}
+
+//Emit source header
+void AotTranslator::_EmitHeader(const String& ProgName){
+  _Out("//Native code for program "+ProgName+" (generated by ahead-of-time translator, do not edit)");
+  _Out(String(_AotHeader).Replace("%ADRTYPE%",(GetArchitecture()==32?"int32_t":"int64_t")));
+}
+
+//Emit C++ function for code segment
+void AotTranslator::_EmitSegment(int SegIndex,const AotSegment& Seg){
+
+  //Variables
+  bool Open;
+  CpuAdr IP;
+  CpuAdr NextIP;
+  CpuInstCode InstCode;
+  const char *Body;
+  const char *Guard;
+
+  //Nothing to emit if segment has no entry points
+  for(IP=Seg.BegAddress;IP<Seg.EndAddress;IP++){ if(_Flags[IP]&AotFlag::Entry){ break; } }
+  if(IP>=Seg.EndAddress){ return; }
+
+  //Function header and entry point switch
+  _Out("//Function "+Seg.Name);
+  _Out("static CpuAdr Fn"+ToString(SegIndex)+"(char *Frm,CpuAdr IP){");
+  _Out("  switch(IP){");
+  for(IP=Seg.BegAddress;IP<Seg.EndAddress;IP++){
+    if(_Flags[IP]&AotFlag::Entry){ _Out("    case "+ToString((long long)IP)+": goto "+_Label(IP)+";"); _EntryNr++; }
+  }
+  _Out("  }");
+  _Out("  return IP;");
+
+  //Translated instructions (return to interpreter at end of each run)
+  Open=false;
+  for(IP=Seg.BegAddress;IP<Seg.EndAddress;IP=NextIP){
+    InstCode=(CpuInstCode)(*(CpuIcd *)(_CodePtr+IP));
+    NextIP=IP+_Inst[(int)InstCode].Length;
+    if(!(_Flags[IP]&AotFlag::Native)){
+      if(Open){ _Out("  return "+ToString((long long)IP)+";"); Open=false; }
+      continue;
+    }
+    Open=true;
+    if(_Flags[IP]&AotFlag::Entry){ _Out("  "+_Label(IP)+":"); }
+    switch(InstCode){
+      case CpuInstCode::JMP:
+        _Out("  "+_Jump(IP+AOT_ARGADR(0),Seg));
+        break;
+      case CpuInstCode::JMPTR:
+        _Out("  if("+_Operand(IP,InstCode,0)+"){ "+_Jump(IP+AOT_ARGADR(1),Seg)+" }");
+        break;
+      case CpuInstCode::JMPFL:
+        _Out("  if(!"+_Operand(IP,InstCode,0)+"){ "+_Jump(IP+AOT_ARGADR(1),Seg)+" }");
+        break;
+      default:
+        Body=_Template(InstCode,&Guard);
+        if(Guard!=nullptr){ _Out("  if("+_Expand(Guard,IP,InstCode)+"){ return "+ToString((long long)IP)+"; }"); }
+        _Out("  "+_Expand(Body,IP,InstCode));
+        break;
+    }
+    _InstNr++;
+  }
+  if(Open){ _Out("  return "+ToString((long long)Seg.EndAddress)+";"); }
+  _Out("}");
+  _Out("");
+  _FunctionNr++;
+
+}
+
+//Emit entry point table and library interface
+void AotTranslator::_EmitFooter(const Array<AotSegment>& Segments){
+
+  //Variables
+  int i;
+  CpuAdr IP;
+
+  //Entry point table
+  _Out("//Entry point table");
+  _Out("static const AotEntry _AotEntry[]={");
+  for(i=0;i<Segments.Length();i++){
+    for(IP=Segments[i].BegAddress;IP<Segments[i].EndAddress;IP++){
+      if(_Flags[IP]&AotFlag::Entry){ _Out("  {"+ToString((long long)IP)+",Fn"+ToString(i)+"},"); }
+    }
+  }
+  _Out("  {-1,nullptr}");
+  _Out("};");
+  _Out("");
+
+  //Library interface (same functions runtime expects from any dynamic library)
+  _Out("//Library interface");
+  _Out("EXPORT bool _IsSystemLibrary(){ return true; }");
+  _Out("EXPORT int _LibArchitecture(){ return "+ToString(GetArchitecture())+"; }");
+  _Out("EXPORT void _GetBuildNumber(char *BuildNumber){ strcpy(BuildNumber,\"AOT\"); }");
+  _Out("EXPORT bool _InitDispatcher(){ return true; }");
+  _Out("EXPORT int _SearchFunction(char *Name){ return strcmp(Name,\"" AOT_TABLE_FUNCTION "\")==0?0:-1; }");
+  _Out("EXPORT bool _CallFunction(int Id,void *Arg[]){");
+  _Out("  if(Id!=0){ return false; }");
+  _Out("  else{");
+  _Out("    *(const AotEntry **)Arg[0]=_AotEntry;");
+  _Out("    *(CpuInt *)Arg[1]="+ToString(_EntryNr)+";");
+  _Out("    *(CpuLon *)Arg[2]=(CpuLon)"+ToString((long long)CodeHash(_CodePtr,_CodeLength),"0x%llXULL")+";");
+  _Out("  }");
+  _Out("  return true;");
+  _Out("}");
+  _Out("EXPORT void _SetDbgMsgInterf(void (*DebugMsg)(char *)){}");
+  _Out("EXPORT void _CloseDispatcher(){}");
+
+}
+
+//Translate code buffer to C++ source file
+bool AotTranslator::Translate(const char *CodePtr,CpuAdr CodeLength,const Array<DbgSymFunction>& Functions,const String& ProgName,const String& SourceFile){
+
+  //Variables
+  int i,j;
+  int Hnd;
+  CpuAdr Address;
+  Array<CpuAdr> Starts;
+  Array<AotSegment> Segments;
+  AotSegment Seg;
+
+  //Debug message
+  DebugMessage(DebugLevel::CmpBinary,"Translate code buffer to C++ source file "+SourceFile);
+
+  //Init
+  _CodePtr=CodePtr;
+  _CodeLength=CodeLength;
+  _Lines.Reset();
+  _FunctionNr=0;
+  _EntryNr=0;
+  _InstNr=0;
+
+  //Scan code
+  _ScanCode();
+
+  //Split code buffer into segments at function start addresses (sorted by insertion)
+  //(code before first function is initialization code, without debug symbols whole buffer is one segment)
+  Starts.Add(0);
+  for(i=0;i<Functions.Length();i++){
+    Address=Functions[i].BegAddress;
+    if(Address<=0 || Address>=CodeLength || !(_Flags[Address]&AotFlag::InstStart)){ continue; }
+    for(j=0;j<Starts.Length() && Starts[j]<Address;j++);
+    if(j<Starts.Length() && Starts[j]==Address){ continue; }
+    Starts.Insert(j,Address);
+  }
+  for(i=0;i<Starts.Length();i++){
+    Seg.BegAddress=Starts[i];
+    Seg.EndAddress=(i<Starts.Length()-1?Starts[i+1]:CodeLength);
+    Seg.Name="(init)";
+    for(j=0;j<Functions.Length();j++){
+      if(Functions[j].BegAddress==Seg.BegAddress){ Seg.Name=String((char *)Functions[j].Name); break; }
+    }
+    Segments.Add(Seg);
+  }
+
+  //Generate source
+  _EmitHeader(ProgName);
+  for(i=0;i<Segments.Length();i++){ _EmitSegment(i,Segments[i]); }
+  _EmitFooter(Segments);
+
+  //Write source file
+  if(!_Stl->FileSystem.GetHandler(Hnd)){ SysMessage(237).Print(SourceFile); return false; }
+  if(!_Stl->FileSystem.OpenForWrite(Hnd,SourceFile)){ SysMessage(230).Print(SourceFile,_Stl->LastError()); return false; }
+  if(!_Stl->FileSystem.WriteArray(Hnd,_Lines)){ SysMessage(582).Print(SourceFile,_Stl->LastError()); return false; }
+  if(!_Stl->FileSystem.CloseFile(Hnd)){ SysMessage(238).Print(SourceFile,_Stl->LastError()); return false; }
+  if(!_Stl->FileSystem.FreeHandler(Hnd)){ SysMessage(239).Print(SourceFile,_Stl->LastError()); return false; }
+  _Lines.Reset();
+
+  //Debug message
+  DebugMessage(DebugLevel::CmpBinary,"Translated "+ToString(_InstNr)+" instructions into "+ToString(_FunctionNr)+" functions with "+ToString(_EntryNr)+" entry points");
+
+  //Return success
+  return true;
+
+}
+
+//Native library file for executable
+String AotTranslator::LibraryFile(const String& BinaryFile){
+  return _Stl->FileSystem.GetDirName(BinaryFile)+_Stl->FileSystem.GetFileNameNoExt(BinaryFile)+AOT_LIBRARY_TAG+DYNLIB_EXT;
+}
+
+//C++ source file for executable
+String AotTranslator::SourceFile(const String& BinaryFile){
+  return _Stl->FileSystem.GetDirName(BinaryFile)+_Stl->FileSystem.GetFileNameNoExt(BinaryFile)+AOT_SOURCE_EXT;
+}
@@ -0,0 +1,67 @@
+//aot.hpp: Ahead-of-time translator to C++
+#ifndef _AOT_HPP
+#define _AOT_HPP
+
+//Ahead-of-time translator class
+//(translates final code buffer of an executable into C++ source with one function per program function, instructions
+//that need runtime helpers are not translated and native code returns to interpreter when it reaches them)
+class AotTranslator{
+
+  //Private members
+  private:
+
+    //Code address flags
+    enum AotFlag{
+      InstStart=1,  //Instruction starts at address
+      JumpTarget=2, //Address is target of a jump instruction
+      Native=4,     //Instruction is translated to C++
+      Entry=8       //Address is an entry point from interpreter
+    };
+
+    //Code segment (translated to one C++ function)
+    struct AotSegment{
+      CpuAdr BegAddress; //Beginning code address
+      CpuAdr EndAddress; //Ending code address
+      String Name;       //Program function name
+    };
+
+    //Internal data
+    const char *_CodePtr;    //Code buffer
+    CpuAdr _CodeLength;      //Code buffer length
+    Buffer _Flags;           //Flags for each code address
+    Array<String> _Lines;    //Generated source lines
+    int _FunctionNr;         //Generated functions
+    int _EntryNr;            //Generated entry points
+    int _InstNr;             //Translated instructions
+
+    //Internal methods
+    const char *_Template(CpuInstCode InstCode,const char **Guard);
+    bool _OperandsFit(CpuAdr IP,CpuInstCode InstCode);
+    String _Operand(CpuAdr IP,CpuInstCode InstCode,int ArgIndex);
+    String _Expand(const char *Template,CpuAdr IP,CpuInstCode InstCode);
+    String _Label(CpuAdr Address);
+    String _Jump(CpuAdr Target,const AotSegment& Seg);
+    void _ScanCode();
+    void _EmitHeader(const String& ProgName);
+    void _EmitSegment(int SegIndex,const AotSegment& Seg);
+    void _EmitFooter(const Array<AotSegment>& Segments);
+    void _Out(const String& Line);
+
+  //Public members
+  public:
+
+    //Methods
+    bool Translate(const char *CodePtr,CpuAdr CodeLength,const Array<DbgSymFunction>& Functions,const String& ProgName,const String& SourceFile);
+    static String LibraryFile(const String& BinaryFile);
+    static String SourceFile(const String& BinaryFile);
+    inline int FunctionNr() const { return _FunctionNr; }
+    inline int EntryNr() const { return _EntryNr; }
+    inline int InstNr() const { return _InstNr; }
+
+    //Constructor / Destructor
+    AotTranslator(){ _CodePtr=nullptr; _CodeLength=0; _FunctionNr=0; _EntryNr=0; _InstNr=0; }
+    ~AotTranslator(){}
+
+};
+
+#endif
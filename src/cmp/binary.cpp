@@ -12,6 +12,7 @@
 #include "sys/stl.hpp"
 #include "sys/msgout.hpp"
 #include "cmp/binary.hpp"
+#include "cmp/aot.hpp"
 
 //Constants
 const int _DefaultAsmIndentation=36;
@@ -358,6 +359,8 @@ Binary::Binary(){
   _BlockMax=DEFAULTBLOCKMAX;
   _AsmIndentation=_DefaultAsmIndentation;
   _CompileToLibrary=false;
+  _ParRegion=false;
+  _ParExitLabel="";
   _LibMajorVers=0;
   _LibMinorVers=0;
   _LibRevisionNr=0;
@@ -676,6 +679,14 @@ void Binary::_WriteBinaryError(int Hnd,const char *FileMark,const String& Index)
   SysMessage(121).Print(_Stl->FileSystem.Hnd2File(Hnd),_Stl->LastError(),FileMark,Index,ToString(_Stl->FileSystem.GetPrevPos(Hnd)));
 }
 
+//Set binary file section directory entry (advances file offset over section mark and section contents)
+void Binary::_SetBinarySection(BinaryHeader& Hdr,BinSection Section,CpuLon Length,CpuLon& Offset){
+  Offset+=strlen(BinSectionMark(Section));
+  Hdr.Section[(int)Section].Offset=Offset;
+  Hdr.Section[(int)Section].Length=Length;
+  Offset+=Length;
+}
+
 //Write binary file
 bool Binary::_WriteBinary(const String& FileName,bool Library,bool DebugSymbols){
   
@@ -684,6 +695,8 @@ bool Binary::_WriteBinary(const String& FileName,bool Library,bool DebugSymbols)
   int Hnd;
   CpuWrd BlockLength;
   CpuInt ObjIdLength;
+  CpuLon Offset;
+  CpuLon Length;
   BinaryHeader Hdr;
 
   //Debug message
@@ -740,6 +753,37 @@ bool Binary::_WriteBinary(const String& FileName,bool Library,bool DebugSymbols)
   Hdr.DbgSymParNr=(DebugSymbols?_ODbgSymTables.Par.Length():0);
   Hdr.DbgSymLinNr=(DebugSymbols?_ODbgSymTables.Lin.Length():0);
   Hdr.SuperInitAdr=(Library?_SuperInitAdr:0);
+
+  //Fill section directory (sections are written after header in this same order, so loaders can find them without reading whole file)
+  Offset=sizeof(BinaryHeader);
+  _SetBinarySection(Hdr,BinSection::Glob,_GlobBuffer.Length(),Offset);
+  _SetBinarySection(Hdr,BinSection::Code,_CodeBuffer.Length(),Offset);
+  _SetBinarySection(Hdr,BinSection::ArrFixDef,sizeof(ArrayFixDef)*_ArrFixDef.Length(),Offset);
+  _SetBinarySection(Hdr,BinSection::ArrDynDef,sizeof(ArrayDynDef)*_ArrDynDef.Length(),Offset);
+  for(i=0,Length=0;i<_Block.Length();i++){ Length+=sizeof(_Block[i].ArrIndex)+sizeof(BlockLength)+_Block[i].Buff.Length(); }
+  _SetBinarySection(Hdr,BinSection::Block,Length,Offset);
+  _SetBinarySection(Hdr,BinSection::DlCall,sizeof(DlCallDef)*_DlCall.Length(),Offset);
+  if(Library){
+    _SetBinarySection(Hdr,BinSection::Depen,sizeof(Dependency)*_Depen.Length(),Offset);
+    for(i=0,Length=0;i<_OUndRef.Length();i++){ Length+=sizeof(_OUndRef[i].Module)+sizeof(_OUndRef[i].Kind)+sizeof(_OUndRef[i].CodeAdr)+sizeof(ObjIdLength)+_OUndRef[i].ObjectName.Length(); }
+    _SetBinarySection(Hdr,BinSection::UndRef,Length,Offset);
+    _SetBinarySection(Hdr,BinSection::Reloc,sizeof(RelocItem)*_RelocTable.Length(),Offset);
+    _SetBinarySection(Hdr,BinSection::LnkSymDim,sizeof(_OLnkSymTables.Dim[0])*_OLnkSymTables.Dim.Length(),Offset);
+    _SetBinarySection(Hdr,BinSection::LnkSymTyp,sizeof(_OLnkSymTables.Typ[0])*_OLnkSymTables.Typ.Length(),Offset);
+    _SetBinarySection(Hdr,BinSection::LnkSymVar,sizeof(_OLnkSymTables.Var[0])*_OLnkSymTables.Var.Length(),Offset);
+    _SetBinarySection(Hdr,BinSection::LnkSymFld,sizeof(_OLnkSymTables.Fld[0])*_OLnkSymTables.Fld.Length(),Offset);
+    _SetBinarySection(Hdr,BinSection::LnkSymFun,sizeof(_OLnkSymTables.Fun[0])*_OLnkSymTables.Fun.Length(),Offset);
+    _SetBinarySection(Hdr,BinSection::LnkSymPar,sizeof(_OLnkSymTables.Par[0])*_OLnkSymTables.Par.Length(),Offset);
+  }
+  if(DebugSymbols){
+    _SetBinarySection(Hdr,BinSection::DbgSymMod,sizeof(DbgSymModule)*_ODbgSymTables.Mod.Length(),Offset);
+    _SetBinarySection(Hdr,BinSection::DbgSymTyp,sizeof(DbgSymType)*_ODbgSymTables.Typ.Length(),Offset);
+    _SetBinarySection(Hdr,BinSection::DbgSymVar,sizeof(DbgSymVariable)*_ODbgSymTables.Var.Length(),Offset);
+    _SetBinarySection(Hdr,BinSection::DbgSymFld,sizeof(DbgSymField)*_ODbgSymTables.Fld.Length(),Offset);
+    _SetBinarySection(Hdr,BinSection::DbgSymFun,sizeof(DbgSymFunction)*_ODbgSymTables.Fun.Length(),Offset);
+    _SetBinarySection(Hdr,BinSection::DbgSymPar,sizeof(DbgSymParameter)*_ODbgSymTables.Par.Length(),Offset);
+    _SetBinarySection(Hdr,BinSection::DbgSymLin,sizeof(DbgSymLine)*_ODbgSymTables.Lin.Length(),Offset);
+  }
   
   //Print program header
   DebugMessage(DebugLevel::CmpBinary,"Written binary header");
@@ -781,6 +825,9 @@ bool Binary::_WriteBinary(const String& FileName,bool Library,bool DebugSymbols)
   DebugMessage(DebugLevel::CmpBinary,"DbgSymParNr  : "+ToString(Hdr.DbgSymParNr));
   DebugMessage(DebugLevel::CmpBinary,"DbgSymLinNr  : "+ToString(Hdr.DbgSymLinNr));
   DebugMessage(DebugLevel::CmpBinary,"SuperInitAdr : "+HEXFORMAT(Hdr.SuperInitAdr));
+  for(i=0;i<_BinSectionNr;i++){
+    DebugMessage(DebugLevel::CmpBinary,"Section "+String(BinSectionMark((BinSection)i))+" : offset="+ToString(Hdr.Section[i].Offset)+" length="+ToString(Hdr.Section[i].Length));
+  }
   
   //Write objects to file
   if(!_Stl->FileSystem.Write(Hnd,Buffer((char *)&Hdr,sizeof(Hdr)))){ _WriteBinaryError(Hnd,"HEAD","0"); return false; }
@@ -1157,6 +1204,34 @@ bool Binary::GenerateExecutable(bool DebugSymbols){
   return _WriteBinary(_BinaryFile,false,DebugSymbols);
 }
 
+//Generate native library for executable
+//(code buffer is translated to C++ and compiled into a shared library that runtime loads when started with -aot)
+bool Binary::GenerateNativeLibrary(){
+
+  //Variables
+  String SourceFile;
+  String LibraryFile;
+  String Command;
+  AotTranslator Aot;
+
+  //Translate code buffer
+  SourceFile=AotTranslator::SourceFile(_BinaryFile);
+  LibraryFile=AotTranslator::LibraryFile(_BinaryFile);
+  if(!Aot.Translate(_CodeBuffer.BuffPnt(),_CodeBuffer.Length(),_ODbgSymTables.Fun,_Stl->FileSystem.GetFileNameNoExt(_BinaryFile),SourceFile)){ return false; }
+
+  //Compile source into shared library
+  Command=String(AOT_COMPILER_CMD)+" -o \""+LibraryFile+"\" \""+SourceFile+"\"";
+  DebugMessage(DebugLevel::CmpBinary,"Native compiler command: "+Command);
+  if(std::system(Command.CharPnt())!=0){
+    SysMessage(583).Print(LibraryFile,Command);
+    return false;
+  }
+
+  //Return code
+  return true;
+
+}
+
 //Readlibrary but only importlibrary dependencies
 bool Binary::LoadLibraryDependencies(const String& FileName,BinaryHeader& Hdr,Array<Dependency>& Depen,const SourceInfo& SrcInfo){
   
@@ -1614,6 +1689,11 @@ bool Binary::PrintBinary(const String& FileName,bool Library){
   _Stl->Console.PrintLine("DbgSymParNr  : "+ToString(Hdr.DbgSymParNr));
   _Stl->Console.PrintLine("DbgSymLinNr  : "+ToString(Hdr.DbgSymLinNr));
   _Stl->Console.PrintLine("SuperInitAdr : "+HEXFORMAT(Hdr.SuperInitAdr));
+  for(i=0;i<_BinSectionNr;i++){
+    if(Hdr.Section[i].Offset!=0){
+      _Stl->Console.PrintLine("Section "+String(BinSectionMark((BinSection)i))+" : offset="+ToString(Hdr.Section[i].Offset)+" length="+ToString(Hdr.Section[i].Length));
+    }
+  }
   _Stl->Console.PrintLine("");
 
   //Print fixed array definitions
@@ -3362,6 +3442,26 @@ bool Binary::SetFunctionStackInst(){
   return true;
 }
 
+//Open parallel walk region (on variable is the first safe reference)
+void Binary::ParallelRegionBegin(CpuAdr OnVarAddress,const String& ExitLabel){
+  _ParRegion=true;
+  _ParExitLabel=ExitLabel;
+  _ParSafeRef.Reset();
+  _ParSafeRef.Add(OnVarAddress);
+}
+
+//Close parallel walk region
+void Binary::ParallelRegionEnd(){
+  _ParRegion=false;
+  _ParExitLabel="";
+  _ParSafeRef.Reset();
+}
+
+//Parallel walk region is open
+bool Binary::ParallelRegionOpen(){
+  return _ParRegion;
+}
+
 //Set function stack size
 void Binary::SetFunctionStackSize(CpuAdr FunAddress){
   
@@ -3539,6 +3639,102 @@ bool Binary::_AsmChecks(CpuInstCode InstCode,int ArgNr,const AsmArg *Arg){
 
 }
 
+//Parallel walk body checks
+//(loop body runs on several threads at once, so it can only calculate on local variables, which are private to each
+//worker, and modify current element through the on variable or local references derived from it, references are
+//followed in code order)
+bool Binary::_ParChecks(CpuInstCode InstCode,int ArgNr,const AsmArg *Arg){
+
+  //Variables
+  int i;
+  int Written;
+  bool Safe;
+
+  //Allowed instructions (calculations on scalar values, references, jumps and decoders)
+  switch(InstCode){
+    case CpuInstCode::LESs: case CpuInstCode::LEQs: case CpuInstCode::GREs: case CpuInstCode::GEQs: case CpuInstCode::EQUs: case CpuInstCode::DISs:
+    case CpuInstCode::BO2ST: case CpuInstCode::CH2ST: case CpuInstCode::CHFMT: case CpuInstCode::SH2ST: case CpuInstCode::SHFMT:
+    case CpuInstCode::IN2ST: case CpuInstCode::INFMT: case CpuInstCode::LO2ST: case CpuInstCode::LOFMT: case CpuInstCode::FL2ST: case CpuInstCode::FLFMT:
+    case CpuInstCode::ST2BO: case CpuInstCode::ST2CH: case CpuInstCode::ST2SH: case CpuInstCode::ST2IN: case CpuInstCode::ST2LO: case CpuInstCode::ST2FL:
+      SysMessage(604,_FileName,_LineNr,_ColNr).Print(_Inst[(int)InstCode].Mnemonic);
+      return false;
+      break;
+    case CpuInstCode::REFOF: case CpuInstCode::REFAD: case CpuInstCode::REFER: case CpuInstCode::COPY: case CpuInstCode::CLEAR:
+    case CpuInstCode::AF1RF: case CpuInstCode::AD1RF: case CpuInstCode::CUPPR: case CpuInstCode::CLOWR:
+    case CpuInstCode::JMPTR: case CpuInstCode::JMPFL: case CpuInstCode::JMP: case CpuInstCode::NOP:
+      break;
+    default:
+      if(!((int)InstCode>=(int)CpuInstCode::NEGc  && (int)InstCode<=(int)CpuInstCode::MVORl)
+      && !((int)InstCode>=(int)CpuInstCode::BO2CH && (int)InstCode<=(int)CpuInstCode::FL2LO)
+      && !((int)InstCode>=(int)CpuInstCode::DAGV1 && (int)InstCode<=(int)CpuInstCode::DALI4)){
+        SysMessage(604,_FileName,_LineNr,_ColNr).Print(_Inst[(int)InstCode].Mnemonic);
+        return false;
+      }
+      break;
+  }
+
+  //Jumps cannot leave loop and decoders do not write variables
+  switch(InstCode){
+    case CpuInstCode::JMPTR: case CpuInstCode::JMPFL: case CpuInstCode::JMP:
+      for(i=0;i<ArgNr;i++){
+        if(Arg[i].Type==CpuDataType::JumpAddr && Arg[i].Name==_ParExitLabel){
+          SysMessage(607,_FileName,_LineNr,_ColNr).Print();
+          return false;
+        }
+      }
+      return true;
+      break;
+    case CpuInstCode::NOP:
+      return true;
+      break;
+    default:
+      if((int)InstCode>=(int)CpuInstCode::DAGV1 && (int)InstCode<=(int)CpuInstCode::DALI4){ return true; }
+      break;
+  }
+
+  //Written arguments (first one, postfix increments and decrements write also second one)
+  Written=1;
+  if((int)InstCode>=(int)CpuInstCode::PINCc && (int)InstCode<=(int)CpuInstCode::PDECf){ Written=2; }
+
+  //Written variables must be local and indirections must go through safe references
+  for(i=0;i<Written && i<ArgNr;i++){
+    if(Arg[i].AdrMode==CpuAdrMode::Address && Arg[i].Glob){
+      SysMessage(605,_FileName,_LineNr,_ColNr).Print("global variable "+Arg[i].Name);
+      return false;
+    }
+    if(Arg[i].AdrMode==CpuAdrMode::Indirection && (Arg[i].Glob || _ParSafeRef.Search(Arg[i].Value.Adr)==-1)){
+      SysMessage(605,_FileName,_LineNr,_ColNr).Print("data through reference "+Arg[i].Name);
+      return false;
+    }
+  }
+
+  //Track local references (references to local variables or to memory pointed by safe references are safe as well)
+  if(Arg[0].AdrMode==CpuAdrMode::Address){
+    switch(InstCode){
+      case CpuInstCode::REFOF: 
+      case CpuInstCode::REFER: 
+        Safe=(Arg[1].AdrMode==CpuAdrMode::Address && !Arg[1].Glob) 
+        || (Arg[1].AdrMode==CpuAdrMode::Indirection && !Arg[1].Glob && _ParSafeRef.Search(Arg[1].Value.Adr)!=-1); 
+        break;
+      case CpuInstCode::MVr: 
+        Safe=(Arg[1].AdrMode==CpuAdrMode::Address && !Arg[1].Glob && _ParSafeRef.Search(Arg[1].Value.Adr)!=-1); 
+        break;
+      case CpuInstCode::REFAD: 
+        Safe=(_ParSafeRef.Search(Arg[0].Value.Adr)!=-1); 
+        break;
+      default: 
+        Safe=false; 
+        break;
+    }
+    if(Safe && _ParSafeRef.Search(Arg[0].Value.Adr)==-1){ _ParSafeRef.Add(Arg[0].Value.Adr); }
+    if(!Safe && _ParSafeRef.Search(Arg[0].Value.Adr)!=-1){ _ParSafeRef.Delete(_ParSafeRef.Search(Arg[0].Value.Adr)); }
+  }
+
+  //Return success
+  return true;
+
+}
+
 //Emit decoder programming instructions
 bool Binary::_AsmProgDecoders(AsmSection Section,CpuInstCode InstCode,int ArgNr,AsmArg *Arg){
 
@@ -3692,6 +3888,11 @@ bool Binary::_AsmWriteCode(CpuInstCode InstCode,AsmSection Section,bool StrArg,c
   if(!_AsmLitValueReplacements(InstCode,ArgNr,Arg,ReplIds,ReplIndexes)){ return false; }
   for(i=0;i<ArgNr;i++){ OrigArg[i]=Arg[i]; }
 
+  //Parallel walk body checks (before decoders change indirections into addresses)
+  if(_ParRegion && Section==AsmSection::Body){
+    if(!_ParChecks(InstCode,ArgNr,Arg)){ return false; }
+  }
+
   //Send decoder programming instructions
   if(!_AsmProgDecoders(Section,InstCode,ArgNr,Arg)){ return false; }
 
@@ -377,6 +377,11 @@ class Binary{
     bool _GlobReplLitValues;
     Array<LitNumValueVars> _ReplLitValues;
 
+    //Parallel walk region (instructions of parallel walk body are checked while region is open)
+    bool _ParRegion;           //Parallel walk region is open
+    String _ParExitLabel;      //Exit label of parallel walk
+    Array<CpuAdr> _ParSafeRef; //Local references pointing to current element or to local variables
+
     //Library optios
     bool _CompileToLibrary; //Compile to library option
     CpuShr _LibMajorVers;   //Library major version
@@ -419,12 +424,14 @@ class Binary{
     void _AsmInstCodeReplacements(CpuInstCode &InstCode,int ArgNr,const AsmArg *Arg);
     bool _AsmLitValueReplacements(CpuInstCode InstCode,int ArgNr,AsmArg *Arg,String& ReplIds,int *ReplIndexes);
     bool _AsmChecks(CpuInstCode InstCode,int ArgNr,const AsmArg *Arg);
+    bool _ParChecks(CpuInstCode InstCode,int ArgNr,const AsmArg *Arg);
     bool _AsmProgDecoders(AsmSection Section,CpuInstCode InstCode,int ArgNr,AsmArg *Arg);
     bool _AsmWriteCode(CpuInstCode InstCode,AsmSection Section,bool StrArg,const AsmArg& Arg1=AsmArg(),const AsmArg& Arg2=AsmArg(),const AsmArg& Arg3=AsmArg(),const AsmArg& Arg4=AsmArg());
     void _AsmOutCode(AsmSection Section,CpuAdr InstAdr,Array<String>& Labels,CpuInstCode InstCode,bool StrArg,AsmArg *Arg,int ArgNr,const String& Tag);
     Array<String> _AsmBufferFilter(const Array<AssemblerLine>& Buff,int NestId);
     void _AsmOutRaw(AsmSection Section,const String& OutLine);
     void _WriteBinaryError(int Hnd,const char *FileMark,const String& Index);
+    void _SetBinarySection(BinaryHeader& Hdr,BinSection Section,CpuLon Length,CpuLon& Offset);
     bool _WriteBinary(const String& FileName,bool Library,bool DebugSymbols);
     void _CalcRelocations(CpuInstCode InstCode,int ArgIndex,const AsmArg& Arg);
     void _ReadBinaryError(int Hnd,const char *FileMark,const String& Index,const SourceInfo& SrcInfo);
@@ -479,6 +486,7 @@ class Binary{
     void SetMemoryConfigBlockMax(CpuMbl BlockMax);
     bool GenerateLibrary(bool DebugSymbols);
     bool GenerateExecutable(bool DebugSymbols);
+    bool GenerateNativeLibrary();
     bool LoadLibraryDependencies(const String& FileName,BinaryHeader& Hdr,Array<Dependency>& Depen,const SourceInfo& SrcInfo);
     bool ImportLibrary(const String& FileName,bool HardLinkage,CpuAdr& InitAddress,CpuShr Major,CpuShr Minor,CpuShr RevNr,const SourceInfo& SrcInfo);
     bool PrintBinary(const String& FileName,bool Library);
@@ -540,6 +548,9 @@ class Binary{
     CpuLon GetInitBufferSize();
     bool SetFunctionStackInst();
     void SetFunctionStackSize(CpuAdr FunAddress);
+    void ParallelRegionBegin(CpuAdr OnVarAddress,const String& ExitLabel);
+    void ParallelRegionEnd();
+    bool ParallelRegionOpen();
     bool AsmWriteCode(CpuMetaInst Meta,const AsmArg& Arg1=AsmArg(),const AsmArg& Arg2=AsmArg(),const AsmArg& Arg3=AsmArg(),const AsmArg& Arg4=AsmArg());
     bool AsmWriteCode(CpuMetaInst Meta,int DriverArg,const AsmArg& Arg1=AsmArg(),const AsmArg& Arg2=AsmArg(),const AsmArg& Arg3=AsmArg(),const AsmArg& Arg4=AsmArg());
     bool AsmWriteCode(CpuInstCode InstCode,const AsmArg& Arg1=AsmArg(),const AsmArg& Arg2=AsmArg(),const AsmArg& Arg3=AsmArg(),const AsmArg& Arg4=AsmArg());
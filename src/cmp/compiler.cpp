@@ -45,6 +45,7 @@ void CompilerConfig::_Move(const CompilerConfig& Config){
   CompilerStats=Config.CompilerStats;
   LinterMode=Config.LinterMode;
   CompileToApp=Config.CompileToApp;
+  AotCompile=Config.AotCompile;
 }
 
 //Compiler constructor
@@ -121,6 +122,7 @@ bool Compiler::Compile(const String& SourceFile,const String& OutputFile,const S
   Stack<Sentence> ForStep;
   Stack<Sentence> SwitchExpr;
   Stack<ExprToken> WalkArray;
+  Stack<int> WalkGen;
   Expression Expr;
   String AssemblerFile;
   String DefaultPath;
@@ -515,7 +517,12 @@ bool Compiler::Compile(const String& SourceFile,const String& OutputFile,const S
 
       //Return
       case SentenceId::Return:
-        if(!_CompileReturn(Stn,_Md->GetMainFunctionName())){ Error=true; break; }
+        if(!_CompileReturn(Stn,_Md->GetMainFunctionName(),WalkGen)){ Error=true; break; }
+        break;
+
+      //Yield
+      case SentenceId::Yield:
+        if(!_CompileYield(Stn)){ Error=true; break; }
         break;
 
       //If
@@ -570,12 +577,12 @@ bool Compiler::Compile(const String& SourceFile,const String& OutputFile,const S
 
       //Walk
       case SentenceId::Walk:
-        if(!_CompileWalk(Stn,WalkArray)){ Error=true; break; }
+        if(!_CompileWalk(Stn,WalkArray,WalkGen)){ Error=true; break; }
         break;
 
       //EndWalk
       case SentenceId::EndWalk:
-        if(!_CompileEndWalk(Stn,WalkArray)){ Error=true; break; }
+        if(!_CompileEndWalk(Stn,WalkArray,WalkGen)){ Error=true; break; }
         break;
 
       //Switch
@@ -752,6 +759,9 @@ bool Compiler::Compile(const String& SourceFile,const String& OutputFile,const S
       }
       else{
         if(!_Md->Bin.GenerateExecutable(_Config.DebugSymbols)){ Error=true; }
+        if(!Error && _Config.AotCompile){
+          if(!_Md->Bin.GenerateNativeLibrary()){ Error=true; }
+        }
       }
     }
     else{
@@ -2973,6 +2983,7 @@ bool Compiler::_CompileFuncDecl(Sentence& Stn,int& FunIndex){
 
   //Variables
   bool IsVoid;
+  bool IsGenerator;
   bool PassByRef;
   bool ConstRef;
   bool IsConstructor;
@@ -3078,6 +3089,21 @@ bool Compiler::_CompileFuncDecl(Sentence& Stn,int& FunIndex){
     IsInitializer=false; 
   }
 
+  //Detect generator functions (only regular non nested functions returning a value)
+  IsGenerator=false;
+  if(Stn.Is(PrKeyword::Yield)){
+    Stn.Get(PrKeyword::Yield);
+    if(Kind!=FunctionKind::Function || _Md->CurrentScope().Kind==ScopeKind::Local){
+      Stn.Msg(610).Print();
+      return false;
+    }
+    if(Stn.Is(PrKeyword::Void)){
+      Stn.Msg(609).Print();
+      return false;
+    }
+    IsGenerator=true;
+  }
+
   //Detect void functions / Get returning data type
   if(IsConstructor){
     ResTypIndex=_Md->CurrentSubScope().TypIndex;
@@ -3129,6 +3155,7 @@ bool Compiler::_CompileFuncDecl(Sentence& Stn,int& FunIndex){
     case FunctionKind::MasterMth  : Stn.Msg(296).Print(); return false;
   }
   FunIndex=_Md->Functions.Length()-1;
+  _Md->Functions[FunIndex].IsGenerator=IsGenerator;
 
   //Update function member indexes in parent datatype
   if(Kind==FunctionKind::Member){
@@ -3335,6 +3362,7 @@ bool Compiler::_CompileFuncDefn(Sentence& Stn,int& FunIndex){
   int i;
   int ModIndex;
   bool IsVoid;
+  bool IsGenerator;
   bool PassByRef;
   bool ConstRef;
   bool IsConstructor;
@@ -3377,6 +3405,13 @@ bool Compiler::_CompileFuncDefn(Sentence& Stn,int& FunIndex){
     Kind=FunctionKind::Function;
   } 
 
+  //Detect generator functions
+  IsGenerator=false;
+  if(Kind==FunctionKind::Function && Stn.Is(PrKeyword::Yield)){
+    Stn.Get(PrKeyword::Yield);
+    IsGenerator=true;
+  }
+
   //Detect void functions / Get returning data type
   if(IsConstructor){
     if((ResTypIndex=_Md->TypSearch(Stn.Tokens[Stn.GetProcIndex()].Value.Typ,_Md->CurrentScope().ModIndex))==-1){
@@ -3550,6 +3585,12 @@ bool Compiler::_CompileFuncDefn(Sentence& Stn,int& FunIndex){
     return false;
   }
 
+  //Check generator definition matches declaration
+  if(IsGenerator!=_Md->Functions[FunIndex].IsGenerator){
+    Stn.Msg(614).Print(MsgFunName);
+    return false;
+  }
+
   //Determine parenthensys parameter start (we must skip function result and reference to self)
   ParmStart=0;
   if(!IsVoid){ ParmStart++; }
@@ -3641,13 +3682,13 @@ bool Compiler::_CompileEndFunction(Sentence& Stn,SentenceId LastStnId){
   //Return statement did not happened before end function
   if(LastStnId!=SentenceId::Return){
 
-    //Return statement before is mandatory
-    if(!_Md->Functions[_Md->CurrentScope().FunIndex].IsVoid){
+    //Return statement before is mandatory (generators return their values with yield)
+    if(!_Md->Functions[_Md->CurrentScope().FunIndex].IsVoid && !_Md->Functions[_Md->CurrentScope().FunIndex].IsGenerator){
       Stn.Tokens[0].Msg(119).Print();
       return false;
     }
   
-    //Emit return statement if fuction is void
+    //Emit return statement if fuction is void or generator
     _Md->Bin.AsmOutNewLine(AsmSection::Body);
     _Md->Bin.AsmOutCommentLine(AsmSection::Body,"Return from function",true);
     if(_Md->ParentScope().Kind==ScopeKind::Local){
@@ -3889,9 +3930,10 @@ bool Compiler::_CompileEndMain(Sentence& Stn,const String& ProgName,SentenceId L
 
 //Compile return
 //return [<expr>]
-bool Compiler::_CompileReturn(Sentence& Stn,const String& ProgName){
+bool Compiler::_CompileReturn(Sentence& Stn,const String& ProgName,Stack<int>& WalkGen){
 
   //Variables
+  int i;
   int Begin;
   int End;
   bool HasRetValue;
@@ -3914,8 +3956,14 @@ bool Compiler::_CompileReturn(Sentence& Stn,const String& ProgName){
     HasRetValue=true;
   }
 
-  //Check return value is permitted
-  if(_Md->Functions[_Md->CurrentScope().FunIndex].IsVoid && HasRetValue){
+  //Check return value is permitted (generators end without value)
+  if(_Md->Functions[_Md->CurrentScope().FunIndex].IsGenerator){
+    if(HasRetValue){
+      Stn.Tokens[0].Msg(615).Print();
+      return false;
+    }
+  }
+  else if(_Md->Functions[_Md->CurrentScope().FunIndex].IsVoid && HasRetValue){
     Stn.Tokens[0].Msg(117).Print();
     return false;
   }
@@ -3933,6 +3981,14 @@ bool Compiler::_CompileReturn(Sentence& Stn,const String& ProgName){
     if(!Expression().CopyOperand(_Md,ResultVar,ResultVal)){ return false; } 
   }
 
+  //Free generators of walk loops we are leaving (outermost one frees all generators created after it)
+  for(i=0;i<WalkGen.Length();i++){
+    if(WalkGen[i]!=-1 && _Md->Variables[WalkGen[i]].Scope.FunIndex==_Md->CurrentScope().FunIndex){
+      if(!_Md->Bin.AsmWriteCode(CpuInstCode::GNFRE,_Md->AsmVar(WalkGen[i]))){ return false; }
+      break;
+    }
+  }
+
   //Return instruction
   if(_Md->Functions[_Md->CurrentScope().FunIndex].Name==ProgName){
     if(!_Md->Bin.AsmWriteCode(CpuInstCode::SCALL,_Md->Bin.AsmLitInt((int)SystemCall::ProgramExit))){ return false; }
@@ -3949,6 +4005,43 @@ bool Compiler::_CompileReturn(Sentence& Stn,const String& ProgName){
 
 }
 
+//Compile yield
+//yield <expr>
+bool Compiler::_CompileYield(Sentence& Stn){
+
+  //Variables
+  int Begin;
+  int End;
+  int RetIndex;
+  Expression Expr;
+  ExprToken ResultVal;
+  ExprToken ResultVar;
+
+  //Parse sentence
+  if(!Stn.Get(PrKeyword::Yield).ReadEx(Begin,End).Ok()){ 
+    return false;
+  }
+
+  //Yield is only allowed inside generator functions
+  if(_Md->CurrentScope().Kind!=ScopeKind::Local || !_Md->Functions[_Md->CurrentScope().FunIndex].IsGenerator){
+    Stn.Tokens[0].Msg(611).Print();
+    return false;
+  }
+
+  //Calculate yielded value on function result
+  if((RetIndex=_Md->VarSearch(_Md->GetFuncResultName(),_Md->CurrentScope().ModIndex))==-1){ Stn.Tokens[0].Msg(375).Print(); return false; }
+  ResultVar.ThisInd(_Md,RetIndex,Stn.Tokens[0].SrcInfo());
+  if(!Expr.Compile(_Md,_Md->CurrentScope(),Stn,Begin,End,ResultVal)){ return false; }
+  if(!Expression().CopyOperand(_Md,ResultVar,ResultVal)){ return false; } 
+
+  //Yield instruction
+  if(!_Md->Bin.AsmWriteCode(CpuInstCode::YIELD)){ return false; }
+
+  //Return code
+  return true;
+
+}
+
 //Compile if statement
 //if(<expr>):
 bool Compiler::_CompileIf(Sentence& Stn){
@@ -4281,7 +4374,7 @@ bool Compiler::_CompileEndFor(Sentence& Stn,Stack<Sentence>& ForStep){
 
 //Compile Walk statement
 //walk(<arraylvalue> on <element> [index <indexvar>] [if <condition>]):
-bool Compiler::_CompileWalk(Sentence& Stn,Stack<ExprToken>& WalkArray){
+bool Compiler::_CompileWalk(Sentence& Stn,Stack<ExprToken>& WalkArray,Stack<int>& WalkGen){
 
   //Variables
   int ArrExpr[2];
@@ -4289,8 +4382,10 @@ bool Compiler::_CompileWalk(Sentence& Stn,Stack<ExprToken>& WalkArray){
   int ElemTypIndex;
   int OnVarIndex;
   int IxVarIndex;
+  int GenHndIndex;
   bool HasIndex;
   bool HasIfExpr;
+  bool Parallel;
   String OnVarName;
   String IxVarName;
   String FoundObject;
@@ -4303,6 +4398,11 @@ bool Compiler::_CompileWalk(Sentence& Stn,Stack<ExprToken>& WalkArray){
   //Parse sentence
   HasIndex=false;
   HasIfExpr=false;
+  Parallel=false;
+  if(Stn.Is(PrKeyword::Parallel)){
+    Stn.Get(PrKeyword::Parallel);
+    Parallel=true;
+  }
   if(!Stn.Get(PrKeyword::Walk).Get(PrPunctuator::BegParen).ReadEx(PrKeyword::On,ArrExpr[0],ArrExpr[1]).Get(PrKeyword::On).ReadId(OnVarName).Ok()){ 
     return false; 
   }
@@ -4324,27 +4424,58 @@ bool Compiler::_CompileWalk(Sentence& Stn,Stack<ExprToken>& WalkArray){
     return false;
   }
 
-  //Compile array expression
-  if(!Expr.Compile(_Md,_Md->CurrentScope(),Stn,ArrExpr[0],ArrExpr[1],ArrToken)){ return false; }
+  //Compile array expression (generator function calls are only allowed here)
+  _Md->GenCallAllowed=true;
+  _Md->GenHandleVar=-1;
+  _Md->GenResultVar=-1;
+  if(!Expr.Compile(_Md,_Md->CurrentScope(),Stn,ArrExpr[0],ArrExpr[1],ArrToken)){ _Md->GenCallAllowed=false; return false; }
+  _Md->GenCallAllowed=false;
+  GenHndIndex=_Md->GenHandleVar;
+
+  //Generator call must be whole walk expression and it is not supported on parallel walk
+  if(GenHndIndex!=-1){
+    if(ArrToken.Id()!=ExprTokenId::Operand || ArrToken.VarIndex()!=_Md->GenResultVar){
+      Stn.Tokens[ArrExpr[0]].Msg(612).Print();
+      return false;
+    }
+    if(Parallel){
+      Stn.Tokens[ArrExpr[0]].Msg(613).Print();
+      return false;
+    }
+  }
 
   //Check array expression results in array, lvalue and 1-dimensional
-  if(ArrToken.MstType()!=MasterType::FixArray && ArrToken.MstType()!=MasterType::DynArray){
+  else if(ArrToken.MstType()!=MasterType::FixArray && ArrToken.MstType()!=MasterType::DynArray){
     Stn.Tokens[ArrExpr[0]].Msg(497).Print();
     return false;
   }
-  if(_Md->Types[ArrToken.TypIndex()].DimNr!=1){
+  if(GenHndIndex==-1 && _Md->Types[ArrToken.TypIndex()].DimNr!=1){
     Stn.Tokens[ArrExpr[0]].Msg(523).Print();
     return false;
   }
 
-  //Push walk array
+  //Parallel walk checks (workers run on copies of function stack frame, so loop must be inside a function and cannot 
+  //iterate over an array that lives in the stack frame)
+  if(Parallel){
+    if(_Md->CurrentScope().Kind!=ScopeKind::Local){
+      Stn.Tokens[0].Msg(602).Print();
+      return false;
+    }
+    if(ArrToken.MstType()==MasterType::FixArray && ArrToken.Asm().AdrMode==CpuAdrMode::Address && !ArrToken.Asm().Glob){
+      Stn.Tokens[ArrExpr[0]].Msg(603).Print();
+      return false;
+    }
+  }
+
+  //Push walk array and generator handler
   WalkArray.Push(ArrToken);
+  WalkGen.Push(GenHndIndex);
 
   //Set array token as used
   ArrToken.SetSourceUsed(_Md->CurrentScope(),true);
 
-  //Get element type index
-  ElemTypIndex=_Md->Types[ArrToken.TypIndex()].ElemTypIndex;
+  //Get element type index (generators produce values of function result type)
+  ElemTypIndex=(GenHndIndex!=-1?ArrToken.TypIndex():_Md->Types[ArrToken.TypIndex()].ElemTypIndex);
 
   //On variable must not be already defined
   if(_Md->VarSearch(OnVarName,_Md->CurrentScope().ModIndex)!=-1){
@@ -4417,6 +4548,12 @@ bool Compiler::_CompileWalk(Sentence& Stn,Stack<ExprToken>& WalkArray){
 
     }
 
+    //Index variable of parallel walk is private to each worker
+    if(Parallel && _Md->AsmVad(IxVarIndex).Glob){
+      IxVarToken.Msg(606).Print();
+      return false;
+    }
+
     //Set index variable as initialized (as no initialization is required)
     _Md->Variables[IxVarIndex].IsInitialized=true;
     DebugMessage(DebugLevel::CmpExpression,"Initialized flag set for variable "+_Md->Variables[IxVarIndex].Name+" in scope "+_Md->ScopeName(_Md->Variables[IxVarIndex].Scope));
@@ -4428,20 +4565,39 @@ bool Compiler::_CompileWalk(Sentence& Stn,Stack<ExprToken>& WalkArray){
     IxVarIndex=-1;
   }
 
+  //Send initialization instructions for generators
+  //(generator already ran until first yield, on variable points to function result that is updated on every resume)
+  if(GenHndIndex!=-1){
+    if(IxVarIndex!=-1){
+      if(!_Md->Bin.AsmWriteCode(CpuMetaInst::MV,_Md->AsmVar(IxVarIndex),_Md->Bin.AsmLitWrd(-1))){ return false; }
+    }
+    if(!_Md->Bin.AsmWriteCode(CpuInstCode::REFER,_Md->AsmVar(OnVarIndex),ArrToken.Asm())){ return false; }
+    _Md->Bin.StoreJumpDestination(Stn.GetLabel(CodeLabelId::LoopBeg),_Md->CurrentScope().Depth,_Md->Bin.CurrentCodeAddress());
+    if(!_Md->Bin.AsmWriteCode(CpuInstCode::GNEND,_Md->AsmVar(GenHndIndex),_Md->AsmJmp(Stn.GetLabel(CodeLabelId::Exit)))){ return false; }
+    if(IxVarIndex!=-1){
+      if(!_Md->Bin.AsmWriteCode(CpuMetaInst::INC,_Md->AsmVar(IxVarIndex))){ return false; }
+    }
+  }
+
   //Send initialization instructions for fixed arrays
-  if(ArrToken.MstType()==MasterType::FixArray){
-    if(!_Md->Bin.AsmWriteCode(CpuInstCode::AF1RW,_Md->AsmAgx(ArrToken.TypIndex()),(IxVarIndex==-1?_Md->AsmNva():_Md->AsmVad(IxVarIndex)),_Md->AsmJmp(Stn.GetLabel(CodeLabelId::Exit)))){ return false; }
+  else if(ArrToken.MstType()==MasterType::FixArray){
+    if(!_Md->Bin.AsmWriteCode((Parallel?CpuInstCode::AF1PW:CpuInstCode::AF1RW),_Md->AsmAgx(ArrToken.TypIndex()),(IxVarIndex==-1?_Md->AsmNva():_Md->AsmVad(IxVarIndex)),_Md->AsmJmp(Stn.GetLabel(CodeLabelId::Exit)))){ return false; }
     _Md->Bin.StoreJumpDestination(Stn.GetLabel(CodeLabelId::LoopBeg),_Md->CurrentScope().Depth,_Md->Bin.CurrentCodeAddress());
     if(!_Md->Bin.AsmWriteCode(CpuInstCode::AF1FO,_Md->AsmVar(OnVarIndex),ArrToken.Asm(),_Md->AsmAgx(ArrToken.TypIndex()))){ return false; }
   }
 
   //Send initialization instructions for dynamic arrays
   else if(ArrToken.MstType()==MasterType::DynArray){
-    if(!_Md->Bin.AsmWriteCode(CpuInstCode::AD1RW,ArrToken.Asm(),(IxVarIndex==-1?_Md->AsmNva():_Md->AsmVad(IxVarIndex)),_Md->AsmJmp(Stn.GetLabel(CodeLabelId::Exit)))){ return false; }
+    if(!_Md->Bin.AsmWriteCode((Parallel?CpuInstCode::AD1PW:CpuInstCode::AD1RW),ArrToken.Asm(),(IxVarIndex==-1?_Md->AsmNva():_Md->AsmVad(IxVarIndex)),_Md->AsmJmp(Stn.GetLabel(CodeLabelId::Exit)))){ return false; }
     _Md->Bin.StoreJumpDestination(Stn.GetLabel(CodeLabelId::LoopBeg),_Md->CurrentScope().Depth,_Md->Bin.CurrentCodeAddress());
     if(!_Md->Bin.AsmWriteCode(CpuInstCode::AD1FO,_Md->AsmVar(OnVarIndex),ArrToken.Asm())){ return false; }
   }
 
+  //Loop body of parallel walk is checked by binary until end of loop
+  if(Parallel){
+    _Md->Bin.ParallelRegionBegin(_Md->Variables[OnVarIndex].Address,Stn.GetLabel(CodeLabelId::Exit));
+  }
+
   //Add if expression
   if(HasIfExpr){
 
@@ -4471,9 +4627,10 @@ bool Compiler::_CompileWalk(Sentence& Stn,Stack<ExprToken>& WalkArray){
 
 //Compile EndWalk
 //:endwalk
-bool Compiler::_CompileEndWalk(Sentence& Stn,Stack<ExprToken>& WalkArray){
+bool Compiler::_CompileEndWalk(Sentence& Stn,Stack<ExprToken>& WalkArray,Stack<int>& WalkGen){
 
   //Variables
+  int GenHndIndex;
   Expression Expr;
   ExprToken ArrToken;
 
@@ -4488,12 +4645,22 @@ bool Compiler::_CompileEndWalk(Sentence& Stn,Stack<ExprToken>& WalkArray){
     return false;
   }
   ArrToken=WalkArray.Pop();
+  GenHndIndex=WalkGen.Pop();
 
   //Record jump destination for loop end
   _Md->Bin.StoreJumpDestination(Stn.GetLabel(CodeLabelId::LoopEnd),_Md->CurrentScope().Depth,_Md->Bin.CurrentCodeAddress());
 
+  //Close parallel walk region (nested walks are not allowed inside parallel walk, so open region belongs to this loop)
+  if(_Md->Bin.ParallelRegionOpen()){
+    _Md->Bin.ParallelRegionEnd();
+  }
+
   //Emit loop end instruction
-  if(_Md->Types[ArrToken.TypIndex()].MstType==MasterType::FixArray){
+  if(GenHndIndex!=-1){
+    if(!_Md->Bin.AsmWriteCode(CpuInstCode::GNRES,_Md->AsmVar(GenHndIndex))){ return false; }
+    if(!_Md->Bin.AsmWriteCode(CpuInstCode::JMP,_Md->AsmJmp(Stn.GetLabel(CodeLabelId::LoopBeg)))){ return false; }
+  }
+  else if(_Md->Types[ArrToken.TypIndex()].MstType==MasterType::FixArray){
     if(!_Md->Bin.AsmWriteCode(CpuInstCode::AF1NX,_Md->AsmAgx(ArrToken.TypIndex()),_Md->AsmJmp(Stn.GetLabel(CodeLabelId::LoopBeg)))){ return false; }
   }
   else if(_Md->Types[ArrToken.TypIndex()].MstType==MasterType::DynArray){
@@ -4503,6 +4670,12 @@ bool Compiler::_CompileEndWalk(Sentence& Stn,Stack<ExprToken>& WalkArray){
   //Record jump destination for loop exit
   _Md->Bin.StoreJumpDestination(Stn.GetLabel(CodeLabelId::Exit),_Md->CurrentScope().Depth,_Md->Bin.CurrentCodeAddress());
 
+  //Free generator (break also lands here) and release its temp variables
+  if(GenHndIndex!=-1){
+    if(!_Md->Bin.AsmWriteCode(CpuInstCode::GNFRE,_Md->AsmVar(GenHndIndex))){ return false; }
+    _Md->TempVarUnlock(GenHndIndex);
+  }
+
   //Release array token
   ArrToken.Release();
 
@@ -4807,6 +4980,7 @@ void Compiler::_EmitSourceLine(const Sentence& Stn,const String& SourceLine){
 
     //Control flow & expressions
     case SentenceId::Return    : 
+    case SentenceId::Yield     : 
     case SentenceId::If        : 
     case SentenceId::ElseIf    : 
     case SentenceId::Else      : 
@@ -4904,7 +5078,7 @@ bool Compiler::CreateAppPackage(const String& BinaryFile,const String& Container
 
 //Main program
 bool CallCompiler(const String& SourceFile,const String& OutputFile,bool CompileToApp,const String& ContainerFile,
-                  bool EnableAsmFile,bool StripSymbols,bool CompilerStats,bool LinterMode,int MaxErrorNr,int MaxWarningNr,bool PassOnWarnings,
+                  bool EnableAsmFile,bool StripSymbols,bool CompilerStats,bool LinterMode,int MaxErrorNr,int MaxWarningNr,bool PassOnWarnings,bool AotCompile,
                   const String& IncludePath,const String& LibraryPath,const String& DynLibPath,bool& CompileToLibrary){
 
   //Variables
@@ -4923,6 +5097,7 @@ bool CallCompiler(const String& SourceFile,const String& OutputFile,bool Compile
     Config.CompilerStats=CompilerStats;
     Config.LinterMode=LinterMode;
     Config.CompileToApp=CompileToApp;
+    Config.AotCompile=AotCompile;
     Comp.SetConfig(Config);
   
     //Open debug log
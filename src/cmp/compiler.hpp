@@ -24,6 +24,7 @@ class CompilerConfig{
     bool CompilerStats;  //Output compiler statistics
     bool LinterMode;     //Linter mode
     bool CompileToApp;   //Compile to application package
+    bool AotCompile;     //Translate executable to native library
     
     //Constructors/Destructors and assignment
     CompilerConfig(){}
@@ -88,7 +89,8 @@ class Compiler{
     bool _CompileEndOperator(Sentence& Stn,SentenceId LastStnId);
     bool _CompileMain(Sentence& Stn,const String& ProgName,bool CompileToLibrary);
     bool _CompileEndMain(Sentence& Stn,const String& ProgName,SentenceId LastStnId);
-    bool _CompileReturn(Sentence& Stn,const String& ProgName);
+    bool _CompileReturn(Sentence& Stn,const String& ProgName,Stack<int>& WalkGen);
+    bool _CompileYield(Sentence& Stn);
     bool _CompileIf(Sentence& Stn);
     bool _CompileElseIf(Sentence& Stn);
     bool _CompileElse(Sentence& Stn);
@@ -99,8 +101,8 @@ class Compiler{
     bool _CompileLoop(Sentence& Stn);
     bool _CompileFor(Sentence& Stn,Stack<Sentence>& ForStep);
     bool _CompileEndFor(Sentence& Stn,Stack<Sentence>& ForStep);
-    bool _CompileWalk(Sentence& Stn,Stack<ExprToken>& WalkArray);
-    bool _CompileEndWalk(Sentence& Stn,Stack<ExprToken>& WalkArray);
+    bool _CompileWalk(Sentence& Stn,Stack<ExprToken>& WalkArray,Stack<int>& WalkGen);
+    bool _CompileEndWalk(Sentence& Stn,Stack<ExprToken>& WalkArray,Stack<int>& WalkGen);
     bool _CompileSwitch(Sentence& Stn,Stack<Sentence>& SwitchExpr);
     bool _CompileWhen(Sentence& Stn,Stack<Sentence>& SwitchExpr,bool FirstCase);
     bool _CompileDefault(Sentence& Stn,Stack<Sentence>& SwitchExpr);
@@ -125,7 +127,7 @@ class Compiler{
 
 //Compiler entry points
 bool CallCompiler(const String& SourceFile,const String& OutputFile,bool CompileToApp,const String& ContainerFile,bool EnableAsmFile,bool StripSymbols,
-                  bool CompilerStats,bool LinterMode,int MaxErrorNr,int MaxWarningNr,bool PassOnWarnings,const String& IncludePath,const String& LibraryPath,
+                  bool CompilerStats,bool LinterMode,int MaxErrorNr,int MaxWarningNr,bool PassOnWarnings,bool AotCompile,const String& IncludePath,const String& LibraryPath,
                   const String& DynLibPath,bool& CompileToLibrary);
 bool CallLibraryInfo(const String& LibraryFile);
 bool CallExecutableInfo(const String& ExecutableFile);
@@ -517,6 +517,7 @@ void ExprToken::_Reset(bool ObjectExists){
   SourceVarIndex=-1;
   IsConst=false;
   IsCalculated=false;
+  IsStrChar=false;
   HasInitialization=false;
   Meta.Case=(MetaConstCase)0;
   Meta.TypIndex=-1;
@@ -541,6 +542,7 @@ void ExprToken::_Move(const ExprToken& Token){
   SourceVarIndex=Token.SourceVarIndex;
   IsConst=Token.IsConst;
   IsCalculated=Token.IsCalculated;
+  IsStrChar=Token.IsStrChar;
   HasInitialization=Token.HasInitialization;
   Meta.Case=Token.Meta.Case;
   Meta.TypIndex=Token.Meta.TypIndex;
@@ -919,6 +921,12 @@ bool ExprToken::NewVar(MasterData *Md,const ScopeDef& Scope,CpuLon CodeBlockId,i
   return true;
 }
 
+//New variable operand of given temp variable kind
+bool ExprToken::NewVar(MasterData *Md,const ScopeDef& Scope,CpuLon CodeBlockId,int TypIndex,const SourceInfo& SrcInfo,TempVarKind TempKind){
+  if(!_New(Md,Scope,CodeBlockId,TypIndex,CpuAdrMode::Address,false,false,SrcInfo,TempKind)){ return false; }
+  return true;
+}
+
 //New reference operand
 bool ExprToken::NewInd(MasterData *Md,const ScopeDef& Scope,CpuLon CodeBlockId,int TypIndex,bool IsConstant,const SourceInfo& SrcInfo,TempVarKind TempKind){
   if(!_New(Md,Scope,CodeBlockId,TypIndex,CpuAdrMode::Indirection,true,IsConstant,SrcInfo,TempKind)){ return false; }
@@ -5202,6 +5210,7 @@ bool Expression::_SubscriptCall(const ScopeDef& Scope,CpuLon CodeBlockId,int Cur
   
     //Emit instructions
     if(!_Md->Bin.AsmWriteCode(CpuInstCode::SINDX,Result.Asm(true),ObjToken.Asm(),IdxTokens[0].Asm())){ return false; }
+    Result.IsStrChar=true;
   
   }
 
@@ -5363,6 +5372,9 @@ bool Expression::_OperatorCall(const ScopeDef& Scope,CpuLon CodeBlockId,int FunI
       //Parameter passing for local functions
       if(_Md->Functions[FunIndex].Scope.Kind==ScopeKind::Local){
         if(_Md->Parameters[i].IsReference){
+          if(ParmTokens[j].IsStrChar && !_Md->Parameters[i].IsConst){
+            if(!_Md->Bin.AsmWriteCode(CpuInstCode::SUNSH,ParmTokens[j].Asm(true))){ return false; }
+          }
           if(ParmTokens[j].AdrMode!=CpuAdrMode::LitValue && _Md->Variables[ParmTokens[j].Value.VarIndex].IsReference){          
             if(!_Md->Bin.AsmWriteCode(CpuInstCode::MVr,_Md->AsmPar(i),ParmTokens[j].Asm(true))){ return false; }
           }
@@ -5400,6 +5412,9 @@ bool Expression::_OperatorCall(const ScopeDef& Scope,CpuLon CodeBlockId,int FunI
       //Parameter passing for public/private functions
       else{
         if(_Md->Parameters[i].IsReference){
+          if(ParmTokens[j].IsStrChar && !_Md->Parameters[i].IsConst){
+            if(!_Md->Bin.AsmWriteCode(CpuInstCode::SUNSH,ParmTokens[j].Asm(true))){ return false; }
+          }
           if(ParmTokens[j].AdrMode!=CpuAdrMode::LitValue && _Md->Variables[ParmTokens[j].Value.VarIndex].IsReference){          
             if(!_Md->Bin.AsmWriteCode(CpuInstCode::PUSHr,ParmTokens[j].Asm(true))){ return false; }
           }
@@ -5465,6 +5480,7 @@ bool Expression::_FunctionMethodCall(const ScopeDef& Scope,CpuLon CodeBlockId,in
   ExprToken FunToken;
   ExprToken ParmToken;
   ExprToken OpdToken;
+  ExprToken GenToken;
   Array<ExprToken> ParmTokens;
   int DlCallId;
 
@@ -5646,6 +5662,13 @@ bool Expression::_FunctionMethodCall(const ScopeDef& Scope,CpuLon CodeBlockId,in
         if(!Result.NewVar(_Md,Scope,CodeBlockId,OpdToken.TypIndex(),FunToken.SrcInfo())){ return false; }
       }
     }
+    else if(_Md->Functions[FunIndex].IsGenerator){
+      if(!_Md->GenCallAllowed){
+        FunToken.Msg(608).Print(_Md->Functions[FunIndex].Name);
+        return false;
+      }
+      if(!Result.NewVar(_Md,Scope,CodeBlockId,_Md->Functions[FunIndex].TypIndex,FunToken.SrcInfo(),TempVarKind::Generator)){ return false; }
+    }
     else{
       if(!Result.NewVar(_Md,Scope,CodeBlockId,_Md->Functions[FunIndex].TypIndex,FunToken.SrcInfo())){ return false; }
     }
@@ -5839,6 +5862,9 @@ bool Expression::_FunctionMethodCall(const ScopeDef& Scope,CpuLon CodeBlockId,in
         //Parameters for dynamic library functions
         if(_Md->Functions[FunIndex].Kind==FunctionKind::DlFunc){
           if(_Md->Parameters[i].IsReference){
+            if(ParmTokens[j].IsStrChar && !_Md->Parameters[i].IsConst){
+              if(!_Md->Bin.AsmWriteCode(CpuInstCode::SUNSH,ParmTokens[j].Asm(true))){ return false; }
+            }
             if(ParmTokens[j].AdrMode!=CpuAdrMode::LitValue && _Md->Variables[ParmTokens[j].Value.VarIndex].IsReference){          
               if(_Md->Types[_Md->Parameters[i].TypIndex].MstType==MasterType::String){
                 if(!_Md->Bin.AsmWriteCode(CpuInstCode::LPUSr,ParmTokens[j].Asm(true),_Md->Bin.AsmLitBol((CpuBol)_Md->Parameters[i].IsConst))){ return false; }
@@ -5898,6 +5924,9 @@ bool Expression::_FunctionMethodCall(const ScopeDef& Scope,CpuLon CodeBlockId,in
         //Parameters for local functions
         else if(_Md->Functions[FunIndex].Scope.Kind==ScopeKind::Local){
           if(_Md->Parameters[i].IsReference){
+            if(ParmTokens[j].IsStrChar && !_Md->Parameters[i].IsConst){
+              if(!_Md->Bin.AsmWriteCode(CpuInstCode::SUNSH,ParmTokens[j].Asm(true))){ return false; }
+            }
             if(ParmTokens[j].AdrMode!=CpuAdrMode::LitValue && _Md->Variables[ParmTokens[j].Value.VarIndex].IsReference){          
               if(!_Md->Bin.AsmWriteCode(CpuInstCode::MVr,_Md->AsmPar(i),ParmTokens[j].Asm(true))){ return false; }
             }
@@ -5935,6 +5964,9 @@ bool Expression::_FunctionMethodCall(const ScopeDef& Scope,CpuLon CodeBlockId,in
         //Parameters for other functions
         else{
           if(_Md->Parameters[i].IsReference){
+            if(ParmTokens[j].IsStrChar && !_Md->Parameters[i].IsConst){
+              if(!_Md->Bin.AsmWriteCode(CpuInstCode::SUNSH,ParmTokens[j].Asm(true))){ return false; }
+            }
             if(ParmTokens[j].AdrMode!=CpuAdrMode::LitValue && _Md->Variables[ParmTokens[j].Value.VarIndex].IsReference){          
               if(!_Md->Bin.AsmWriteCode(CpuInstCode::PUSHr,ParmTokens[j].Asm(true))){ return false; }
             }
@@ -5980,6 +6012,13 @@ bool Expression::_FunctionMethodCall(const ScopeDef& Scope,CpuLon CodeBlockId,in
     
     //Regular function
     case FunctionKind::Function:
+      if(_Md->Functions[FunIndex].IsGenerator){
+        if(!GenToken.NewVar(_Md,Scope,CodeBlockId,_Md->WrdTypIndex,FunToken.SrcInfo(),TempVarKind::Generator)){ return false; }
+        if(!_Md->Bin.AsmWriteCode(CpuInstCode::GNNEW,GenToken.Asm())){ return false; }
+        _Md->GenHandleVar=GenToken.VarIndex();
+        _Md->GenResultVar=Result.VarIndex();
+        _Md->GenCallAllowed=false;
+      }
       if(_Md->Functions[FunIndex].IsNested){
         if(!_Md->Bin.AsmWriteCode(CpuInstCode::CALLN,_Md->AsmFun(FunIndex))){ return false; }
       }
@@ -6177,6 +6216,9 @@ bool Expression::_MasterMethodExecute(const ScopeDef& Scope,CpuLon CodeBlockId,i
     case MasterMethod::ArdReset:      
       if(!_Md->Bin.AsmWriteCode(CpuInstCode::ADRST,SelfToken.Asm())){ return false; } 
       break; 
+    case MasterMethod::ArdShrink:      
+      if(!_Md->Bin.AsmWriteCode(CpuInstCode::ADSHR,SelfToken.Asm())){ return false; } 
+      break; 
     
     //1-dim dyn array methods
     case MasterMethod::ArdLen:      
@@ -6215,6 +6257,12 @@ bool Expression::_MasterMethodExecute(const ScopeDef& Scope,CpuLon CodeBlockId,i
       }
       else{ FunToken.Msg(530).Print(); return false; }
       break;
+    case MasterMethod::ArdReserve:      
+      if(_Md->Types[SelfToken.TypIndex()].DimNr!=1){ FunToken.Msg(620).Print(); return false; }
+      CellSizeArg=_Md->Bin.AsmLitWrd(_Md->Types[_Md->Types[SelfToken.TypIndex()].ElemTypIndex].Length);
+      if(!_Md->Bin.AsmWriteCode(CpuInstCode::AD1DF,SelfToken.Asm())){ return false; }
+      if(!_Md->Bin.AsmWriteCode(CpuInstCode::AD1RV,SelfToken.Asm(),ParmTokens[0].Asm(),CellSizeArg)){ return false; }
+      break;
 
     //Char methods
     case MasterMethod::ChrUpper:      if(!_Md->Bin.AsmWriteCode(CpuInstCode::CUPPR,Result.Asm(),SelfToken.Asm())){ return false; } break; 
@@ -6248,6 +6296,8 @@ bool Expression::_MasterMethodExecute(const ScopeDef& Scope,CpuLon CodeBlockId,i
     case MasterMethod::StrIsint:      if(!_Md->Bin.AsmWriteCode(CpuInstCode::SISIN,Result.Asm(),SelfToken.Asm())){ return false; } break; 
     case MasterMethod::StrIslong:     if(!_Md->Bin.AsmWriteCode(CpuInstCode::SISLO,Result.Asm(),SelfToken.Asm())){ return false; } break; 
     case MasterMethod::StrIsfloat:    if(!_Md->Bin.AsmWriteCode(CpuInstCode::SISFL,Result.Asm(),SelfToken.Asm())){ return false; } break; 
+    case MasterMethod::StrReserve:    if(!_Md->Bin.AsmWriteCode(CpuInstCode::SRESV,SelfToken.Asm(),ParmTokens[0].Asm())){ return false; } break; 
+    case MasterMethod::StrShrink:     if(!_Md->Bin.AsmWriteCode(CpuInstCode::SSHRK,SelfToken.Asm())){ return false; } break; 
     
     //Data conversion methods
     case MasterMethod::BolToshort:    if(!_Md->Bin.AsmWriteCode(CpuInstCode::BO2SH,Result.Asm(),SelfToken.Asm())){ return false; } break; 
@@ -6456,6 +6506,9 @@ bool Expression::_MasterMethodExecute(const ScopeDef& Scope,CpuLon CodeBlockId,i
         return false;
       }
       else{
+        if(SelfToken.IsStrChar){
+          if(!_Md->Bin.AsmWriteCode(CpuInstCode::SUNSH,SelfToken.Asm(true))){ return false; }
+        }
         if(!_Md->Bin.AsmWriteCode(CpuInstCode::FRCA,Result.Asm(),ParmTokens[0].Asm(),_Md->Bin.AsmLitWrd(_Md->Types[_Md->Functions[FunIndex].TypIndex].Length))){ return false; }
         if(!CopyOperand(_Md,SelfToken,Result)){return false; }
       }
@@ -7544,6 +7597,9 @@ bool Expression::_Compile(const ScopeDef& Scope,CpuLon CodeBlockId,bool ResultIs
                 Result=OpndAux;
                 OpndStack.Pop();
                 SkipNext=true;
+                if(Result.IsStrChar){
+                  if(!_Md->Bin.AsmWriteCode(CpuInstCode::SUNSH,Result.Asm(true))){ Error=true; break; }
+                }
                 if(OpndAux.AdrMode==CpuAdrMode::Address){ 
                   _Md->Variables[OpndAux.Value.VarIndex].IsInitialized=true; 
                   DebugMessage(DebugLevel::CmpExpression,"Initialized flag set for variable "+_Md->Variables[OpndAux.Value.VarIndex].Name+" in scope "+_Md->ScopeName(_Md->Variables[OpndAux.Value.VarIndex].Scope));
@@ -7557,6 +7613,11 @@ bool Expression::_Compile(const ScopeDef& Scope,CpuLon CodeBlockId,bool ResultIs
               
             }
 
+            //String data written through char reference is detached first (reading through it never copies string data)
+            if(_Opr[(int)_Tokens[i].Value.Operator].LValueMandatory[0] && Opnd1.IsStrChar){
+              if(!_Md->Bin.AsmWriteCode(CpuInstCode::SUNSH,Opnd1.Asm(true))){ Error=true; break; }
+            }
+
             //Complete operation
             switch(_Tokens[i].Value.Operator){
               
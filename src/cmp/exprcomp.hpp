@@ -220,6 +220,7 @@ class ExprToken{
     ExprTokenValue Value;   //Expression token value
     bool IsConst;           //Is token constant ?
     bool IsCalculated;      //Is token calculated (for expression evaluation)
+    bool IsStrChar;         //Token is a reference to a char inside string data (string subscript)
     bool HasInitialization; //Token is a variable declaration that has initialization
     int LitNumTypIndex;     //Type index for litteral value token
     int CastTypIndex;       //Type cast operator casting type
@@ -255,6 +256,7 @@ class ExprToken{
     bool NewVar(MasterData *Md,const ScopeDef& Scope,CpuLon CodeBlockId,MasterType MstType,const SourceInfo& SrcInfo,TempVarKind TempKind);
     bool NewVar(MasterData *Md,const ScopeDef& Scope,CpuLon CodeBlockId,int TypIndex,const SourceInfo& SrcInfo);
     bool NewVar(MasterData *Md,const ScopeDef& Scope,CpuLon CodeBlockId,int TypIndex,const SourceInfo& SrcInfo,bool& Reused);
+    bool NewVar(MasterData *Md,const ScopeDef& Scope,CpuLon CodeBlockId,int TypIndex,const SourceInfo& SrcInfo,TempVarKind TempKind);
     bool NewInd(MasterData *Md,const ScopeDef& Scope,CpuLon CodeBlockId,int TypIndex,bool IsConstant,const SourceInfo& SrcInfo,TempVarKind TempKind=TempVarKind::Regular);
     bool NewPtr(MasterData *Md,const ScopeDef& Scope,CpuLon CodeBlockId,int TypIndex,bool IsConstant,const SourceInfo& SrcInfo);
     bool ToBol();
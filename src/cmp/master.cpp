@@ -37,6 +37,7 @@ const String _DestroyedVariablePrefix=SYSTEM_NAMESPACE "destroyed";
 const String _TempVarSuffixRegl="t";
 const String _TempVarSuffixProm="c";
 const String _TempVarSuffixMast="m";
+const String _TempVarSuffixGene="g";
 const String _LitVarPreffix="lit";
 
 //Scope equality operator
@@ -123,6 +124,9 @@ void MasterData::ScopeStkDfn::_Move(const ScopeStkDfn& ScopeStk){
 MasterData::MasterData(void){
   _LitStrGenerator=0;
   _LitStaGenerator=0;
+  GenCallAllowed=false;
+  GenHandleVar=-1;
+  GenResultVar=-1;
 }
 
 //Destructor
@@ -240,6 +244,11 @@ void MasterData::SetMainDefinitions(){
   StoreFunctionSearchIndex(Functions.Length()-1);
   StoreFunctionId(Functions.Length()-1);
 
+  //Dynamic array master type method: void .shrink()
+  StoreMasterMethod("shrink",-1,true,false,false,MasterType::DynArray,MasterMethod::ArdShrink);
+  StoreFunctionSearchIndex(Functions.Length()-1);
+  StoreFunctionId(Functions.Length()-1);
+
   //Dynamic 1-dim array master type method: word .len()
   StoreMasterMethod("len",WrdTypIndex,false,false,false,MasterType::DynArray,MasterMethod::ArdLen);
   StoreParameter(Functions.Length()-1,GetFuncResultName(),WrdTypIndex,false,true,0,true,SourceInfo(),"");
@@ -272,6 +281,12 @@ void MasterData::SetMainDefinitions(){
   StoreFunctionSearchIndex(Functions.Length()-1);
   StoreFunctionId(Functions.Length()-1);
 
+  //Dynamic 1-dim array master type method: void .reserve(word elements)
+  StoreMasterMethod("reserve",-1,true,false,false,MasterType::DynArray,MasterMethod::ArdReserve);
+  StoreParameter(Functions.Length()-1,"elements",WrdTypIndex,false,false,0,true,SourceInfo(),"");
+  StoreFunctionSearchIndex(Functions.Length()-1);
+  StoreFunctionId(Functions.Length()-1);
+
   //String Master type method: char .upper()
   StoreMasterMethod("upper",ChrTypIndex,false,false,false,MasterType::Char,MasterMethod::ChrUpper);
   StoreParameter(Functions.Length()-1,GetFuncResultName(),ChrTypIndex,false,true,0,true,SourceInfo(),"");
@@ -468,6 +483,17 @@ void MasterData::SetMainDefinitions(){
   StoreFunctionSearchIndex(Functions.Length()-1);
   StoreFunctionId(Functions.Length()-1);
 
+  //String Master type method: void .reserve(word length)
+  StoreMasterMethod("reserve",-1,true,false,false,MasterType::String,MasterMethod::StrReserve);
+  StoreParameter(Functions.Length()-1,"length",WrdTypIndex,false,false,0,true,SourceInfo(),"");
+  StoreFunctionSearchIndex(Functions.Length()-1);
+  StoreFunctionId(Functions.Length()-1);
+
+  //String Master type method: void .shrink()
+  StoreMasterMethod("shrink",-1,true,false,false,MasterType::String,MasterMethod::StrShrink);
+  StoreFunctionSearchIndex(Functions.Length()-1);
+  StoreFunctionId(Functions.Length()-1);
+
   //Data conversion from boolean to char
   StoreMasterMethod("tochr"  ,ChrTypIndex,false,false,false,MasterType::Boolean,MasterMethod::BolTochar);
   StoreParameter(Functions.Length()-1,GetFuncResultName(),ChrTypIndex,false,true,0,true,SourceInfo(),"");
@@ -3633,6 +3659,7 @@ void MasterData::_InnerStoreFunction(const ScopeDef& Scope,const SubScopeDef& Su
   Function.IsDefined=false;
   Function.IsInitializer=IsInitializer;
   Function.IsMetaMethod=IsMetaMethod;
+  Function.IsGenerator=false;
   Function.ParmNr=0;
   Function.ParmLow=-1;
   Function.ParmHigh=-1;
@@ -4696,6 +4723,7 @@ bool MasterData::TempVarNew(const ScopeDef& Scope,CpuLon CodeBlockId,int TypInde
     case TempVarKind::Regular  : Suffix=_TempVarSuffixRegl; KindName="regular";   break;
     case TempVarKind::Promotion: Suffix=_TempVarSuffixProm; KindName="promotion"; break;
     case TempVarKind::Master   : Suffix=_TempVarSuffixMast; KindName="master";    break;
+    case TempVarKind::Generator: Suffix=_TempVarSuffixGene; KindName="generator"; break;
   }
 
   //Initialize counters on scope change
@@ -4781,10 +4809,11 @@ void MasterData::TempVarUnlock(int VarIndex){
  }
 
 //Unlock temporary variable
+//(generator temp variables are released by walk loop when it ends)
 void MasterData::TempVarUnlockAll(){
   DebugMessage(DebugLevel::CmpExpression,"Release all temp variables");
   for(int i=0;i<Variables.Length();i++){
-    if(Variables[i].IsTempVar){
+    if(Variables[i].IsTempVar && !Variables[i].Name.EndsWith(_TempVarSuffixGene)){
       Variables[i].IsTempLocked=false;
       DebugMessage(DebugLevel::CmpExpression,"Temp variable "+Variables[i].Name+" released");
     }
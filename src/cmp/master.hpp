@@ -37,7 +37,8 @@ enum class GrantKind:int{
 enum class TempVarKind:int{
   Regular,   //Regular temporary variable
   Promotion, //Temporary variables for promotions
-  Master     //Temporary variables for master method execution
+  Master,    //Temporary variables for master method execution
+  Generator  //Temporary variables for generator calls (kept locked until walk loop ends)
 };
 
 //Meta const case
@@ -81,14 +82,14 @@ enum class MasterMethod{
   //Fixed 1-dim arrays
   ArfLen,ArfJoin,
   //Dynamic arrays
-  ArdRsize1,ArdRsize2,ArdRsize3,ArdRsize4,ArdRsize5,ArdDsize,ArdReset,
+  ArdRsize1,ArdRsize2,ArdRsize3,ArdRsize4,ArdRsize5,ArdDsize,ArdReset,ArdShrink,
   //Dynamic 1-dim arrays
-  ArdLen,ArdAdd,ArdIns,ArdDel,ArdJoin,
+  ArdLen,ArdAdd,ArdIns,ArdDel,ArdJoin,ArdReserve,
   //Chars
   ChrUpper,ChrLower,
   //Strings
   StrLen,StrSub,StrRight,StrLeft,StrCutRight,StrCutLeft,StrSearch,StrReplace,StrTrim,StrUpper,StrLower,StrLJust1,StrRJust1,StrLJust2,
-  StrRJust2,StrMatch,StrLike,StrReplicate,StrSplit,StrStartswith,StrEndswith,StrIsbool,StrIschar,StrIsshort,StrIsint,StrIslong,StrIsfloat,
+  StrRJust2,StrMatch,StrLike,StrReplicate,StrSplit,StrStartswith,StrEndswith,StrIsbool,StrIschar,StrIsshort,StrIsint,StrIslong,StrIsfloat,StrReserve,StrShrink,
   //Data conversions
   BolTochar,BolToshort,BolToint,BolTolong,BolTofloat,BolTostring,
   ChrTobool,ChrToshort,ChrToint,ChrTolong,ChrTofloat,ChrTostring,ChrFormat,
@@ -293,6 +294,7 @@ class MasterData{
       bool IsDefined;         //Is function defined already?
       bool IsInitializer;     //Is initializer function? (sets class initial value) 
       bool IsMetaMethod;      //Is a master method that returns metadata? (.name() .dtype() ...) 
+      bool IsGenerator;       //Is generator function? (returns values with yield)
       int ParmNr;             //Number of function parameters
       int ParmLow;            //Parameter low in parameter table
       int ParmHigh;           //Parameter high in parameter table
@@ -343,6 +345,11 @@ class MasterData{
     bool DebugSymbols;     //Generate debug symbols on binary file
     String DynLibPath;     //Path for dynamiclibraries
 
+    //Generator calls (only allowed in walk expression, handler is temp variable created by expression compiler)
+    bool GenCallAllowed;   //Generator function call is allowed in current expression
+    int GenHandleVar;      //Generator handler variable of last generator call
+    int GenResultVar;      //Result variable of last generator call
+
     //Compiler tables
     Array<ModuleTable> Modules;       //Module table
     Array<TrackerTable> Trackers;     //Module tracker table
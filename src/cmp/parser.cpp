@@ -42,7 +42,7 @@ const char *_ValidIdChars="abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0
 enum class CodeBlockAction { Push, Pop, Keep, Replace };
 
 //PrKeyword table
-const int _KwdNr=62;
+const int _KwdNr=64;
 const String _Kwd[_KwdNr]={
   ".libs"          , //PrKeyword::Libs
   ".public"        , //PrKeyword::Public
@@ -78,6 +78,7 @@ const String _Kwd[_KwdNr]={
   "let"            , //PrKeyword::Let
   "init"           , //PrKeyword::Init
   "return"         , //PrKeyword::Return
+  "yield"          , //PrKeyword::Yield
   "ref"            , //PrKeyword::Ref
   "if"             , //PrKeyword::If
   "elif"           , //PrKeyword::ElseIf
@@ -89,6 +90,7 @@ const String _Kwd[_KwdNr]={
   ":loop"          , //PrKeyword::Loop
   "for"            , //PrKeyword::For
   ":for"           , //PrKeyword::EndFor
+  "parallel"       , //PrKeyword::Parallel
   "walk"           , //PrKeyword::Walk
   ":walk"          , //PrKeyword::EndWalk
   "on"             , //PrKeyword::On
@@ -195,7 +197,7 @@ struct SentenceDef{
 const int _LocalScope=
 (int)CodeBlock::Local|(int)CodeBlock::FirstWhen|(int)CodeBlock::NextWhen|(int)CodeBlock::Default|(int)CodeBlock::DoLoop|
 (int)CodeBlock::While|(int)CodeBlock::If|(int)CodeBlock::ElseIf|(int)CodeBlock::Else|(int)CodeBlock::For|(int)CodeBlock::Walk;
-const int _StnNr=54;
+const int _StnNr=55;
 const SentenceDef _Stn[_StnNr]={
 // Type                     Action                    NewBlock              Jmp                  PshDel PopDel AllowedBlocks
   {SentenceId::Libs       , CodeBlockAction::Replace, CodeBlock::Libs,      JumpMode::None,      false, false, (int)CodeBlock::Init },
@@ -232,6 +234,7 @@ const SentenceDef _Stn[_StnNr]={
   {SentenceId::Member     , CodeBlockAction::Push,    CodeBlock::Local,     JumpMode::BlockBeg,  false, false, (int)CodeBlock::Implem|(int)CodeBlock::Local },
   {SentenceId::EndMember  , CodeBlockAction::Pop,     (CodeBlock)0,         JumpMode::BlockEnd,  false, false, (int)CodeBlock::Local  },
   {SentenceId::Return     , CodeBlockAction::Keep,    (CodeBlock)0,         JumpMode::None,      false, false, _LocalScope },
+  {SentenceId::Yield      , CodeBlockAction::Keep,    (CodeBlock)0,         JumpMode::None,      false, false, _LocalScope },
   {SentenceId::If         , CodeBlockAction::Push,    CodeBlock::If,        JumpMode::FirstCase, false, false, _LocalScope },
   {SentenceId::ElseIf     , CodeBlockAction::Replace, CodeBlock::ElseIf,    JumpMode::NextCase,  false, false, (int)CodeBlock::If|(int)CodeBlock::ElseIf },
   {SentenceId::Else       , CodeBlockAction::Replace, CodeBlock::Else,      JumpMode::LastCase,  false, false, (int)CodeBlock::If|(int)CodeBlock::ElseIf },
@@ -1580,6 +1583,15 @@ bool Sentence::_GetSentenceId(CodeBlock Block,SentenceId& StnId){
       case PrKeyword::Operator:    StnId=SentenceId::Operator;    break;
       case PrKeyword::EndOperator: StnId=SentenceId::EndOperator; break;
       case PrKeyword::Return:      StnId=SentenceId::Return;      break;
+      case PrKeyword::Yield:
+        if(Tokens.Length()>=3 && Tokens[1].Id()==PrTokenId::TypeName 
+        && (Tokens[2].Id()==PrTokenId::Identifier || (Tokens[2].Id()==PrTokenId::Punctuator && Tokens[2].Value.Pnc==PrPunctuator::BegBracket))){
+          StnId=SentenceId::FunDecl;
+        }
+        else{
+          StnId=SentenceId::Yield;
+        }
+        break;
       case PrKeyword::If:          StnId=SentenceId::If;          break;
       case PrKeyword::ElseIf:      StnId=SentenceId::ElseIf;      break;
       case PrKeyword::Else:        StnId=SentenceId::Else;        break;
@@ -1597,6 +1609,13 @@ bool Sentence::_GetSentenceId(CodeBlock Block,SentenceId& StnId){
       case PrKeyword::Break:       StnId=SentenceId::Break;       break;
       case PrKeyword::Continue:    StnId=SentenceId::Continue;    break;
       case PrKeyword::Walk:        StnId=SentenceId::Walk;        break;
+      case PrKeyword::Parallel:
+        if(Tokens.Length()<2 || Tokens[1].Id()!=PrTokenId::Keyword || Tokens[1].Value.Kwd!=PrKeyword::Walk){
+          Tokens[0].Msg(15).Print(_Kwd[(int)Tokens[0].Value.Kwd]);
+          return false;
+        }
+        StnId=SentenceId::Walk;
+        break;
       case PrKeyword::EndWalk:     StnId=SentenceId::EndWalk;     break;
       case PrKeyword::Void:        StnId=SentenceId::FunDecl;     break;
       case PrKeyword::XlvSet:      StnId=SentenceId::XlvSet;      break;
@@ -3126,6 +3145,7 @@ String SentenceIdText(SentenceId Id){
     case SentenceId::Operator   : Text="Operator";    break;
     case SentenceId::EndOperator: Text="EndOperator"; break;
     case SentenceId::Return     : Text="Return";      break;
+    case SentenceId::Yield      : Text="Yield";       break;
     case SentenceId::If         : Text="If";          break;
     case SentenceId::ElseIf     : Text="ElseIf";      break;
     case SentenceId::Else       : Text="Else";        break;
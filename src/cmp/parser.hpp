@@ -9,8 +9,8 @@ extern const String _KwdInitVar;
 //Labels for keywords, Operators, Punctuators, ParserSymbols, ParserTokens and Sentences
 enum class PrKeyword:int{
   Libs=0,Public,Private,Implem,Set,Import,Include,As,Version,Static,Var,Const,DefType,DefClass,Publ,Priv,EndClass,Allow,To,From,DefEnum,EndEnum,
-  Void,Main,EndMain,Function,EndFunction,Member,EndMember,Operator,EndOperator,Let,Init,Return,Ref,If,ElseIf,Else,EndIf,While,EndWhile,Do,Loop,For,EndFor,
-  Walk,EndWalk,On,Switch,When,Default,EndSwitch,Break,Continue,Array,Index,SystemCall,SystemFunc,DlFunction,DlType,XlvSet,InitVar
+  Void,Main,EndMain,Function,EndFunction,Member,EndMember,Operator,EndOperator,Let,Init,Return,Yield,Ref,If,ElseIf,Else,EndIf,While,EndWhile,Do,Loop,For,EndFor,
+  Parallel,Walk,EndWalk,On,Switch,When,Default,EndSwitch,Break,Continue,Array,Index,SystemCall,SystemFunc,DlFunction,DlType,XlvSet,InitVar
 };
 enum class PrOperator:int{
   PrefixIncrement=0,PrefixDecrement,Plus,Minus,ShlAssign,ShrAssign,PostfixIncrement,PostfixDecrement,ShiftLeft,ShiftRight,LessEqual,GreaterEqual,
@@ -25,7 +25,7 @@ enum class PrTokenId{
 };
 enum class SentenceId{
   Libs=0,Public,Private,Implem,Set,Import,Include,Const,VarDecl,DefType,DefClass,Publ,Priv,EndClass,Allow,DefEnum,EnumField,EndEnum,
-  FunDecl,Main,EndMain,Function,EndFunction,Member,EndMember,Operator,EndOperator,Return,If,ElseIf,Else,EndIf,While,EndWhile,Do,Loop,
+  FunDecl,Main,EndMain,Function,EndFunction,Member,EndMember,Operator,EndOperator,Return,Yield,If,ElseIf,Else,EndIf,While,EndWhile,Do,Loop,
   For,EndFor,Walk,EndWalk,Switch,When,Default,EndSwitch,Break,Continue,Expression,SystemCall,SystemFunc,DlFunction,DlType,XlvSet,InitVar,Empty
 };
 
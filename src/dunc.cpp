@@ -104,7 +104,7 @@ int main(int argc,char *argv[]){
         if(!ConfigParser::GetCmdLineOptions(ExecPath,argc,argv,OptionSet,false,CONFIG_FILE,CmdOpt,ArgStart)){ return 0; }
         if(ArgStart<argc-1){ SysMessage(373).Print(); return 0; }
         if(!ConfigParser::EnableDebugLevels(DUNC_APPID,CmdOpt.DebugLevelIds,CmdOpt.AllDebugLevels,CmdOpt.DebugToConsole)){ return 0; }
-        if(!CallCompiler(CmdOpt.SourceFile,CmdOpt.OutputFile,CmdOpt.CompileToApp,GetPkgContainer(ExecPath),CmdOpt.EnableAsmFile,CmdOpt.StripSymbols,CmdOpt.CompilerStats,CmdOpt.LinterMode,CmdOpt.MaxErrorNr,CmdOpt.MaxWarningNr,CmdOpt.PassOnWarnings,CmdOpt.IncludePath,CmdOpt.LibraryPath,CmdOpt.DynLibPath,CompileToLibrary)){ return 0; }
+        if(!CallCompiler(CmdOpt.SourceFile,CmdOpt.OutputFile,CmdOpt.CompileToApp,GetPkgContainer(ExecPath),CmdOpt.EnableAsmFile,CmdOpt.StripSymbols,CmdOpt.CompilerStats,CmdOpt.LinterMode,CmdOpt.MaxErrorNr,CmdOpt.MaxWarningNr,CmdOpt.PassOnWarnings,CmdOpt.Aot,CmdOpt.IncludePath,CmdOpt.LibraryPath,CmdOpt.DynLibPath,CompileToLibrary)){ return 0; }
         break;
 
       //Version info
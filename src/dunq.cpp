@@ -0,0 +1,128 @@
+//Dungeon spells runtime server client
+//(sends execution requests to a runtime started with dunr -serve <socket>)
+
+//Include files
+#include "bas/basedefs.hpp"
+#include "bas/allocator.hpp"
+#include "bas/array.hpp"
+#include "bas/stack.hpp"
+#include "bas/queue.hpp"
+#include "bas/buffer.hpp"
+#include "bas/string.hpp"
+#include "sys/sysdefs.hpp"
+
+//Send request to runtime server
+int SendRequest(const char *SocketFile,int ArgNr,char *Arg[],bool ShowTime);
+
+//Main program
+int main(int argc,char *argv[]){
+
+  //Variables
+  int ArgStart;
+  bool ShowTime;
+
+  //Show help
+  ArgStart=1;
+  ShowTime=false;
+  if(argc>1 && strcmp(argv[1],"-t")==0){ ShowTime=true; ArgStart++; }
+  if(argc<=ArgStart){
+    std::cerr << "Usage: dunq [-t] <socket> [arguments...]" << std::endl;
+    std::cerr << "Runs program loaded by runtime server (dunr -serve <socket> <program>) with given arguments" << std::endl;
+    std::cerr << "-t: Show request time on standard error" << std::endl;
+    return 1;
+  }
+
+  //Send request
+  return SendRequest(argv[ArgStart],argc-ArgStart-1,&argv[ArgStart+1],ShowTime);
+
+}
+
+//Not available on windows
+#ifdef __WIN__
+int SendRequest(const char *SocketFile,int ArgNr,char *Arg[],bool ShowTime){
+  std::cerr << "dunq: Runtime server mode is not available on windows" << std::endl;
+  return 1;
+}
+
+//Linux
+#else
+int SendRequest(const char *SocketFile,int ArgNr,char *Arg[],bool ShowTime){
+
+  //Variables
+  int i;
+  int Conn;
+  int Fd[3]={STDIN_FILENO,STDOUT_FILENO,STDERR_FILENO};
+  ssize_t Bytes;
+  ClockPoint Start;
+  Buffer ArgBuff;
+  ServeRequest Request;
+  ServeReply Reply;
+  struct sockaddr_un Addr;
+  struct msghdr Msg;
+  struct iovec Iov;
+  struct cmsghdr *Cmsg;
+  char Control[CMSG_SPACE(sizeof(Fd))];
+
+  //Argument block
+  for(i=0;i<ArgNr;i++){ ArgBuff.Append(Arg[i],strlen(Arg[i])+1); }
+  if(ArgBuff.Length()>SERVE_MAX_ARGLEN){
+    std::cerr << "dunq: Arguments exceed maximun length (" << SERVE_MAX_ARGLEN << " bytes)" << std::endl;
+    return 1;
+  }
+
+  //Connect to server
+  Start=ClockGet();
+  if(strlen(SocketFile)>=sizeof(Addr.sun_path)){
+    std::cerr << "dunq: Socket path is too long" << std::endl;
+    return 1;
+  }
+  memset(&Addr,0,sizeof(Addr));
+  Addr.sun_family=AF_UNIX;
+  strncpy(Addr.sun_path,SocketFile,sizeof(Addr.sun_path)-1);
+  if((Conn=socket(AF_UNIX,SOCK_STREAM,0))==-1 || connect(Conn,(struct sockaddr *)&Addr,sizeof(Addr))==-1){
+    std::cerr << "dunq: Unable to connect to runtime server on " << SocketFile << " (" << strerror(errno) << ")" << std::endl;
+    return 1;
+  }
+
+  //Send request header with standard descriptors and argument block
+  memcpy(Request.FileMark,SERVE_REQUEST_MARK,4);
+  Request.ArgNr=ArgNr;
+  Request.ArgLength=ArgBuff.Length();
+  memset(&Msg,0,sizeof(Msg));
+  memset(Control,0,sizeof(Control));
+  Iov.iov_base=&Request;
+  Iov.iov_len=sizeof(Request);
+  Msg.msg_iov=&Iov;
+  Msg.msg_iovlen=1;
+  Msg.msg_control=Control;
+  Msg.msg_controllen=sizeof(Control);
+  Cmsg=CMSG_FIRSTHDR(&Msg);
+  Cmsg->cmsg_level=SOL_SOCKET;
+  Cmsg->cmsg_type=SCM_RIGHTS;
+  Cmsg->cmsg_len=CMSG_LEN(sizeof(Fd));
+  memcpy(CMSG_DATA(Cmsg),Fd,sizeof(Fd));
+  if(sendmsg(Conn,&Msg,MSG_NOSIGNAL)!=sizeof(Request)
+  || (ArgBuff.Length()!=0 && send(Conn,ArgBuff.BuffPnt(),ArgBuff.Length(),MSG_NOSIGNAL)!=ArgBuff.Length())){
+    std::cerr << "dunq: Unable to send request to runtime server (" << strerror(errno) << ")" << std::endl;
+    close(Conn);
+    return 1;
+  }
+
+  //Wait for program result (program output goes directly to our descriptors)
+  while((Bytes=recv(Conn,&Reply,sizeof(Reply),MSG_WAITALL))==-1 && errno==EINTR){}
+  close(Conn);
+  if(Bytes!=sizeof(Reply) || memcmp(Reply.FileMark,SERVE_REPLY_MARK,4)!=0){
+    std::cerr << "dunq: Runtime server closed connection without sending program result" << std::endl;
+    return 1;
+  }
+
+  //Request time
+  if(ShowTime){
+    std::cerr << "dunq: Request time " << ClockIntervalNSec(ClockGet(),Start)/1000000.0 << " ms" << std::endl;
+  }
+
+  //Return program result
+  return Reply.Result;
+
+}
+#endif
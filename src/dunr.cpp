@@ -17,6 +17,7 @@
 #include "vrm/auxmem.hpp"
 #include "vrm/strcomp.hpp"
 #include "vrm/arrcomp.hpp"
+#include "vrm/jit.hpp"
 #include "vrm/runtime.hpp"
 #include "vrm/scheduler.hpp" 
 #include "cfgparser.hpp"
@@ -67,7 +68,9 @@ int main(int argc,char *argv[]){
       if(!ConfigParser::GetCmdLineOptions(ExecPath,argc,argv,OPSRUN,true,ConfigFileName.CharPnt(),CmdOpt,ArgStart)){ return 0; }
 
       //Call runtime environment main
-      if(!CallRuntime(CmdOpt.BinaryFile,CmdOpt.MemoryUnitKB,CmdOpt.StartUnits,CmdOpt.ChunkUnits,CmdOpt.LockMemory,CmdOpt.BenchMark,CmdOpt.DynLibPath,CmdOpt.TmpLibPath,argc,argv,ArgStart,&_RomBuffer)){ return 0; }
+      MemoryPool::SetSlabLimit(CmdOpt.SlabLimit);
+      AuxMemoryManager::SetEagerRelease(!CmdOpt.LazyRelease);
+      if(!CallRuntime(CmdOpt.BinaryFile,CmdOpt.MemoryUnitKB,CmdOpt.StartUnits,CmdOpt.ChunkUnits,CmdOpt.LockMemory,CmdOpt.StackReserveKB,CmdOpt.Jit,CmdOpt.Aot,CmdOpt.BenchMark,CmdOpt.Profiler,CmdOpt.CallTimming,CmdOpt.ImageCache,CmdOpt.Workers,CmdOpt.ServeSocket,CmdOpt.SnapshotFile,CmdOpt.RestoreFile,CmdOpt.DynLibPath,CmdOpt.TmpLibPath,argc,argv,ArgStart,&_RomBuffer)){ return 0; }
 
     }
 
@@ -87,6 +90,9 @@ int main(int argc,char *argv[]){
       else if(String(argv[1])=="-ve"){
         OptionSet=OPSVER;
       }
+      else if(String(argv[1])=="-batch"){
+        OptionSet=OPSBAT;
+      }
       else{
         OptionSet=OPSNUL;
         for(i=1;i<argc;i++){
@@ -115,7 +121,17 @@ int main(int argc,char *argv[]){
         case OPSRUN:
           if(!ConfigParser::GetCmdLineOptions(ExecPath,argc,argv,OptionSet,false,CONFIG_FILE,CmdOpt,ArgStart)){ return 0; }
           if(!ConfigParser::EnableDebugLevels(DUNR_APPID,CmdOpt.DebugLevelIds,CmdOpt.AllDebugLevels,CmdOpt.DebugToConsole)){ return 0; }
-          if(!CallRuntime(CmdOpt.BinaryFile,CmdOpt.MemoryUnitKB,CmdOpt.StartUnits,CmdOpt.ChunkUnits,CmdOpt.LockMemory,CmdOpt.BenchMark,CmdOpt.DynLibPath,CmdOpt.TmpLibPath,argc,argv,ArgStart,nullptr)){ return 0; }
+          MemoryPool::SetSlabLimit(CmdOpt.SlabLimit);
+          AuxMemoryManager::SetEagerRelease(!CmdOpt.LazyRelease);
+          if(!CallRuntime(CmdOpt.BinaryFile,CmdOpt.MemoryUnitKB,CmdOpt.StartUnits,CmdOpt.ChunkUnits,CmdOpt.LockMemory,CmdOpt.StackReserveKB,CmdOpt.Jit,CmdOpt.Aot,CmdOpt.BenchMark,CmdOpt.Profiler,CmdOpt.CallTimming,CmdOpt.ImageCache,CmdOpt.Workers,CmdOpt.ServeSocket,CmdOpt.SnapshotFile,CmdOpt.RestoreFile,CmdOpt.DynLibPath,CmdOpt.TmpLibPath,argc,argv,ArgStart,nullptr)){ return 0; }
+          break;
+
+        //Batch execution
+        case OPSBAT:
+          if(!ConfigParser::GetCmdLineOptions(ExecPath,argc,argv,OptionSet,false,CONFIG_FILE,CmdOpt,ArgStart)){ return 0; }
+          MemoryPool::SetSlabLimit(CmdOpt.SlabLimit);
+          AuxMemoryManager::SetEagerRelease(!CmdOpt.LazyRelease);
+          if(!CallScheduler(CmdOpt.BatchFile,CmdOpt.Workers,CmdOpt.MemoryUnitKB,CmdOpt.StartUnits,CmdOpt.ChunkUnits,CmdOpt.LockMemory,CmdOpt.Jit,CmdOpt.DynLibPath,CmdOpt.TmpLibPath)){ return 0; }
           break;
 
         //Version info
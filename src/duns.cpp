@@ -23,6 +23,7 @@
 #include "vrm/auxmem.hpp"
 #include "vrm/strcomp.hpp"
 #include "vrm/arrcomp.hpp"
+#include "vrm/jit.hpp"
 #include "vrm/runtime.hpp"
 #include "vrm/scheduler.hpp" 
 #include "cfgparser.hpp"
@@ -122,9 +123,11 @@ int main(int argc,char *argv[]){
       case OPSCNR:
         if(!ConfigParser::GetCmdLineOptions(ExecPath,argc,argv,OptionSet,false,CONFIG_FILE,CmdOpt,ArgStart)){ return 0; }
         if(!ConfigParser::EnableDebugLevels(DUNS_APPID,CmdOpt.DebugLevelIds,CmdOpt.AllDebugLevels,CmdOpt.DebugToConsole)){ return 0; }
-        if(!CallCompiler(CmdOpt.SourceFile,CmdOpt.OutputFile,CmdOpt.CompileToApp,GetPkgContainer(ExecPath),CmdOpt.EnableAsmFile,CmdOpt.StripSymbols,CmdOpt.CompilerStats,CmdOpt.LinterMode,CmdOpt.MaxErrorNr,CmdOpt.MaxWarningNr,CmdOpt.PassOnWarnings,CmdOpt.IncludePath,CmdOpt.LibraryPath,CmdOpt.DynLibPath,CompileToLibrary)){ return 0; }
+        if(!CallCompiler(CmdOpt.SourceFile,CmdOpt.OutputFile,CmdOpt.CompileToApp,GetPkgContainer(ExecPath),CmdOpt.EnableAsmFile,CmdOpt.StripSymbols,CmdOpt.CompilerStats,CmdOpt.LinterMode,CmdOpt.MaxErrorNr,CmdOpt.MaxWarningNr,CmdOpt.PassOnWarnings,CmdOpt.Aot,CmdOpt.IncludePath,CmdOpt.LibraryPath,CmdOpt.DynLibPath,CompileToLibrary)){ return 0; }
         if(!CompileToLibrary && !CmdOpt.CompileToApp){
-          if(!CallRuntime(CmdOpt.OutputFile+EXECUTABLE_EXT,CmdOpt.MemoryUnitKB,CmdOpt.StartUnits,CmdOpt.ChunkUnits,CmdOpt.LockMemory,CmdOpt.BenchMark,CmdOpt.DynLibPath,CmdOpt.TmpLibPath,argc,argv,ArgStart,nullptr)){ return 0; }
+          MemoryPool::SetSlabLimit(CmdOpt.SlabLimit);
+          AuxMemoryManager::SetEagerRelease(!CmdOpt.LazyRelease);
+          if(!CallRuntime(CmdOpt.OutputFile+EXECUTABLE_EXT,CmdOpt.MemoryUnitKB,CmdOpt.StartUnits,CmdOpt.ChunkUnits,CmdOpt.LockMemory,CmdOpt.StackReserveKB,CmdOpt.Jit,CmdOpt.Aot,CmdOpt.BenchMark,CmdOpt.Profiler,CmdOpt.CallTimming,CmdOpt.ImageCache,CmdOpt.Workers,"","","",CmdOpt.DynLibPath,CmdOpt.TmpLibPath,argc,argv,ArgStart,nullptr)){ return 0; }
         }
         break;
  
@@ -132,7 +135,9 @@ int main(int argc,char *argv[]){
       case OPSRUN:
         if(!ConfigParser::GetCmdLineOptions(ExecPath,argc,argv,OptionSet,false,CONFIG_FILE,CmdOpt,ArgStart)){ return 0; }
         if(!ConfigParser::EnableDebugLevels(DUNR_APPID,CmdOpt.DebugLevelIds,CmdOpt.AllDebugLevels,CmdOpt.DebugToConsole)){ return 0; }
-        if(!CallRuntime(CmdOpt.BinaryFile,CmdOpt.MemoryUnitKB,CmdOpt.StartUnits,CmdOpt.ChunkUnits,CmdOpt.LockMemory,CmdOpt.BenchMark,CmdOpt.DynLibPath,CmdOpt.TmpLibPath,argc,argv,ArgStart,nullptr)){ return 0; }
+        MemoryPool::SetSlabLimit(CmdOpt.SlabLimit);
+        AuxMemoryManager::SetEagerRelease(!CmdOpt.LazyRelease);
+        if(!CallRuntime(CmdOpt.BinaryFile,CmdOpt.MemoryUnitKB,CmdOpt.StartUnits,CmdOpt.ChunkUnits,CmdOpt.LockMemory,CmdOpt.StackReserveKB,CmdOpt.Jit,CmdOpt.Aot,CmdOpt.BenchMark,CmdOpt.Profiler,CmdOpt.CallTimming,CmdOpt.ImageCache,CmdOpt.Workers,"","","",CmdOpt.DynLibPath,CmdOpt.TmpLibPath,argc,argv,ArgStart,nullptr)){ return 0; }
         break;
 
       //Version info
@@ -196,6 +196,7 @@ FDECLVO3(PrintChar,cint,cint,cint);
 FDECLVO3(Print,cint,cint,const char *);
 FDECLVO3(PrintCharXY,cint,cint,cint);
 FDECLVO3(PrintXY,cint,cint,const char *);
+FDECLVO2(FitText,char *,cint);
 FDECLRS2(bool,LoadTexture,const char *,cint *);
 FDECLRS1(bool,FreeTexture,cint);
 FDECLVO3(GetTextureSize,cint,cint *,cint *);
@@ -1231,6 +1232,12 @@ CALLDEFN void PrintXY(cint x,cint y,const char *Text){
   }
 }
 
+//FitText (cuts text in place so it fits on given number of character columns)
+CALLDEFN void FitText(char *Text,cint Columns){
+  if(Columns<0){ return; }
+  if((cint)strlen(Text)>Columns){ Text[Columns]=0; }
+}
+
 //Load texture
 CALLDEFN bool LoadTexture(const char *FileName,cint *TxtrHnd){
 
@@ -218,6 +218,7 @@ CALLDECL void PrintChar(cint cx,cint cy,cint Chr);
 CALLDECL void Print(cint cx,cint cy,const char *Text);
 CALLDECL void PrintCharXY(cint x,cint y,cint Chr);
 CALLDECL void PrintXY(cint x,cint y,const char *Text);
+CALLDECL void FitText(char *Text,cint Columns);
 CALLDECL bool LoadTexture(const char *FileName,cint *TxtrHnd);
 CALLDECL bool FreeTexture(cint TxtrHnd);
 CALLDECL void GetTextureSize(cint TxtrHnd,cint *Width,cint *Height);
@@ -57,7 +57,7 @@ int _MsgCount[2]={0,0};             //Message counters
 bool _ForceOutput=false;            //Forcemessage output regardless of maximun message counts
 
 //SysMessage table
-const int _MsgNr=600;
+const int _MsgNr=622;
 const SysMsgDefinition _Msg[_MsgNr]={
   {  0,SysMsgSeverity::Error,   SysMsgClass::Internal, "Unable to determine path of executable module" },
   {  1,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Identifier %p is invalid because it cannot start by number"},
@@ -416,7 +416,7 @@ const SysMsgDefinition _Msg[_MsgNr]={
   {354,SysMsgSeverity::Error,   SysMsgClass::File,     "Error while closing application file %p (%p)"},
   {355,SysMsgSeverity::Error,   SysMsgClass::File,     "Error while freeing handler for application file %p (%p)"},
   {356,SysMsgSeverity::Error,   SysMsgClass::File,     "Rom buffer overrun when reading at position %p (buffer length is %p)"},
-  {357,SysMsgSeverity::Error,   SysMsgClass::CmdLine,  "Invalid benchmark mode specified, valid values are 0, 1, 2 or 3"},
+  {357,SysMsgSeverity::Error,   SysMsgClass::CmdLine,  "Invalid benchmark mode specified, valid values are 0, 1, 2, 3 or 4"},
   {358,SysMsgSeverity::Error,   SysMsgClass::CmdLine,  "A file with extension %p must be given or first argument must be -ve"},
   {359,SysMsgSeverity::Error,   SysMsgClass::File,     "Cannot open source file %p (%p)"},
   {360,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Unknown escape sequence in char literal %p"},
@@ -634,7 +634,49 @@ const SysMsgDefinition _Msg[_MsgNr]={
   {576,SysMsgSeverity::Error,   SysMsgClass::Internal, "Invalid instrucion code found at code address %p (int=%p, hex=%p)"},
   {577,SysMsgSeverity::Error,   SysMsgClass::Runtime,  ""},
   {578,SysMsgSeverity::Error,   SysMsgClass::Runtime,  "Reference indirection error for local address in argument %p on instruction %p"},
+  {579,SysMsgSeverity::Error,   SysMsgClass::CmdLine,  "Invalid stack reservation size specified, value must be zero or positive"},
+  {580,SysMsgSeverity::Error,   SysMsgClass::Runtime,  "Unable to allocate executable memory for jit compiler"},
+  {581,SysMsgSeverity::Warning, SysMsgClass::CmdLine,  "Jit compiler is only available on x86-64 linux, program runs on interpreter"},
+  {582,SysMsgSeverity::Error,   SysMsgClass::Runtime,  "Unable to write native source file %p (%p)"},
+  {583,SysMsgSeverity::Error,   SysMsgClass::Runtime,  "Native compilation failed for library %p, command was: %p"},
+  {584,SysMsgSeverity::Warning, SysMsgClass::Runtime,  "Native library %p not found, program runs on interpreter"},
+  {585,SysMsgSeverity::Warning, SysMsgClass::Runtime,  "Native library %p does not match executable code, program runs on interpreter"},
+  {586,SysMsgSeverity::Error,   SysMsgClass::CmdLine,  "Sampling profiler cannot be used together with benchmark modes 2, 3 and 4"},
+  {587,SysMsgSeverity::Warning, SysMsgClass::CmdLine,  "Sampling profiler is not available on windows, program runs without profiling"},
+  {588,SysMsgSeverity::Warning, SysMsgClass::Runtime,  "Unable to start sampling profiler timer (%p), program runs without profiling"},
+  {589,SysMsgSeverity::Error,   SysMsgClass::File,     "Unable to write profiler file %p (%p)"},
+  {590,SysMsgSeverity::Error,   SysMsgClass::CmdLine,  "Call timming mode cannot be used together with benchmark modes 2, 3 and 4"},
+  {591,SysMsgSeverity::Error,   SysMsgClass::File,     "Unable to write instruction sequence file %p (%p)"},
+  {592,SysMsgSeverity::Error,   SysMsgClass::Runtime,  "Cannot load executable file %p because it has incompatible file format (%p), program needs to be recompiled"},
+  {593,SysMsgSeverity::Error,   SysMsgClass::Runtime,  "Executable file %p is damaged, section %p does not match header (offset: %p, length: %p)"},
+  {594,SysMsgSeverity::Warning, SysMsgClass::File,     "Unable to write decoded code image file %p (%p), program runs without it"},
+  {595,SysMsgSeverity::Error,   SysMsgClass::CmdLine,  "Runtime server mode is not available on windows"},
+  {596,SysMsgSeverity::Error,   SysMsgClass::Runtime,  "Unable to start runtime server on socket %p (%p)"},
+  {597,SysMsgSeverity::Error,   SysMsgClass::CmdLine,  "Provide batch file name"},
+  {598,SysMsgSeverity::Error,   SysMsgClass::CmdLine,  "Invalid number of workers specified, value must be zero (one for each cpu core) or positive"},
   {599,SysMsgSeverity::Error,   SysMsgClass::Syntax,   ""},
+  {600,SysMsgSeverity::Error,   SysMsgClass::File,     "Unable to read batch file %p (%p)"},
+  {601,SysMsgSeverity::Error,   SysMsgClass::CmdLine,  "Invalid job on line %p of batch file %p, executable file with %p extension is expected"},
+  {602,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Parallel walk is only allowed inside functions"},
+  {603,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Parallel walk cannot iterate over a local fixed array, use a global, static or dynamic array"},
+  {604,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Operation is not allowed inside parallel walk (instruction %p), loop body can only do calculations on local variables and current element"},
+  {605,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Parallel walk body modifies %p, only local variables and current element can be modified"},
+  {606,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Parallel walk index variable must be a local variable"},
+  {607,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Break is not allowed inside parallel walk"},
+  {608,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Generator function %p can only be called as expression of walk sentence"},
+  {609,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Generator functions cannot return void"},
+  {610,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Only global functions can be generators, operators, function members and nested functions cannot"},
+  {611,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Yield is only allowed inside generator functions"},
+  {612,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Walk expression must be a single generator function call when it calls a generator"},
+  {613,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Parallel walk cannot iterate over a generator"},
+  {614,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "%p is declared as generator on one side and as regular function on the other side"},
+  {615,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Return from generator functions cannot have a value, values are returned with yield"},
+  {616,SysMsgSeverity::Error,   SysMsgClass::CmdLine,  "Snapshot option cannot be combined with restore or runtime server options"},
+  {617,SysMsgSeverity::Error,   SysMsgClass::Runtime,  "Unable to restore process snapshot from file %p (%p)"},
+  {618,SysMsgSeverity::Warning, SysMsgClass::Runtime,  "Debug symbols are not available, executable file %p changed after program was loaded"},
+  {619,SysMsgSeverity::Error,   SysMsgClass::CmdLine,  "Invalid slab limit specified, value must be zero (slabs disabled) or positive"},
+  {620,SysMsgSeverity::Error,   SysMsgClass::Syntax,   "Invalid call to .reserve() master method, array is not 1-dimensional"},
+  {621,SysMsgSeverity::Error,   SysMsgClass::Runtime,  "Unable to start runtime server, program %p ended before initialization routines finished"},
 }; 
 
 //Constructors
@@ -16,6 +16,10 @@
 //Global STL pointer
 StlSubsystem* _Stl;
 
+//Last error (kept for each thread that runs a process)
+thread_local StlErrorCode StlSubsystem::_ErrorCode;
+thread_local String StlSubsystem::_ErrorInfo;
+
 //Month days
 const int _MonthDays[12+1]={0,31,28,31,30,31,30,31,31,30,31,30,31};
 
@@ -36,10 +40,17 @@ struct StlFileHandler{
   int ProcessId;
   bool Used;
   CpuLon PrevPos;
+  std::atomic<int> AsyncPending;
 };
 const int _MaxFileHandlers=255;
 StlFileHandler _File[_MaxFileHandlers];
 
+//File handler table mutex (processes run by scheduler share the table)
+std::mutex _FileMutex;
+
+//Current thread is an asynchronous I/O thread (it executes the requests that keep handlers busy)
+thread_local bool _AsyncIoThread=false;
+
 //Internal functions
 CpuInt _Date2Serial(CpuInt Date);
 CpuInt _Serial2Date(CpuInt Serial);
@@ -74,6 +85,8 @@ void StlSubsystem::StlConsole::SetMainPtr(StlSubsystem *Bios){
 
 //Constructor
 StlSubsystem::StlConsole::StlConsole(){
+  _LockOverride=false;
+  _Shared=false;
   _LockTable.Reset();
 }
 
@@ -82,6 +95,16 @@ StlSubsystem::StlConsole::~StlConsole(){}
 
 //Internal print function
 void StlSubsystem::StlConsole::_Print(const char *Pnt,bool NewLine){
+  if(_Shared){
+    std::lock_guard<std::mutex> Lock(_Mutex);
+    if(NewLine){
+      std::cout << Pnt << std::endl;
+    }
+    else{
+      std::cout << Pnt << std::flush;
+    }
+    return;
+  }
   if(_LockTable.Top().ProcessId!=System::CurrentProcessId() && _LockOverride==false){
     System::Throw(SysExceptionCode::ConsoleLockedByOtherProcess,ToString(System::CurrentProcessId()));  
   }
@@ -98,6 +121,16 @@ void StlSubsystem::StlConsole::_Print(const char *Pnt,bool NewLine){
 
 //Internal print error function
 void StlSubsystem::StlConsole::_PrintError(const char *Pnt,bool NewLine){
+  if(_Shared){
+    std::lock_guard<std::mutex> Lock(_Mutex);
+    if(NewLine){
+      std::cerr << Pnt << std::endl;
+    }
+    else{
+      std::cerr << Pnt << std::flush;
+    }
+    return;
+  }
   if(_LockTable.Top().ProcessId!=System::CurrentProcessId() && _LockOverride==false){
     System::Throw(SysExceptionCode::ConsoleLockedByOtherProcess,ToString(System::CurrentProcessId()));  
   }
@@ -140,6 +173,11 @@ void StlSubsystem::StlConsole::Override(){
   _LockOverride=true;
 }
 
+//Shared console (all processes print without lock check, used when scheduler runs processes concurrently)
+void StlSubsystem::StlConsole::SetShared(bool Enable){
+  _Shared=Enable;
+}
+
 //Print
 void StlSubsystem::StlConsole::Print(const char *Pnt){
   _Print(Pnt,false);
@@ -354,6 +392,7 @@ StlSubsystem::StlFileSystem::StlFileSystem(){
     _File[i].Used=false;
     _File[i].ProcessId=-1;
     _File[i].PrevPos=-1;
+    _File[i].AsyncPending=0;
   }
 }
 
@@ -380,6 +419,7 @@ void StlSubsystem::StlFileSystem::_ForcedFileClose(int Hnd){
 bool StlSubsystem::StlFileSystem::GetHandler(int& Hnd){
   
   //Variables
+  std::lock_guard<std::mutex> Lock(_FileMutex);
   int Index=-1;
   
   //Find non used handler
@@ -406,10 +446,12 @@ bool StlSubsystem::StlFileSystem::GetHandler(int& Hnd){
 
 //Free handler
 bool StlSubsystem::StlFileSystem::FreeHandler(int Hnd){
+  std::lock_guard<std::mutex> Lock(_FileMutex);
   if(_File[Hnd].ProcessId!=System::CurrentProcessId()){
     _Main->SetError(StlErrorCode::HandlerForbidden);
     return false; 
   }
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
   if(_File[Hnd].Status!=StlFileStatus::Closed){
     _Main->SetError(StlErrorCode::FreeHandlerOpenFile);
     return false; 
@@ -423,6 +465,7 @@ bool StlSubsystem::StlFileSystem::FreeHandler(int Hnd){
 bool StlSubsystem::StlFileSystem::OpenForRead(int Hnd,const String& FilePath){
   
   //Variables
+  std::lock_guard<std::mutex> Lock(_FileMutex);
   String FileName=Normalize(FilePath);
 
   //Check if handler belongs to current process
@@ -431,6 +474,9 @@ bool StlSubsystem::StlFileSystem::OpenForRead(int Hnd,const String& FilePath){
     return false; 
   }
 
+  //Check handler has no pending asynchronous requests
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
+
   //Check file is in use by another process
   for(int i=0;i<_MaxFileHandlers;i++){
     if(_File[i].FileName==FileName){
@@ -463,6 +509,7 @@ bool StlSubsystem::StlFileSystem::OpenForRead(int Hnd,const String& FilePath){
 bool StlSubsystem::StlFileSystem::OpenForWrite(int Hnd,const String& FilePath){
 
   //Variables
+  std::lock_guard<std::mutex> Lock(_FileMutex);
   String FileName=Normalize(FilePath);
 
   //Check if handler belongs to current process
@@ -471,6 +518,9 @@ bool StlSubsystem::StlFileSystem::OpenForWrite(int Hnd,const String& FilePath){
     return false; 
   }
 
+  //Check handler has no pending asynchronous requests
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
+
   //Check file is in use by another process
   for(int i=0;i<_MaxFileHandlers;i++){
     if(_File[i].FileName==FileName){
@@ -503,6 +553,7 @@ bool StlSubsystem::StlFileSystem::OpenForWrite(int Hnd,const String& FilePath){
 bool StlSubsystem::StlFileSystem::OpenForAppend(int Hnd,const String& FilePath){
 
   //Variables
+  std::lock_guard<std::mutex> Lock(_FileMutex);
   String FileName=Normalize(FilePath);
 
   //Check if handler belongs to current process
@@ -511,6 +562,9 @@ bool StlSubsystem::StlFileSystem::OpenForAppend(int Hnd,const String& FilePath){
     return false; 
   }
 
+  //Check handler has no pending asynchronous requests
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
+
   //Check file is in use by another process
   for(int i=0;i<_MaxFileHandlers;i++){
     if(_File[i].FileName==FileName){
@@ -545,6 +599,9 @@ bool StlSubsystem::StlFileSystem::GetFileSize(int Hnd,CpuLon& Size){
   //File position
   CpuLon Pos;
 
+  //Check handler has no pending asynchronous requests
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
+
   //Size of input file
   if(_File[Hnd].Status==StlFileStatus::OpenRead){
     Pos=_File[Hnd].InpStream.tellg();
@@ -573,6 +630,9 @@ bool StlSubsystem::StlFileSystem::Read(int Hnd,String& Line){
     return false; 
   }
 
+  //Check handler has no pending asynchronous requests
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
+
   //Check handler
   if(_File[Hnd].Status!=StlFileStatus::OpenRead){ _Main->SetError(StlErrorCode::ReadWhenClosed); return false; }
 
@@ -602,6 +662,9 @@ bool StlSubsystem::StlFileSystem::Write(int Hnd,const String& Line){
     return false; 
   }
 
+  //Check handler has no pending asynchronous requests
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
+
   //Check handler
   if(_File[Hnd].Status!=StlFileStatus::OpenWrite){ _Main->SetError(StlErrorCode::WriteWhenClosed); return false; }
 
@@ -629,6 +692,9 @@ bool StlSubsystem::StlFileSystem::WriteArray(int Hnd,const Array<String>& Lines)
     return false; 
   }
 
+  //Check handler has no pending asynchronous requests
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
+
   //Check handler
   if(_File[Hnd].Status!=StlFileStatus::OpenWrite){ _Main->SetError(StlErrorCode::WriteWhenClosed); return false; }
 
@@ -658,6 +724,9 @@ bool StlSubsystem::StlFileSystem::Read(int Hnd,Buffer& Buff,long Length){
     return false; 
   }
 
+  //Check handler has no pending asynchronous requests
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
+
   //Check handler
   if(_File[Hnd].Status!=StlFileStatus::OpenRead){ _Main->SetError(StlErrorCode::ReadWhenClosed); return false; }
 
@@ -689,6 +758,9 @@ bool StlSubsystem::StlFileSystem::Write(int Hnd,const Buffer& Buff){
     return false; 
   }
 
+  //Check handler has no pending asynchronous requests
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
+
   //Check handler
   if(_File[Hnd].Status!=StlFileStatus::OpenWrite){ _Main->SetError(StlErrorCode::WriteWhenClosed); return false; }
 
@@ -716,6 +788,9 @@ bool StlSubsystem::StlFileSystem::WriteArray(int Hnd,const Array<Buffer>& Buffer
     return false; 
   }
 
+  //Check handler has no pending asynchronous requests
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
+
   //Check handler
   if(_File[Hnd].Status!=StlFileStatus::OpenWrite){ _Main->SetError(StlErrorCode::WriteWhenClosed); return false; }
 
@@ -745,6 +820,9 @@ bool StlSubsystem::StlFileSystem::Read(int Hnd,char *Pnt,long Length){
     return false; 
   }
 
+  //Check handler has no pending asynchronous requests
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
+
   //Check handler
   if(_File[Hnd].Status!=StlFileStatus::OpenRead){ _Main->SetError(StlErrorCode::ReadWhenClosed); return false; }
 
@@ -776,6 +854,9 @@ bool StlSubsystem::StlFileSystem::Write(int Hnd,const char *Pnt,long Length){
     return false; 
   }
 
+  //Check handler has no pending asynchronous requests
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
+
   //Check handler
   if(_File[Hnd].Status!=StlFileStatus::OpenWrite){ _Main->SetError(StlErrorCode::WriteWhenClosed); return false; }
 
@@ -806,6 +887,9 @@ bool StlSubsystem::StlFileSystem::FullRead(int Hnd,Buffer& Buff){
     return false; 
   }
 
+  //Check handler has no pending asynchronous requests
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
+
   //Check status
   if(_File[Hnd].Status!=StlFileStatus::OpenRead){ 
     _Main->SetError(StlErrorCode::ReadWhenClosed); 
@@ -841,6 +925,7 @@ bool StlSubsystem::StlFileSystem::FullRead(int Hnd,Array<String>& Lines){
     _Main->SetError(StlErrorCode::HandlerForbidden);
     return false; 
   }
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
   Lines.Reset();
   _Main->ClearError();
   while(Read(Hnd,Line)){ 
@@ -856,6 +941,7 @@ bool StlSubsystem::StlFileSystem::FullWrite(int Hnd,const Array<String>& Lines){
     _Main->SetError(StlErrorCode::HandlerForbidden);
     return false; 
   }
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
   for(int i=0;i<Lines.Length();i++){
     if(!Write(Hnd,Lines[i])){ return false; }
   }
@@ -868,6 +954,7 @@ bool StlSubsystem::StlFileSystem::GetStateFlags(int Hnd,bool& Good,bool& Eof,boo
     _Main->SetError(StlErrorCode::HandlerForbidden);
     return false; 
   }
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
   Good=_File[Hnd].InpStream.good();
   Eof=_File[Hnd].InpStream.eof();
   Fail=_File[Hnd].InpStream.fail();
@@ -877,10 +964,12 @@ bool StlSubsystem::StlFileSystem::GetStateFlags(int Hnd,bool& Good,bool& Eof,boo
 
 //Close file
 bool StlSubsystem::StlFileSystem::CloseFile(int Hnd){
+  std::lock_guard<std::mutex> Lock(_FileMutex);
   if(_File[Hnd].ProcessId!=System::CurrentProcessId()){
     _Main->SetError(StlErrorCode::HandlerForbidden);
     return false; 
   }
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
   if(_File[Hnd].Status==StlFileStatus::Closed){
     _Main->SetError(StlErrorCode::CloseAlreadyClosed);
     return false;
@@ -896,9 +985,13 @@ bool StlSubsystem::StlFileSystem::CloseFile(int Hnd){
   return true;
 }
 
-//Close all open files
+//Close all open files of current process and release its handlers
 void StlSubsystem::StlFileSystem::CloseAll(){
+  std::lock_guard<std::mutex> Lock(_FileMutex);
   for(int i=0;i<_MaxFileHandlers;i++){
+    if(!_File[i].Used || _File[i].ProcessId!=System::CurrentProcessId()){
+      continue;
+    }
     if(_File[i].Status==StlFileStatus::OpenRead){
       _File[i].InpStream.close();
     }
@@ -907,6 +1000,8 @@ void StlSubsystem::StlFileSystem::CloseAll(){
     }
     _File[i].FileName="";
     _File[i].Status=StlFileStatus::Closed;
+    _File[i].Used=false;
+    _File[i].ProcessId=-1;
   }
 }
 
@@ -934,6 +1029,7 @@ CpuLon StlSubsystem::StlFileSystem::GetSeekPos(int Hnd){
     _Main->SetError(StlErrorCode::HandlerForbidden);
     return false; 
   }
+  if(!_CheckAsyncIdle(Hnd)){ return false; }
   if(_File[Hnd].Status==StlFileStatus::OpenRead){
     return _File[Hnd].InpStream.tellg();
   }
@@ -949,9 +1045,41 @@ CpuLon StlSubsystem::StlFileSystem::GetPrevPos(int Hnd){
     _Main->SetError(StlErrorCode::HandlerForbidden);
     return -1; 
   }
+  if(!_CheckAsyncIdle(Hnd)){ return -1; }
   return _File[Hnd].PrevPos;
 }
 
+//Check handler has no pending asynchronous requests
+//(file functions called by I/O threads are the ones executing the requests, so they are not checked)
+bool StlSubsystem::StlFileSystem::_CheckAsyncIdle(int Hnd){
+  if(!_AsyncIoThread && _File[Hnd].AsyncPending!=0){
+    _Main->SetError(StlErrorCode::AsyncIoPending);
+    return false; 
+  }
+  return true;
+}
+
+//Asynchronous request submitted on handler
+//(checked before request is queued, so I/O threads never get handlers out of range or owned by other process)
+bool StlSubsystem::StlFileSystem::AsyncBegin(int Hnd){
+  if(Hnd<0 || Hnd>=_MaxFileHandlers || _File[Hnd].ProcessId!=System::CurrentProcessId()){
+    _Main->SetError(StlErrorCode::HandlerForbidden);
+    return false; 
+  }
+  _File[Hnd].AsyncPending++;
+  return true;
+}
+
+//Asynchronous request on handler completed
+void StlSubsystem::StlFileSystem::AsyncEnd(int Hnd){
+  _File[Hnd].AsyncPending--;
+}
+
+//Mark current thread as asynchronous I/O thread
+void StlSubsystem::StlFileSystem::SetAsyncIoThread(){
+  _AsyncIoThread=true;
+}
+
 //Set reference to main class
 void StlSubsystem::StlMath::SetMainPtr(StlSubsystem *Bios){
   _Main=Bios;  
@@ -1308,6 +1436,11 @@ StlErrorCode StlSubsystem::Error(){
   return _ErrorCode;
 }
 
+//Get last error information
+String StlSubsystem::ErrorInfo(){
+  return _ErrorInfo;
+}
+
 //Get information about last error produced
 String StlSubsystem::LastError(){
   return ErrorText(_ErrorCode)+(_ErrorInfo.Length()!=0?" ("+_ErrorInfo+")":"");
@@ -1332,6 +1465,13 @@ String StlSubsystem::ErrorText(StlErrorCode Err){
     case StlErrorCode::HandlerForbidden      : Text="Tried to access handler that belongs to other process"; break;
     case StlErrorCode::ExecFileNotExists     : Text="Executable file does not exist"; break;
     case StlErrorCode::ReadTimeout           : Text="Read timeout"; break;
+    case StlErrorCode::InvalidTask           : Text="Invalid task id"; break;
+    case StlErrorCode::TaskAlreadyJoined     : Text="Task was already joined"; break;
+    case StlErrorCode::InvalidChannel        : Text="Invalid channel id"; break;
+    case StlErrorCode::ChannelClosed         : Text="Channel is closed"; break;
+    case StlErrorCode::ChannelTypeMismatch   : Text="Message in channel is of different type"; break;
+    case StlErrorCode::InvalidIoRequest      : Text="Invalid asynchronous I/O request id"; break;
+    case StlErrorCode::AsyncIoPending        : Text="File handler has pending asynchronous I/O requests"; break;
   }
   return Text;
 }
@@ -1431,6 +1571,26 @@ String SystemCallId(SystemCall Nr){
     case SystemCall::GetTime                  : Id="gettime"; break;
     case SystemCall::DateDiff                 : Id="datediff"; break;
     case SystemCall::TimeDiff                 : Id="timediff"; break;
+    case SystemCall::Spawn                    : Id="spawn"; break;
+    case SystemCall::Join                     : Id="join"; break;
+    case SystemCall::ChOpen                   : Id="chopen"; break;
+    case SystemCall::ChClose                  : Id="chclose"; break;
+    case SystemCall::ChSendStr                : Id="chsendstr"; break;
+    case SystemCall::ChSendInt                : Id="chsendint"; break;
+    case SystemCall::ChSendLon                : Id="chsendlon"; break;
+    case SystemCall::ChSendFlo                : Id="chsendflo"; break;
+    case SystemCall::ChSendArr                : Id="chsendarr"; break;
+    case SystemCall::ChRecvStr                : Id="chrecvstr"; break;
+    case SystemCall::ChRecvInt                : Id="chrecvint"; break;
+    case SystemCall::ChRecvLon                : Id="chrecvlon"; break;
+    case SystemCall::ChRecvFlo                : Id="chrecvflo"; break;
+    case SystemCall::ChRecvArr                : Id="chrecvarr"; break;
+    case SystemCall::ReadAsync                : Id="readasync"; break;
+    case SystemCall::ReadAllAsync             : Id="readallasync"; break;
+    case SystemCall::WriteAsync               : Id="writeasync"; break;
+    case SystemCall::IoPoll                   : Id="iopoll"; break;
+    case SystemCall::IoWait                   : Id="iowait"; break;
+    case SystemCall::IoWaitData               : Id="iowaitdata"; break;
   }
   return Id;
 }
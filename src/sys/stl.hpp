@@ -60,7 +60,14 @@ enum class StlErrorCode:int{
   FreeHandlerOpenFile,
   HandlerForbidden,
   ExecFileNotExists,
-  ReadTimeout
+  ReadTimeout,
+  InvalidTask,
+  TaskAlreadyJoined,
+  InvalidChannel,
+  ChannelClosed,
+  ChannelTypeMismatch,
+  InvalidIoRequest,
+  AsyncIoPending
 };
 
 //Date parts
@@ -96,6 +103,8 @@ class StlSubsystem{
         //Private fields
         StlSubsystem *_Main;
         bool _LockOverride;
+        bool _Shared;
+        std::mutex _Mutex;
         Stack<StlConsoleLock> _LockTable;
 
         //Private members
@@ -107,6 +116,7 @@ class StlSubsystem{
         bool Lock();
         bool Unlock();
         void Override();
+        void SetShared(bool Enable);
         void Print(const char *Pnt);
         void Print(const String& Str);
         void PrintLine(const char *Pnt);
@@ -132,6 +142,7 @@ class StlSubsystem{
         
         //Methods
         void _ForcedFileClose(int Hnd);
+        bool _CheckAsyncIdle(int Hnd);
 
       //Public members
       public:
@@ -169,6 +180,9 @@ class StlSubsystem{
         int File2Hnd(const String& FilePath);
         CpuLon GetSeekPos(int Hnd);
         CpuLon GetPrevPos(int Hnd);
+        bool AsyncBegin(int Hnd);
+        void AsyncEnd(int Hnd);
+        void SetAsyncIoThread();
         void SetMainPtr(StlSubsystem *Bios);
         StlFileSystem();
         ~StlFileSystem();
@@ -240,9 +254,9 @@ class StlSubsystem{
         ~StlDateTime();
     };
         
-    //Main class private properties
-    StlErrorCode _ErrorCode;
-    String _ErrorInfo;
+    //Main class private properties (last error is kept for each thread that runs a process)
+    static thread_local StlErrorCode _ErrorCode;
+    static thread_local String _ErrorInfo;
 
   //Public members
   public:
@@ -259,6 +273,7 @@ class StlSubsystem{
     void SetError(StlErrorCode Code);
     void SetError(StlErrorCode Code,const String& Info);
     StlErrorCode Error();
+    String ErrorInfo();
     String ErrorText(StlErrorCode Code);
     String LastError();
     StlSubsystem();
@@ -9,7 +9,7 @@
 
 //Heading information
 #define VERSION_MAXLEN 10
-#define BINARY_FORMAT 0
+#define BINARY_FORMAT 1
 #define MASTER_NAME "Dungeon Spells"
 #define GITHUB_URL "https://github.com/lionteddy/DungeonSpells"
 #define SPLASH_BANNER \
@@ -55,11 +55,24 @@ struct CpuRef{ CpuMbl Id; CpuWrd Offset; };
 #define EXECUTABLE_EXT ".dex"
 #define CMP_LOG_EXT    ".clog"
 #define RUN_LOG_EXT    ".xlog"
+#define PROF_FOLDED_EXT ".folded"
+#define INST_SEQ_EXT   ".iseq"
+#define CODE_IMAGE_EXT ".dimg"
 #ifdef __WIN__
   #define DYNLIB_EXT ".dll"
 #else
   #define DYNLIB_EXT ".so"
 #endif
+#define AOT_SOURCE_EXT ".aot.cpp"
+#define AOT_LIBRARY_TAG ".aot"
+#define AOT_TABLE_FUNCTION "AotTable" //Native library function that returns entry point table
+
+//Native compiler command for ahead-of-time translation (source and library file names are appended)
+#ifdef __WIN__
+  #define AOT_COMPILER_CMD "g++ -O2 -fwrapv -fno-strict-aliasing -shared"
+#else
+  #define AOT_COMPILER_CMD "g++ -O2 -fwrapv -fno-strict-aliasing -shared -fPIC"
+#endif
 
 //Regex for file extensions
 #define SOUR_REGEX R"(.*\.ds$)"
@@ -102,6 +115,8 @@ struct CpuRef{ CpuMbl Id; CpuWrd Offset; };
 #define FILEMARKDFUN "DFUN"
 #define FILEMARKDPAR "DPAR"
 #define FILEMARKDLIN "DLIN"
+#define FILEMARKCIMG "DSCI"
+#define FILEMARKSNAP "DSSN"
 
 //String to note error at filemark when reading/writing binary files
 #define INDEXHEAD "head"
@@ -297,8 +312,8 @@ enum class CpuDecMode:char{
 
 //Constants
 const int _MaxArrayDims=5;
-const int _InstructionNr=361;
-const int _SystemCallNr=91;
+const int _InstructionNr=373;
+const int _SystemCallNr=111;
 const int _MaxIdLen=64;
 
 //CPU instruction code
@@ -324,21 +339,23 @@ enum class CpuInstCode:int{
   //Memory
   REFOF,REFAD,REFER,COPY,SCOPY,SSWCP,ACOPY,TOCA,STOCA,ATOCA,FRCA,SFRCA,AFRCA,CLEAR,STACK,
   //1-dimensional fix array operations
-  AF1RF,AF1RW,AF1FO,AF1NX,AF1SJ,AF1CJ,
+  AF1RF,AF1RW,AF1FO,AF1NX,AF1SJ,AF1CJ,AF1PW,
   //Fixed array operations
   AFDEF,AFSSZ,AFGET,AFIDX,AFREF,
   //1-dimensional dyn array operations
-  AD1EM,AD1DF,AD1AP,AD1IN,AD1DE,AD1RF,AD1RS,AD1RW,AD1FO,AD1NX,AD1SJ,AD1CJ,
+  AD1EM,AD1DF,AD1AP,AD1IN,AD1DE,AD1RF,AD1RS,AD1RW,AD1FO,AD1NX,AD1SJ,AD1CJ,AD1PW,AD1RV,
   //Dynamic array operations
-  ADEMP,ADDEF,ADSET,ADRSZ,ADGET,ADRST,ADIDX,ADREF,ADSIZ,
+  ADEMP,ADDEF,ADSET,ADRSZ,ADGET,ADRST,ADIDX,ADREF,ADSIZ,ADSHR,
   //Array casting
   AF2F,AF2D,AD2F,AD2D,
   //Function calls
   PUSHb,PUSHc,PUSHw,PUSHi,PUSHl,PUSHf,PUSHr,REFPU,LPUb,LPUc,LPUw,LPUi,LPUl,LPUf,LPUr,LPUSr,LPADr,LPAFr,LRPU,LRPUS,LRPAD,LRPAF,CALL,RET,CALLN,RETN,SCALL,LCALL,SULOK,
+  //Generators
+  GNNEW,GNEND,GNRES,GNFRE,YIELD,
   //Char operations
   CUPPR,CLOWR,
   //String operations
-  SEMP,SLEN,SMID,SINDX,SRGHT,SLEFT,SCUTR,SCUTL,SCONC,SMVCO,SMVRC,SFIND,SSUBS,STRIM,SUPPR,SLOWR,SLJUS,SRJUS,SMATC,SLIKE,SREPL,SSPLI,SSTWI,SENWI,SISBO,SISCH,SISSH,SISIN,SISLO,SISFL,
+  SEMP,SLEN,SMID,SINDX,SRGHT,SLEFT,SCUTR,SCUTL,SCONC,SMVCO,SMVRC,SFIND,SSUBS,STRIM,SUPPR,SLOWR,SLJUS,SRJUS,SMATC,SLIKE,SREPL,SSPLI,SSTWI,SENWI,SISBO,SISCH,SISSH,SISIN,SISLO,SISFL,SRESV,SSHRK,SUNSH,
   //Data conversions
   BO2CH,BO2SH,BO2IN,BO2LO,BO2FL,BO2ST,CH2BO,CH2SH,CH2IN,CH2LO,CH2FL,CH2ST,CHFMT,SH2BO,SH2CH,SH2IN,SH2LO,SH2FL,SH2ST,SHFMT,
   IN2BO,IN2CH,IN2SH,IN2LO,IN2FL,IN2ST,INFMT,LO2BO,LO2CH,LO2SH,LO2IN,LO2FL,LO2ST,LOFMT,FL2BO,FL2CH,FL2SH,FL2IN,FL2LO,FL2ST,FLFMT,ST2BO,ST2CH,ST2SH,ST2IN,ST2LO,ST2FL,
@@ -363,7 +380,11 @@ enum class SystemCall:int{
   AbsChr,AbsShr,AbsInt,AbsLon,AbsFlo,MinChr,MinShr,MinInt,MinLon,MinFlo,MaxChr,MaxShr,MaxInt,MaxLon,MaxFlo,
   Exp,Ln,Log,Logn,Pow,Sqrt,Cbrt,Sin,Cos,Tan,Asin,Acos,Atan,Sinh,Cosh,Tanh,Asinh,Acosh,Atanh,Ceil,Floor,Round,Seed,Rand,
   //Date & time
-  DateValid,DateValue,BegOfMonth,EndOfMonth,DatePart,DateAdd,TimeValid,TimeValue,TimePart,TimeAdd,NanoSecAdd,GetDate,GetTime,DateDiff,TimeDiff
+  DateValid,DateValue,BegOfMonth,EndOfMonth,DatePart,DateAdd,TimeValid,TimeValue,TimePart,TimeAdd,NanoSecAdd,GetDate,GetTime,DateDiff,TimeDiff,
+  //Tasks & channels
+  Spawn,Join,ChOpen,ChClose,ChSendStr,ChSendInt,ChSendLon,ChSendFlo,ChSendArr,ChRecvStr,ChRecvInt,ChRecvLon,ChRecvFlo,ChRecvArr,
+  //Asynchronous file I/O
+  ReadAsync,ReadAllAsync,WriteAsync,IoPoll,IoWait,IoWaitData
 };
 
 //Block definition table (for strings and arrays, same way aux mememory manager stores information)
@@ -399,6 +420,70 @@ struct DlCallDef{
   CpuChr DlFunction[_MaxIdLen+1]; //Dynamic library function
 };
 
+//Binary file sections (one entry for each file mark after header, in the same order they are written)
+enum class BinSection:int{
+  Glob=0,    //Global buffer
+  Code,      //Code buffer
+  ArrFixDef, //Fixed array definitions
+  ArrDynDef, //Dynamic array definitions
+  Block,     //Memory blocks
+  DlCall,    //Dynamic library calls
+  Depen,     //Dependencies (libraries only)
+  UndRef,    //Undefined references (libraries only)
+  Reloc,     //Relocation table (libraries only)
+  LnkSymDim, //Linker symbols: dimensions (libraries only)
+  LnkSymTyp, //Linker symbols: data types (libraries only)
+  LnkSymVar, //Linker symbols: variables (libraries only)
+  LnkSymFld, //Linker symbols: fields (libraries only)
+  LnkSymFun, //Linker symbols: functions (libraries only)
+  LnkSymPar, //Linker symbols: parameters (libraries only)
+  DbgSymMod, //Debug symbols: modules
+  DbgSymTyp, //Debug symbols: types
+  DbgSymVar, //Debug symbols: variables
+  DbgSymFld, //Debug symbols: fields
+  DbgSymFun, //Debug symbols: functions
+  DbgSymPar, //Debug symbols: parameters
+  DbgSymLin  //Debug symbols: source code lines
+};
+const int _BinSectionNr=22;
+
+//Binary file section directory entry (section contents start after its file mark, sections not written have zero offset)
+struct BinarySection{
+  CpuLon Offset; //Offset from beginning of file
+  CpuLon Length; //Length in bytes
+};
+
+//Binary file section mark
+inline const char *BinSectionMark(BinSection Section){
+  const char *Mark;
+  switch(Section){
+    case BinSection::Glob     : Mark=FILEMARKGLOB; break;
+    case BinSection::Code     : Mark=FILEMARKCODE; break;
+    case BinSection::ArrFixDef: Mark=FILEMARKFARR; break;
+    case BinSection::ArrDynDef: Mark=FILEMARKDARR; break;
+    case BinSection::Block    : Mark=FILEMARKBLCK; break;
+    case BinSection::DlCall   : Mark=FILEMARKDLCA; break;
+    case BinSection::Depen    : Mark=FILEMARKDEPN; break;
+    case BinSection::UndRef   : Mark=FILEMARKUREF; break;
+    case BinSection::Reloc    : Mark=FILEMARKRELO; break;
+    case BinSection::LnkSymDim: Mark=FILEMARKSDIM; break;
+    case BinSection::LnkSymTyp: Mark=FILEMARKSTYP; break;
+    case BinSection::LnkSymVar: Mark=FILEMARKSVAR; break;
+    case BinSection::LnkSymFld: Mark=FILEMARKSFLD; break;
+    case BinSection::LnkSymFun: Mark=FILEMARKSFUN; break;
+    case BinSection::LnkSymPar: Mark=FILEMARKSPAR; break;
+    case BinSection::DbgSymMod: Mark=FILEMARKDMOD; break;
+    case BinSection::DbgSymTyp: Mark=FILEMARKDTYP; break;
+    case BinSection::DbgSymVar: Mark=FILEMARKDVAR; break;
+    case BinSection::DbgSymFld: Mark=FILEMARKDFLD; break;
+    case BinSection::DbgSymFun: Mark=FILEMARKDFUN; break;
+    case BinSection::DbgSymPar: Mark=FILEMARKDPAR; break;
+    case BinSection::DbgSymLin: Mark=FILEMARKDLIN; break;
+    default: Mark=""; break;
+  }
+  return Mark;
+}
+
 //Binary file header (Same for libraries and executables)
 #ifdef __DUNS32__
   #define BIN_HEADER_FILLER 8
@@ -445,6 +530,7 @@ struct BinaryHeader{
   CpuInt DbgSymLinNr;                //Records in Source code lines debug symbol table
   CpuAdr SuperInitAdr;               //Address of super initialization routine
   char Filler[BIN_HEADER_FILLER];    //Filler to have same size of header in 32 / 64 bit modes
+  BinarySection Section[_BinSectionNr]; //Section directory (offset and length of each file section)
   BinaryHeader(){};
 };
 
@@ -527,6 +613,22 @@ struct RomFileBuffer{
   CpuShr End;
 };
 
+//Runtime server protocol (dunr -serve and dunq client)
+//(request is followed by argument block with arguments separated by null chars, client standard input, output and
+//error descriptors travel with request as ancillary data, so program output goes directly to client)
+#define SERVE_REQUEST_MARK "DSRQ"
+#define SERVE_REPLY_MARK   "DSRP"
+#define SERVE_MAX_ARGLEN   1048576
+struct ServeRequest{
+  char FileMark[4]; //Request mark
+  CpuInt ArgNr;     //Number of arguments
+  CpuInt ArgLength; //Length of argument block
+};
+struct ServeReply{
+  char FileMark[4]; //Reply mark
+  CpuInt Result;    //Program result (0=Success, 1=Failure)
+};
+
 //Clock types
 typedef std::chrono::time_point<std::chrono::steady_clock> ClockPoint;
 typedef std::chrono::duration<double,std::nano> ClockSpanNSec;
@@ -678,6 +780,13 @@ inline String BuildNumber(const String& AppId){
   +(IsProfilerMode()?"P":"")+(IsSanitizerMode()?"S":"")+(IsPerformanceToolMode()?"F":"")+(IsRuntimeExpandedMode()?"E":"")+(IsCoverageMode()?"C":"")+(IsNoOptimizationMode()?"N":"");
 }
 
+//Code buffer hash (FNV-1a 64 bits, used to match translated code against executable)
+inline CpuLon CodeHash(const char *Pnt,CpuWrd Length){
+  uint64_t Hash=0xCBF29CE484222325ULL;
+  for(CpuWrd i=0;i<Length;i++){ Hash^=(unsigned char)Pnt[i]; Hash*=0x100000001B3ULL; }
+  return (CpuLon)Hash;
+}
+
 //CPU Decoder mode name
 inline String CpuDecModeName(CpuDecMode Mode){
   String Result;
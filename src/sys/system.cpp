@@ -9,9 +9,10 @@
 #include "sys/system.hpp"
 
 //Define static variables
-Stack<int> System::_GlobalProcessId;
-bool System::_ExceptionFlag;
-Array<SysExceptionRecord> System::_ExceptionTable;
+thread_local Stack<int> System::_GlobalProcessId;
+thread_local bool System::_ExceptionFlag;
+thread_local Array<SysExceptionRecord> System::_ExceptionTable;
+std::atomic<int> System::_NextProcessId(1);
 std::ofstream DebugMessages::_Log;
 bool DebugMessages::_ToConsole;
 int64_t _DebugLevels;
@@ -232,6 +233,7 @@ const InstTable _Inst[_InstructionNr]={
 { "AF1NX",2, ISIZ_IGA  , {CpuDataType::ArrGeom  ,CpuDataType::JumpAddr ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdLtVl,_AmdLtVl,_AmdNull,_AmdNull}, {AOFF_I,AOFF_IG,0       ,0        } }, //Increases array for loop pointer then jumps to loop beginning
 { "AF1SJ",4, ISIZ_IAAGA, {CpuDataType::StrBlk   ,CpuDataType::Undefined,CpuDataType::ArrGeom  ,CpuDataType::StrBlk   }, {_AmdAddr,_AmdAddr,_AmdLtVl,_AmdAddr}, {AOFF_I,AOFF_IA,AOFF_IAA,AOFF_IAAG} }, //Join string array
 { "AF1CJ",4, ISIZ_IAAGA, {CpuDataType::StrBlk   ,CpuDataType::Undefined,CpuDataType::ArrGeom  ,CpuDataType::StrBlk   }, {_AmdAddr,_AmdAddr,_AmdLtVl,_AmdAddr}, {AOFF_I,AOFF_IA,AOFF_IAA,AOFF_IAAG} }, //Join char array
+{ "AF1PW",3, ISIZ_IGAA , {CpuDataType::ArrGeom  ,CpuDataType::VarAddr  ,CpuDataType::JumpAddr ,(CpuDataType)0        }, {_AmdLtVl,_AmdLtVl,_AmdLtVl,_AmdNull}, {AOFF_I,AOFF_IG,AOFF_IGA,0        } }, //Rewinds array loop like AF1RW and splits loop among worker threads (parallel walk)
 { "AFDEF",3, ISIZ_IGCZ , {CpuDataType::ArrGeom  ,CpuDataType::Char     ,(CpuDataType)-1       ,(CpuDataType)0        }, {_AmdLtVl,_AmdLtVl,_AmdLtVl,_AmdNull}, {AOFF_I,AOFF_IG,AOFF_IGC,0        } }, //Set array dimensions and cell size
 { "AFSSZ",3, ISIZ_IGAA , {CpuDataType::ArrGeom  ,CpuDataType::Char     ,(CpuDataType)-1       ,(CpuDataType)0        }, {_AmdLtVl,_AmdAddr,_AmdAddr,_AmdNull}, {AOFF_I,AOFF_IG,AOFF_IGA,0        } }, //Set array dimension size
 { "AFGET",3, ISIZ_IGAA , {CpuDataType::ArrGeom  ,CpuDataType::Char     ,(CpuDataType)-1       ,(CpuDataType)0        }, {_AmdLtVl,_AmdAddr,_AmdAddr,_AmdNull}, {AOFF_I,AOFF_IG,AOFF_IGA,0        } }, //Get array dimension size
@@ -249,6 +251,8 @@ const InstTable _Inst[_InstructionNr]={
 { "AD1NX",2, ISIZ_IAA  , {CpuDataType::ArrBlk   ,CpuDataType::JumpAddr ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdLtVl,_AmdNull,_AmdNull}, {AOFF_I,AOFF_IA,0       ,0        } }, //Increases array for loop pointer then jumps to loop beginning
 { "AD1SJ",3, ISIZ_IAAA , {CpuDataType::StrBlk   ,CpuDataType::ArrBlk   ,CpuDataType::StrBlk   ,(CpuDataType)0        }, {_AmdAddr,_AmdAddr,_AmdAddr,_AmdNull}, {AOFF_I,AOFF_IA,AOFF_IAA,0        } }, //Join string array
 { "AD1CJ",3, ISIZ_IAAA , {CpuDataType::StrBlk   ,CpuDataType::ArrBlk   ,CpuDataType::StrBlk   ,(CpuDataType)0        }, {_AmdAddr,_AmdAddr,_AmdAddr,_AmdNull}, {AOFF_I,AOFF_IA,AOFF_IAA,0        } }, //Join char array
+{ "AD1PW",3, ISIZ_IAAA , {CpuDataType::ArrBlk   ,CpuDataType::VarAddr  ,CpuDataType::JumpAddr ,(CpuDataType)0        }, {_AmdAddr,_AmdLtVl,_AmdLtVl,_AmdNull}, {AOFF_I,AOFF_IA,AOFF_IAA,0        } }, //Rewinds array loop like AD1RW and splits loop among worker threads (parallel walk)
+{ "AD1RV",3, ISIZ_IAAZ , {CpuDataType::ArrBlk   ,(CpuDataType)-1       ,(CpuDataType)-1       ,(CpuDataType)0        }, {_AmdAddr,_AmdAddr,_AmdLtVl,_AmdNull}, {AOFF_I,AOFF_IA,AOFF_IAA,0        } }, //Reserves memory for given number of elements without changing array size
 { "ADEMP",3, ISIZ_IACZ , {CpuDataType::ArrBlk   ,CpuDataType::Char     ,(CpuDataType)-1       ,(CpuDataType)0        }, {_AmdAddr,_AmdLtVl,_AmdLtVl,_AmdNull}, {AOFF_I,AOFF_IA,AOFF_IAC,0        } }, //Define empty array
 { "ADDEF",3, ISIZ_IACZ , {CpuDataType::ArrBlk   ,CpuDataType::Char     ,(CpuDataType)-1       ,(CpuDataType)0        }, {_AmdAddr,_AmdLtVl,_AmdLtVl,_AmdNull}, {AOFF_I,AOFF_IA,AOFF_IAC,0        } }, //Set array dimensions and cell size
 { "ADSET",3, ISIZ_IACA , {CpuDataType::ArrBlk   ,CpuDataType::Char     ,(CpuDataType)-1       ,(CpuDataType)0        }, {_AmdAddr,_AmdLtVl,_AmdAddr,_AmdNull}, {AOFF_I,AOFF_IA,AOFF_IAC,0        } }, //Set array dimension size
@@ -258,6 +262,7 @@ const InstTable _Inst[_InstructionNr]={
 { "ADIDX",3, ISIZ_IACA , {CpuDataType::ArrBlk   ,CpuDataType::Char     ,(CpuDataType)-1       ,(CpuDataType)0        }, {_AmdAddr,_AmdLtVl,_AmdAddr,_AmdNull}, {AOFF_I,AOFF_IA,AOFF_IAC,0        } }, //Set array dimension index
 { "ADREF",2, ISIZ_IAA  , {CpuDataType::Undefined,CpuDataType::ArrBlk   ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdAddr,_AmdNull,_AmdNull}, {AOFF_I,AOFF_IA,0       ,0        } }, //Create reference to array element (uses indexes set with AIDX)
 { "ADSIZ",2, ISIZ_IAA  , {CpuDataType::ArrBlk   ,(CpuDataType)-1       ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdAddr,_AmdNull,_AmdNull}, {AOFF_I,AOFF_IA,0       ,0        } }, //Calculate array size
+{ "ADSHR",1, ISIZ_IA   , {CpuDataType::ArrBlk   ,(CpuDataType)0        ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdNull,_AmdNull,_AmdNull}, {AOFF_I,0      ,0       ,0        } }, //Releases memory reserved beyond array size
 { "AF2F" ,4, ISIZ_IAGAG, {CpuDataType::Undefined,CpuDataType::ArrGeom  ,CpuDataType::Undefined,CpuDataType::ArrGeom  }, {_AmdAddr,_AmdLtVl,_AmdAddr,_AmdLtVl}, {AOFF_I,AOFF_IA,AOFF_IAG,AOFF_IAGA} }, //Cast fixed array to fixed
 { "AF2D" ,3, ISIZ_IAAG , {CpuDataType::ArrBlk   ,CpuDataType::Undefined,CpuDataType::ArrGeom  ,(CpuDataType)0        }, {_AmdAddr,_AmdAddr,_AmdLtVl,_AmdNull}, {AOFF_I,AOFF_IA,AOFF_IAA,0        } }, //Cast fixed array to dynamic
 { "AD2F" ,3, ISIZ_IAGA , {CpuDataType::Undefined,CpuDataType::ArrGeom  ,CpuDataType::ArrBlk   ,(CpuDataType)0        }, {_AmdAddr,_AmdLtVl,_AmdAddr,_AmdNull}, {AOFF_I,AOFF_IA,AOFF_IAG,0        } }, //Cast dynamic array to fixed
@@ -291,6 +296,11 @@ const InstTable _Inst[_InstructionNr]={
 { "SCALL",1, ISIZ_II   , {CpuDataType::Integer  ,(CpuDataType)0        ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdLtVl,_AmdNull,_AmdNull,_AmdNull}, {AOFF_I,0      ,0       ,0        } }, //System call
 { "LCALL",1, ISIZ_II   , {CpuDataType::Integer  ,(CpuDataType)0        ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdLtVl,_AmdNull,_AmdNull,_AmdNull}, {AOFF_I,0      ,0       ,0        } }, //Dynamic library call
 { "SULOK",0, ISIZ_I    , {(CpuDataType)0        ,(CpuDataType)0        ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdNull,_AmdNull,_AmdNull,_AmdNull}, {0     ,0      ,0       ,0        } }, //Allows changes in machine scope state
+{ "GNNEW",1, ISIZ_IA   , {(CpuDataType)-1       ,(CpuDataType)0        ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdNull,_AmdNull,_AmdNull}, {AOFF_I,0      ,0       ,0        } }, //Creates generator for next function call and returns its handler
+{ "GNEND",2, ISIZ_IAA  , {(CpuDataType)-1       ,CpuDataType::JumpAddr ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdLtVl,_AmdNull,_AmdNull}, {AOFF_I,AOFF_IA,0       ,0        } }, //Jumps if generator returned instead of yielding a value
+{ "GNRES",1, ISIZ_IA   , {(CpuDataType)-1       ,(CpuDataType)0        ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdNull,_AmdNull,_AmdNull}, {AOFF_I,0      ,0       ,0        } }, //Resumes generator until it yields next value
+{ "GNFRE",1, ISIZ_IA   , {(CpuDataType)-1       ,(CpuDataType)0        ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdNull,_AmdNull,_AmdNull}, {AOFF_I,0      ,0       ,0        } }, //Frees generator and all generators created after it
+{ "YIELD",0, ISIZ_I    , {(CpuDataType)0        ,(CpuDataType)0        ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdNull,_AmdNull,_AmdNull,_AmdNull}, {0     ,0      ,0       ,0        } }, //Suspends generator and returns to the instruction that resumed it
 { "CUPPR",2, ISIZ_IAA  , {CpuDataType::Char     ,CpuDataType::Char     ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdAddr,_AmdNull,_AmdNull}, {AOFF_I,AOFF_IA,0       ,0        } }, //char .upper()
 { "CLOWR",2, ISIZ_IAA  , {CpuDataType::Char     ,CpuDataType::Char     ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdAddr,_AmdNull,_AmdNull}, {AOFF_I,AOFF_IA,0       ,0        } }, //char .lower()
 { "SEMP" ,1, ISIZ_IA   , {CpuDataType::StrBlk   ,(CpuDataType)0        ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdNull,_AmdNull,_AmdNull}, {AOFF_I,0      ,0       ,0        } }, //Creates empty string
@@ -323,6 +333,9 @@ const InstTable _Inst[_InstructionNr]={
 { "SISIN",2, ISIZ_IAA  , {CpuDataType::Boolean  ,CpuDataType::StrBlk   ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdAddr,_AmdNull,_AmdNull}, {AOFF_I,AOFF_IA,0       ,0        } }, //bool .isint()
 { "SISLO",2, ISIZ_IAA  , {CpuDataType::Boolean  ,CpuDataType::StrBlk   ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdAddr,_AmdNull,_AmdNull}, {AOFF_I,AOFF_IA,0       ,0        } }, //bool .islong()
 { "SISFL",2, ISIZ_IAA  , {CpuDataType::Boolean  ,CpuDataType::StrBlk   ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdAddr,_AmdNull,_AmdNull}, {AOFF_I,AOFF_IA,0       ,0        } }, //bool .isfloat()
+{ "SRESV",2, ISIZ_IAA  , {CpuDataType::StrBlk   ,(CpuDataType)-1       ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdAddr,_AmdNull,_AmdNull}, {AOFF_I,AOFF_IA,0       ,0        } }, //string .reserve(word length)
+{ "SSHRK",1, ISIZ_IA   , {CpuDataType::StrBlk   ,(CpuDataType)0        ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdNull,_AmdNull,_AmdNull}, {AOFF_I,0      ,0       ,0        } }, //string .shrink()
+{ "SUNSH",1, ISIZ_IA   , {CpuDataType::Undefined,(CpuDataType)0        ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdNull,_AmdNull,_AmdNull}, {AOFF_I,0      ,0       ,0        } }, //string detach before writing through char reference
 { "BO2CH",2, ISIZ_IAA  , {CpuDataType::Char     ,CpuDataType::Boolean  ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdAddr,_AmdNull,_AmdNull}, {AOFF_I,AOFF_IA,0       ,0        } }, //char .tochar()
 { "BO2SH",2, ISIZ_IAA  , {CpuDataType::Short    ,CpuDataType::Boolean  ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdAddr,_AmdNull,_AmdNull}, {AOFF_I,AOFF_IA,0       ,0        } }, //short .toshort()
 { "BO2IN",2, ISIZ_IAA  , {CpuDataType::Integer  ,CpuDataType::Boolean  ,(CpuDataType)0        ,(CpuDataType)0        }, {_AmdAddr,_AmdAddr,_AmdNull,_AmdNull}, {AOFF_I,AOFF_IA,0       ,0        } }, //int .toint()
@@ -395,7 +408,7 @@ struct SysExceptionMessage{
 };
 
 //Exception message table
-const int _MsgNr=81;
+const int _MsgNr=88;
 const SysExceptionMessage _Msg[_MsgNr]={
   {SysExceptionCode::RuntimeBaseException             , "%p"},
   {SysExceptionCode::SystemPanic                      , "%p"},
@@ -442,7 +455,7 @@ const SysExceptionMessage _Msg[_MsgNr]={
   {SysExceptionCode::ArrayIndexAllocationFailure      , "Memory allocation error when allocating new array dimension index record"},
   {SysExceptionCode::ArrayBlockAllocationFailure      , "Memory allocation error when reallocating array block"},
   {SysExceptionCode::CallStackUnderflow               , "Call stack underflow"},
-  {SysExceptionCode::StackOverflow                    , "Stack oveflow when allocating %p bytes"},
+  {SysExceptionCode::StackOverflow                    , "Stack overflow when allocating %p bytes"},
   {SysExceptionCode::StackUnderflow                   , "Stack underflow"},
   {SysExceptionCode::InvalidArrayDimension            , "Attempt to operate with invalid array dimension (block:%p, dimension:%p)"},
   {SysExceptionCode::InvalidDimensionSize             , "Cannot resize array dimension to negative value"},
@@ -476,7 +489,14 @@ const SysExceptionMessage _Msg[_MsgNr]={
   {SysExceptionCode::FdStatusError                    , "File descriptor returned error status on %p"},
   {SysExceptionCode::ReadError                        , "Read error on %p "},
   {SysExceptionCode::InvalidDate                      , "Invalid date value (%p.%p.%p)"},
-  {SysExceptionCode::InvalidTime                      , "Invalid time value (%p:%p:%p.%p)"}
+  {SysExceptionCode::InvalidTime                      , "Invalid time value (%p:%p:%p.%p)"},
+  {SysExceptionCode::StackReservationFailure          , "Unable to reserve %p bytes of virtual memory for stack"},
+  {SysExceptionCode::StackGuardPageHit                , "Stack overflow, access to stack guard page beyond reserved %p bytes"},
+  {SysExceptionCode::GeneratorMaxNestingReached       , "Maximun number of live generators reached (%p)"},
+  {SysExceptionCode::InvalidGeneratorHandler          , "Invalid generator handler (%p)"},
+  {SysExceptionCode::YieldOutsideGenerator            , "Yield executed outside of generator function"},
+  {SysExceptionCode::SnapshotSaveFailure              , "Unable to save process snapshot on file %p (%p)"},
+  {SysExceptionCode::ServeInitFailure                 , "Runtime server unable to keep process state after initialization routines (%p)"}
 };
 
 //Debug level configuration table
@@ -567,6 +587,11 @@ int System::CurrentProcessId(){
   return _GlobalProcessId.Top();
 }
 
+//Get new process id (process ids are unique among all threads, zero is the system process)
+int System::NewProcessId(){
+  return _NextProcessId.fetch_add(1);
+}
+
 //Count
 long System::ExceptionCount(){
   return _ExceptionTable.Length();
@@ -589,6 +614,12 @@ bool System::ExceptionRead(int Index,SysExceptionRecord& Excp){
   }
 }
 
+//Append exception raised on another thread
+void System::ExceptionAppend(const SysExceptionRecord& Excp){
+  _ExceptionTable.Add(Excp);
+  _ExceptionFlag=true;
+}
+
 //Throw
 void System::Throw(SysExceptionCode Code,const String& Parm1,const String& Parm2,const String& Parm3,const String& Parm4,const String& Parm5){
   SysExceptionRecord Excp;
@@ -708,6 +739,13 @@ String System::ExceptionName(SysExceptionCode Code){
     case SysExceptionCode::ReadError                        : Name="ReadError";                        break;
     case SysExceptionCode::InvalidDate                      : Name="InvalidDate";                      break;
     case SysExceptionCode::InvalidTime                      : Name="InvalidTime";                      break;
+    case SysExceptionCode::StackReservationFailure          : Name="StackReservationFailure";          break;
+    case SysExceptionCode::StackGuardPageHit                : Name="StackGuardPageHit";                break;
+    case SysExceptionCode::GeneratorMaxNestingReached       : Name="GeneratorMaxNestingReached";       break;
+    case SysExceptionCode::InvalidGeneratorHandler          : Name="InvalidGeneratorHandler";          break;
+    case SysExceptionCode::YieldOutsideGenerator            : Name="YieldOutsideGenerator";            break;
+    case SysExceptionCode::SnapshotSaveFailure              : Name="SnapshotSaveFailure";              break;
+    case SysExceptionCode::ServeInitFailure                 : Name="ServeInitFailure";                 break;
   }
   return Name;
 }
@@ -104,7 +104,14 @@ enum class SysExceptionCode:int{
   FdStatusError,
   ReadError,
   InvalidDate,
-  InvalidTime
+  InvalidTime,
+  StackReservationFailure,
+  StackGuardPageHit,
+  GeneratorMaxNestingReached,
+  InvalidGeneratorHandler,
+  YieldOutsideGenerator,
+  SnapshotSaveFailure,
+  ServeInitFailure
 };
 
 //Exception record
@@ -128,9 +135,11 @@ class System{
   private:
 
     //Private fields
-    static Stack<int> _GlobalProcessId;
-    static Array<SysExceptionRecord> _ExceptionTable;
-    static bool _ExceptionFlag;
+    //(they are per thread, as each scheduler worker thread runs its own process)
+    static thread_local Stack<int> _GlobalProcessId;
+    static thread_local Array<SysExceptionRecord> _ExceptionTable;
+    static thread_local bool _ExceptionFlag;
+    static std::atomic<int> _NextProcessId;
 
     //Constructor
     System();
@@ -142,10 +151,12 @@ class System{
     static void PushProcessId(int ProcessId);
     static void PopProcessId();
     static int CurrentProcessId();
+    static int NewProcessId();
     static long ExceptionCount();
     inline static bool ExceptionFlag(){ return _ExceptionFlag; }
     static void ExceptionReset();
     static bool ExceptionRead(int Index,SysExceptionRecord& Excp);
+    static void ExceptionAppend(const SysExceptionRecord& Excp);
     static void Throw(SysExceptionCode Code,const String& Parm1="",const String& Parm2="",const String& Parm3="",const String& Parm4="",const String& Parm5="");
     static void ExceptionPrint();
 
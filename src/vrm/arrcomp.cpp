@@ -21,13 +21,13 @@ enum class StaOperation{
   Write=2
 };
 
-//Internal global variables
-CpuMbl _StaArrBlock=-1;
-StaOperation _StaOpr=(StaOperation)0;
-int _StaArrIndex=-1;
-CpuWrd _StaLines=0;
-CpuWrd _StaWrittenLines=0;
-CpuWrd _StaReservedLines=0;
+//Internal global variables (one copy for each thread that runs a process)
+thread_local CpuMbl _StaArrBlock=-1;
+thread_local StaOperation _StaOpr=(StaOperation)0;
+thread_local int _StaArrIndex=-1;
+thread_local CpuWrd _StaLines=0;
+thread_local CpuWrd _StaWrittenLines=0;
+thread_local CpuWrd _StaReservedLines=0;
 const CpuWrd _StaChunkLines=512;
 
 //Internal funtion prototypes
@@ -526,7 +526,7 @@ int ArrayComputer::_DynNewArrIndex(){
   int i;
   int ArrIndex=-1;
   for(i=0;i<_ArrMeta.Length();i++){
-    if(!_ArrMeta[i].Used || _ArrMeta[i].ScopeId>_ScopeId || (_ArrMeta[i].ScopeId==_ScopeId && _ArrMeta[i].ScopeNr!=_ScopeNr)){ ArrIndex=i; break; }
+    if(!_ArrMeta[i].Used || ((_ArrMeta[i].ScopeId>_ScopeId || (_ArrMeta[i].ScopeId==_ScopeId && _ArrMeta[i].ScopeNr!=_ScopeNr)) && !_Aux->IsLiveGen(_ArrMeta[i].ScopeNr))){ ArrIndex=i; break; }
   }
   if(ArrIndex==-1){
     if(!_ArrMeta.Push((ArrayMeta){_ScopeId,_ScopeNr,true,0,0,{0},{0},{0}})){ return -1; }
@@ -716,6 +716,7 @@ bool ArrayComputer::_DynCheckAsDestin(CpuMbl *ArrBlock,CpuWrd InitSize,int *ArrI
       System::Throw(SysExceptionCode::ArrayBlockAllocationFailure);
       return false;
     }
+    _Aux->SetHolder(*ArrBlock,ArrBlock);
   }
 
   //When array block is not zero: Check validity and get ArrIndex
@@ -987,6 +988,31 @@ bool ArrayComputer::AD1DE(CpuMbl ArrBlock,CpuWrd DimValue){
 
 }
 
+//Reserve memory for 1-dimensional array without changing its size
+bool ArrayComputer::AD1RV(CpuMbl ArrBlock,CpuWrd Elements,CpuWrd CellSize){
+  
+  //Variables
+  int ArrIndex;
+  
+  //Check array as source
+  if(!_DynCheckAsSource(ArrBlock,&ArrIndex)){ return false; }
+
+  //Set cell size
+  _ArrMeta[ArrIndex].CellSize=CellSize;
+
+  //Raise array block capacity (appends do not reallocate until reserved elements are used)
+  if(Elements>0){
+    if(!_Aux->Reserve(_ScopeId,_ScopeNr,ArrBlock,Elements*CellSize)){
+      System::Throw(SysExceptionCode::ArrayBlockAllocationFailure);
+      return false;
+    }
+  }
+
+  //Return code
+  return true;
+
+}
+
 //Offset calculation for 1-dimensional array
 bool ArrayComputer::AD1OF(CpuMbl ArrBlock,CpuWrd DimValue,CpuWrd *Offset){
   
@@ -1395,6 +1421,26 @@ bool ArrayComputer::ADRST(CpuMbl *ArrBlock){
 
 }
 
+//Release array memory reserved beyond array size
+bool ArrayComputer::ADSHR(CpuMbl ArrBlock){
+  
+  //Variables
+  int ArrIndex;
+  
+  //Check array as source
+  if(!_DynCheckAsSource(ArrBlock,&ArrIndex)){ return false; }
+
+  //Lower array block capacity to array size
+  if(!_Aux->Shrink(_ScopeId,_ScopeNr,ArrBlock)){
+    System::Throw(SysExceptionCode::ArrayBlockAllocationFailure);
+    return false;
+  }
+
+  //Return code
+  return true;
+
+}
+
 //Set dimension index value
 bool ArrayComputer::ADIDX(CpuMbl ArrBlock,int DimIndex,CpuWrd DimValue){
   
@@ -1542,7 +1588,14 @@ bool ArrayComputer::SSPL(CpuMbl *Arr,CpuMbl Str,CpuMbl Sep){
   _ArrMeta[ArrIndex].CellSize=sizeof(CpuMbl);
   _ArrMeta[ArrIndex].DimSize.n[0]=Splits.Length();
 
-  //Copy string splits
+  //Copy string splits (source string must not be inline as allocation of splits can move handler table)
+  if(!_Aux->Pin(_ScopeId,_ScopeNr,Str)){
+    _Aux->Free(*Arr);
+    _DynFreeArrIndex(ArrIndex);
+    *Arr=0;
+    System::Throw(SysExceptionCode::StringAllocationError,ToString(_Aux->GetLen(Str))); 
+    return false; 
+  }
   for(i=0;i<Splits.Length();i++){
     *(CpuMbl *)&_Aux->CharPtr(*Arr)[i*sizeof(CpuMbl)]=0;
     if(!_StC->SCOPY((CpuMbl *)&_Aux->CharPtr(*Arr)[i*sizeof(CpuMbl)],(char *)&_Aux->CharPtr(Str)[Splits[i].Pos],Splits[i].Len)){ 
@@ -2296,7 +2349,7 @@ bool ArrayComputer::STAWRL(CpuMbl StrBlock){
       return false;
     }
   }
-  if(!_StC->SCOPY(&((CpuMbl *)_Aux->CharPtr(_StaArrBlock))[_StaWrittenLines-1],_Aux->CharPtr(StrBlock),_Aux->GetLen(StrBlock))){ return false; }
+  if(!_StC->SCOPY(&((CpuMbl *)_Aux->CharPtr(_StaArrBlock))[_StaWrittenLines-1],StrBlock)){ return false; }
   _ArrMeta[_StaArrIndex].DimSize.n[0]=_StaWrittenLines;
   DebugMessage(DebugLevel::VrmRuntime,"STA: Write line from string block (arrblock="+HEXFORMAT(_StaArrBlock)+")");
   return true;
@@ -2361,6 +2414,95 @@ bool ArrayComputer::STACLO(){
 
 }
 
+//string[] array interface: STAGET - Copy whole array into string list
+bool ArrayComputer::STAGET(CpuMbl ArrBlock,Array<String>& Lines){
+  
+  //Variables
+  CpuWrd LineNr;
+  CpuMbl LineBlock;
+
+  //Read loop
+  Lines.Reset();
+  if(!STAOPR(ArrBlock,&LineNr)){ return false; }
+  for(CpuWrd i=0;i<LineNr;i++){
+    if(!STARDL(i,&LineBlock)){ return false; }
+    if(!_Aux->IsValid(LineBlock)){
+      System::Throw(SysExceptionCode::InvalidStringBlock,ToString(LineBlock)); 
+      return false; 
+    }
+    Lines.Add(LineBlock!=0?String(_Aux->CharPtr(LineBlock)):String(""));
+  }
+  if(!STACLO()){ return false; }
+
+  //Return code
+  return true;
+
+}
+
+//string[] array interface: STASET - Replace whole array with string list
+bool ArrayComputer::STASET(CpuMbl *ArrBlock,const Array<String>& Lines){
+  if(!STAOPW(ArrBlock)){ return false; }
+  for(int i=0;i<Lines.Length();i++){
+    if(!STAWRL(Lines[i])){ return false; }
+  }
+  if(!STACLO()){ return false; }
+  return true;
+}
+
+//char[] array interface: CHAPNT - Get pointer to array data checking it has at least given length
+bool ArrayComputer::CHAPNT(CpuMbl ArrBlock,CpuLon Length,char **Pnt){
+
+  //Variables
+  int ArrIndex;
+
+  //Check array as source
+  if(!_DynCheckAsSource(ArrBlock,&ArrIndex)){ return false; }
+  
+  //Check length of provided array is not overflowed
+  if(Length>_ArrMeta[ArrIndex].DimSize.n[0]){
+    System::Throw(SysExceptionCode::WriteCharArrayIncorrectLength,ToString(_ArrMeta[ArrIndex].DimSize.n[0]),ToString(Length));
+    return false;
+  }
+
+  //Return pointer
+  *Pnt=_Aux->CharPtr(ArrBlock);
+  return true;
+
+}
+
+//char[] array interface: CHASET - Replace whole array with buffer contents
+bool ArrayComputer::CHASET(CpuMbl *ArrBlock,const Buffer& Buff){
+
+  //Variables
+  int ArrIndex;
+
+  //Check provided array as destination
+  if(!_DynCheckAsDestin(ArrBlock,0,&ArrIndex)){ return false; }
+  
+  //Initialize array metadata
+  _ArrMeta[ArrIndex].DimNr=1;
+  _ArrMeta[ArrIndex].CellSize=sizeof(CpuChr);
+  _ArrMeta[ArrIndex].DimSize.n[0]=0;
+  if(Buff.Length()==0){ return true; }
+
+  //Allocate array memory
+  if(!_Aux->Realloc(_ScopeId,_ScopeNr,*ArrBlock,Buff.Length())){
+    _DynFreeArrIndex(ArrIndex);
+    _Aux->Free(*ArrBlock);
+    (*ArrBlock)=0;
+    System::Throw(SysExceptionCode::ArrayBlockAllocationFailure);
+    return false;
+  }
+  
+  //Copy data
+  MemCpy(_Aux->CharPtr(*ArrBlock),Buff.BuffPnt(),Buff.Length());
+  _ArrMeta[ArrIndex].DimSize.n[0]=Buff.Length();
+
+  //Return code
+  return true;
+
+}
+
 //Return command line arguments as string[]
 bool ArrayComputer::GETARG(CpuMbl *Arr,int ArgNr,char *Arg[],int ArgStart){
 
@@ -2413,3 +2555,84 @@ bool ArrayComputer::GETARG(CpuMbl *Arr,int ArgNr,char *Arg[],int ArgStart){
 
 }
 
+//Check array holds command line arguments (1-dim string array with same strings)
+bool ArrayComputer::ISARG(CpuMbl Arr,int ArgNr,char *Arg[],int ArgStart){
+  
+  //Variables
+  int i;
+  int ArrIndex;
+  CpuMbl StrBlock;
+
+  //Check array geometry
+  if(!_Aux->IsValid(Arr) || (ArrIndex=_Aux->GetArrIndex(Arr))<0 || ArrIndex>=_ArrMeta.Length()){ return false; }
+  if(_ArrMeta[ArrIndex].DimNr!=1 || _ArrMeta[ArrIndex].CellSize!=sizeof(CpuMbl) || _ArrMeta[ArrIndex].DimSize.n[0]!=ArgNr-ArgStart){ return false; }
+
+  //Compare strings
+  for(i=ArgStart;i<ArgNr;i++){
+    StrBlock=((CpuMbl *)_Aux->CharPtr(Arr))[i-ArgStart];
+    if(!_Aux->IsValid(StrBlock) || strcmp(_Aux->CharPtr(StrBlock),Arg[i])!=0){ return false; }
+  }
+
+  //Return code
+  return true;
+
+}
+
+//Replace contents of command line arguments array (array keeps its block number)
+bool ArrayComputer::SETARG(CpuMbl Arr,int ArgNr,char *Arg[],int ArgStart){
+  
+  //Variables
+  CpuWrd i;
+  CpuWrd Elements;
+  CpuMbl *StrBlock;
+
+  //Release strings (slots are cleared so that they are not taken as destination strings when array is filled again)
+  Elements=_DynGetElements(_Aux->GetArrIndex(Arr));
+  StrBlock=(CpuMbl *)_Aux->CharPtr(Arr);
+  for(i=0;i<Elements;i++){
+    if(StrBlock[i]!=0 && _Aux->IsValid(StrBlock[i])){ _Aux->Free(StrBlock[i]); }
+    StrBlock[i]=0;
+  }
+
+  //Fill array again
+  return GETARG(&Arr,ArgNr,Arg,ArgStart);
+
+}
+
+//Save array geometries and metadata (process snapshot)
+void ArrayComputer::SaveState(Buffer& State){
+  CpuLon GeomNr=_ArrGeom.Length();
+  CpuLon MetaNr=_ArrMeta.Length();
+  State.Append((const char *)&GeomNr,sizeof(CpuLon));
+  State.Append((const char *)&MetaNr,sizeof(CpuLon));
+  if(GeomNr!=0){ State.Append((const char *)_ArrGeom.Pnt(),GeomNr*sizeof(ArrayGeometry)); }
+  if(MetaNr!=0){ State.Append((const char *)_ArrMeta.Pnt(),MetaNr*sizeof(ArrayMeta)); }
+}
+
+//Load array geometries and metadata (process snapshot)
+bool ArrayComputer::LoadState(const char *State,CpuWrd Length,CpuWrd& Offset,String& Error){
+  
+  //Variables
+  CpuLon GeomNr;
+  CpuLon MetaNr;
+
+  //Table sizes
+  if(Offset+(CpuWrd)(2*sizeof(CpuLon))>Length){ Error="truncated array tables"; return false; }
+  MemCpy((char *)&GeomNr,State+Offset,sizeof(CpuLon));
+  MemCpy((char *)&MetaNr,State+Offset+sizeof(CpuLon),sizeof(CpuLon));
+  Offset+=2*sizeof(CpuLon);
+  if(GeomNr<0 || MetaNr<0 || Offset+(CpuWrd)(GeomNr*sizeof(ArrayGeometry)+MetaNr*sizeof(ArrayMeta))>Length){ Error="truncated array tables"; return false; }
+
+  //Replace tables
+  _ArrGeom.Empty();
+  _ArrMeta.Empty();
+  if(GeomNr!=0 && !_ArrGeom.Append((const ArrayGeometry *)(State+Offset),GeomNr)){ Error="unable to allocate array geometries"; return false; }
+  Offset+=GeomNr*sizeof(ArrayGeometry);
+  if(MetaNr!=0 && !_ArrMeta.Append((const ArrayMeta *)(State+Offset),MetaNr)){ Error="unable to allocate array metadata"; return false; }
+  Offset+=MetaNr*sizeof(ArrayMeta);
+
+  //Return code
+  return true;
+
+}
+
@@ -115,6 +115,7 @@ class ArrayComputer{
     bool AD1NX(CpuMbl ArrBlock,CpuAdr *IndexVarAddr,CpuDecMode *IndexVarMode);
     bool AD1SJ(CpuMbl *Str,CpuMbl ArrBlock,CpuMbl Sep);
     bool AD1CJ(CpuMbl *Str,CpuMbl ArrBlock,CpuMbl Sep);
+    bool AD1RV(CpuMbl ArrBlock,CpuWrd Elements,CpuWrd CellSize);
 
     //Dyn array instructions
     bool ACOPY(CpuMbl *Destin,CpuMbl Source);
@@ -127,6 +128,7 @@ class ArrayComputer{
     bool ADIDX(CpuMbl ArrBlock,int DimIndex,CpuWrd DimValue);
     bool ADOFN(CpuMbl ArrBlock,CpuWrd *Offset);
     bool ADSIZ(CpuMbl ArrBlock,CpuWrd *Size);
+    bool ADSHR(CpuMbl ArrBlock);
     bool SSPL(CpuMbl *ArrBlock,CpuMbl Str,CpuMbl Sep);
     bool ADVCP(CpuMbl *ArrBlock,void *Data,CpuLon Elements);
     bool RDCH(CpuBol *RetCode,CpuInt Handler,CpuMbl *ArrBlock,CpuLon Length);
@@ -155,9 +157,21 @@ class ArrayComputer{
     bool STAWRL(CpuMbl StrBlock);
     bool STAWRL(const String& Line);
     bool STACLO();
+    bool STAGET(CpuMbl ArrBlock,Array<String>& Lines);
+    bool STASET(CpuMbl *ArrBlock,const Array<String>& Lines);
+
+    //char[] array interface
+    bool CHAPNT(CpuMbl ArrBlock,CpuLon Length,char **Pnt);
+    bool CHASET(CpuMbl *ArrBlock,const Buffer& Buff);
 
     //Command line arguments
     bool GETARG(CpuMbl *Arr,int ArgNr,char *Arg[],int ArgStart);
+    bool SETARG(CpuMbl Arr,int ArgNr,char *Arg[],int ArgStart);
+    bool ISARG(CpuMbl Arr,int ArgNr,char *Arg[],int ArgStart);
+
+    //Process snapshot methods
+    void SaveState(Buffer& State);
+    bool LoadState(const char *State,CpuWrd Length,CpuWrd& Offset,String& Error);
 };
 
 #endif
\ No newline at end of file
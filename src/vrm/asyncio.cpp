@@ -0,0 +1,247 @@
+//asyncio.cpp: Asynchronous file I/O
+#include "bas/basedefs.hpp"
+#include "bas/allocator.hpp"
+#include "bas/array.hpp"
+#include "bas/sortedarray.hpp"
+#include "bas/stack.hpp"
+#include "bas/queue.hpp"
+#include "bas/buffer.hpp"
+#include "bas/string.hpp"
+#include "sys/sysdefs.hpp"
+#include "sys/system.hpp"
+#include "sys/stl.hpp"
+#include "sys/msgout.hpp"
+#include "vrm/asyncio.hpp"
+
+//Define static variables
+std::mutex AsyncIoManager::_Mutex;
+std::condition_variable AsyncIoManager::_Queued;
+std::condition_variable AsyncIoManager::_Done;
+Array<AsyncIoRequest *> AsyncIoManager::_Request;
+Array<std::thread *> AsyncIoManager::_Thread;
+int AsyncIoManager::_LastReqId=0;
+bool AsyncIoManager::_Stop=false;
+
+//Submit request (I/O threads are started on first request, returns -1 when handler does not belong to current process)
+//(handler is kept busy until request is completed, so synchronous file functions on it fail meanwhile)
+int AsyncIoManager::_Submit(AsyncIoRequest *Req){
+
+  //Variables
+  int ReqId;
+
+  //Queue request
+  {
+    std::lock_guard<std::mutex> Lock(_Mutex);
+    if(!_Stl->FileSystem.AsyncBegin(Req->Hnd)){ delete Req; return -1; }
+    if(_Thread.Length()==0){
+      _Stop=false;
+      for(int i=0;i<ASYNCIO_WORKERS;i++){ _Thread.Add(new std::thread(&AsyncIoManager::_Worker)); }
+      DebugMessage(DebugLevel::VrmRuntime,"Started "+ToString(ASYNCIO_WORKERS)+" asynchronous I/O threads");
+    }
+    ReqId=++_LastReqId;
+    Req->ReqId=ReqId;
+    Req->ProcessId=System::CurrentProcessId();
+    Req->Running=false;
+    Req->Done=false;
+    Req->Result=false;
+    Req->ErrorCode=StlErrorCode::Ok;
+    _Request.Add(Req);
+  }
+  _Queued.notify_one();
+
+  //Return request id
+  return ReqId;
+
+}
+
+//Read given length
+int AsyncIoManager::Read(int Hnd,CpuLon Length){
+  AsyncIoRequest *Req=new AsyncIoRequest;
+  Req->Hnd=Hnd;
+  Req->Oper=AsyncIoOper::Read;
+  Req->Length=Length;
+  return _Submit(Req);
+}
+
+//Read whole file
+int AsyncIoManager::ReadAll(int Hnd){
+  AsyncIoRequest *Req=new AsyncIoRequest;
+  Req->Hnd=Hnd;
+  Req->Oper=AsyncIoOper::ReadAll;
+  Req->Length=0;
+  return _Submit(Req);
+}
+
+//Write data (data is copied so caller can release it as soon as call returns)
+int AsyncIoManager::Write(int Hnd,const char *Pnt,CpuLon Length){
+  AsyncIoRequest *Req=new AsyncIoRequest;
+  Req->Hnd=Hnd;
+  Req->Oper=AsyncIoOper::Write;
+  Req->Length=Length;
+  Req->Data.Copy(Pnt,Length);
+  return _Submit(Req);
+}
+
+//Find request of current process (must be called with mutex locked, returns -1 when not found)
+int AsyncIoManager::_Find(int ReqId){
+  for(int i=0;i<_Request.Length();i++){
+    if(_Request[i]->ReqId==ReqId){
+      if(_Request[i]->ProcessId!=System::CurrentProcessId()){ break; }
+      return i;
+    }
+  }
+  _Stl->SetError(StlErrorCode::InvalidIoRequest,ToString(ReqId));
+  return -1;
+}
+
+//Check whether request is completed
+bool AsyncIoManager::Poll(int ReqId,bool& Done){
+  int Index;
+  std::lock_guard<std::mutex> Lock(_Mutex);
+  if((Index=_Find(ReqId))==-1){ return false; }
+  Done=_Request[Index]->Done;
+  return true;
+}
+
+//Wait for request (returns result of file system call, data read is returned and error of file system call becomes
+//error of current thread, request id is no longer valid after this call)
+bool AsyncIoManager::Wait(int ReqId,Buffer& Data){
+
+  //Variables
+  int Index;
+  bool Result;
+  AsyncIoRequest *Req;
+
+  //Wait for request and remove it from table
+  {
+    std::unique_lock<std::mutex> Lock(_Mutex);
+    if((Index=_Find(ReqId))==-1){ return false; }
+    Req=_Request[Index];
+    _Done.wait(Lock,[Req]{ return Req->Done; });
+    _Request.Delete(_Find(ReqId));
+  }
+
+  //Deliver result
+  Result=Req->Result;
+  if(Result){ Data=Req->Data; } else { Data.Reset(); }
+  if(Req->ErrorCode==StlErrorCode::Ok){ _Stl->ClearError(); } else { _Stl->SetError(Req->ErrorCode,Req->ErrorInfo); }
+  delete Req;
+  return Result;
+
+}
+
+//Get next request that can be executed (must be called with mutex locked)
+//(a request is not taken while an older request on the same handler of the same process is not completed)
+AsyncIoRequest *AsyncIoManager::_NextRequest(){
+  for(int i=0;i<_Request.Length();i++){
+    if(_Request[i]->Running){ continue; }
+    bool Blocked=false;
+    for(int j=0;j<i;j++){
+      if(!_Request[j]->Done && _Request[j]->Hnd==_Request[i]->Hnd && _Request[j]->ProcessId==_Request[i]->ProcessId){ Blocked=true; break; }
+    }
+    if(!Blocked){ return _Request[i]; }
+  }
+  return nullptr;
+}
+
+//Execute request on current thread
+//(process of request becomes current process so file system checks handler ownership as for synchronous calls)
+void AsyncIoManager::_Execute(AsyncIoRequest *Req){
+
+  //Variables
+  bool Result=false;
+  CpuLon Size;
+  Buffer Data;
+
+  //Run file system call
+  System::PushProcessId(Req->ProcessId);
+  _Stl->ClearError();
+  switch(Req->Oper){
+    case AsyncIoOper::Read:
+      Result=_Stl->FileSystem.Read(Req->Hnd,Data,Req->Length);
+      break;
+    case AsyncIoOper::ReadAll:
+      Result=_Stl->FileSystem.GetFileSize(Req->Hnd,Size) && _Stl->FileSystem.Read(Req->Hnd,Data,Size);
+      break;
+    case AsyncIoOper::Write:
+      Result=_Stl->FileSystem.Write(Req->Hnd,Req->Data.BuffPnt(),Req->Length);
+      break;
+  }
+  System::PopProcessId();
+
+  //Store result
+  std::lock_guard<std::mutex> Lock(_Mutex);
+  Req->Result=Result;
+  Req->Data=Data;
+  Req->ErrorCode=_Stl->Error();
+  Req->ErrorInfo=_Stl->ErrorInfo();
+  Req->Done=true;
+  _Stl->FileSystem.AsyncEnd(Req->Hnd);
+  _Done.notify_all();
+  _Queued.notify_all();
+
+}
+
+//I/O thread main loop
+void AsyncIoManager::_Worker(){
+  AsyncIoRequest *Req;
+  _Stl->FileSystem.SetAsyncIoThread();
+  while(true){
+    {
+      std::unique_lock<std::mutex> Lock(_Mutex);
+      _Queued.wait(Lock,[&Req]{ return (Req=_NextRequest())!=nullptr || _Stop; });
+      if(Req==nullptr){ return; }
+      Req->Running=true;
+    }
+    _Execute(Req);
+  }
+}
+
+//Wait for pending requests of current process and discard them
+//(called when program ends before its files are closed)
+void AsyncIoManager::Release(){
+
+  //Variables
+  int i;
+  int ProcessId;
+  AsyncIoRequest *Req;
+
+  //Remove requests of current process as they complete
+  ProcessId=System::CurrentProcessId();
+  std::unique_lock<std::mutex> Lock(_Mutex);
+  while(true){
+    for(i=0;i<_Request.Length();i++){ if(_Request[i]->ProcessId==ProcessId){ break; } }
+    if(i==_Request.Length()){ break; }
+    Req=_Request[i];
+    _Done.wait(Lock,[Req]{ return Req->Done; });
+    _Request.Delete(_Find(Req->ReqId));
+    delete Req;
+  }
+
+}
+
+//Wait for all requests and stop I/O threads
+//(called when main program ends, requests not waited for by programs are discarded)
+void AsyncIoManager::Terminate(){
+
+  //Variables
+  int i;
+
+  //Let I/O threads finish queued requests and stop them
+  {
+    std::unique_lock<std::mutex> Lock(_Mutex);
+    if(_Thread.Length()==0){ return; }
+    _Done.wait(Lock,[]{ for(int i=0;i<_Request.Length();i++){ if(!_Request[i]->Done){ return false; } } return true; });
+    _Stop=true;
+  }
+  _Queued.notify_all();
+  for(i=0;i<_Thread.Length();i++){ _Thread[i]->join(); delete _Thread[i]; }
+
+  //Release tables
+  std::lock_guard<std::mutex> Lock(_Mutex);
+  for(i=0;i<_Request.Length();i++){ delete _Request[i]; }
+  _Request.Reset();
+  _Thread.Reset();
+  DebugMessage(DebugLevel::VrmRuntime,"Stopped asynchronous I/O threads");
+
+}
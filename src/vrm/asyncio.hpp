@@ -0,0 +1,77 @@
+//asyncio.hpp: Asynchronous file I/O
+
+//Wrap include
+#ifndef _ASYNCIO_HPP
+#define _ASYNCIO_HPP
+
+//Number of I/O worker threads
+#define ASYNCIO_WORKERS 2
+
+//Asynchronous I/O operations
+enum class AsyncIoOper:int{
+  Read=1,    //Read given length into char[]
+  ReadAll=2, //Read whole file into char[]
+  Write=3    //Write char[]
+};
+
+//Asynchronous I/O request
+//(data to write is copied out of the memory managers of requesting runtime when request is submitted and data read is
+//copied into them when request is waited for, so I/O threads never touch runtime memory)
+struct AsyncIoRequest{
+  int ReqId;              //Request id
+  int ProcessId;          //Process that submitted request
+  int Hnd;                //File handler
+  AsyncIoOper Oper;       //Operation
+  CpuLon Length;          //Length to read
+  Buffer Data;            //Data read or data to write
+  bool Running;           //Request was taken by an I/O thread
+  bool Done;              //Request is completed
+  bool Result;            //Result of file system call
+  StlErrorCode ErrorCode; //Error code set by file system call
+  String ErrorInfo;       //Error information set by file system call
+};
+
+//Asynchronous I/O manager class
+//(requests are process wide and run on a small pool of I/O threads started on first request, request ids start at 1,
+//requests on same handler are executed one after the other in the same order they were submitted, other file functions
+//on a handler fail while it has requests not completed)
+class AsyncIoManager{
+
+  //Private members
+  private:
+
+    //Internal data
+    static std::mutex _Mutex;                //Protects request table
+    static std::condition_variable _Queued;  //Signaled when a request is submitted or manager terminates
+    static std::condition_variable _Done;    //Signaled when a request is completed
+    static Array<AsyncIoRequest *> _Request; //Requests not waited for yet
+    static Array<std::thread *> _Thread;     //I/O threads
+    static int _LastReqId;                   //Last request id
+    static bool _Stop;                       //I/O threads must end
+
+    //Internal methods
+    static void _Worker();
+    static AsyncIoRequest *_NextRequest();
+    static void _Execute(AsyncIoRequest *Req);
+    static int _Submit(AsyncIoRequest *Req);
+    static int _Find(int ReqId);
+
+  //Public members
+  public:
+
+    //Requests
+    static int Read(int Hnd,CpuLon Length);
+    static int ReadAll(int Hnd);
+    static int Write(int Hnd,const char *Pnt,CpuLon Length);
+    static bool Poll(int ReqId,bool& Done);
+    static bool Wait(int ReqId,Buffer& Data);
+
+    //Wait for pending requests of current process and discard them
+    static void Release();
+
+    //Wait for all requests and stop I/O threads
+    static void Terminate();
+
+};
+
+#endif
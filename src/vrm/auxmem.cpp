@@ -24,6 +24,9 @@
 //Global process id variable (used on inner allocators as we cannot pass it to them)
 int _InnerProcessId;
 
+//Define static variables
+bool AuxMemoryManager::_DefEagerRelease=true;
+
 //Internal functions
 char *_AuxInnerAlloc(CpuWrd Size,int Owner);
 void _AxInnerFree(char *Ptr);
@@ -55,6 +58,18 @@ bool AuxMemoryManager::Init(int ProcessId,CpuMbl BlockMax,CpuWrd Units,CpuWrd Ch
   }
   _Block=reinterpret_cast<AuxBlock *>(Ptr);
 
+  //Get memory for free handler stack
+  if((Ptr=MemoryManager::Alloc(ProcessId,BlockMax*sizeof(CpuMbl)))==nullptr){
+    return false;
+  }
+  _FreeHnd=reinterpret_cast<CpuMbl *>(Ptr);
+
+  //Get memory for scope chains
+  if((Ptr=MemoryManager::Alloc(ProcessId,AUXMAN_SCOPES*sizeof(AuxScope)))==nullptr){
+    return false;
+  }
+  _Scope=reinterpret_cast<AuxScope *>(Ptr);
+
   //Init internal memory pool
   if(!_MemoryPool.Create(Units,ChunkUnits,UnitSize,AUXMAN_FREELIST,AUXMAN_FREEBITS,ProcessId,false,&_AuxInnerAlloc,&_AuxInnerFree)){
     Error=_MemoryPool.ErrorText(_MemoryPool.LastError());
@@ -67,12 +82,33 @@ bool AuxMemoryManager::Init(int ProcessId,CpuMbl BlockMax,CpuWrd Units,CpuWrd Ch
   
   //Init block table
   for(i=0;i<_BlockMax;i++){ memset(reinterpret_cast<char *>(&_Block[i]),0,sizeof(AuxBlock)); }
-
-  //Set last assigned pointers to -1 (means no assignment yet)
-  _LastBlockAsg=-1;
+  for(i=0;i<AUXMAN_MAXGEN;i++){ _LiveGen[i]=0; }
+
+  //Init scope chains
+  _ScopeMax=AUXMAN_SCOPES;
+  _ScopeTop=0;
+  for(i=0;i<_ScopeMax;i++){ _Scope[i].First=0; _Scope[i].Last=0; }
+  _ReclaimNr=0;
+  _ReclaimRuns=0;
+
+  //Init frame release and memory usage
+  _Stack=nullptr;
+  _FrameBase=0;
+  _FrameNr=0;
+  _CallerBase=0;
+  _CallerNr=0;
+  _EagerRelease=_DefEagerRelease;
+  _ReleaseNr=0;
+  _UsedMem=0;
+  _PeakMem=0;
+
+  //Init free handler stack (block zero is never given as it means no allocated block)
+  _FreeHndNr=0;
+  _FreeHndDirty=false;
+  for(i=_BlockMax-1;i>=1;i--){ _FreeHnd[_FreeHndNr++]=i; }
   
   //Debug message
-  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory manager initialized: handlers="+ToString(_BlockMax)+" memory_unit="+ToString(UnitSize)+" memory="+ToString(Units*UnitSize));
+  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory manager initialized: handlers="+ToString(_BlockMax)+" memory_unit="+ToString(UnitSize)+" memory="+ToString(Units*UnitSize)+" eagerrelease="+(_EagerRelease?"1":"0"));
   DebugMessage(DebugLevel::VrmAuxMemStatus,GetStatus(0,0));
 
   //Return code
@@ -83,10 +119,20 @@ bool AuxMemoryManager::Init(int ProcessId,CpuMbl BlockMax,CpuWrd Units,CpuWrd Ch
 void AuxMemoryManager::Terminate(){
   _MemoryPool.Destroy();
   MemoryManager::Free(reinterpret_cast<char *>(_Block));     
+  MemoryManager::Free(reinterpret_cast<char *>(_FreeHnd));     
+  MemoryManager::Free(reinterpret_cast<char *>(_Scope));     
+  _FreeHndNr=0;
+  _ScopeTop=-1;
   DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory manager terminated");
   DebugMessage(DebugLevel::VrmAuxMemStatus,GetStatus(0,0));
 }
 
+//Set eager release of frame local blocks for new memory managers
+//(when disabled blocks of returning functions are only reclaimed as zombies when handlers or memory run out)
+void AuxMemoryManager::SetEagerRelease(bool Enable){
+  _DefEagerRelease=Enable;
+}
+
 //Constructor
 AuxMemoryManager::AuxMemoryManager(){
   _Init=false;
@@ -99,11 +145,12 @@ AuxMemoryManager::~AuxMemoryManager(){
   }
 }
 
-//Get memory handler
+//Extend handler table
+//(new handlers are pushed on free handler stack)
 bool AuxMemoryManager::_ExtendHandlers(){
   
   //Variables
-  int i;
+  CpuMbl i;
   char *Ptr;
   CpuMbl CurMax;
   CpuMbl NewMax;
@@ -112,6 +159,13 @@ bool AuxMemoryManager::_ExtendHandlers(){
   CurMax=_BlockMax;
   NewMax=_BlockMax+(_BlockMax/4);
 
+  //Extend free handler stack
+  Ptr=reinterpret_cast<char *>(_FreeHnd);
+  if(!MemoryManager::Realloc(&Ptr,NewMax*sizeof(CpuMbl))){ 
+    return false;
+  }
+  _FreeHnd=reinterpret_cast<CpuMbl *>(Ptr);
+
   //Extend handler table
   Ptr=reinterpret_cast<char *>(_Block);
   if(!MemoryManager::Realloc(&Ptr,NewMax*sizeof(AuxBlock))){ 
@@ -121,10 +175,18 @@ bool AuxMemoryManager::_ExtendHandlers(){
   //Update block table
   _Block=reinterpret_cast<AuxBlock *>(Ptr);
   _BlockMax=NewMax;
+
+  //Inline blocks moved with handler table
+  for(i=1;i<CurMax;i++){ if(_Block[i].Inline){ _Block[i].Ptr=_Block[i].Small; } }
   
   //Init new added handlers
   for(i=CurMax;i<NewMax;i++){ memset(reinterpret_cast<char *>(&_Block[i]),0,sizeof(AuxBlock)); }
 
+  //Push new handlers on free handler stack (lowest goes on top)
+  if(!_FreeHndDirty){
+    for(i=NewMax-1;i>=CurMax;i--){ _FreeHnd[_FreeHndNr++]=i; }
+  }
+
   //Debug message
   DebugMessage(DebugLevel::VrmAuxMemory,"Block table is extended to "+ToString(_BlockMax)+" blocks");
   
@@ -133,53 +195,192 @@ bool AuxMemoryManager::_ExtendHandlers(){
 
 }
 
+//Extend scope chain table so it contains given scope
+bool AuxMemoryManager::_ExtendScopes(int ScopeId){
+  
+  //Variables
+  int i;
+  char *Ptr;
+  int NewMax;
+
+  //Calculate new size
+  NewMax=_ScopeMax;
+  while(NewMax<=ScopeId){ NewMax*=2; }
+
+  //Extend scope chain table
+  Ptr=reinterpret_cast<char *>(_Scope);
+  if(!MemoryManager::Realloc(&Ptr,NewMax*sizeof(AuxScope))){ 
+    return false;
+  }
+  _Scope=reinterpret_cast<AuxScope *>(Ptr);
+  
+  //Init new added scope chains
+  for(i=_ScopeMax;i<NewMax;i++){ _Scope[i].First=0; _Scope[i].Last=0; }
+  _ScopeMax=NewMax;
+
+  //Debug message
+  DebugMessage(DebugLevel::VrmAuxMemory,"Scope chain table is extended to "+ToString(_ScopeMax)+" scopes");
+  
+  //Return success
+  return true;
+
+}
+
+//Rebuild free handler stack from handler table
+//(needed after handlers are taken by number, since they might be still on the stack)
+void AuxMemoryManager::_RebuildFreeHandlers(){
+  _FreeHndNr=0;
+  for(CpuMbl i=_BlockMax-1;i>=1;i--){ 
+    if(!_Block[i].Used){ _FreeHnd[_FreeHndNr++]=i; } 
+  }
+  _FreeHndDirty=false;
+}
+
+//Reclaim zombie blocks walking scope chains
+//(chains of deeper scopes are walked entirely, chain of current scope is walked from oldest block until a block of current
+//ScopeNr appears as blocks of previous calls on same depth are always older, blocks of live generators are skipped,
+//when Ptr is given search stops on first zombie pool block not sharing its data that has capacity between Size and double of Size and
+//its memory is given to caller instead of being released, returns number of reclaimed handlers)
+CpuMbl AuxMemoryManager::_Reclaim(int ScopeId,CpuLon ScopeNr,CpuMbl Keep,CpuWrd Size,char **Ptr){
+
+  //Variables
+  int i;
+  CpuMbl Block;
+  CpuMbl Next;
+  CpuMbl Count;
+
+  //Init result
+  Count=0;
+  if(Ptr!=nullptr){ *Ptr=nullptr; }
+  _ReclaimRuns++;
+
+  //Walk scope chains from deepest scope
+  for(i=_ScopeTop;i>=ScopeId && i>=0;i--){
+    Block=_Scope[i].First;
+    while(Block!=0){
+      Next=_Block[Block].ScopeNext;
+      if(i==ScopeId && _Block[Block].ScopeNr==ScopeNr){ break; }
+      if(Block!=Keep && IsZombie(Block,ScopeId,ScopeNr)){
+        Count++;
+        if(Ptr!=nullptr && _Block[Block].Ptr!=nullptr && !_Block[Block].Inline && _Block[Block].ShareNext==0 && _Block[Block].Capacity>=Size && _Block[Block].Capacity<=2*Size){
+          DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory reclaim, found zombie block (scopeid="+ToString(_Block[Block].ScopeId)+" scopenr="+ToString(_Block[Block].ScopeNr)+" capacity="+ToString(_Block[Block].Capacity)+" ptr="+PTRFORMAT(_Block[Block].Ptr)+")");
+          *Ptr=_Block[Block].Ptr;
+          _Block[Block].Ptr=nullptr;
+          _Free(Block);
+          _ReclaimNr+=Count;
+          return Count;
+        }
+        _Free(Block);
+      }
+      Block=Next;
+    }
+  }
+
+  //Lower highest scope while chains are empty
+  while(_ScopeTop>0 && _Scope[_ScopeTop].First==0){ _ScopeTop--; }
+
+  //Return reclaimed handlers
+  _ReclaimNr+=Count;
+  return Count;
+
+}
+
+//Release blocks of scope chain held on stack frame of returning function
+//(scope chain is walked from newest block, as blocks allocated while function was running are the newest ones of the chain,
+//blocks of generators are skipped and walk ends on first block of a call older than returning function)
+CpuMbl AuxMemoryManager::_ReleaseChain(int ScopeId,CpuLon ScopeNr){
+
+  //Variables
+  CpuMbl Block;
+  CpuMbl Prev;
+  CpuMbl Count;
+
+  //Walk scope chain from newest block
+  Count=0;
+  Block=_Scope[ScopeId].Last;
+  while(Block!=0){
+    Prev=_Block[Block].ScopePrev;
+    if(_Block[Block].FrameNr==ScopeNr){ _Free(Block); Count++; }
+    else if(_Block[Block].ScopeNr>0 && _Block[Block].ScopeNr<ScopeNr){ break; }
+    Block=Prev;
+  }
+
+  //Return released blocks
+  return Count;
+
+}
+
+//Release blocks held on stack frame of returning function
+//(these are blocks allocated by the function itself and results of functions it called, blocks that can outlive the call
+//like its own function result or blocks stored inside arrays are not held on its stack frame and are left to zombie reclaim)
+void AuxMemoryManager::_ReleaseFrame(int ScopeId,CpuLon ScopeNr){
+
+  //Variables
+  CpuMbl Count;
+
+  //Release blocks of function and blocks of called functions
+  Count=0;
+  if(ScopeId<=_ScopeTop){ Count+=_ReleaseChain(ScopeId,ScopeNr); }
+  if(ScopeId+1<=_ScopeTop){ Count+=_ReleaseChain(ScopeId+1,ScopeNr); }
+  _ReleaseNr+=Count;
+
+  //Debug message
+  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory frame release: processid="+ToString(_ProcessId)+" released="+ToString(Count)+" scopeid="+ToString(ScopeId)+" scopenr="+ToString(ScopeNr));
+
+}
+
 //Get memory handler
+//(handlers are popped from free handler stack, when it is empty zombie blocks of dead scopes are reclaimed in bulk and
+//handler table is extended only when there were no zombie blocks to reclaim)
 bool AuxMemoryManager::_GetHandler(int ScopeId,CpuLon ScopeNr,CpuMbl *Block){
   
   //Variables
-  long i;
-  CpuMbl FirstFree;
+  #ifdef __DEV__
+  CpuMbl Count;
+  #endif
 
   //Init result
   *Block=-1;
 
-  //Find from last assigned block
-  if(_LastBlockAsg!=-1){
-    for(i=_LastBlockAsg+1;i<_BlockMax;i++){
-      if(!_Block[i].Used || IsZombie(i,ScopeId,ScopeNr)){
-        *Block=i;
-        _LastBlockAsg=i;
-        return true;
-      }
-    }
+  //Scope chain must exist
+  if(ScopeId>=_ScopeMax){
+    if(!_ExtendScopes(ScopeId)){ return false; }
   }
 
-  //Find from beginning
-  for(i=1;i<_BlockMax;i++){
-    if(!_Block[i].Used || IsZombie(i,ScopeId,ScopeNr)){
-      *Block=i;
-      _LastBlockAsg=i;
-      return true;
+  //Rebuild free handler stack after handlers were taken by number
+  if(_FreeHndDirty){ _RebuildFreeHandlers(); }
+
+  //Reclaim zombie blocks and extend handler table
+  if(_FreeHndNr==0){
+    #ifdef __DEV__
+    Count=_Reclaim(ScopeId,ScopeNr,0,0,nullptr);
+    DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory handler reclaim: processid="+ToString(_ProcessId)+" reclaimed="+ToString(Count)+" scopeid="+ToString(ScopeId)+" scopenr="+ToString(ScopeNr));
+    #else
+    _Reclaim(ScopeId,ScopeNr,0,0,nullptr);
+    #endif
+    if(_FreeHndNr==0){
+      if(!_ExtendHandlers()){ return false; }
     }
   }
 
-  //Extend handler table
-  FirstFree=_BlockMax;
-  if(_ExtendHandlers()){ 
-    *Block=FirstFree;
-    _LastBlockAsg=FirstFree;
-    return true;
-  }
-  
-  //Return failure
-  return false;
+  //Pop free handler
+  *Block=_FreeHnd[--_FreeHndNr];
+
+  //Return success
+  return true;
 
 }
 
-//Internal releaser
+//Internal releaser (shared data is only released with last block of share ring)
 void AuxMemoryManager::_Free(CpuMbl Block){
-  _MemoryPool.Free(_Block[Block].Ptr);
+  if(_Block[Block].ShareNext!=0){ _ShareUnlink(Block); }
+  else{
+    if(!_Block[Block].Inline){ _MemoryPool.Free(_Block[Block].Ptr); }
+    _MemUsage(-_PoolSize(Block));
+  }
+  _ScopeUnlink(Block);
   memset(reinterpret_cast<char *>(&_Block[Block]),0,sizeof(AuxBlock));
+  if(!_FreeHndDirty){ _FreeHnd[_FreeHndNr++]=Block; }
 }
 
 //Memory empty allocation request (only handler)
@@ -199,10 +400,15 @@ bool AuxMemoryManager::EmptyAlloc(int ScopeId,CpuLon ScopeNr,CpuMbl *Block){
   _Block[*Block].ScopeId=ScopeId;
   _Block[*Block].ScopeNr=ScopeNr;
   _Block[*Block].Used=1;
+  _Block[*Block].Inline=false;
+  _Block[*Block].NoShare=false;
   _Block[*Block].Size=0;
+  _Block[*Block].Capacity=0;
   _Block[*Block].Length=0;
   _Block[*Block].ArrIndex=-1;
   _Block[*Block].Ptr=nullptr;
+  _Block[*Block].FrameNr=0;
+  _ScopeLink(*Block);
 
   //Debug message
   DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory empty allocation end: processid="+ToString(_ProcessId)+" handler="+HEXFORMAT(*Block)+" scopeid="+ToString(ScopeId)+" scopenr="+ToString(ScopeNr));
@@ -232,8 +438,15 @@ bool AuxMemoryManager::Alloc(int ScopeId,CpuLon ScopeNr,CpuWrd Size,int ArrIndex
     return false; 
   }
 
+  //Small strings are stored inline on handler
+  if(ArrIndex==-1 && Size<=AUXMAN_INLINE){
+    Ptr=_Block[*Block].Small;
+  }
+
   //Try allocation
-  Ptr=_MemoryPool.Allocate(Size,_ProcessId,false);
+  else{
+    Ptr=_MemoryPool.Allocate(Size,_ProcessId,false);
+  }
 
   //Traverse zombie blocks
   if(Ptr==nullptr){
@@ -242,25 +455,14 @@ bool AuxMemoryManager::Alloc(int ScopeId,CpuLon ScopeNr,CpuWrd Size,int ArrIndex
     DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory allocation, started search on zombie blocks");
 
     //Try allocation on zombie blocks (we take a block not much bigger that double size of request)
-    for(CpuMbl i=1;i<_BlockMax;i++){
-      if(_Block[i].Used && IsZombie(i,ScopeId,ScopeNr)){
-        if(_Block[i].Size>=Size && _Block[i].Size<=2*Size){
-          DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory allocation, found zombie block (scopeid="+ToString(_Block[i].ScopeId)+" scopenr="+ToString(_Block[i].ScopeNr)+" size="+ToString(_Block[i].Size)+" ptr="+PTRFORMAT(_Block[i].Ptr)+")");
-          Ptr=_Block[i].Ptr;
-          memset(reinterpret_cast<char *>(&_Block[i]),0,sizeof(AuxBlock));
-          break;
-        }
-        else{
-          _Free(i);
-        }
-      }
-    }
+    _Reclaim(ScopeId,ScopeNr,0,Size,&Ptr);
 
-    //Try allocation again if allocation on zombie blocks failed
+    //Try allocation again if allocation on zombie blocks failed (handler goes back to free handler stack on failure)
     if(Ptr==nullptr){
       DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory allocation, zombie block search failed, extending memory");
       if((Ptr=_MemoryPool.Allocate(Size,_ProcessId,true))==nullptr){
         DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory allocation failure, no free blocks (processid="+ToString(_ProcessId)+" scopeid="+ToString(ScopeId)+" scopenr="+ToString(ScopeNr)+" size="+ToString(Size)+")");
+        _FreeHnd[_FreeHndNr++]=*Block;
         return false;
       }
     }
@@ -271,10 +473,16 @@ bool AuxMemoryManager::Alloc(int ScopeId,CpuLon ScopeNr,CpuWrd Size,int ArrIndex
   _Block[*Block].ScopeId=ScopeId;
   _Block[*Block].ScopeNr=ScopeNr;
   _Block[*Block].Used=1;
+  _Block[*Block].Inline=(Ptr==_Block[*Block].Small);
+  _Block[*Block].NoShare=false;
   _Block[*Block].Size=Size;
+  _Block[*Block].Capacity=(_Block[*Block].Inline?AUXMAN_INLINE:Size);
   _Block[*Block].Length=0;
   _Block[*Block].ArrIndex=ArrIndex;
   _Block[*Block].Ptr=Ptr;
+  _Block[*Block].FrameNr=0;
+  _ScopeLink(*Block);
+  _MemUsage(_PoolSize(*Block));
 
   //Debug message
   DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory allocation end: processid="+ToString(_ProcessId)+" size="+ToString(Size)+" handler="+HEXFORMAT(*Block)+" scopeid="+ToString(ScopeId)+" scopenr="+ToString(ScopeNr)+" ptr="+PTRFORMAT(Ptr));
@@ -308,13 +516,28 @@ bool AuxMemoryManager::ForcedAlloc(int ScopeId,CpuLon ScopeNr,CpuWrd Size,int Ar
     return(false);
   }
 
+  //Scope chain must exist
+  if(ScopeId>=_ScopeMax){
+    if(!_ExtendScopes(ScopeId)){ return false; }
+  }
+
+  //Handler might be on free handler stack, so stack is rebuilt on next handler request
+  _FreeHndDirty=true;
+
   //Force block free
   if(_Block[Block].Used){
     Free(Block);
   }
 
+  //Small strings are stored inline on handler
+  if(ArrIndex==-1 && Size<=AUXMAN_INLINE){
+    Ptr=_Block[Block].Small;
+  }
+
   //Try allocation
-  Ptr=_MemoryPool.Allocate(Size,_ProcessId,false);
+  else{
+    Ptr=_MemoryPool.Allocate(Size,_ProcessId,false);
+  }
 
   //Traverse zombie blocks
   if(Ptr==nullptr){
@@ -323,19 +546,7 @@ bool AuxMemoryManager::ForcedAlloc(int ScopeId,CpuLon ScopeNr,CpuWrd Size,int Ar
     DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory forced allocation, started search on zombie blocks");
     
     //Try allocation on zombie blocks (we take a block not much bigger that double size of request)
-    for(CpuMbl i=1;i<_BlockMax;i++){
-      if(_Block[i].Used && IsZombie(i,ScopeId,ScopeNr)){
-        if(_Block[i].Size>=Size && _Block[i].Size<=2*Size){
-          DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory forced allocation, found zombie block (scopeid="+ToString(_Block[i].ScopeId)+" scopenr="+ToString(_Block[i].ScopeNr)+" size="+ToString(_Block[i].Size)+" ptr="+PTRFORMAT(_Block[i].Ptr)+")");
-          Ptr=_Block[i].Ptr;
-          memset(reinterpret_cast<char *>(&_Block[i]),0,sizeof(AuxBlock));
-          break;
-        }
-        else{
-          _Free(i);
-        }
-      }
-    }
+    _Reclaim(ScopeId,ScopeNr,0,Size,&Ptr);
 
     //Try allocation again if allocation on zombie blocks failed
     if(Ptr==nullptr){
@@ -352,10 +563,16 @@ bool AuxMemoryManager::ForcedAlloc(int ScopeId,CpuLon ScopeNr,CpuWrd Size,int Ar
   _Block[Block].ScopeId=ScopeId;
   _Block[Block].ScopeNr=ScopeNr;
   _Block[Block].Used=1;
+  _Block[Block].Inline=(Ptr==_Block[Block].Small);
+  _Block[Block].NoShare=false;
   _Block[Block].Size=Size;
+  _Block[Block].Capacity=(_Block[Block].Inline?AUXMAN_INLINE:Size);
   _Block[Block].Length=Size;
   _Block[Block].ArrIndex=ArrIndex;
   _Block[Block].Ptr=Ptr;
+  _Block[Block].FrameNr=0;
+  _ScopeLink(Block);
+  _MemUsage(_PoolSize(Block));
   
   //Debug message
   DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory forced allocation end: processid="+ToString(_ProcessId)+" size="+ToString(Size)+" handler="+HEXFORMAT(Block)+" scopeid="+ToString(ScopeId)+" scopenr="+ToString(ScopeNr)+" ptr="+PTRFORMAT(Ptr));
@@ -369,65 +586,181 @@ bool AuxMemoryManager::ForcedAlloc(int ScopeId,CpuLon ScopeNr,CpuWrd Size,int Ar
 
 }
 
-//Memory re-allocation request
-bool AuxMemoryManager::Realloc(int ScopeId,CpuLon ScopeNr,CpuMbl Block,CpuWrd Size){
+//Change memory allocated for block keeping its contents
+//(strings move inline on handler when capacity is small enough and move back to memory pool when they grow)
+bool AuxMemoryManager::_Resize(int ScopeId,CpuLon ScopeNr,CpuMbl Block,CpuWrd Capacity){
   
   //Variables
-  bool Found;
+  char *Ptr;
+  CpuWrd PoolSize;
 
-  //Debug message
-  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory manager re-allocation start (size="+ToString(Size)+" handler="+HEXFORMAT(Block)+" blockscopeid="+ToString(_Block[Block].ScopeId)+" blockscopenr="+ToString(_Block[Block].ScopeNr)+")");
+  //Pool memory taken before resize
+  PoolSize=_PoolSize(Block);
 
-  //Check handler exists, it is used and belongs to process
-  if(Block<1 || Block>_BlockMax-1){
-    DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory re-allocation failure, invalid handler (size="+ToString(Size)+" handler="+HEXFORMAT(Block)+" blockscopeid="+ToString(_Block[Block].ScopeId)+" blockscopenr="+ToString(_Block[Block].ScopeNr)+")");
-    return(false);
+  //Small strings are stored inline on handler (capacity is whole inline storage)
+  if(_Block[Block].ArrIndex==-1 && Capacity<=AUXMAN_INLINE){
+    if(!_Block[Block].Inline){
+      if(_Block[Block].Ptr!=nullptr){ 
+        MemCpy(_Block[Block].Small,_Block[Block].Ptr,(_Block[Block].Size<Capacity?_Block[Block].Size:Capacity)); 
+        _MemoryPool.Free(_Block[Block].Ptr);
+      }
+      _Block[Block].Ptr=_Block[Block].Small;
+      _Block[Block].Inline=true;
+    }
+    Capacity=AUXMAN_INLINE;
   }
-  else if(!_Block[Block].Used){
-    DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory re-allocation failure, access to unused handler (size="+ToString(Size)+" handler="+HEXFORMAT(Block)+" blockscopeid="+ToString(_Block[Block].ScopeId)+" blockscopenr="+ToString(_Block[Block].ScopeNr)+")");
-    return(false);
+
+  //Inline string moves to memory pool
+  else if(_Block[Block].Inline){
+    if((Ptr=_MemoryPool.Allocate(Capacity,_ProcessId,false))==nullptr){
+      DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory re-allocation of inline block, started search on zombie blocks");
+      _Reclaim(ScopeId,ScopeNr,Block,Capacity,&Ptr);
+      if(Ptr==nullptr){
+        DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory re-allocation of inline block, zombie block search failed, extending memory");
+        if((Ptr=_MemoryPool.Allocate(Capacity,_ProcessId,true))==nullptr){
+          DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory re-allocation failure, no free blocks (processid="+ToString(_ProcessId)+" scopeid="+ToString(ScopeId)+" scopenr="+ToString(ScopeNr)+" capacity="+ToString(Capacity)+")");
+          return false;
+        }
+      }
+    }
+    MemCpy(Ptr,_Block[Block].Small,(_Block[Block].Size<Capacity?_Block[Block].Size:Capacity)); 
+    _Block[Block].Ptr=Ptr;
+    _Block[Block].Inline=false;
   }
 
   //Try re-allocation without pool extension
-  if(!_MemoryPool.ReAllocate(&_Block[Block].Ptr,Size,false)){
+  else if(!_MemoryPool.ReAllocate(&_Block[Block].Ptr,Capacity,false)){
 
     //Debug message
     DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory re-allocation, started search on zombie blocks");
     
-    //Try allocation on zombie blocks (we take a block not much bigger that double size of request)
-    Found=false;
-    for(CpuMbl i=1;i<_BlockMax;i++){
-      if(_Block[i].Used && IsZombie(i,ScopeId,ScopeNr)){
-        if(_Block[i].Size>=Size && _Block[i].Size<=2*Size){
-          DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory re-allocation, found zombie block (scopeid="+ToString(_Block[i].ScopeId)+" scopenr="+ToString(_Block[i].ScopeNr)+" size="+ToString(_Block[i].Size)+" ptr="+PTRFORMAT(_Block[i].Ptr)+")");
-          MemCpy(_Block[i].Ptr,_Block[Block].Ptr,_Block[Block].Size); 
-          _Block[Block].Ptr=_Block[i].Ptr;
-          memset(reinterpret_cast<char *>(&_Block[i]),0,sizeof(AuxBlock));
-          Found=true;
-          break;
-        }
-        else{
-          _Free(i);
-        }
-      }
+    //Try allocation on zombie blocks (we take a block not much bigger that double size of request, block itself is never taken)
+    _Reclaim(ScopeId,ScopeNr,Block,Capacity,&Ptr);
+    if(Ptr!=nullptr){
+      MemCpy(Ptr,_Block[Block].Ptr,(_Block[Block].Size<Capacity?_Block[Block].Size:Capacity)); 
+      _MemoryPool.Free(_Block[Block].Ptr);
+      _Block[Block].Ptr=Ptr;
     }
 
     //Try re-allocation again if allocation on zombie blocks failed with pool extension
-    if(!Found){
+    else{
       DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory re-allocation, zombie block search failed, extending memory");
-      if(!_MemoryPool.ReAllocate(&_Block[Block].Ptr,Size,true)){
-        DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory re-allocation failure, no free blocks (processid="+ToString(_ProcessId)+" scopeid="+ToString(ScopeId)+" scopenr="+ToString(ScopeNr)+" size="+ToString(Size)+")");
+      if(!_MemoryPool.ReAllocate(&_Block[Block].Ptr,Capacity,true)){
+        DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory re-allocation failure, no free blocks (processid="+ToString(_ProcessId)+" scopeid="+ToString(ScopeId)+" scopenr="+ToString(ScopeNr)+" capacity="+ToString(Capacity)+")");
+        return false;
+      }
+    }
+
+  }
+
+  //Set new capacity
+  _Block[Block].Capacity=Capacity;
+  _MemUsage(_PoolSize(Block)-PoolSize);
+
+  //Return code
+  return true;
+
+}
+
+//Give block its own copy of shared data with given capacity
+//(data is not copied when caller is going to overwrite it entirely)
+bool AuxMemoryManager::_Unshare(int ScopeId,CpuLon ScopeNr,CpuMbl Block,CpuWrd Capacity,bool KeepData){
+  
+  //Variables
+  char *Ptr;
+  char *OldPtr;
+
+  //Small strings are stored inline on handler
+  OldPtr=_Block[Block].Ptr;
+  if(_Block[Block].ArrIndex==-1 && Capacity<=AUXMAN_INLINE){
+    Ptr=_Block[Block].Small;
+    Capacity=AUXMAN_INLINE;
+  }
+
+  //Allocate memory for copy (block itself is never reclaimed and shared data is never given by zombie search)
+  else if((Ptr=_MemoryPool.Allocate(Capacity,_ProcessId,false))==nullptr){
+    DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory unshare, started search on zombie blocks");
+    _Reclaim(ScopeId,ScopeNr,Block,Capacity,&Ptr);
+    if(Ptr==nullptr){
+      DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory unshare, zombie block search failed, extending memory");
+      if((Ptr=_MemoryPool.Allocate(Capacity,_ProcessId,true))==nullptr){
+        DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory unshare failure, no free blocks (processid="+ToString(_ProcessId)+" scopeid="+ToString(ScopeId)+" scopenr="+ToString(ScopeNr)+" capacity="+ToString(Capacity)+")");
         return false;
       }
     }
+  }
+
+  //Copy data
+  if(KeepData){ MemCpy(Ptr,OldPtr,(_Block[Block].Size<Capacity?_Block[Block].Size:Capacity)); }
 
+  //Leave share ring (zombie search might have released all other blocks of ring, then old data belongs only to this block)
+  if(_Block[Block].ShareNext!=0){ 
+    _ShareUnlink(Block); 
+  }
+  else{ 
+    _MemoryPool.Free(OldPtr); 
+    _MemUsage(-_Block[Block].Capacity); 
+  }
+
+  //Set new data
+  _Block[Block].Ptr=Ptr;
+  _Block[Block].Inline=(Ptr==_Block[Block].Small);
+  _Block[Block].Capacity=Capacity;
+  _MemUsage(_PoolSize(Block));
+
+  //Debug message
+  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory unshare: processid="+ToString(_ProcessId)+" size="+ToString(_Block[Block].Size)+" capacity="+ToString(Capacity)+" handler="+HEXFORMAT(Block)+" ptr="+PTRFORMAT(Ptr));
+
+  //Return code
+  return true;
+
+}
+
+//Memory re-allocation request
+//(shared data is copied before it changes unless caller overwrites it entirely, memory is only re-allocated when size goes beyond block capacity, which then grows geometrically, or when size falls below
+//a fraction of capacity, which then shrinks leaving room for one growth step, so repeated appends do not copy block every time)
+bool AuxMemoryManager::Realloc(int ScopeId,CpuLon ScopeNr,CpuMbl Block,CpuWrd Size,bool KeepData){
+  
+  //Variables
+  CpuWrd Capacity;
+
+  //Debug message
+  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory manager re-allocation start (size="+ToString(Size)+" handler="+HEXFORMAT(Block)+" blockscopeid="+ToString(_Block[Block].ScopeId)+" blockscopenr="+ToString(_Block[Block].ScopeNr)+")");
+
+  //Check handler exists, it is used and belongs to process
+  if(Block<1 || Block>_BlockMax-1){
+    DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory re-allocation failure, invalid handler (size="+ToString(Size)+" handler="+HEXFORMAT(Block)+" blockscopeid="+ToString(_Block[Block].ScopeId)+" blockscopenr="+ToString(_Block[Block].ScopeNr)+")");
+    return(false);
+  }
+  else if(!_Block[Block].Used){
+    DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory re-allocation failure, access to unused handler (size="+ToString(Size)+" handler="+HEXFORMAT(Block)+" blockscopeid="+ToString(_Block[Block].ScopeId)+" blockscopenr="+ToString(_Block[Block].ScopeNr)+")");
+    return(false);
+  }
+
+  //Block shares its data
+  if(_Block[Block].ShareNext!=0){
+    if(!_Unshare(ScopeId,ScopeNr,Block,Size,KeepData)){ return false; }
+  }
+
+  //Size goes beyond capacity (exact size is tried when geometric growth does not fit in memory)
+  else if(Size>_Block[Block].Capacity){
+    Capacity=_Block[Block].Capacity*AUXMAN_GROWTH;
+    if(Capacity<Size){ Capacity=Size; }
+    if(!_Resize(ScopeId,ScopeNr,Block,Capacity)){
+      if(Capacity==Size || !_Resize(ScopeId,ScopeNr,Block,Size)){ return false; }
+    }
+  }
+
+  //Size falls below a fraction of capacity
+  else if(Size<_Block[Block].Capacity/AUXMAN_SHRINK && !_Block[Block].Inline){
+    if(!_Resize(ScopeId,ScopeNr,Block,Size*AUXMAN_GROWTH)){ return false; }
   }
 
   //Set new size
   _Block[Block].Size=Size;
   
   //Debug message
-  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory re-allocation end: processid="+ToString(_ProcessId)+" newsize="+ToString(Size)+" handler="+HEXFORMAT(Block)+" blockscopeid="+ToString(_Block[Block].ScopeId)+" blockscopenr="+ToString(_Block[Block].ScopeNr)+" ptr="+PTRFORMAT(_Block[Block].Ptr));
+  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory re-allocation end: processid="+ToString(_ProcessId)+" newsize="+ToString(Size)+" capacity="+ToString(_Block[Block].Capacity)+" handler="+HEXFORMAT(Block)+" blockscopeid="+ToString(_Block[Block].ScopeId)+" blockscopenr="+ToString(_Block[Block].ScopeNr)+" ptr="+PTRFORMAT(_Block[Block].Ptr));
   DebugMessage(DebugLevel::VrmAuxMemStatus,GetStatus(ScopeId,ScopeNr));
 
   //Main memory check
@@ -438,6 +771,151 @@ bool AuxMemoryManager::Realloc(int ScopeId,CpuLon ScopeNr,CpuMbl Block,CpuWrd Si
 
 }
 
+//Memory reservation request (capacity is raised to given value, block size does not change)
+bool AuxMemoryManager::Reserve(int ScopeId,CpuLon ScopeNr,CpuMbl Block,CpuWrd Capacity){
+  
+  //Debug message
+  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory manager reservation start (capacity="+ToString(Capacity)+" handler="+HEXFORMAT(Block)+" blockscopeid="+ToString(_Block[Block].ScopeId)+" blockscopenr="+ToString(_Block[Block].ScopeNr)+")");
+
+  //Check handler exists and it is used
+  if(Block<1 || Block>_BlockMax-1){
+    DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory reservation failure, invalid handler (capacity="+ToString(Capacity)+" handler="+HEXFORMAT(Block)+")");
+    return(false);
+  }
+  else if(!_Block[Block].Used){
+    DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory reservation failure, access to unused handler (capacity="+ToString(Capacity)+" handler="+HEXFORMAT(Block)+")");
+    return(false);
+  }
+
+  //Raise capacity (shared data is copied as reservation is done to write on block)
+  if(_Block[Block].ShareNext!=0){
+    if(!_Unshare(ScopeId,ScopeNr,Block,(Capacity>_Block[Block].Size?Capacity:_Block[Block].Size),true)){ return false; }
+  }
+  else if(Capacity>_Block[Block].Capacity){
+    if(!_Resize(ScopeId,ScopeNr,Block,Capacity)){ return false; }
+  }
+
+  //Debug message
+  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory reservation end: processid="+ToString(_ProcessId)+" size="+ToString(_Block[Block].Size)+" capacity="+ToString(_Block[Block].Capacity)+" handler="+HEXFORMAT(Block)+" ptr="+PTRFORMAT(_Block[Block].Ptr));
+  DebugMessage(DebugLevel::VrmAuxMemStatus,GetStatus(ScopeId,ScopeNr));
+
+  //Main memory check
+  MainMemoryCheckReturn();
+
+  //Return code
+  return true;
+
+}
+
+//Memory shrink request (capacity is lowered to block size)
+bool AuxMemoryManager::Shrink(int ScopeId,CpuLon ScopeNr,CpuMbl Block){
+  
+  //Debug message
+  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory manager shrink start (handler="+HEXFORMAT(Block)+" blockscopeid="+ToString(_Block[Block].ScopeId)+" blockscopenr="+ToString(_Block[Block].ScopeNr)+")");
+
+  //Check handler exists and it is used
+  if(Block<1 || Block>_BlockMax-1){
+    DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory shrink failure, invalid handler (handler="+HEXFORMAT(Block)+")");
+    return(false);
+  }
+  else if(!_Block[Block].Used){
+    DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory shrink failure, access to unused handler (handler="+HEXFORMAT(Block)+")");
+    return(false);
+  }
+
+  //Lower capacity (shared data is left as it is)
+  if(_Block[Block].Capacity>_Block[Block].Size && _Block[Block].ShareNext==0){
+    if(!_Resize(ScopeId,ScopeNr,Block,_Block[Block].Size)){ return false; }
+  }
+
+  //Debug message
+  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory shrink end: processid="+ToString(_ProcessId)+" size="+ToString(_Block[Block].Size)+" capacity="+ToString(_Block[Block].Capacity)+" handler="+HEXFORMAT(Block)+" ptr="+PTRFORMAT(_Block[Block].Ptr));
+  DebugMessage(DebugLevel::VrmAuxMemStatus,GetStatus(ScopeId,ScopeNr));
+
+  //Main memory check
+  MainMemoryCheckReturn();
+
+  //Return code
+  return true;
+
+}
+
+//Move inline block data to memory pool and copy shared data
+//(needed when a pointer to block data is handed out that must stay valid while other blocks are allocated, since an allocation
+//can extend handler table and inline data moves with it, data might go inline again later when block is re-allocated)
+bool AuxMemoryManager::Pin(int ScopeId,CpuLon ScopeNr,CpuMbl Block){
+  
+  //Shared data is copied as pointer can be used to write on block
+  if(_Block[Block].ShareNext!=0){
+    if(!_Unshare(ScopeId,ScopeNr,Block,(_Block[Block].Size>AUXMAN_INLINE?_Block[Block].Size:AUXMAN_INLINE+1),true)){ return false; }
+    return true;
+  }
+
+  //Block is not inline
+  if(!_Block[Block].Inline){ return true; }
+
+  //Move data to memory pool
+  if(!_Resize(ScopeId,ScopeNr,Block,AUXMAN_INLINE+1)){ return false; }
+
+  //Debug message
+  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory pin: processid="+ToString(_ProcessId)+" size="+ToString(_Block[Block].Size)+" handler="+HEXFORMAT(Block)+" ptr="+PTRFORMAT(_Block[Block].Ptr));
+
+  //Return code
+  return true;
+
+}
+
+//Move data of source block to destination block and release source block
+//(destination block must have no data, inline data is copied since it cannot be handed over)
+void AuxMemoryManager::Move(CpuMbl Des,CpuMbl Src){
+  if(_Block[Src].ShareNext!=0){
+    _ShareLink(Des,Src);
+    _ShareUnlink(Src);
+  }
+  _Block[Des].Inline=_Block[Src].Inline;
+  _Block[Des].NoShare=_Block[Src].NoShare;
+  _Block[Des].Size=_Block[Src].Size;
+  _Block[Des].Capacity=_Block[Src].Capacity;
+  _Block[Des].Length=_Block[Src].Length;
+  if(_Block[Src].Inline){
+    MemCpy(_Block[Des].Small,_Block[Src].Small,_Block[Src].Size);
+    _Block[Des].Ptr=_Block[Des].Small;
+  }
+  else{
+    _Block[Des].Ptr=_Block[Src].Ptr;
+  }
+  _Block[Src].Inline=false;
+  _Block[Src].Capacity=0;
+  _Block[Src].Ptr=nullptr;
+  Free(Src);
+}
+
+//Share data of source block with destination block
+//(destination block must have no data, source block must be shareable)
+void AuxMemoryManager::Share(CpuMbl Des,CpuMbl Src){
+  _Block[Des].Inline=false;
+  _Block[Des].Size=_Block[Src].Size;
+  _Block[Des].Capacity=_Block[Src].Capacity;
+  _Block[Des].Length=_Block[Src].Length;
+  _Block[Des].Ptr=_Block[Src].Ptr;
+  _ShareLink(Des,Src);
+  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory share: processid="+ToString(_ProcessId)+" handler="+HEXFORMAT(Des)+" source="+HEXFORMAT(Src)+" size="+ToString(_Block[Src].Size)+" ptr="+PTRFORMAT(_Block[Src].Ptr));
+}
+
+//Give block its own copy of data when it is shared
+bool AuxMemoryManager::Unshare(int ScopeId,CpuLon ScopeNr,CpuMbl Block){
+  if(_Block[Block].ShareNext==0){ return true; }
+  return _Unshare(ScopeId,ScopeNr,Block,_Block[Block].Size,true);
+}
+
+//Give block its own copy of data and never share it again
+//(used when a reference to write on block data is handed out, since reference outlives any later copy of block)
+bool AuxMemoryManager::Detach(int ScopeId,CpuLon ScopeNr,CpuMbl Block){
+  if(!Unshare(ScopeId,ScopeNr,Block)){ return false; }
+  _Block[Block].NoShare=true;
+  return true;
+}
+
 //Free memory
 void AuxMemoryManager::Free(CpuMbl Block){
   
@@ -490,10 +968,16 @@ void AuxMemoryManager::Clear(CpuMbl Block){
     return;
   }
 
-  //De-Allocate memory block
-  _MemoryPool.Free(_Block[Block].Ptr);
+  //De-Allocate memory block (shared data is only released with last block of share ring)
+  if(_Block[Block].ShareNext!=0){ _ShareUnlink(Block); }
+  else{
+    if(!_Block[Block].Inline){ _MemoryPool.Free(_Block[Block].Ptr); }
+    _MemUsage(-_PoolSize(Block));
+  }
+  _Block[Block].Inline=false;
   _Block[Block].Ptr=nullptr;
   _Block[Block].Size=0;
+  _Block[Block].Capacity=0;
   _Block[Block].Length=0;
   _Block[Block].ArrIndex=-1;
 
@@ -520,6 +1004,7 @@ String AuxMemoryManager::GetStatus(int ScopeId,CpuLon ScopeNr){
   long j;
   long BlockCount;
   CpuLon CumulSize;
+  CpuMbl Block;
   String Result;
 
   //Init result string
@@ -566,10 +1051,131 @@ String AuxMemoryManager::GetStatus(int ScopeId,CpuLon ScopeNr){
   }
   Result+="{"+ToString(BlockCount)+"bl:"+ToString(CumulSize)+"B}";
 
+  //Free handler stack
+  Result+=" freestack="+ToString(_FreeHndNr)+(_FreeHndDirty?"(dirty)":"");
+
+  //Blocks on scope chains
+  Result+=" chains={";
+  for(i=0;i<=_ScopeTop && i<_ScopeMax;i++){
+    BlockCount=0;
+    for(Block=_Scope[i].First;Block!=0;Block=_Block[Block].ScopeNext){ BlockCount++; }
+    if(BlockCount!=0){ Result+=" "+ToString(i)+":"+ToString(BlockCount)+"bl"; }
+  }
+  Result+=" }";
+
+  //Zombie reclaim counters
+  Result+=" reclaimed="+ToString(_ReclaimNr)+"bl/"+ToString(_ReclaimRuns)+"runs";
+
+  //Inline blocks
+  BlockCount=0;
+  for(j=1;j<_BlockMax;j++){ if(_Block[j].Used && _Block[j].Inline){ BlockCount++; } }
+  Result+=" inline="+ToString(BlockCount)+"bl";
+
+  //Shared blocks
+  BlockCount=0;
+  for(j=1;j<_BlockMax;j++){ if(_Block[j].Used && _Block[j].ShareNext!=0){ BlockCount++; } }
+  Result+=" shared="+ToString(BlockCount)+"bl";
+
+  //Frame release counter and memory usage
+  Result+=" released="+ToString(_ReleaseNr)+"bl"+(_EagerRelease?"":"(lazy)");
+  Result+=" memory="+ToString(_UsedMem)+"B/peak="+ToString(_PeakMem)+"B";
+
   //Total Blocks
   Result+=" total="+ToString(_BlockMax)+" }";
 
   //Return result
   return Result;
 
+}
+
+//Save state of used blocks (process snapshot)
+//(block count followed by block number, handler and data of each used block, data pointer only tells block had memory)
+void AuxMemoryManager::SaveState(Buffer& State){
+  
+  //Variables
+  CpuMbl i;
+  CpuMbl BlockNr;
+
+  //Block count
+  BlockNr=0;
+  for(i=1;i<_BlockMax;i++){ if(_Block[i].Used){ BlockNr++; } }
+  State.Append((const char *)&BlockNr,sizeof(CpuMbl));
+
+  //Blocks
+  for(i=1;i<_BlockMax;i++){
+    if(!_Block[i].Used){ continue; }
+    State.Append((const char *)&i,sizeof(CpuMbl));
+    State.Append((const char *)&_Block[i],sizeof(AuxBlock));
+    if(_Block[i].Ptr!=nullptr){ State.Append(_Block[i].Ptr,_Block[i].Size); }
+  }
+
+  //Debug message
+  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory manager state saved (blocks="+ToString(BlockNr)+")");
+
+}
+
+//Load state of used blocks (process snapshot)
+//(all blocks are released and blocks from state are allocated again under same block numbers, blocks that shared data get a copy)
+bool AuxMemoryManager::LoadState(const char *State,CpuWrd Length,CpuWrd& Offset,String& Error){
+  
+  //Variables
+  CpuMbl i;
+  CpuMbl Block;
+  CpuMbl BlockNr;
+  AuxBlock Hnd;
+  char *Ptr;
+
+  //Block count
+  if(Offset+(CpuWrd)sizeof(CpuMbl)>Length){ Error="truncated memory block table"; return false; }
+  MemCpy((char *)&BlockNr,State+Offset,sizeof(CpuMbl));
+  Offset+=sizeof(CpuMbl);
+
+  //Release all blocks (free handler stack is rebuilt on next handler request)
+  _FreeHndDirty=true;
+  for(i=1;i<_BlockMax;i++){ if(_Block[i].Used){ _Free(i); } }
+  for(i=0;i<AUXMAN_MAXGEN;i++){ _LiveGen[i]=0; }
+
+  //Allocate blocks
+  for(i=0;i<BlockNr;i++){
+    if(Offset+(CpuWrd)(sizeof(CpuMbl)+sizeof(AuxBlock))>Length){ Error="truncated memory block table"; return false; }
+    MemCpy((char *)&Block,State+Offset,sizeof(CpuMbl));
+    MemCpy((char *)&Hnd,State+Offset+sizeof(CpuMbl),sizeof(AuxBlock));
+    Offset+=sizeof(CpuMbl)+sizeof(AuxBlock);
+    if(Block<1 || Hnd.Size<0 || (Hnd.Ptr!=nullptr && Offset+Hnd.Size>Length)){ Error="invalid memory block "+ToString(Block); return false; }
+    while(Block>_BlockMax-1){
+      if(!_ExtendHandlers()){ Error="unable to extend memory handler table"; return false; }
+    }
+    if(_Block[Block].Used){ Error="duplicated memory block "+ToString(Block); return false; }
+    if(Hnd.ScopeId<0 || (Hnd.ScopeId>=_ScopeMax && !_ExtendScopes(Hnd.ScopeId))){ Error="invalid scope on memory block "+ToString(Block); return false; }
+    if(Hnd.Ptr!=nullptr && Hnd.Inline){
+      if(Hnd.Size>AUXMAN_INLINE){ Error="invalid memory block "+ToString(Block); return false; }
+      Offset+=Hnd.Size;
+      Ptr=_Block[Block].Small;
+    }
+    else if(Hnd.Ptr!=nullptr){
+      if((Ptr=_MemoryPool.Allocate(Hnd.Size,_ProcessId,true))==nullptr){ Error="unable to allocate memory block "+ToString(Block); return false; }
+      MemCpy(Ptr,State+Offset,Hnd.Size);
+      Offset+=Hnd.Size;
+    }
+    else{
+      Ptr=nullptr;
+    }
+    _Block[Block]=Hnd;
+    _Block[Block].Used=1;
+    _Block[Block].Inline=(Ptr!=nullptr && Hnd.Inline);
+    _Block[Block].SharePrev=0;
+    _Block[Block].ShareNext=0;
+    _Block[Block].Ptr=Ptr;
+    _Block[Block].Capacity=(_Block[Block].Inline?AUXMAN_INLINE:Hnd.Size);
+    _ScopeLink(Block);
+    _MemUsage(_PoolSize(Block));
+  }
+
+  //Debug message
+  DebugMessage(DebugLevel::VrmAuxMemory,"Aux memory manager state loaded (blocks="+ToString(BlockNr)+")");
+  DebugMessage(DebugLevel::VrmAuxMemStatus,GetStatus(0,0));
+
+  //Return code
+  return true;
+
 }
\ No newline at end of file
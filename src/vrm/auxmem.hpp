@@ -1,6 +1,11 @@
 //auxmem.hpp: Auxiliar CPU memory manager
 //This memory controller uses a chained list instead of a memory map, however there is still a table for the memory handlers
 //The reason to have a table for the memory handers is that compiler assigns block numbers sequentially when allocating constant strings and arrays
+//Small strings are stored inline on their handler, pointers to their data are only valid until handler table is extended
+//(any allocation of a new block can extend it), Pin() moves them to memory pool when a pointer must live longer
+//Strings on memory pool can share their data, blocks sharing same data are linked on a share ring (number of blocks on ring is the
+//reference count of data), data is copied when a block of the ring is re-allocated or unshared and released with last block of ring,
+//strings that handed out references to write on their data are detached and never share it again
 
 //Wrap include
 #ifndef _AU2MEM_HPP
@@ -9,6 +14,11 @@
 //Memory definitions
 #define AUXMAN_FREEBITS 64
 #define AUXMAN_FREELIST 256
+#define AUXMAN_MAXGEN   256
+#define AUXMAN_SCOPES   64
+#define AUXMAN_GROWTH   2
+#define AUXMAN_SHRINK   4
+#define AUXMAN_INLINE   16
 
 //Aux memory manager exception numbers
 enum class AuxMemoryException{
@@ -21,10 +31,25 @@ struct AuxBlock{
   int ScopeId;    //ScopeId of allocated block
   CpuLon ScopeNr; //ScopeNr of allocated block
   bool Used;      //Used flag
+  bool Inline;    //Block data is stored inline on handler (Ptr points to Small)
+  bool NoShare;   //Block data is never shared (references to write on it were handed out)
   CpuWrd Size;    //Memory request size
+  CpuWrd Capacity; //Memory allocated for block (never below size, grows geometrically and shrinks with hysteresis)
   CpuWrd Length;  //String length (used when block allocates a string)
   int ArrIndex;   //Array definition index (used when block allocates an array)
   char *Ptr;      //Pointer to data
+  CpuMbl ScopePrev; //Previous (older) used block of same ScopeId (zero when block is first on scope chain)
+  CpuMbl ScopeNext; //Next (newer) used block of same ScopeId (zero when block is last on scope chain)
+  CpuLon FrameNr;   //ScopeNr of function whose stack frame holds the block (zero when block is not held on a known stack frame)
+  CpuMbl SharePrev; //Previous block on share ring (zero when block data is not shared)
+  CpuMbl ShareNext; //Next block on share ring (zero when block data is not shared)
+  char Small[AUXMAN_INLINE]; //Inline storage for small strings (saves a memory pool block)
+};
+
+//Scope chain (used blocks of one ScopeId, from oldest to newest)
+struct AuxScope{
+  CpuMbl First; //Oldest block (zero when chain is empty)
+  CpuMbl Last;  //Newest block (zero when chain is empty)
 };
 
 //Auxiliar memory manager class
@@ -38,13 +63,85 @@ class AuxMemoryManager{
     AuxBlock *_Block;       //Memory handler table
     CpuMbl _BlockMax;       //Memory handler table size
     int _ProcessId;         //Process Id owner
-    CpuMbl _LastBlockAsg;   //Last assigned handler (used to optimize free handler search)
+    CpuMbl *_FreeHnd;       //Free handler stack (lowest handlers on top)
+    CpuMbl _FreeHndNr;      //Free handlers on stack
+    bool _FreeHndDirty;     //Free handler stack must be rebuilt (handlers were taken by number)
+    AuxScope *_Scope;       //Scope chains (indexed by ScopeId)
+    int _ScopeMax;          //Scope chain table size
+    int _ScopeTop;          //Highest ScopeId that can have a non empty scope chain
+    CpuLon _ReclaimNr;      //Zombie handlers reclaimed from scope chains
+    CpuLon _ReclaimRuns;    //Scope chain reclaim passes
+    RamBuffer<char> *_Stack; //Stack buffer (to find out whether blocks are held on stack frames)
+    CpuWrd _FrameBase;      //Base pointer of current function
+    CpuLon _FrameNr;        //ScopeNr of current function
+    CpuWrd _CallerBase;     //Base pointer of calling function
+    CpuLon _CallerNr;       //ScopeNr of calling function
+    bool _EagerRelease;     //Blocks held on stack frame of a function are released when it returns
+    CpuLon _ReleaseNr;      //Blocks released on function return
+    CpuLon _UsedMem;        //Memory allocated by used blocks
+    CpuLon _PeakMem;        //Peak of memory allocated by used blocks
+    static bool _DefEagerRelease; //Eager release for new memory managers
     MemoryPool _MemoryPool; //Internal memory pool     
+    CpuLon _LiveGen[AUXMAN_MAXGEN]; //Scope numbers of live generators (blocks of live generators are never zombies)
+
+    //Insert block at end of its scope chain (scope chain table must be big enough)
+    inline void _ScopeLink(CpuMbl Block){
+      int ScopeId=_Block[Block].ScopeId;
+      _Block[Block].ScopeNext=0;
+      _Block[Block].ScopePrev=_Scope[ScopeId].Last;
+      if(_Scope[ScopeId].Last!=0){ _Block[_Scope[ScopeId].Last].ScopeNext=Block; } else{ _Scope[ScopeId].First=Block; }
+      _Scope[ScopeId].Last=Block;
+      if(ScopeId>_ScopeTop){ _ScopeTop=ScopeId; }
+    }
+
+    //Remove block from its scope chain
+    inline void _ScopeUnlink(CpuMbl Block){
+      int ScopeId=_Block[Block].ScopeId;
+      if(_Block[Block].ScopePrev!=0){ _Block[_Block[Block].ScopePrev].ScopeNext=_Block[Block].ScopeNext; } else{ _Scope[ScopeId].First=_Block[Block].ScopeNext; }
+      if(_Block[Block].ScopeNext!=0){ _Block[_Block[Block].ScopeNext].ScopePrev=_Block[Block].ScopePrev; } else{ _Scope[ScopeId].Last=_Block[Block].ScopePrev; }
+      _Block[Block].ScopePrev=0;
+      _Block[Block].ScopeNext=0;
+    }
+
+    //Insert block on share ring of source block (block takes data of source block)
+    inline void _ShareLink(CpuMbl Block,CpuMbl Src){
+      if(_Block[Src].ShareNext==0){ _Block[Src].ShareNext=Src; _Block[Src].SharePrev=Src; }
+      _Block[Block].SharePrev=Src;
+      _Block[Block].ShareNext=_Block[Src].ShareNext;
+      _Block[_Block[Src].ShareNext].SharePrev=Block;
+      _Block[Src].ShareNext=Block;
+    }
+
+    //Remove block from its share ring (remaining block is no longer shared when ring had two blocks)
+    inline void _ShareUnlink(CpuMbl Block){
+      CpuMbl Prev=_Block[Block].SharePrev;
+      CpuMbl Next=_Block[Block].ShareNext;
+      if(Prev==Next){ _Block[Next].SharePrev=0; _Block[Next].ShareNext=0; }
+      else{ _Block[Prev].ShareNext=Next; _Block[Next].SharePrev=Prev; }
+      _Block[Block].SharePrev=0;
+      _Block[Block].ShareNext=0;
+    }
+
+    //Memory pool space taken by block (inline blocks take none)
+    inline CpuWrd _PoolSize(CpuMbl Block){ return (_Block[Block].Inline?0:_Block[Block].Capacity); }
+
+    //Account memory allocated by used blocks
+    inline void _MemUsage(CpuWrd Delta){
+      _UsedMem+=Delta;
+      if(_UsedMem>_PeakMem){ _PeakMem=_UsedMem; }
+    }
 
     //Handler methods
     bool _ExtendHandlers();
+    bool _ExtendScopes(int ScopeId);
+    void _RebuildFreeHandlers();
     bool _GetHandler(int ScopeId,CpuLon ScopeNr,CpuMbl *Block);
+    CpuMbl _Reclaim(int ScopeId,CpuLon ScopeNr,CpuMbl Keep,CpuWrd Size,char **Ptr);
     void _Free(CpuMbl Block);
+    bool _Resize(int ScopeId,CpuLon ScopeNr,CpuMbl Block,CpuWrd Capacity);
+    bool _Unshare(int ScopeId,CpuLon ScopeNr,CpuMbl Block,CpuWrd Capacity,bool KeepData);
+    CpuMbl _ReleaseChain(int ScopeId,CpuLon ScopeNr);
+    void _ReleaseFrame(int ScopeId,CpuLon ScopeNr);
 
   //Public members
   public:
@@ -55,12 +152,18 @@ class AuxMemoryManager{
     bool EmptyAlloc(int ScopeId,CpuLon ScopeNr,CpuMbl *Block);
     bool Alloc(int ScopeId,CpuLon ScopeNr,CpuWrd Size,int ArrIndex,CpuMbl *Block);
     bool ForcedAlloc(int ScopeId,CpuLon ScopeNr,CpuWrd Size,int ArrIndex,CpuMbl Block);
-    bool Realloc(int ScopeId,CpuLon ScopeNr,CpuMbl Block,CpuWrd Size);
+    bool Realloc(int ScopeId,CpuLon ScopeNr,CpuMbl Block,CpuWrd Size,bool KeepData=true);
+    bool Reserve(int ScopeId,CpuLon ScopeNr,CpuMbl Block,CpuWrd Capacity);
+    bool Shrink(int ScopeId,CpuLon ScopeNr,CpuMbl Block);
+    bool Pin(int ScopeId,CpuLon ScopeNr,CpuMbl Block);
+    void Move(CpuMbl Des,CpuMbl Src);
+    void Share(CpuMbl Des,CpuMbl Src);
+    bool Unshare(int ScopeId,CpuLon ScopeNr,CpuMbl Block);
+    bool Detach(int ScopeId,CpuLon ScopeNr,CpuMbl Block);
     void Free(CpuMbl Block);
     void Clear(CpuMbl Block);
     void Copy(CpuMbl Block, char *Src,CpuWrd Length);
     inline char *CharPtr(CpuMbl Block){ return _Block[Block].Ptr; }
-    inline void SetPtr(CpuMbl Block,char *Pnt){ _Block[Block].Ptr=Pnt; }
     inline int ScopeId(CpuMbl Block){ return _Block[Block].ScopeId; }        
     inline CpuLon ScopeNr(CpuMbl Block){ return _Block[Block].ScopeNr; }        
     inline bool IsValid(CpuMbl Block){ return ((Block)>=0&&(Block)<=_BlockMax-1?_Block[Block].Used:false); }
@@ -68,11 +171,37 @@ class AuxMemoryManager{
     inline int GetArrIndex(CpuMbl Block){ return _Block[Block].ArrIndex; }         
     inline CpuWrd GetLen(CpuMbl Block){ return _Block[Block].Length; }         
     inline CpuWrd GetSize(CpuMbl Block){ return _Block[Block].Size; }         
+    inline CpuWrd GetCapacity(CpuMbl Block){ return _Block[Block].Capacity; }         
+    inline bool IsInline(CpuMbl Block){ return _Block[Block].Inline; }         
+    inline bool IsShared(CpuMbl Block){ return _Block[Block].ShareNext!=0; }         
+    inline bool IsShareable(CpuMbl Block){ return _Block[Block].ArrIndex==-1 && !_Block[Block].Inline && !_Block[Block].NoShare && _Block[Block].Ptr!=nullptr; }
+    inline bool IsDetached(CpuMbl Block){ return _Block[Block].NoShare; }         
+    inline CpuMbl GetBlockMax(){ return _BlockMax; }
     inline void SetLen(CpuMbl Block,CpuWrd Length){ _Block[Block].Length=Length; }         
     inline void SetSize(CpuMbl Block,CpuWrd Size){ _Block[Block].Size=Size; }         
-    inline bool IsZombie(CpuMbl Block,int ScopeId,CpuLon ScopeNr){ return (_Block[Block].ScopeId>ScopeId || (_Block[Block].ScopeId==ScopeId && _Block[Block].ScopeNr!=ScopeNr))?true:false; }
+    inline bool IsZombie(CpuMbl Block,int ScopeId,CpuLon ScopeNr){ return (_Block[Block].ScopeId>ScopeId || (_Block[Block].ScopeId==ScopeId && _Block[Block].ScopeNr!=ScopeNr))&&!IsLiveGen(_Block[Block].ScopeNr)?true:false; }
+    inline bool IsLiveGen(CpuLon ScopeNr){ return ScopeNr<0 && _LiveGen[(-ScopeNr-1)%AUXMAN_MAXGEN]==ScopeNr; }
+    inline void SetLiveGen(int Slot,CpuLon ScopeNr){ _LiveGen[Slot]=ScopeNr; }
     String GetStatus(int ScopeId,CpuLon ScopeNr);    
 
+    //Stack frame methods
+    inline void SetStack(RamBuffer<char> *Stack){ _Stack=Stack; }
+    inline void SetFrame(CpuWrd BasePointer,CpuLon ScopeNr,CpuWrd CallerBase,CpuLon CallerNr){ 
+      _FrameBase=BasePointer; _FrameNr=ScopeNr; _CallerBase=CallerBase; _CallerNr=CallerNr; 
+    }
+    inline void SetHolder(CpuMbl Block,const void *Holder){
+      if(_Stack==nullptr || (const char *)Holder<_Stack->Pnt()+_CallerBase || (const char *)Holder>=_Stack->Pnt()+_Stack->Length()){ return; }
+      _Block[Block].FrameNr=((const char *)Holder>=_Stack->Pnt()+_FrameBase?_FrameNr:_CallerNr);
+    }
+    inline void ReleaseFrame(int ScopeId,CpuLon ScopeNr){ if(_EagerRelease && ScopeNr>0){ _ReleaseFrame(ScopeId,ScopeNr); } }
+    inline CpuLon PeakMemory(){ return _PeakMem; }
+    inline CpuLon ReleasedBlocks(){ return _ReleaseNr; }
+    static void SetEagerRelease(bool Enable);
+
+    //Process snapshot methods
+    void SaveState(Buffer& State);
+    bool LoadState(const char *State,CpuWrd Length,CpuWrd& Offset,String& Error);
+
     //Constructors/Destructors
     AuxMemoryManager();
     ~AuxMemoryManager();
@@ -0,0 +1,422 @@
+//jit.cpp: Baseline template JIT compiler
+#include "bas/basedefs.hpp"
+#include "bas/allocator.hpp"
+#include "bas/array.hpp"
+#include "bas/stack.hpp"
+#include "bas/buffer.hpp"
+#include "bas/string.hpp"
+#include "sys/sysdefs.hpp"
+#include "sys/system.hpp"
+#include "sys/stl.hpp"
+#include "sys/msgout.hpp"
+#include "vrm/jit.hpp"
+
+//Minimun number of instructions in a region to translate it
+#define JIT_MIN_REGION_INSTS 2
+
+//Native registers (x86-64 encoding)
+#define JIT_RAX  0
+#define JIT_RCX  1
+#define JIT_XMM0 0
+
+//Native code templates
+//(all memory operands are [rdi+disp32], rdi holds frame pointer StackPnt+BP)
+#define JIT_LOAD32   "\x8B"
+#define JIT_LOAD64   "\x48\x8B"
+#define JIT_STORE8   "\x88"
+#define JIT_STORE32  "\x89"
+#define JIT_STORE64  "\x48\x89"
+#define JIT_ADD32    "\x03"
+#define JIT_ADD64    "\x48\x03"
+#define JIT_SUB32    "\x2B"
+#define JIT_SUB64    "\x48\x2B"
+#define JIT_MUL32    "\x0F\xAF"
+#define JIT_MUL64    "\x48\x0F\xAF"
+#define JIT_CMP32    "\x3B"
+#define JIT_CMP64    "\x48\x3B"
+#define JIT_INCDEC32 "\x83"
+#define JIT_INCDEC64 "\x48\x83"
+#define JIT_MOVIMM32 "\xC7"
+#define JIT_CMPIMM8  "\x80"
+#define JIT_FLOLOAD  "\xF2\x0F\x10"
+#define JIT_FLOSTORE "\xF2\x0F\x11"
+#define JIT_FLOADD   "\xF2\x0F\x58"
+#define JIT_FLOSUB   "\xF2\x0F\x5C"
+#define JIT_FLOMUL   "\xF2\x0F\x59"
+#define JIT_FLOCMP   "\x66\x0F\x2E"
+#define JIT_JMP      "\xE9"
+#define JIT_JE       "\x0F\x84"
+#define JIT_JNE      "\x0F\x85"
+
+//Condition codes for setcc (second opcode byte)
+#define JIT_SETL  0x9C
+#define JIT_SETLE 0x9E
+#define JIT_SETG  0x9F
+#define JIT_SETGE 0x9D
+#define JIT_SETE  0x94
+#define JIT_SETNE 0x95
+#define JIT_SETA  0x97
+#define JIT_SETAE 0x93
+#define JIT_SETNP 0x9B
+#define JIT_SETP  0x9A
+
+//Operand read from code buffer
+#define JIT_ARGADR(n) (*(CpuAdr *)(CodePtr+IP+_Inst[(int)InstCode].Offset[n]))
+#define JIT_ARGINT(n) (*(CpuInt *)(CodePtr+IP+_Inst[(int)InstCode].Offset[n]))
+#define JIT_ARGLON(n) (*(CpuLon *)(CodePtr+IP+_Inst[(int)InstCode].Offset[n]))
+
+//Jit compiler available on this platform
+bool JitCompiler::Supported(){
+  #ifdef __JIT__
+  return true;
+  #else
+  return false;
+  #endif
+}
+
+//Instruction is translated to native code
+bool JitCompiler::_IsSupported(CpuInstCode InstCode){
+  switch(InstCode){
+    case CpuInstCode::NOP:
+    case CpuInstCode::MVi:   case CpuInstCode::MVl:   case CpuInstCode::MVf:
+    case CpuInstCode::LOADi: case CpuInstCode::LOADl: case CpuInstCode::LOADf:
+    case CpuInstCode::NEGi:  case CpuInstCode::NEGl:  case CpuInstCode::NEGf:
+    case CpuInstCode::ADDi:  case CpuInstCode::ADDl:  case CpuInstCode::ADDf:
+    case CpuInstCode::SUBi:  case CpuInstCode::SUBl:  case CpuInstCode::SUBf:
+    case CpuInstCode::MULi:  case CpuInstCode::MULl:  case CpuInstCode::MULf:
+    case CpuInstCode::MVADi: case CpuInstCode::MVADl: case CpuInstCode::MVADf:
+    case CpuInstCode::MVSUi: case CpuInstCode::MVSUl: case CpuInstCode::MVSUf:
+    case CpuInstCode::MVMUi: case CpuInstCode::MVMUl: case CpuInstCode::MVMUf:
+    case CpuInstCode::INCi:  case CpuInstCode::INCl:
+    case CpuInstCode::DECi:  case CpuInstCode::DECl:
+    case CpuInstCode::LESi:  case CpuInstCode::LESl:  case CpuInstCode::LESf:
+    case CpuInstCode::LEQi:  case CpuInstCode::LEQl:  case CpuInstCode::LEQf:
+    case CpuInstCode::GREi:  case CpuInstCode::GREl:  case CpuInstCode::GREf:
+    case CpuInstCode::GEQi:  case CpuInstCode::GEQl:  case CpuInstCode::GEQf:
+    case CpuInstCode::EQUi:  case CpuInstCode::EQUl:  case CpuInstCode::EQUf:
+    case CpuInstCode::DISi:  case CpuInstCode::DISl:  case CpuInstCode::DISf:
+    case CpuInstCode::JMP:
+    case CpuInstCode::JMPTR:
+    case CpuInstCode::JMPFL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//Check address operands fit in a 32-bit displacement
+bool JitCompiler::_OperandsFit(const char *CodePtr,CpuAdr IP,CpuInstCode InstCode){
+  for(int i=0;i<_Inst[(int)InstCode].ArgNr;i++){
+    if(_Inst[(int)InstCode].AdrMode[i]==CpuAdrMode::Address){
+      if(JIT_ARGADR(i)<0 || JIT_ARGADR(i)>INT32_MAX){ return false; }
+    }
+  }
+  return true;
+}
+
+//Emit byte
+void JitCompiler::_EmitByte(unsigned char Byte){
+  _Text.Append((const char *)&Byte,1);
+}
+
+//Emit 32-bit value
+void JitCompiler::_EmitDword(int32_t Value){
+  _Text.Append((const char *)&Value,sizeof(int32_t));
+}
+
+//Emit 64-bit value
+void JitCompiler::_EmitQword(int64_t Value){
+  _Text.Append((const char *)&Value,sizeof(int64_t));
+}
+
+//Emit instruction with memory operand [rdi+disp32]
+void JitCompiler::_EmitMem(const char *Opcode,int Reg,CpuAdr Disp){
+  _Text.Append(Opcode,strlen(Opcode));
+  _EmitByte(0x87|(Reg<<3));
+  _EmitDword((int32_t)Disp);
+}
+
+//Emit return to interpreter (mov rax,Target; ret)
+void JitCompiler::_EmitExit(CpuAdr Target){
+  _EmitByte(0x48);
+  _EmitByte(0xB8);
+  _EmitQword((int64_t)Target);
+  _EmitByte(0xC3);
+}
+
+//Emit jump (native jump when target is translated in same region, otherwise return to interpreter)
+void JitCompiler::_EmitJump(const char *Opcode,CpuAdr Target,CpuAdr RegionBeg,CpuAdr RegionEnd,const char *Flags,Array<JitPatch>& Patches){
+  if(Target>=RegionBeg && Target<RegionEnd && (Flags[Target]&JitFlag::InstStart)){
+    _Text.Append(Opcode,strlen(Opcode));
+    Patches.Add((JitPatch){_Text.Length(),Target});
+    _EmitDword(0);
+  }
+  else if(strcmp(Opcode,JIT_JMP)==0){
+    _EmitExit(Target);
+  }
+  else{
+    _EmitByte(strcmp(Opcode,JIT_JE)==0?0x75:0x74); //Short jump with inverted condition over exit sequence
+    _EmitByte(11);
+    _EmitExit(Target);
+  }
+}
+
+//Emit native code for one instruction
+void JitCompiler::_EmitInstruction(const char *CodePtr,CpuAdr IP,CpuInstCode InstCode,CpuAdr RegionBeg,CpuAdr RegionEnd,const char *Flags,Array<JitPatch>& Patches){
+
+  //Switch on instruction
+  switch(InstCode){
+
+    //No operation
+    case CpuInstCode::NOP:
+      break;
+
+    //Moves
+    case CpuInstCode::MVi: _EmitMem(JIT_LOAD32,JIT_RAX,JIT_ARGADR(1)); _EmitMem(JIT_STORE32,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::MVl: _EmitMem(JIT_LOAD64,JIT_RAX,JIT_ARGADR(1)); _EmitMem(JIT_STORE64,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::MVf: _EmitMem(JIT_LOAD64,JIT_RAX,JIT_ARGADR(1)); _EmitMem(JIT_STORE64,JIT_RAX,JIT_ARGADR(0)); break;
+
+    //Loads (mov dword [m],imm32 / mov rax,imm64 + store)
+    case CpuInstCode::LOADi:
+      _EmitMem(JIT_MOVIMM32,0,JIT_ARGADR(0));
+      _EmitDword(JIT_ARGINT(1));
+      break;
+    case CpuInstCode::LOADl:
+    case CpuInstCode::LOADf:
+      _EmitByte(0x48); _EmitByte(0xB8); _EmitQword(JIT_ARGLON(1));
+      _EmitMem(JIT_STORE64,JIT_RAX,JIT_ARGADR(0));
+      break;
+
+    //Negation (neg eax / neg rax / btc rax,63)
+    case CpuInstCode::NEGi: _EmitMem(JIT_LOAD32,JIT_RAX,JIT_ARGADR(1)); _EmitByte(0xF7); _EmitByte(0xD8); _EmitMem(JIT_STORE32,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::NEGl: _EmitMem(JIT_LOAD64,JIT_RAX,JIT_ARGADR(1)); _EmitByte(0x48); _EmitByte(0xF7); _EmitByte(0xD8); _EmitMem(JIT_STORE64,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::NEGf: _EmitMem(JIT_LOAD64,JIT_RAX,JIT_ARGADR(1)); _EmitByte(0x48); _EmitByte(0x0F); _EmitByte(0xBA); _EmitByte(0xF8); _EmitByte(63); _EmitMem(JIT_STORE64,JIT_RAX,JIT_ARGADR(0)); break;
+
+    //Arithmetic
+    case CpuInstCode::ADDi: _EmitMem(JIT_LOAD32,JIT_RAX,JIT_ARGADR(1)); _EmitMem(JIT_ADD32,JIT_RAX,JIT_ARGADR(2)); _EmitMem(JIT_STORE32,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::ADDl: _EmitMem(JIT_LOAD64,JIT_RAX,JIT_ARGADR(1)); _EmitMem(JIT_ADD64,JIT_RAX,JIT_ARGADR(2)); _EmitMem(JIT_STORE64,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::ADDf: _EmitMem(JIT_FLOLOAD,JIT_XMM0,JIT_ARGADR(1)); _EmitMem(JIT_FLOADD,JIT_XMM0,JIT_ARGADR(2)); _EmitMem(JIT_FLOSTORE,JIT_XMM0,JIT_ARGADR(0)); break;
+    case CpuInstCode::SUBi: _EmitMem(JIT_LOAD32,JIT_RAX,JIT_ARGADR(1)); _EmitMem(JIT_SUB32,JIT_RAX,JIT_ARGADR(2)); _EmitMem(JIT_STORE32,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::SUBl: _EmitMem(JIT_LOAD64,JIT_RAX,JIT_ARGADR(1)); _EmitMem(JIT_SUB64,JIT_RAX,JIT_ARGADR(2)); _EmitMem(JIT_STORE64,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::SUBf: _EmitMem(JIT_FLOLOAD,JIT_XMM0,JIT_ARGADR(1)); _EmitMem(JIT_FLOSUB,JIT_XMM0,JIT_ARGADR(2)); _EmitMem(JIT_FLOSTORE,JIT_XMM0,JIT_ARGADR(0)); break;
+    case CpuInstCode::MULi: _EmitMem(JIT_LOAD32,JIT_RAX,JIT_ARGADR(1)); _EmitMem(JIT_MUL32,JIT_RAX,JIT_ARGADR(2)); _EmitMem(JIT_STORE32,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::MULl: _EmitMem(JIT_LOAD64,JIT_RAX,JIT_ARGADR(1)); _EmitMem(JIT_MUL64,JIT_RAX,JIT_ARGADR(2)); _EmitMem(JIT_STORE64,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::MULf: _EmitMem(JIT_FLOLOAD,JIT_XMM0,JIT_ARGADR(1)); _EmitMem(JIT_FLOMUL,JIT_XMM0,JIT_ARGADR(2)); _EmitMem(JIT_FLOSTORE,JIT_XMM0,JIT_ARGADR(0)); break;
+
+    //Move and operate
+    case CpuInstCode::MVADi: _EmitMem(JIT_LOAD32,JIT_RAX,JIT_ARGADR(0)); _EmitMem(JIT_ADD32,JIT_RAX,JIT_ARGADR(1)); _EmitMem(JIT_STORE32,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::MVADl: _EmitMem(JIT_LOAD64,JIT_RAX,JIT_ARGADR(0)); _EmitMem(JIT_ADD64,JIT_RAX,JIT_ARGADR(1)); _EmitMem(JIT_STORE64,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::MVADf: _EmitMem(JIT_FLOLOAD,JIT_XMM0,JIT_ARGADR(0)); _EmitMem(JIT_FLOADD,JIT_XMM0,JIT_ARGADR(1)); _EmitMem(JIT_FLOSTORE,JIT_XMM0,JIT_ARGADR(0)); break;
+    case CpuInstCode::MVSUi: _EmitMem(JIT_LOAD32,JIT_RAX,JIT_ARGADR(0)); _EmitMem(JIT_SUB32,JIT_RAX,JIT_ARGADR(1)); _EmitMem(JIT_STORE32,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::MVSUl: _EmitMem(JIT_LOAD64,JIT_RAX,JIT_ARGADR(0)); _EmitMem(JIT_SUB64,JIT_RAX,JIT_ARGADR(1)); _EmitMem(JIT_STORE64,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::MVSUf: _EmitMem(JIT_FLOLOAD,JIT_XMM0,JIT_ARGADR(0)); _EmitMem(JIT_FLOSUB,JIT_XMM0,JIT_ARGADR(1)); _EmitMem(JIT_FLOSTORE,JIT_XMM0,JIT_ARGADR(0)); break;
+    case CpuInstCode::MVMUi: _EmitMem(JIT_LOAD32,JIT_RAX,JIT_ARGADR(0)); _EmitMem(JIT_MUL32,JIT_RAX,JIT_ARGADR(1)); _EmitMem(JIT_STORE32,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::MVMUl: _EmitMem(JIT_LOAD64,JIT_RAX,JIT_ARGADR(0)); _EmitMem(JIT_MUL64,JIT_RAX,JIT_ARGADR(1)); _EmitMem(JIT_STORE64,JIT_RAX,JIT_ARGADR(0)); break;
+    case CpuInstCode::MVMUf: _EmitMem(JIT_FLOLOAD,JIT_XMM0,JIT_ARGADR(0)); _EmitMem(JIT_FLOMUL,JIT_XMM0,JIT_ARGADR(1)); _EmitMem(JIT_FLOSTORE,JIT_XMM0,JIT_ARGADR(0)); break;
+
+    //Increment / decrement (add/sub [m],1)
+    case CpuInstCode::INCi: _EmitMem(JIT_INCDEC32,0,JIT_ARGADR(0)); _EmitByte(1); break;
+    case CpuInstCode::INCl: _EmitMem(JIT_INCDEC64,0,JIT_ARGADR(0)); _EmitByte(1); break;
+    case CpuInstCode::DECi: _EmitMem(JIT_INCDEC32,5,JIT_ARGADR(0)); _EmitByte(1); break;
+    case CpuInstCode::DECl: _EmitMem(JIT_INCDEC64,5,JIT_ARGADR(0)); _EmitByte(1); break;
+
+    //Integer comparisons (cmp + setcc al + store byte)
+    case CpuInstCode::LESi: case CpuInstCode::LEQi: case CpuInstCode::GREi: case CpuInstCode::GEQi: case CpuInstCode::EQUi: case CpuInstCode::DISi:
+    case CpuInstCode::LESl: case CpuInstCode::LEQl: case CpuInstCode::GREl: case CpuInstCode::GEQl: case CpuInstCode::EQUl: case CpuInstCode::DISl:
+      {
+        bool Wide=(InstCode==CpuInstCode::LESl || InstCode==CpuInstCode::LEQl || InstCode==CpuInstCode::GREl || InstCode==CpuInstCode::GEQl || InstCode==CpuInstCode::EQUl || InstCode==CpuInstCode::DISl);
+        unsigned char SetCode;
+        switch(InstCode){
+          case CpuInstCode::LESi: case CpuInstCode::LESl: SetCode=JIT_SETL;  break;
+          case CpuInstCode::LEQi: case CpuInstCode::LEQl: SetCode=JIT_SETLE; break;
+          case CpuInstCode::GREi: case CpuInstCode::GREl: SetCode=JIT_SETG;  break;
+          case CpuInstCode::GEQi: case CpuInstCode::GEQl: SetCode=JIT_SETGE; break;
+          case CpuInstCode::EQUi: case CpuInstCode::EQUl: SetCode=JIT_SETE;  break;
+          default:                                        SetCode=JIT_SETNE; break;
+        }
+        _EmitMem(Wide?JIT_LOAD64:JIT_LOAD32,JIT_RAX,JIT_ARGADR(1));
+        _EmitMem(Wide?JIT_CMP64:JIT_CMP32,JIT_RAX,JIT_ARGADR(2));
+        _EmitByte(0x0F); _EmitByte(SetCode); _EmitByte(0xC0);
+        _EmitMem(JIT_STORE8,JIT_RAX,JIT_ARGADR(0));
+      }
+      break;
+
+    //Float comparisons (ucomisd leaves CF=ZF=PF=1 when unordered, so less than comparisons swap operands
+    //and use above conditions, equality tests also check parity flag to give same result as C++ on NaN)
+    case CpuInstCode::LESf: case CpuInstCode::LEQf:
+      _EmitMem(JIT_FLOLOAD,JIT_XMM0,JIT_ARGADR(2));
+      _EmitMem(JIT_FLOCMP,JIT_XMM0,JIT_ARGADR(1));
+      _EmitByte(0x0F); _EmitByte(InstCode==CpuInstCode::LESf?JIT_SETA:JIT_SETAE); _EmitByte(0xC0);
+      _EmitMem(JIT_STORE8,JIT_RAX,JIT_ARGADR(0));
+      break;
+    case CpuInstCode::GREf: case CpuInstCode::GEQf:
+      _EmitMem(JIT_FLOLOAD,JIT_XMM0,JIT_ARGADR(1));
+      _EmitMem(JIT_FLOCMP,JIT_XMM0,JIT_ARGADR(2));
+      _EmitByte(0x0F); _EmitByte(InstCode==CpuInstCode::GREf?JIT_SETA:JIT_SETAE); _EmitByte(0xC0);
+      _EmitMem(JIT_STORE8,JIT_RAX,JIT_ARGADR(0));
+      break;
+    case CpuInstCode::EQUf:
+      _EmitMem(JIT_FLOLOAD,JIT_XMM0,JIT_ARGADR(1));
+      _EmitMem(JIT_FLOCMP,JIT_XMM0,JIT_ARGADR(2));
+      _EmitByte(0x0F); _EmitByte(JIT_SETE);  _EmitByte(0xC0);
+      _EmitByte(0x0F); _EmitByte(JIT_SETNP); _EmitByte(0xC1);
+      _EmitByte(0x20); _EmitByte(0xC8); //and al,cl
+      _EmitMem(JIT_STORE8,JIT_RAX,JIT_ARGADR(0));
+      break;
+    case CpuInstCode::DISf:
+      _EmitMem(JIT_FLOLOAD,JIT_XMM0,JIT_ARGADR(1));
+      _EmitMem(JIT_FLOCMP,JIT_XMM0,JIT_ARGADR(2));
+      _EmitByte(0x0F); _EmitByte(JIT_SETNE); _EmitByte(0xC0);
+      _EmitByte(0x0F); _EmitByte(JIT_SETP);  _EmitByte(0xC1);
+      _EmitByte(0x08); _EmitByte(0xC8); //or al,cl
+      _EmitMem(JIT_STORE8,JIT_RAX,JIT_ARGADR(0));
+      break;
+
+    //Jumps (jump offsets are relative to jump instruction)
+    case CpuInstCode::JMP:
+      _EmitJump(JIT_JMP,IP+JIT_ARGADR(0),RegionBeg,RegionEnd,Flags,Patches);
+      break;
+    case CpuInstCode::JMPTR:
+      _EmitMem(JIT_CMPIMM8,7,JIT_ARGADR(0)); _EmitByte(0);
+      _EmitJump(JIT_JNE,IP+JIT_ARGADR(1),RegionBeg,RegionEnd,Flags,Patches);
+      break;
+    case CpuInstCode::JMPFL:
+      _EmitMem(JIT_CMPIMM8,7,JIT_ARGADR(0)); _EmitByte(0);
+      _EmitJump(JIT_JE,IP+JIT_ARGADR(1),RegionBeg,RegionEnd,Flags,Patches);
+      break;
+
+    //Rest of instructions are not translated
+    default:
+      break;
+
+  }
+
+}
+
+//Translate code buffer
+//(must be called before local variable addresses are decoded, as native code uses original frame offsets)
+bool JitCompiler::Compile(const char *CodePtr,CpuAdr CodeLength){
+
+  //Variables
+  int i;
+  bool Prefixed;
+  CpuAdr IP;
+  CpuAdr Target;
+  CpuAdr RegionBeg;
+  CpuAdr RegionEnd;
+  CpuInstCode InstCode;
+  Buffer Flags;
+  Array<JitLabel> Labels;
+  Array<JitLabel> Entries;
+  Array<JitPatch> Patches;
+
+  //Release previous compilation
+  Release();
+  if(!Supported()){ return true; }
+
+  //Debug message
+  DebugMessage(DebugLevel::VrmRuntime,"Entered jit compilation (codeptr="+HEXFORMAT(CodePtr)+" length="+ToString(CodeLength)+")");
+
+  //Scan code buffer to find instruction starts, jump targets and translatable instructions
+  //(instructions programmed by decoder instructions are not translated, as decoder modes are set at run time)
+  Flags=Buffer(CodeLength,0);
+  Prefixed=false;
+  for(IP=0;IP<CodeLength;IP+=_Inst[(int)InstCode].Length){
+    InstCode=(CpuInstCode)(*(CpuIcd *)(CodePtr+IP));
+    if((int)InstCode<0 || (int)InstCode>=_InstructionNr){ return true; }
+    Flags[IP]|=JitFlag::InstStart;
+    if(InstCode>=CpuInstCode::DAGV1 && InstCode<=CpuInstCode::DALI4){ Prefixed=true; continue; }
+    if(!Prefixed && _IsSupported(InstCode) && _OperandsFit(CodePtr,IP,InstCode)){ Flags[IP]|=JitFlag::Translate; }
+    if(InstCode==CpuInstCode::JMP || InstCode==CpuInstCode::JMPTR || InstCode==CpuInstCode::JMPFL){
+      Target=IP+JIT_ARGADR(InstCode==CpuInstCode::JMP?0:1);
+      if(Target>=0 && Target<CodeLength){ Flags[Target]|=JitFlag::JumpTarget; }
+    }
+    Prefixed=false;
+  }
+
+  //Generate native code for each region of consecutive translatable instructions
+  IP=0;
+  while(IP<CodeLength){
+
+    //Find region
+    if(!(Flags[IP]&JitFlag::Translate)){ IP+=_Inst[(int)(CpuInstCode)(*(CpuIcd *)(CodePtr+IP))].Length; continue; }
+    RegionBeg=IP;
+    RegionEnd=IP;
+    i=0;
+    while(RegionEnd<CodeLength && (Flags[RegionEnd]&JitFlag::Translate)){ RegionEnd+=_Inst[(int)(CpuInstCode)(*(CpuIcd *)(CodePtr+RegionEnd))].Length; i++; }
+    if(i<JIT_MIN_REGION_INSTS){ IP=RegionEnd; continue; }
+
+    //Generate instructions (region start and jump targets are entry points)
+    Labels.Reset();
+    Patches.Reset();
+    for(IP=RegionBeg;IP<RegionEnd;IP+=_Inst[(int)InstCode].Length){
+      InstCode=(CpuInstCode)(*(CpuIcd *)(CodePtr+IP));
+      Labels.Add((JitLabel){IP,_Text.Length()});
+      if(IP==RegionBeg || (Flags[IP]&JitFlag::JumpTarget)){ Entries.Add((JitLabel){IP,_Text.Length()}); }
+      _EmitInstruction(CodePtr,IP,InstCode,RegionBeg,RegionEnd,Flags.BuffPnt(),Patches);
+    }
+    _EmitExit(RegionEnd);
+
+    //Resolve native jumps
+    for(i=0;i<Patches.Length();i++){
+      for(int j=0;j<Labels.Length();j++){
+        if(Labels[j].InstAddress==Patches[i].Target){
+          *(int32_t *)(_Text.BuffPnt()+Patches[i].PatchOffset)=(int32_t)(Labels[j].NativeOffset-(Patches[i].PatchOffset+(long)sizeof(int32_t)));
+          break;
+        }
+      }
+    }
+
+    //Region statistics
+    _RegionNr++;
+    _InstNr+=Labels.Length();
+    DebugMessage(DebugLevel::VrmRuntime,"Jit region "+HEXFORMAT(RegionBeg)+"-"+HEXFORMAT(RegionEnd)+" instructions="+ToString(Labels.Length()));
+
+  }
+
+  //Nothing translated
+  if(_Text.Length()==0){
+    DebugMessage(DebugLevel::VrmRuntime,"Exited jit compilation (no regions)");
+    return true;
+  }
+
+  //Copy native code into executable memory
+  #ifdef __JIT__
+  _MemSize=_Text.Length();
+  if((_Memory=(char *)mmap(nullptr,_MemSize,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0))==MAP_FAILED){
+    _Memory=nullptr;
+    return false;
+  }
+  memcpy(_Memory,_Text.BuffPnt(),_MemSize);
+  if(mprotect(_Memory,_MemSize,PROT_READ|PROT_EXEC)!=0){
+    Release();
+    return false;
+  }
+  #endif
+  _Text.Reset();
+
+  //Build entry point table
+  _Entry.Resize(CodeLength);
+  for(IP=0;IP<CodeLength;IP++){ _Entry[IP]=nullptr; }
+  for(i=0;i<Entries.Length();i++){ _Entry[Entries[i].InstAddress]=(void *)(_Memory+Entries[i].NativeOffset); }
+
+  //Debug message
+  DebugMessage(DebugLevel::VrmRuntime,"Exited jit compilation (regions="+ToString(_RegionNr)+" instructions="+ToString(_InstNr)+" nativesize="+ToString(_MemSize)+")");
+
+  //Return success
+  return true;
+
+}
+
+//Release native code
+void JitCompiler::Release(){
+  #ifdef __JIT__
+  if(_Memory!=nullptr){ munmap(_Memory,_MemSize); }
+  #endif
+  _Memory=nullptr;
+  _MemSize=0;
+  _Text.Reset();
+  _Entry.Reset();
+  _RegionNr=0;
+  _InstNr=0;
+}
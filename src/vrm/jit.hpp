@@ -0,0 +1,80 @@
+//jit.hpp: Baseline template JIT compiler
+
+//Wrap include
+#ifndef _JIT_HPP
+#define _JIT_HPP
+
+//Jit compiler is only available on x86-64 linux
+#if defined(__linux__) && defined(__x86_64__)
+  #define __JIT__
+#endif
+
+//Native region entry point (receives frame pointer StackPnt+BP, returns address of next instruction to interpret)
+typedef CpuAdr (*JitFunction)(char *FramePnt);
+
+//Jit compiler class
+//(translates runs of consecutive supported instructions of the code buffer into native code regions, regions
+//are entered from the interpreter and return to it on first instruction that is not translated)
+class JitCompiler{
+
+  //Private members
+  private:
+
+    //Code address flags
+    enum JitFlag{
+      InstStart=1,  //Instruction starts at address
+      JumpTarget=2, //Address is target of a jump instruction
+      Translate=4   //Instruction is translated to native code
+    };
+
+    //Native code label
+    struct JitLabel{
+      CpuAdr InstAddress; //Instruction address in code buffer
+      long NativeOffset;  //Offset in native code
+    };
+
+    //Native jump pending to resolve
+    struct JitPatch{
+      long PatchOffset;   //Offset of rel32 field in native code
+      CpuAdr Target;      //Target instruction address
+    };
+
+    //Internal data
+    char *_Memory;          //Executable memory
+    long _MemSize;          //Executable memory size
+    Buffer _Text;           //Native code being generated
+    Array<void *> _Entry;   //Native entry point for each code buffer address (null if not an entry point)
+    int _RegionNr;          //Translated regions
+    int _InstNr;            //Translated instructions
+
+    //Internal methods
+    bool _IsSupported(CpuInstCode InstCode);
+    bool _OperandsFit(const char *CodePtr,CpuAdr IP,CpuInstCode InstCode);
+    void _EmitByte(unsigned char Byte);
+    void _EmitDword(int32_t Value);
+    void _EmitQword(int64_t Value);
+    void _EmitMem(const char *Opcode,int Reg,CpuAdr Disp);
+    void _EmitExit(CpuAdr Target);
+    void _EmitJump(const char *Opcode,CpuAdr Target,CpuAdr RegionBeg,CpuAdr RegionEnd,const char *Flags,Array<JitPatch>& Patches);
+    void _EmitInstruction(const char *CodePtr,CpuAdr IP,CpuInstCode InstCode,CpuAdr RegionBeg,CpuAdr RegionEnd,const char *Flags,Array<JitPatch>& Patches);
+
+  //Public members
+  public:
+
+    //Methods
+    static bool Supported();
+    bool Compile(const char *CodePtr,CpuAdr CodeLength);
+    void Release();
+    inline bool IsEntry(CpuAdr IP) const { return _Entry.Length()!=0 && _Entry[IP]!=nullptr; }
+    inline JitFunction Entry(CpuAdr IP) const { return (JitFunction)_Entry[IP]; }
+    inline bool Compiled() const { return _Memory!=nullptr; }
+    inline int RegionNr() const { return _RegionNr; }
+    inline int InstNr() const { return _InstNr; }
+
+    //Constructor / Destructor
+    JitCompiler(){ _Memory=nullptr; _MemSize=0; _RegionNr=0; _InstNr=0; }
+    ~JitCompiler(){ Release(); }
+
+};
+
+#endif
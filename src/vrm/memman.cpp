@@ -14,6 +14,8 @@
 
 //Definition of static variables
 MemoryPool MemoryManager::_MemoryPool;
+std::mutex MemoryManager::_Mutex;
+bool MemoryManager::_ThreadSafe=false;
 
 //Internal functions
 char *_MainInnerAlloc(CpuWrd Size,int Owner);
@@ -34,6 +36,113 @@ void _MainInnerFree(char *Ptr){
   delete[] Ptr;
 }
 
+//Reserve virtual memory with guard area at the end
+char *MemoryManager::MapReserve(CpuWrd Size,CpuWrd GuardSize){
+  char *Ptr;
+  #ifdef __WIN__
+  DWORD OldProtect;
+  if((Ptr=(char *)VirtualAlloc(nullptr,Size+GuardSize,MEM_RESERVE|MEM_COMMIT,PAGE_READWRITE))==nullptr){ return nullptr; }
+  if(!VirtualProtect(Ptr+Size,GuardSize,PAGE_NOACCESS,&OldProtect)){ VirtualFree(Ptr,0,MEM_RELEASE); return nullptr; }
+  #else
+  if((Ptr=(char *)mmap(nullptr,Size+GuardSize,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS|MAP_NORESERVE,-1,0))==MAP_FAILED){ return nullptr; }
+  if(mprotect(Ptr+Size,GuardSize,PROT_NONE)==-1){ munmap(Ptr,Size+GuardSize); return nullptr; }
+  #endif
+  DebugMessage(DebugLevel::VrmMemory,"Memory manager reserved virtual memory (ptr="+PTRFORMAT(Ptr)+" size="+ToString(Size)+" guard="+ToString(GuardSize)+")");
+  return Ptr;
+}
+
+//Release reserved virtual memory
+void MemoryManager::MapRelease(char *Ptr,CpuWrd Size){
+  DebugMessage(DebugLevel::VrmMemory,"Memory manager released virtual memory (ptr="+PTRFORMAT(Ptr)+" size="+ToString(Size)+")");
+  #ifdef __WIN__
+  VirtualFree(Ptr,0,MEM_RELEASE);
+  #else
+  munmap(Ptr,Size);
+  #endif
+}
+
+//Map file into memory (read only, pages are loaded by OS when they are accessed)
+char *MemoryManager::MapFile(const String& FileName,CpuWrd& Size,String& Error){
+  char *Ptr;
+  #ifdef __WIN__
+  HANDLE File;
+  HANDLE Mapping;
+  LARGE_INTEGER FileSize;
+  if((File=CreateFileA(FileName.CharPnt(),GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr))==INVALID_HANDLE_VALUE){ 
+    Error="Error code "+ToString((long)GetLastError()); 
+    return nullptr; 
+  }
+  if(!GetFileSizeEx(File,&FileSize)){ 
+    Error="Error code "+ToString((long)GetLastError()); 
+    CloseHandle(File); 
+    return nullptr; 
+  }
+  if(FileSize.QuadPart==0){ 
+    Error="File is empty"; 
+    CloseHandle(File); 
+    return nullptr; 
+  }
+  if((Mapping=CreateFileMappingA(File,nullptr,PAGE_READONLY,0,0,nullptr))==nullptr){ 
+    Error="Error code "+ToString((long)GetLastError()); 
+    CloseHandle(File); 
+    return nullptr; 
+  }
+  Ptr=(char *)MapViewOfFile(Mapping,FILE_MAP_READ,0,0,0);
+  if(Ptr==nullptr){ Error="Error code "+ToString((long)GetLastError()); }
+  CloseHandle(Mapping);
+  CloseHandle(File);
+  if(Ptr==nullptr){ return nullptr; }
+  Size=(CpuWrd)FileSize.QuadPart;
+  #else
+  int Fd;
+  struct stat FileStat;
+  if((Fd=open(FileName.CharPnt(),O_RDONLY))==-1){ 
+    Error=String(strerror(errno)); 
+    return nullptr; 
+  }
+  if(fstat(Fd,&FileStat)==-1){ 
+    Error=String(strerror(errno)); 
+    close(Fd); 
+    return nullptr; 
+  }
+  if(FileStat.st_size==0){ 
+    Error="File is empty"; 
+    close(Fd); 
+    return nullptr; 
+  }
+  if((Ptr=(char *)mmap(nullptr,FileStat.st_size,PROT_READ,MAP_PRIVATE,Fd,0))==MAP_FAILED){ 
+    Error=String(strerror(errno)); 
+    close(Fd); 
+    return nullptr; 
+  }
+  close(Fd);
+  Size=(CpuWrd)FileStat.st_size;
+  #endif
+  DebugMessage(DebugLevel::VrmMemory,"Memory manager mapped file "+FileName+" (ptr="+PTRFORMAT(Ptr)+" size="+ToString(Size)+")");
+  return Ptr;
+}
+
+//Unmap file from memory
+void MemoryManager::UnmapFile(char *Ptr,CpuWrd Size){
+  DebugMessage(DebugLevel::VrmMemory,"Memory manager unmapped file (ptr="+PTRFORMAT(Ptr)+" size="+ToString(Size)+")");
+  #ifdef __WIN__
+  UnmapViewOfFile(Ptr);
+  #else
+  munmap(Ptr,Size);
+  #endif
+}
+
+//Get OS memory page size
+CpuWrd MemoryManager::PageSize(){
+  #ifdef __WIN__
+  SYSTEM_INFO Info;
+  GetSystemInfo(&Info);
+  return (CpuWrd)Info.dwPageSize;
+  #else
+  return (CpuWrd)sysconf(_SC_PAGESIZE);
+  #endif
+}
+
 //Memory manager initialization
 bool MemoryManager::Init(CpuWrd Units,CpuWrd ChunkUnits,CpuWrd UnitSize,bool Lock){
 
@@ -16,6 +16,8 @@ class MemoryManager{
     
     //Internal data
     static MemoryPool _MemoryPool; 
+    static std::mutex _Mutex;   //Serializes memory pool access when several processes run on worker threads
+    static bool _ThreadSafe;    //Memory pool access is serialized
 
   //Public members
   public:
@@ -24,6 +26,8 @@ class MemoryManager{
     inline static char *Alloc(int ProcessId,CpuWrd Size){
       char *Ptr;
       DebugMessage(DebugLevel::VrmMemory,"Memory manager allocation (processid="+ToString(ProcessId)+" size="+ToString(Size)+")");
+      std::unique_lock<std::mutex> Lock(_Mutex,std::defer_lock);
+      if(_ThreadSafe){ Lock.lock(); }
       if((Ptr=_MemoryPool.Allocate(Size,ProcessId))==nullptr){
         DebugMessage(DebugLevel::VrmMemory,"Memory allocation failure (processid="+ToString(ProcessId)+" size="+ToString(Size)+")");
         return nullptr;
@@ -34,6 +38,8 @@ class MemoryManager{
     //Memory re-allocation request
     inline static bool Realloc(char **Ptr,CpuWrd Size){
       DebugMessage(DebugLevel::VrmMemory,"Memory manager re-allocation (ptr="+PTRFORMAT(*Ptr)+" size="+ToString(Size)+")");
+      std::unique_lock<std::mutex> Lock(_Mutex,std::defer_lock);
+      if(_ThreadSafe){ Lock.lock(); }
       if(!_MemoryPool.ReAllocate(Ptr,Size)){
         DebugMessage(DebugLevel::VrmMemory,"Memory re-allocation failure (ptr="+PTRFORMAT(*Ptr)+" requested_size="+ToString(Size));
         return false;
@@ -44,9 +50,23 @@ class MemoryManager{
     //Free memory
     inline static void Free(char *Ptr){
       DebugMessage(DebugLevel::VrmMemory,"Memory manager release (ptr="+PTRFORMAT(Ptr)+")");
+      std::unique_lock<std::mutex> Lock(_Mutex,std::defer_lock);
+      if(_ThreadSafe){ Lock.lock(); }
       _MemoryPool.Free(Ptr);
     }
 
+    //Serialize memory pool access (set while processes run concurrently on scheduler worker threads)
+    inline static void SetThreadSafe(bool Enable){ _ThreadSafe=Enable; }
+
+    //Virtual memory reservation (outside memory pool, guard area at the end is not accessible)
+    static char *MapReserve(CpuWrd Size,CpuWrd GuardSize);
+    static void MapRelease(char *Ptr,CpuWrd Size);
+    static CpuWrd PageSize();
+
+    //Read only file mapping (outside memory pool)
+    static char *MapFile(const String& FileName,CpuWrd& Size,String& Error);
+    static void UnmapFile(char *Ptr,CpuWrd Size);
+
     //Handler methods
     static bool Init(CpuWrd Units,CpuWrd ChunkUnits,CpuWrd UnitSize,bool Lock);
     static void Terminate();
@@ -81,6 +101,8 @@ class RamBuffer {
     long _Nr;
     long _Size;
     long _ChunkSize;
+    bool _Fixed;
+    CpuWrd _MapSize;
 
     //Internal functions
     bool _Allocate(long Size);
@@ -114,6 +136,19 @@ class RamBuffer {
     inline long Length() const {
       return _Nr;
     }
+
+    //Get capacity in elements
+    inline long Capacity() const {
+      return _Size;
+    }
+
+    //Get pointer to guard area (only for fixed reservation)
+    inline char *GuardPnt() const {
+      return (_Fixed?reinterpret_cast<char *>(_Pnt)+_Size*sizeof(datatype):nullptr);
+    }
+    
+    //Reserve fixed virtual memory (buffer does not move any more)
+    bool FixedReserve(long Elements);
     
     //Set process id and chunk size
     inline void Init(int ProcessId,long ChunkSize,char *Name){
@@ -184,10 +219,15 @@ class RamBuffer {
     
     //Reset array
     inline void Reset(){
-      if(_Pnt!=nullptr){ MemoryManager::Free(reinterpret_cast<char *>(_Pnt)); }
+      if(_Pnt!=nullptr){ 
+        if(_Fixed){ MemoryManager::MapRelease(reinterpret_cast<char *>(_Pnt),_MapSize); }
+        else{ MemoryManager::Free(reinterpret_cast<char *>(_Pnt)); }
+      }
       _Nr=0;
       _Size=0;
       _Pnt=nullptr;
+      _Fixed=false;
+      _MapSize=0;
     }
 
     //Empty array (faster than reset as memory is not deallocated but set as unused)
@@ -218,12 +258,55 @@ RamBuffer<datatype>::RamBuffer(){
   _Size=0;
   _ChunkSize=10;
   _Pnt=nullptr;
+  _Fixed=false;
+  _MapSize=0;
 }
 
 //Destructor
 template <typename datatype> 
 RamBuffer<datatype>::~RamBuffer(){
-  if(_Pnt!=nullptr){ MemoryManager::Free(reinterpret_cast<char *>(_Pnt)); }
+  Reset();
+}
+
+//Reserve fixed virtual memory
+//(pages are only committed by OS when touched, so reservation can be large, a guard page is placed after buffer end)
+template <typename datatype> 
+bool RamBuffer<datatype>::FixedReserve(long Elements){
+  
+  //Variables
+  char *Ptr;
+  CpuWrd Bytes;
+  CpuWrd PageSize;
+
+  //Check primery memory controler pointer is valid
+  _CheckException(__FUNCTION__);
+
+  //Calculate size rounded to page size
+  PageSize=MemoryManager::PageSize();
+  Bytes=Elements*sizeof(datatype);
+  Bytes=((Bytes+PageSize-1)/PageSize)*PageSize;
+  if(Bytes<_Nr*(CpuWrd)sizeof(datatype)){ return false; }
+
+  //Reserve memory
+  if((Ptr=MemoryManager::MapReserve(Bytes,PageSize))==nullptr){ return false; }
+  DebugMessage(DebugLevel::VrmMemory,"RamBuffer "+String(_Name)+" fixed reservation of "+ToString(Bytes)+" bytes at "+PTRFORMAT(Ptr));
+
+  //Move current contents
+  if(_Pnt!=nullptr){
+    if(_Nr!=0){ MemCpy(Ptr,reinterpret_cast<const char *>(_Pnt),_Nr*sizeof(datatype)); }
+    if(_Fixed){ MemoryManager::MapRelease(reinterpret_cast<char *>(_Pnt),_MapSize); }
+    else{ MemoryManager::Free(reinterpret_cast<char *>(_Pnt)); }
+  }
+
+  //Set new buffer
+  _Pnt=reinterpret_cast<datatype *>(Ptr);
+  _Size=Bytes/sizeof(datatype);
+  _MapSize=Bytes+PageSize;
+  _Fixed=true;
+
+  //Return code
+  return true;
+
 }
 
 //Allocate items
@@ -234,14 +317,20 @@ bool RamBuffer<datatype>::_Allocate(long Size){
   char *Ptr;
   bool ResizeBuffer=false;
 
+  //Check primery memory controler pointer is valid
+  _CheckException(__FUNCTION__);
+
+  //Fixed reservation never moves
+  if(_Fixed){
+    return (Size<=_Size?true:false);
+  }
+
   //Debug message
   #ifdef __DEV__
    long Bytes=Size*sizeof(datatype);
     DebugAppend(DebugLevel::VrmMemory,"RamBuffer "+String(_Name)+" allocation for "+ToString(Bytes)+" bytes ("+ToString(Size)+" elements) (occupied="+ToString(_Nr)+" currsize="+ToString(_Size));
   #endif
   
-  //Check primery memory controler pointer is valid
-  _CheckException(__FUNCTION__);
 
   //Increase size
   if(Size>_Size){
@@ -23,6 +23,9 @@
   #define MemoryCheckVoid(op) 
 #endif
 
+//Slab limit for new memory pools
+CpuWrd MemoryPool::_DefSlabLimit=SLAB_DEFLIMIT;
+
 //Block pointer (used only on memory check)
 struct BlockPointer{
   BlockHeader *Ptr; 
@@ -36,6 +39,11 @@ CpuWrd MemoryPool::MinUnitSize() const {
   return MinSize;
 }
 
+//Set slab limit for memory pools created from now on (zero disables slabs, limit is never bigger than last size class)
+void MemoryPool::SetSlabLimit(CpuWrd Limit){
+  _DefSlabLimit=(Limit<0?0:(Limit>SLAB_MAXSIZE?SLAB_MAXSIZE:Limit));
+}
+
 //Memory pool creation
 bool MemoryPool::Create(CpuWrd Units,CpuWrd ChunkUnits,CpuWrd UnitSize,long FreeListNr,int FreeBits,int PoolOwner,bool Lock,FunPtrAlloc InnerAlloc,FunPtrFree InnerFree){
 
@@ -59,7 +67,8 @@ bool MemoryPool::Create(CpuWrd Units,CpuWrd ChunkUnits,CpuWrd UnitSize,long Free
   " chunk_units="+ToString(ChunkUnits)+
   " memory_units="+ToString(Units)+
   " lock="+(Lock?"true":"false")+
-  " blockheader="+ToString((int)sizeof(BlockHeader)));
+  " blockheader="+ToString((int)sizeof(BlockHeader))+
+  " slablimit="+ToString(_DefSlabLimit));
 
   //Calculate minimun memory unit and check
   if(UnitSize<MinUnitSize()){
@@ -116,6 +125,7 @@ bool MemoryPool::Create(CpuWrd Units,CpuWrd ChunkUnits,CpuWrd UnitSize,long Free
   Header.FreeIndex=-1;
   Header.Next=nullptr;
   Header.Prev=nullptr;
+  Header.SizeClass=-1;
   SetBlockMarks(&Header);
   MemCpy(Memory+sizeof(PageHeader),(char *)&Header,sizeof(Header));
 
@@ -135,6 +145,17 @@ bool MemoryPool::Create(CpuWrd Units,CpuWrd ChunkUnits,CpuWrd UnitSize,long Free
   _Lock=Lock;
   _Error=(MemPoolError)0;
   _BlockCount=1;
+
+  //Init slab size classes
+  _SlabLimit=_DefSlabLimit;
+  for(i=0;i<SLAB_CLASSES;i++){
+    _Slab[i].CellSize=sizeof(SlabCellHeader)+(SLAB_MINSIZE<<i);
+    _Slab[i].CellNr=(SLAB_SIZE-sizeof(SlabHeader))/_Slab[i].CellSize;
+    _Slab[i].SlabNr=0;
+    _Slab[i].UsedNr=0;
+    _Slab[i].First=nullptr;
+    _Slab[i].Last=nullptr;
+  }
   
   //Add block into free list
   _FreeListAdd(_List);
@@ -161,6 +182,7 @@ void MemoryPool::Destroy(){
   //Variables
   PageHeader *LastPtr;
   BlockHeader *Header;
+  SlabHeader *SlabPtr;
   Array<PageHeader *> Pages;
   CpuWrd BlockNr;
   CpuWrd UsedNr;
@@ -181,6 +203,19 @@ void MemoryPool::Destroy(){
   //Memory check
   MemoryCheckVoid(MemOperation::Destroy);
 
+  //Free slabs
+  for(int i=0;i<SLAB_CLASSES;i++){
+    while(_Slab[i].First!=nullptr){
+      SlabPtr=_Slab[i].First;
+      _Slab[i].First=SlabPtr->Next;
+      DebugMessage(DebugLevel::VrmMemPool,MEMORY_POOL_NAME(_PoolOwner)+"Free slab "+SLAB_PTR_STRING(SlabPtr));
+      _InnerFree(reinterpret_cast<char *>(SlabPtr));
+    }
+    _Slab[i].Last=nullptr;
+    _Slab[i].SlabNr=0;
+    _Slab[i].UsedNr=0;
+  }
+
   //Nothing to destroy if list pointer is null already
   if(_List==nullptr){
     DebugMessage(DebugLevel::VrmMemPool,MEMORY_POOL_NAME(_PoolOwner)+"Nothing to do, memory pool is already destroyed");
@@ -281,6 +316,7 @@ bool MemoryPool::_Allocate(BlockHeader **Block,CpuWrd Size,int BlockOwner){
       Header->FreeIndex=-1;
       Header->Next=(*Block)->Next;
       Header->Prev=(*Block);
+      Header->SizeClass=-1;
       if(Header->Next!=nullptr){ Header->Next->Prev=Header; }
       SetBlockMarks(Header);
       _FreeListAdd(Header);
@@ -344,6 +380,7 @@ bool MemoryPool::_Allocate(BlockHeader **Block,CpuWrd Size,int BlockOwner){
           Header->FreeIndex=-1;
           Header->Next=(*Block)->Next;
           Header->Prev=(*Block);
+          Header->SizeClass=-1;
           if(Header->Next!=nullptr){ Header->Next->Prev=Header; }
           SetBlockMarks(Header);
           _FreeListAdd(Header);
@@ -453,6 +490,7 @@ bool MemoryPool::_Allocate(BlockHeader **Block,CpuWrd Size,int BlockOwner){
     AuxHeader->FreeIndex=-1;
     AuxHeader->Next=Header->Next;
     AuxHeader->Prev=Header;
+    AuxHeader->SizeClass=-1;
     if(AuxHeader->Next!=nullptr){ AuxHeader->Next->Prev=AuxHeader; }
     SetBlockMarks(AuxHeader);
     _FreeListAdd(AuxHeader);
@@ -561,7 +599,8 @@ void MemoryPool::_Free(BlockHeader *Block){
   }
 
   //Release page if it does not countain any used blocks
-  if(KeptBlock->PagePtr->UsedNr==0){
+  //(last page is always kept, since pool must never run out of block list as small requests might live only on slabs)
+  if(KeptBlock->PagePtr->UsedNr==0 && _Units>KeptBlock->PagePtr->Units){
 
     //Debug message
     DebugMessage(DebugLevel::VrmMemPool,DebugMsgHeader+"page "+PAGE_PTR_STRING(KeptBlock->PagePtr)+" does not contain used blocks, selected for release");
@@ -691,6 +730,7 @@ bool MemoryPool::_Extend(CpuWrd Chunks){
   Header->FreeIndex=-1;
   Header->Next=_List;
   Header->Prev=nullptr;
+  Header->SizeClass=-1;
   Header->Next->Prev=Header;
   SetBlockMarks(Header);
   _List=Header;
@@ -709,6 +749,367 @@ bool MemoryPool::_Extend(CpuWrd Chunks){
 
 }
 
+//Slab allocator (request must not be bigger than slab limit)
+bool MemoryPool::_SlabAllocate(char **Ptr,CpuWrd Size,int Owner,bool AutoExtend){
+
+  //Variables
+  CpuWrd SizeClass;
+  SlabHeader *Slab;
+  SlabCellHeader *Cell;
+
+  //Get size class
+  SizeClass=_SlabSizeClass(Size);
+
+  //Debug message header
+  #ifdef __DEV__
+  String DebugMsgHeader;
+  if(DebugLevelEnabled(DebugLevel::VrmMemPool)){
+    DebugMsgHeader=MEMORY_POOL_NAME(_PoolOwner)+"Slab allocator, allocation for size "+ToString(Size)+" (class="+ToString(SizeClass)+"): ";
+  }
+  #endif
+
+  //Slabs with free cells are kept before full slabs, so when first slab is full a new slab is needed
+  Slab=_Slab[SizeClass].First;
+  if(Slab==nullptr || Slab->FreeCell==nullptr){
+    if(!AutoExtend){
+      DebugMessage(DebugLevel::VrmMemPool,DebugMsgHeader+"No free cells on size class");
+      _Error=MemPoolError::RequestError; 
+      return false; 
+    }
+    if(!_SlabExtend(SizeClass)){ return false; }
+    Slab=_Slab[SizeClass].First;
+  }
+
+  //Take first free cell of slab
+  Cell=Slab->FreeCell;
+  Slab->FreeCell=*reinterpret_cast<SlabCellHeader **>(reinterpret_cast<char *>(Cell)+sizeof(SlabCellHeader));
+  Cell->Used=true;
+  Cell->BlockOwner=Owner;
+  Slab->UsedNr++;
+  _Slab[SizeClass].UsedNr++;
+  DebugMessage(DebugLevel::VrmMemPool,DebugMsgHeader+"cell "+PTRFORMAT(Cell)+" taken from slab "+SLAB_PTR_STRING(Slab));
+
+  //Slab becomes full, move it to end of size class list
+  if(Slab->FreeCell==nullptr && Slab->Next!=nullptr){
+    _SlabUnlink(Slab);
+    _SlabLinkLast(Slab);
+  }
+
+  //Memory check
+  MemoryCheckReturn(MemOperation::SlabAlloc);
+
+  //Return cell payload
+  *Ptr=reinterpret_cast<char *>(Cell)+sizeof(SlabCellHeader);
+  return true;
+
+}
+
+//Slab re-allocator (pointer must be a slab cell)
+bool MemoryPool::_SlabReAllocate(char **Ptr,CpuWrd Size,bool AutoExtend){
+
+  //Variables
+  char *NewPtr;
+  SlabCellHeader *Cell;
+
+  //Get cell header
+  Cell=reinterpret_cast<SlabCellHeader *>((*Ptr)-sizeof(SlabCellHeader));
+  DebugMessage(DebugLevel::VrmMemPool,MEMORY_POOL_NAME(_PoolOwner)+"Slab re-allocation request (ptr="+PTRFORMAT(*Ptr)+
+  " class="+ToString(Cell->SizeClass)+" size="+ToString(Size)+" autoextend="+ToString(AutoExtend)+")");
+  #ifdef __DEV__
+  if(_CheckFailure){
+    DebugMessage(DebugLevel::VrmMemPool,MEMORY_POOL_NAME(_PoolOwner)+"Slab re-allocation request skipped since memory pool is in invalid state");
+    return false;
+  }
+  #endif
+
+  //Current cell fits
+  if(Size<=(SLAB_MINSIZE<<Cell->SizeClass)){
+    MemoryCheckReturn(MemOperation::SlabReallocFits);
+    return true;
+  }
+
+  //Move contents to new cell or chained list block
+  if((NewPtr=Allocate(Size,Cell->BlockOwner,AutoExtend))==nullptr){ return false; }
+  MemCpy(NewPtr,*Ptr,SLAB_MINSIZE<<Cell->SizeClass);
+  _SlabFree(Cell);
+  *Ptr=NewPtr;
+  MemoryCheckReturn(MemOperation::SlabReallocMove);
+
+  //Return success
+  return true;
+
+}
+
+//Slab releaser (cell pointer must not be nullptr)
+void MemoryPool::_SlabFree(SlabCellHeader *Cell){
+
+  //Variables
+  CpuWrd SizeClass;
+  SlabHeader *Slab;
+
+  //Debug message header
+  #ifdef __DEV__
+  String DebugMsgHeader;
+  if(DebugLevelEnabled(DebugLevel::VrmMemPool)){
+    DebugMsgHeader=MEMORY_POOL_NAME(_PoolOwner)+"Slab releaser, ";
+  }
+  #endif
+
+  //Debug message
+  DebugMessage(DebugLevel::VrmMemPool,DebugMsgHeader+"release on cell "+PTRFORMAT(Cell)+" of slab "+SLAB_PTR_STRING(Cell->SlabPtr));
+
+  //Trow exception if cell is already released
+  if(Cell->Used==false){
+    String Message="Tried to free slab cell "+PTRFORMAT(Cell)+" which is already released";
+    ThrowBaseException((int)ExceptionSource::MemoryPool,(int)MemoryPoolException::FreeAlreadyReleased,Message.CharPnt());
+  }    
+
+  //Return cell to slab free list
+  Slab=Cell->SlabPtr;
+  SizeClass=Slab->SizeClass;
+  Cell->Used=false;
+  Cell->BlockOwner=_PoolOwner;
+  *reinterpret_cast<SlabCellHeader **>(reinterpret_cast<char *>(Cell)+sizeof(SlabCellHeader))=Slab->FreeCell;
+  Slab->FreeCell=Cell;
+  Slab->UsedNr--;
+  _Slab[SizeClass].UsedNr--;
+
+  //Slab was full, move it to beginning of size class list
+  if(Slab->UsedNr==Slab->CellNr-1 && Slab->Prev!=nullptr){
+    _SlabUnlink(Slab);
+    _SlabLinkFirst(Slab);
+  }
+  MemoryCheckVoid(MemOperation::SlabFree);
+
+  //Release empty slab when rest of slabs of size class keep at least one slab of free cells
+  //(this way a size class never releases and takes back slabs on every request)
+  if(Slab->UsedNr==0 && (_Slab[SizeClass].SlabNr-1)*_Slab[SizeClass].CellNr-_Slab[SizeClass].UsedNr>=_Slab[SizeClass].CellNr){
+    DebugMessage(DebugLevel::VrmMemPool,DebugMsgHeader+"slab "+SLAB_PTR_STRING(Slab)+" does not contain used cells, selected for release");
+    _SlabUnlink(Slab);
+    _Slab[SizeClass].SlabNr--;
+    MemoryCheckVoid(MemOperation::SlabRelease);
+    #ifdef __DEV__
+    if(_CheckFailure){ return; }
+    #endif
+    _InnerFree(reinterpret_cast<char *>(Slab));
+  }
+
+}
+
+//Extend size class with a new slab
+bool MemoryPool::_SlabExtend(CpuWrd SizeClass){
+
+  //Variables
+  char *Memory;
+  CpuWrd i;
+  SlabHeader *Slab;
+  SlabCellHeader *Cell;
+
+  //Get slab memory
+  try{ Memory=_InnerAlloc(SLAB_SIZE,_PoolOwner); } 
+  catch(std::bad_alloc& Ex){ 
+    _Error=MemPoolError::AllocationError;
+    return false; 
+  }
+  if(Memory==nullptr){
+    _Error=MemPoolError::AllocationError;
+    return false; 
+  }
+
+  //Lock memory page
+  if(_Lock){
+    if(!_LockMemory(Memory,SLAB_SIZE)){
+      _Error=MemPoolError::PageLockFailure;
+      _InnerFree(Memory);
+      return false; 
+    }
+  }
+
+  //Set slab header
+  Slab=reinterpret_cast<SlabHeader *>(Memory);
+  Slab->SizeClass=SizeClass;
+  Slab->CellNr=_Slab[SizeClass].CellNr;
+  Slab->UsedNr=0;
+  Slab->FreeCell=nullptr;
+  SetSlabMarks(Slab);
+
+  //Chain all cells on free list (in reverse order so first cell is taken first)
+  for(i=Slab->CellNr-1;i>=0;i--){
+    Cell=reinterpret_cast<SlabCellHeader *>(Memory+sizeof(SlabHeader)+i*_Slab[SizeClass].CellSize);
+    Cell->SlabPtr=Slab;
+    Cell->BlockOwner=_PoolOwner;
+    Cell->Used=false;
+    Cell->SizeClass=SizeClass;
+    *reinterpret_cast<SlabCellHeader **>(reinterpret_cast<char *>(Cell)+sizeof(SlabCellHeader))=Slab->FreeCell;
+    Slab->FreeCell=Cell;
+  }
+
+  //Insert slab at beginning of size class
+  _SlabLinkFirst(Slab);
+  _Slab[SizeClass].SlabNr++;
+  DebugMessage(DebugLevel::VrmMemPool,MEMORY_POOL_NAME(_PoolOwner)+"Slab extension "+SLAB_PTR_STRING(Slab)+" (slabcount="+ToString(_Slab[SizeClass].SlabNr)+")");
+
+  //Memory check
+  MemoryCheckReturn(MemOperation::SlabExtend);
+
+  //Return success
+  return true;
+
+}
+
+//Slab internal check
+bool MemoryPool::_SlabCheck(MemOperation Oper){
+
+  //Variables
+  bool Error;
+  bool Full;
+  CpuWrd i;
+  CpuWrd SlabNr;
+  CpuWrd UsedNr;
+  CpuWrd FreeNr;
+  CpuWrd Offset;
+  SlabHeader *Slab;
+  SlabCellHeader *Cell;
+  String Message;
+
+  //Traverse size classes
+  Error=false;
+  for(i=0;i<SLAB_CLASSES && !Error;i++){
+
+    //Check list ends
+    if((_Slab[i].First==nullptr)!=(_Slab[i].Last==nullptr)){
+      Message="On size class "+ToString(i)+" only one of first and last slab pointers is null";
+      Error=true;
+      break;
+    }
+    if(_Slab[i].First!=nullptr && _Slab[i].First->Prev!=nullptr){
+      Message="On size class "+ToString(i)+" first slab "+SLAB_PTR_STRING(_Slab[i].First)+" has a previous slab";
+      Error=true;
+      break;
+    }
+
+    //Traverse slabs
+    SlabNr=0;
+    UsedNr=0;
+    Full=false;
+    Slab=_Slab[i].First;
+    while(Slab!=nullptr){
+
+      //Check slab marks
+      #ifdef __DEV__
+      if(Slab->Mark1!=SLAB_MARK1 || Slab->Mark2!=SLAB_MARK2){
+        Message="On size class "+ToString(i)+" slab "+PTRFORMAT(Slab)+" mark test fails (mark1="+HEXFORMAT(Slab->Mark1)+", mark2="+HEXFORMAT(Slab->Mark2)+")"; 
+        Error=true;
+        break;
+      }
+      #endif
+
+      //Check slab fields
+      if(Slab->SizeClass!=i){
+        Message="On size class "+ToString(i)+" slab "+SLAB_PTR_STRING(Slab)+" belongs to a different size class";
+        Error=true;
+        break;
+      }
+      if(Slab->CellNr!=_Slab[i].CellNr || Slab->UsedNr<0 || Slab->UsedNr>Slab->CellNr){
+        Message="On size class "+ToString(i)+" slab "+SLAB_PTR_STRING(Slab)+" has invalid cell counters";
+        Error=true;
+        break;
+      }
+
+      //Check pointers
+      if(Slab->Next!=nullptr && Slab->Next->Prev!=Slab){
+        Message="On size class "+ToString(i)+" slab "+SLAB_PTR_STRING(Slab)+" next slab does not point back";
+        Error=true;
+        break;
+      }
+      if(Slab->Next==nullptr && _Slab[i].Last!=Slab){
+        Message="On size class "+ToString(i)+" slab "+SLAB_PTR_STRING(Slab)+" is last slab but last slab pointer is "+PTRFORMAT(_Slab[i].Last);
+        Error=true;
+        break;
+      }
+
+      //Traverse free cells
+      FreeNr=0;
+      Cell=Slab->FreeCell;
+      while(Cell!=nullptr){
+        Offset=reinterpret_cast<char *>(Cell)-reinterpret_cast<char *>(Slab)-sizeof(SlabHeader);
+        if(Offset<0 || Offset>=Slab->CellNr*_Slab[i].CellSize || Offset%_Slab[i].CellSize!=0){
+          Message="On size class "+ToString(i)+" slab "+SLAB_PTR_STRING(Slab)+" free cell "+PTRFORMAT(Cell)+" is not a cell of the slab";
+          Error=true;
+          break;
+        }
+        if(Cell->Used || Cell->SlabPtr!=Slab || Cell->SizeClass!=i){
+          Message="On size class "+ToString(i)+" slab "+SLAB_PTR_STRING(Slab)+" free cell "+PTRFORMAT(Cell)+" has invalid header (used="+(Cell->Used?"1":"0")+", slabptr="+PTRFORMAT(Cell->SlabPtr)+", class="+ToString(Cell->SizeClass)+")";
+          Error=true;
+          break;
+        }
+        FreeNr++;
+        if(FreeNr>Slab->CellNr){
+          Message="On size class "+ToString(i)+" slab "+SLAB_PTR_STRING(Slab)+" free cell traverse exceeds cell count";
+          Error=true;
+          break;
+        }
+        Cell=*reinterpret_cast<SlabCellHeader **>(reinterpret_cast<char *>(Cell)+sizeof(SlabCellHeader));
+      }
+      if(Error){ break; }
+      if(FreeNr!=Slab->CellNr-Slab->UsedNr){
+        Message="On size class "+ToString(i)+" slab "+SLAB_PTR_STRING(Slab)+" free cell count does not match (traversed="+ToString(FreeNr)+")";
+        Error=true;
+        break;
+      }
+
+      //Check slabs with free cells are before full slabs
+      if(FreeNr==0){ 
+        Full=true; 
+      }
+      else if(Full){
+        Message="On size class "+ToString(i)+" slab "+SLAB_PTR_STRING(Slab)+" has free cells but is after a full slab";
+        Error=true;
+        break;
+      }
+
+      //Count slabs
+      SlabNr++;
+      UsedNr+=Slab->UsedNr;
+      if(SlabNr>_Slab[i].SlabNr){
+        Message="On size class "+ToString(i)+" slab list traverse exceeds slab count ("+ToString(_Slab[i].SlabNr)+")";
+        Error=true;
+        break;
+      }
+
+      //Next slab
+      Slab=Slab->Next;
+
+    }
+
+    //Check counters
+    if(!Error && SlabNr!=_Slab[i].SlabNr){
+      Message="On size class "+ToString(i)+" slab count does not match (slabnr="+ToString(_Slab[i].SlabNr)+", traversed="+ToString(SlabNr)+")";
+      Error=true;
+    }
+    if(!Error && UsedNr!=_Slab[i].UsedNr){
+      Message="On size class "+ToString(i)+" used cell count does not match (usednr="+ToString(_Slab[i].UsedNr)+", traversed="+ToString(UsedNr)+")";
+      Error=true;
+    }
+
+  }
+
+  //Return error
+  if(Error){
+    DebugMessage(DebugLevel::VrmMemPoolCheck,"Memory check failure ["+MEMORY_POOL_NAME(_PoolOwner).Replace(": ","")+"]: "+Message+" (memory operation: "+MemOperationText(Oper)+")");
+    for(i=0;i<SLAB_CLASSES;i++){
+      DebugMessage(DebugLevel::VrmMemPoolCheck,"Size class #"+ToString(i)+": cellsize="+ToString(_Slab[i].CellSize)+", cellnr="+ToString(_Slab[i].CellNr)+
+      ", slabnr="+ToString(_Slab[i].SlabNr)+", usednr="+ToString(_Slab[i].UsedNr)+", first="+PTRFORMAT(_Slab[i].First)+", last="+PTRFORMAT(_Slab[i].Last));
+    }
+    _CheckFailure=true;
+    ThrowBaseException((int)ExceptionSource::MemoryPool,(int)MemoryPoolException::MemoryCheckError,Message.CharPnt());
+  }
+
+  //Return success
+  return true;
+
+}
+
 //Return last error
 MemPoolError MemoryPool::LastError() const {
   return _Error;
@@ -748,6 +1149,12 @@ String MemoryPool::MemOperationText(MemOperation MemOper) const {
     case MemOperation::Extend                 : Text="Extend";                  break;
     case MemOperation::OuterCheck             : Text="OuterCheck";              break;
     case MemOperation::PageRelease            : Text="PageRelease";             break;
+    case MemOperation::SlabAlloc              : Text="SlabAlloc";               break;
+    case MemOperation::SlabFree               : Text="SlabFree";                break;
+    case MemOperation::SlabExtend             : Text="SlabExtend";              break;
+    case MemOperation::SlabRelease            : Text="SlabRelease";             break;
+    case MemOperation::SlabReallocFits        : Text="SlabReallocFits";         break;
+    case MemOperation::SlabReallocMove        : Text="SlabReallocMove";         break;
   }
   return Text;
 }
@@ -765,6 +1172,9 @@ bool MemoryPool::MemoryCheck(MemOperation Oper){
   SortedArray<BlockPointer,BlockHeader *> SBlock;
   Array<BlockHeader *> TBlock;
   String Message;
+
+  //Check slabs
+  if(!_SlabCheck(Oper)){ return false; }
  
   //Checks when list pointer is null
   if(_List==nullptr){ 
@@ -10,13 +10,24 @@
   #define PAGE_MARK2       0x33BCE8F9
   #define BLOCK_MARK1      0x7F8E9DAC
   #define BLOCK_MARK2      0x44CAD9E8
+  #define SLAB_MARK1       0x5D6C7B8A
+  #define SLAB_MARK2       0x22ABD7E6
   #define SetPageMarks(p)  (p)->Mark1=PAGE_MARK1;  (p)->Mark2=PAGE_MARK2;
   #define SetBlockMarks(p) (p)->Mark1=BLOCK_MARK1; (p)->Mark2=BLOCK_MARK2;
+  #define SetSlabMarks(p)  (p)->Mark1=SLAB_MARK1;  (p)->Mark2=SLAB_MARK2;
 #else
   #define SetPageMarks(p)
   #define SetBlockMarks(p)
+  #define SetSlabMarks(p)
 #endif
 
+//Slab allocator (requests up to slab limit are served from size classes of fixed size cells, bigger ones from chained block lists)
+#define SLAB_CLASSES  6     //Number of size classes (cell payloads are 16, 32, 64, 128, 256 and 512 bytes)
+#define SLAB_MINSIZE  16    //Cell payload of first size class
+#define SLAB_MAXSIZE  512   //Cell payload of last size class
+#define SLAB_SIZE     32768 //Memory taken from inner allocator for each slab
+#define SLAB_DEFLIMIT 256   //Default slab limit
+
 //Memory pool name in dbug messages
 #define MEMORY_POOL_NAME(Owner) ((Owner)==-1?String("Main memory pool: "):"Aux memory pool(processid="+ToString(Owner)+"): ")
 
@@ -24,6 +35,7 @@
 #define PAGE_PTR_STRING(p) (PTRFORMAT(p)+"{blocks="+ToString((p)->BlockNr)+", used="+ToString((p)->UsedNr)+", units="+ToString((p)->Units)+"}")
 #define BLOCK_PTR_STRING(p) ((p)==nullptr?"nullptr":PTRFORMAT(p)+"("+ToString((p)->Units)+")")
 #define BLOCK_INFO(p) PTRFORMAT(p)+"(used="+((p)->Used==true?"1":"0")+", units="+ToString((p)->Units)+", prev="+PTRFORMAT((p)->Prev)+", next="+PTRFORMAT((p)->Next)+", pageptr="+PTRFORMAT((p)->PagePtr)+")"
+#define SLAB_PTR_STRING(p) ((p)==nullptr?"nullptr":PTRFORMAT(p)+"{class="+ToString((p)->SizeClass)+", cells="+ToString((p)->CellNr)+", used="+ToString((p)->UsedNr)+"}")
 
 //Memory pool exception numbers
 enum class MemoryPoolException{
@@ -58,7 +70,13 @@ enum class MemOperation:int{
   FreeReleaseJoinPrev=15,
   Extend=16,
   OuterCheck=17,
-  PageRelease=18
+  PageRelease=18,
+  SlabAlloc=19,
+  SlabFree=20,
+  SlabExtend=21,
+  SlabRelease=22,
+  SlabReallocFits=23,
+  SlabReallocMove=24
 };
 
 //Memory page header
@@ -90,6 +108,44 @@ struct BlockHeader{
   #ifdef __DEV__
   CpuInt Mark2;         //Block mark 2
   #endif
+  CpuWrd SizeClass;     //Always -1 (must be last field, it tells chained list blocks from slab cells)
+};
+
+//Slab cell header (forward declaration)
+struct SlabCellHeader;
+
+//Slab header (at beginning of memory taken from inner allocator for each slab)
+struct SlabHeader{
+  #ifdef __DEV__
+  CpuInt Mark1;         //Slab mark 1
+  #endif
+  CpuWrd SizeClass;     //Size class
+  CpuWrd CellNr;        //Total cells
+  CpuWrd UsedNr;        //Used cells
+  SlabCellHeader *FreeCell; //First free cell (free cells are chained through their payload)
+  SlabHeader *Next;     //Next slab on size class
+  SlabHeader *Prev;     //Previous slab on size class
+  #ifdef __DEV__
+  CpuInt Mark2;         //Slab mark 2
+  #endif
+};
+
+//Slab cell header
+struct SlabCellHeader{
+  SlabHeader *SlabPtr;  //Slab containing the cell
+  int BlockOwner;       //Tag to identify owner of memory cell
+  bool Used;            //Used flag
+  CpuWrd SizeClass;     //Size class (must be last field, in same position as in BlockHeader)
+};
+
+//Size class
+struct SlabSizeClass{
+  CpuWrd CellSize;      //Cell size (including header)
+  CpuWrd CellNr;        //Cells on each slab
+  CpuWrd SlabNr;        //Slabs on size class
+  CpuWrd UsedNr;        //Used cells on size class
+  SlabHeader *First;    //First slab (slabs with free cells are kept before full slabs)
+  SlabHeader *Last;     //Last slab
 };
 
 //Free memory block table
@@ -128,6 +184,11 @@ class MemoryPool{
     FunPtrAlloc _InnerAlloc;    //Inner allocator
     FunPtrFree _InnerFree;      //Inner releaser
 
+    //Slab allocator
+    SlabSizeClass _Slab[SLAB_CLASSES]; //Size classes
+    CpuWrd _SlabLimit;          //Biggest request served by slabs (zero when slabs are disabled)
+    static CpuWrd _DefSlabLimit; //Slab limit for new memory pools
+
     //Memory check failure flag
     bool _CheckFailure=false;
 
@@ -203,10 +264,52 @@ class MemoryPool{
       return Line;
     }
 
+    //Check pointer is a slab cell
+    inline bool _IsSlabCell(char *Ptr){
+      return *reinterpret_cast<CpuWrd *>(Ptr-sizeof(CpuWrd))!=-1;
+    }
+
+    //Get size class for request
+    inline CpuWrd _SlabSizeClass(CpuWrd Size){
+      CpuWrd SizeClass=0;
+      CpuWrd Payload=SLAB_MINSIZE;
+      while(Payload<Size){ Payload<<=1; SizeClass++; }
+      return SizeClass;
+    }
+
+    //Remove slab from size class list
+    inline void _SlabUnlink(SlabHeader *Slab){
+      if(Slab->Prev!=nullptr){ Slab->Prev->Next=Slab->Next; } else{ _Slab[Slab->SizeClass].First=Slab->Next; }
+      if(Slab->Next!=nullptr){ Slab->Next->Prev=Slab->Prev; } else{ _Slab[Slab->SizeClass].Last=Slab->Prev; }
+      Slab->Next=nullptr;
+      Slab->Prev=nullptr;
+    }
+
+    //Insert slab at beginning of size class list
+    inline void _SlabLinkFirst(SlabHeader *Slab){
+      Slab->Prev=nullptr;
+      Slab->Next=_Slab[Slab->SizeClass].First;
+      if(Slab->Next!=nullptr){ Slab->Next->Prev=Slab; } else{ _Slab[Slab->SizeClass].Last=Slab; }
+      _Slab[Slab->SizeClass].First=Slab;
+    }
+
+    //Insert slab at end of size class list
+    inline void _SlabLinkLast(SlabHeader *Slab){
+      Slab->Next=nullptr;
+      Slab->Prev=_Slab[Slab->SizeClass].Last;
+      if(Slab->Prev!=nullptr){ Slab->Prev->Next=Slab; } else{ _Slab[Slab->SizeClass].First=Slab; }
+      _Slab[Slab->SizeClass].Last=Slab;
+    }
+
     //Internal methods
     bool _Allocate(BlockHeader **Block,CpuWrd Size,int BlockOwner);
     void _Free(BlockHeader *Block);
     bool _Extend(CpuWrd Chunks);
+    bool _SlabAllocate(char **Ptr,CpuWrd Size,int Owner,bool AutoExtend);
+    bool _SlabReAllocate(char **Ptr,CpuWrd Size,bool AutoExtend);
+    void _SlabFree(SlabCellHeader *Cell);
+    bool _SlabExtend(CpuWrd SizeClass);
+    bool _SlabCheck(MemOperation Oper);
     
   //Public members
   public:
@@ -223,6 +326,11 @@ class MemoryPool{
         return nullptr;
       }
       #endif
+      if(Size<=_SlabLimit){
+        char *Ptr;
+        if(!_SlabAllocate(&Ptr,Size,Owner,AutoExtend)){ return nullptr; }
+        return Ptr;
+      }
       if(!_Allocate(&Header,Size,Owner)){ 
         if(!AutoExtend){ return nullptr; }
         Chunks=(Size+sizeof(BlockHeader)+_ChunkUnits*_UnitSize)/(_ChunkUnits*_UnitSize);
@@ -235,6 +343,7 @@ class MemoryPool{
     //Memory re-allocation
     inline bool ReAllocate(char **Ptr,CpuWrd Size,bool AutoExtend=true){
       CpuWrd Chunks;
+      if(_IsSlabCell(*Ptr)){ return _SlabReAllocate(Ptr,Size,AutoExtend); }
       BlockHeader *Header=reinterpret_cast<BlockHeader *>((*Ptr)-sizeof(BlockHeader));
       DebugMessage(DebugLevel::VrmMemPool,MEMORY_POOL_NAME(_PoolOwner)+"Re-allocation request (ptr="+PTRFORMAT(*Ptr)+
       " header="+BLOCK_PTR_STRING(Header)+" size="+ToString(Size)+" autoextend="+ToString(AutoExtend)+")");
@@ -257,6 +366,13 @@ class MemoryPool{
     //Memory release
     inline void Free(char *Ptr){
       if(Ptr==nullptr){ return; }
+      if(_IsSlabCell(Ptr)){
+        #ifdef __DEV__
+        if(_CheckFailure){ return; }
+        #endif
+        _SlabFree(reinterpret_cast<SlabCellHeader *>(Ptr-sizeof(SlabCellHeader)));
+        return;
+      }
       BlockHeader *Header=reinterpret_cast<BlockHeader *>((Ptr)-sizeof(BlockHeader));
       DebugMessage(DebugLevel::VrmMemPool,MEMORY_POOL_NAME(_PoolOwner)+"Release (ptr="+PTRFORMAT(Ptr)+" header="+BLOCK_PTR_STRING(Header)+")");
       #ifdef __DEV__
@@ -276,6 +392,7 @@ class MemoryPool{
     String ErrorText(MemPoolError Error) const;
     String MemOperationText(MemOperation MemOper) const;
     bool MemoryCheck(MemOperation Oper);
+    static void SetSlabLimit(CpuWrd Limit);
 
     //Constructors/Destructors
     MemoryPool(){}
@@ -4,6 +4,7 @@
 #include "bas/array.hpp"
 #include "bas/sortedarray.hpp"
 #include "bas/stack.hpp"
+#include "bas/queue.hpp"
 #include "bas/buffer.hpp"
 #include "bas/string.hpp"
 #include "sys/sysdefs.hpp"
@@ -15,14 +16,17 @@
 #include "vrm/auxmem.hpp"
 #include "vrm/strcomp.hpp"
 #include "vrm/arrcomp.hpp"
+#include "vrm/jit.hpp"
 #include "vrm/runtime.hpp"
+#include "vrm/tasks.hpp"
+#include "vrm/asyncio.hpp"
 
 //Default memory buffers data chunk sizes
 #define DEFAULT_CHUNKSIZE_GLOB      65536L   //Default program buffer chunk sizes for Glob buffer
 #define DEFAULT_CHUNKSIZE_STACK     65536L   //Default program buffer chunk sizes for Stack buffer
 #define DEFAULT_CHUNKSIZE_CODE      65536L   //Default program buffer chunk sizes for Code buffer
 #define DEFAULT_CHUNKSIZE_CALLST    64L      //Default program buffer chunk sizes for CallSt buffer
-#define DEFAULT_CHUNKSIZE_PARMST    16384L   //Default program buffer chunk sizes for ParmSt buffer
+#define DEFAULT_CHUNKSIZE_GEN       16L      //Default program buffer chunk sizes for generator buffer
 #define DEFAULT_CHUNKSIZE_PARAM     256L     //Default program buffer chunk sizes for Param buffer
 #define DEFAULT_CHUNKSIZE_PARMPTR   256L     //Default program buffer chunk sizes for ParmPtr buffer
 #define DEFAULT_CHUNKSIZE_ARRMETA   64L      //Default program buffer chunk sizes for ArrMeta buffer
@@ -38,6 +42,24 @@
 #define DEFAULT_CHUNKSIZE_DBGSYMFUN 64L      //Default program buffer chunk size for debug symbol functions
 #define DEFAULT_CHUNKSIZE_DBGSYMPAR 64L      //Default program buffer chunk size for debug symbol parameters
 #define DEFAULT_CHUNKSIZE_DBGSYMLIN 64L      //Default program buffer chunk size for debug symbol source code lines
+#define DEFAULT_CHUNKSIZE_PROFSAMPLE 65536L //Default program buffer chunk size for profiler samples
+
+//Sampling profiler
+#define PROF_SAMPLE_USEC 1000 //Sampling period in microseconds (cpu time)
+#define PROF_MAX_ROWS    25   //Maximun rows shown in profiler tables
+
+//Parallel walk
+#define PARALLEL_WALK_CHUNKS 8 //Chunks in which index range of each worker is taken (smaller chunks balance better but lock more often)
+
+//Instruction sequences (benchmark mode 4)
+//(instruction key is instruction code shifted 8 bits plus 2 bits for decoder mode of each argument,
+//sequence key packs up to three instruction keys plus control flow jump flags and sequence length)
+#define INST_SEQ_KEYBITS  17                                        //Bits for instruction key
+#define INST_SEQ_KEYMASK  ((((CpuLon)1)<<INST_SEQ_KEYBITS)-1)       //Instruction key mask
+#define INST_SEQ_JMPSHIFT (3*INST_SEQ_KEYBITS)                      //Shift for jump flags (one bit for each pair of consecutive instructions)
+#define INST_SEQ_LENSHIFT (3*INST_SEQ_KEYBITS+2)                    //Shift for sequence length
+#define INST_SEQ_SLOTS    4096                                      //Initial slots on instruction sequence hash table (power of 2)
+#define INST_SEQ_MAX_ROWS 40                                        //Maximun rows shown in instruction sequence tables
 
 //Maximun string printout length in debug messages
 #define MAX_STRING_DEBUG_PRINT 9999 //255
@@ -46,58 +68,71 @@
 const CpuMbl _GlobalScopeId=BLOCKMASK7F;    
 
 //Pointer to current runtime instance
-Runtime *_Rt=nullptr;
+thread_local Runtime *_Rt=nullptr;
 
 // Runtime local variables, only used in _RunProgram() -----------------------------
 // (they are here to avoid optimization, as they do not belong to fast path) 
+// (they are thread local as scheduler runs one process on each worker thread)
 
 //Pointers
-char *GlobPnt;  //Pointer to glob buffer
-char *StackPnt; //Pointer to stack buffer
+thread_local char *GlobPnt;  //Pointer to glob buffer
+thread_local char *StackPnt; //Pointer to stack buffer
 
 //Instruction tables
-const void *FakeInstAddress[_InstructionNr];    //Fake instruction table
-const void **InstAddressConstPtr;               //Instruction table pointer (constant)
+thread_local const void *FakeInstAddress[_InstructionNr];    //Fake instruction table
+thread_local const void *CallTimInstAddress[_InstructionNr]; //Call timming instruction table
+thread_local const void **InstAddressConstPtr;               //Instruction table pointer (constant)
 
 //Control registers
-CpuAdr PST;              //Parameter stack pointer
-char *TPTR;          //Temporary pointer
-CpuWrd *WRDP;        //Auxiliar word pointer
-CpuIcd ICODE;        //Current instruction code
-CpuMbl TRYBLK;       //Trial block (CHECK_SAFE_ADDRESSING)
-CpuAdr TRYADR;       //Trial address (CHECK_SAFE_ADDRESSING)
-CpuAdr MAXADR;       //Maximun address (CHECK_SAFE_ADDRESSING)
-CpuWrd OFF;          //Used for offset calculations
-CpuAdr INDXADDR;     //Index variable address on array loop
-CpuDecMode INDXDMOD; //Index variable decoder mode on array loop
-CpuAdr EXITADR;      //Used array loop exit jump
-CpuInt SCNR;         //Last system call executed
-CpuInt LCNR;         //Last dynamic library call executed
-CallStack RETADR;    //Return address
-CpuLon CUMULSC;      //Acumulated scope number (never decreases, ensures ScopeNr is always different)
-CpuMbl DSOZ;         //Necessary just to avoid compiler error, not used
-String STR;          //Temporary string
-void *VPTR;          //Void pointer used in library push instructions
-CpuMbl *BLK;         //Used in library push instructions
-CpuWrd *HPTR;        //Handler pointer to the instruction to be restored
-CpuIcd HICD;         //Instruction code related to the instruction to be restored
-CpuAdr PREVIP;       //Previous IP
-CpuAdr PREVBP;       //Previous BP
-int CFIX;            //Current function index
+thread_local CpuAdr PST;              //Parameter stack pointer
+thread_local CpuWrd PSZ;              //Size of parameters pushed on top of stack
+thread_local char *TPTR;          //Temporary pointer
+thread_local CpuWrd *WRDP;        //Auxiliar word pointer
+thread_local CpuIcd ICODE;        //Current instruction code
+thread_local CpuMbl TRYBLK;       //Trial block (CHECK_SAFE_ADDRESSING)
+thread_local CpuAdr TRYADR;       //Trial address (CHECK_SAFE_ADDRESSING)
+thread_local CpuAdr MAXADR;       //Maximun address (CHECK_SAFE_ADDRESSING)
+thread_local CpuWrd OFF;          //Used for offset calculations
+thread_local CpuAdr INDXADDR;     //Index variable address on array loop
+thread_local CpuDecMode INDXDMOD; //Index variable decoder mode on array loop
+thread_local CpuAdr EXITADR;      //Used array loop exit jump
+thread_local ParallelWalk *PWCTX=nullptr; //Parallel walk that current thread is running (null if none)
+thread_local int PWWORKER;        //Worker number on parallel walk (main thread is worker zero)
+thread_local CpuWrd PWINDEX;      //Current array index on parallel walk
+thread_local CpuWrd PWCHKEND;     //End of index chunk taken by current thread on parallel walk
+thread_local CpuWrd PWLEN;        //Array length on parallel walk start
+thread_local CpuInt SCNR;         //Last system call executed
+thread_local CpuInt LCNR;         //Last dynamic library call executed
+thread_local CallStack RETADR;    //Return address
+thread_local GeneratorState *GNPTR; //Generator pointer used in generator instructions
+thread_local CpuLon CUMULSC;      //Acumulated scope number (never decreases, ensures ScopeNr is always different)
+thread_local CpuMbl DSOZ;         //Necessary just to avoid compiler error, not used
+thread_local String STR;          //Temporary string
+thread_local Array<String> STRA;  //Temporary string array
+thread_local CpuLon TLON;         //Temporary long
+thread_local CpuFlo TFLO;         //Temporary float
+thread_local bool TBOL;           //Temporary boolean
+thread_local Buffer TBUF;         //Temporary buffer
+thread_local void *VPTR;          //Void pointer used in library push instructions
+thread_local CpuMbl *BLK;         //Used in library push instructions
+thread_local CpuWrd *HPTR;        //Handler pointer to the instruction to be restored
+thread_local CpuIcd HICD;         //Instruction code related to the instruction to be restored
+thread_local CpuAdr PREVIP;       //Previous IP
+thread_local CpuAdr PREVBP;       //Previous BP
+thread_local int CFIX;            //Current function index
 
 //Reference indirections
-CpuMbl DSO1,DSO2,DSO3,DSO4,DSO5,DSO6; //Decoder argument scope
-CpuRef DRF1,DRF2,DRF3,DRF4,DRF5,DRF6; //Decoder reference
+thread_local CpuMbl DSO1,DSO2,DSO3,DSO4,DSO5,DSO6; //Decoder argument scope
+thread_local CpuRef DRF1,DRF2,DRF3,DRF4,DRF5,DRF6; //Decoder reference
 
 //Cpu decoding
-CpuDecMode DMOD1,DMOD2,DMOD3,DMOD4; //Argument decoder modes
-CpuAdr ADV1,ADV2,ADV3,ADV4;         //Argument address value (used by decoder argument instructions)
-CpuAdr *ADP1,*ADP2,*ADP3,*ADP4;     //Argument address pointer (used by decoder argument instructions)
+thread_local CpuDecMode DMOD1,DMOD2,DMOD3,DMOD4; //Argument decoder modes
+thread_local CpuAdr ADV1,ADV2,ADV3,ADV4;         //Argument address value (used by decoder argument instructions)
+thread_local CpuAdr *ADP1,*ADP2,*ADP3,*ADP4;     //Argument address pointer (used by decoder argument instructions)
 
 // ---------------------------------------------------------------------------------
 
 //Internal functions
-void SetCurrentRuntime(Runtime *Rt);
 int _GetCurrentProcess();
 
 // Windows only specific -----------------------------------------------------------
@@ -108,8 +143,103 @@ String _GetLastError();
 #else
 enum class FdStatus{ Readable, Closed, Timeout, Error };
 bool _GetFdStatus(int Fd,int MaxTimeInSeconds,FdStatus &Status);
+thread_local char *StackGuardPnt=nullptr; //Stack guard page (fixed stack reservation, one per executing thread)
+thread_local CpuWrd StackGuardSize=0;     //Stack guard page size
+thread_local sigjmp_buf StackGuardJump;   //Jump point when stack guard page is hit
+std::mutex StackGuardMutex;               //Stack guard handler installation lock
+int StackGuardUsers=0;                    //Threads having a stack guard page set (handler is process wide)
+struct sigaction StackGuardOldAction;     //Previous SIGSEGV handler
+void _StackGuardHandler(int Signal,siginfo_t *Info,void *Context);
+bool _SetStackGuard(char *GuardPnt,CpuWrd GuardSize);
+void _ClearStackGuard();
+CpuWrd **ProfSlot=nullptr;               //Profiler handler slot pointers
+CpuWrd *ProfSaved=nullptr;               //Profiler saved handlers
+long ProfSlotNr=0;                       //Profiler handler slot count
+CpuWrd ProfHandler=0;                    //Profiler sample handler
+volatile sig_atomic_t ProfArmed=0;       //Profiler sample is armed (handler slots point to sample handler)
+struct sigaction ProfOldAction;          //Previous SIGPROF handler
+void _ProfilerHandler(int Signal);
+void _ProfilerDisarm();
+volatile sig_atomic_t ServeStop=0;       //Runtime server stop requested
+void _ServeStopHandler(int Signal);
 #endif
 
+//Superinstruction fusion rules
+//(pairs of consecutive instructions that _DecodeInstructionCodes() replaces by a single fused handler, instruction
+//codes in the code buffer are not changed so disassembler and benchmark modes still see the original instructions)
+struct FusionRule{
+  CpuInstCode First;  //First instruction of the pair
+  CpuInstCode Second; //Second instruction of the pair
+  bool SameArg1;      //First argument of both instructions must be the same address
+};
+const int _FusedInstNr=35;
+const FusionRule _FusionRule[_FusedInstNr]={
+  {CpuInstCode::LESc, CpuInstCode::JMPFL,true },
+  {CpuInstCode::LESw, CpuInstCode::JMPFL,true },
+  {CpuInstCode::LESi, CpuInstCode::JMPFL,true },
+  {CpuInstCode::LESl, CpuInstCode::JMPFL,true },
+  {CpuInstCode::LESf, CpuInstCode::JMPFL,true },
+  {CpuInstCode::LEQc, CpuInstCode::JMPFL,true },
+  {CpuInstCode::LEQw, CpuInstCode::JMPFL,true },
+  {CpuInstCode::LEQi, CpuInstCode::JMPFL,true },
+  {CpuInstCode::LEQl, CpuInstCode::JMPFL,true },
+  {CpuInstCode::LEQf, CpuInstCode::JMPFL,true },
+  {CpuInstCode::GREc, CpuInstCode::JMPFL,true },
+  {CpuInstCode::GREw, CpuInstCode::JMPFL,true },
+  {CpuInstCode::GREi, CpuInstCode::JMPFL,true },
+  {CpuInstCode::GREl, CpuInstCode::JMPFL,true },
+  {CpuInstCode::GREf, CpuInstCode::JMPFL,true },
+  {CpuInstCode::GEQc, CpuInstCode::JMPFL,true },
+  {CpuInstCode::GEQw, CpuInstCode::JMPFL,true },
+  {CpuInstCode::GEQi, CpuInstCode::JMPFL,true },
+  {CpuInstCode::GEQl, CpuInstCode::JMPFL,true },
+  {CpuInstCode::GEQf, CpuInstCode::JMPFL,true },
+  {CpuInstCode::EQUc, CpuInstCode::JMPFL,true },
+  {CpuInstCode::EQUw, CpuInstCode::JMPFL,true },
+  {CpuInstCode::EQUi, CpuInstCode::JMPFL,true },
+  {CpuInstCode::EQUl, CpuInstCode::JMPFL,true },
+  {CpuInstCode::EQUf, CpuInstCode::JMPFL,true },
+  {CpuInstCode::DISc, CpuInstCode::JMPFL,true },
+  {CpuInstCode::DISw, CpuInstCode::JMPFL,true },
+  {CpuInstCode::DISi, CpuInstCode::JMPFL,true },
+  {CpuInstCode::DISl, CpuInstCode::JMPFL,true },
+  {CpuInstCode::DISf, CpuInstCode::JMPFL,true },
+  {CpuInstCode::INCi, CpuInstCode::JMP,  false},
+  {CpuInstCode::INCl, CpuInstCode::JMP,  false},
+  {CpuInstCode::MVi,  CpuInstCode::ADDi, false},
+  {CpuInstCode::MVl,  CpuInstCode::ADDl, false},
+  {CpuInstCode::MVf,  CpuInstCode::ADDf, false}
+};
+
+//Operand-mode specialized instructions
+//(when decoder instructions DAGV*/DALI* are in front of one of these instructions, _DecodeInstructionCodes() installs on the
+//first decoder instruction a handler variant that skips them and decodes every argument with its mode fixed at load time)
+const int _SpecInstNr=18;
+const int _SpecModeNr=27; //Mode combinations for 3 arguments (index = Mode1 + 3*Mode2 + 9*Mode3)
+const int _SpecModeLoclVar=0;
+const int _SpecModeGlobVar=1;
+const int _SpecModeLoclInd=2;
+const CpuInstCode _SpecInst[_SpecInstNr]={
+  CpuInstCode::MVi,
+  CpuInstCode::MVl,
+  CpuInstCode::MVf,
+  CpuInstCode::ADDi,
+  CpuInstCode::ADDl,
+  CpuInstCode::ADDf,
+  CpuInstCode::SUBi,
+  CpuInstCode::SUBl,
+  CpuInstCode::SUBf,
+  CpuInstCode::MULi,
+  CpuInstCode::MULl,
+  CpuInstCode::MULf,
+  CpuInstCode::LESi,
+  CpuInstCode::LEQi,
+  CpuInstCode::GREi,
+  CpuInstCode::GEQi,
+  CpuInstCode::EQUi,
+  CpuInstCode::DISi
+};
+
 //Define instruction labels
 #define INST_LABEL_TABLE \
   const void *InstAddress[_InstructionNr]={ \
@@ -320,6 +450,7 @@ bool _GetFdStatus(int Fd,int MaxTimeInSeconds,FdStatus &Status);
   &&InstLabelAF1NX, \
   &&InstLabelAF1SJ, \
   &&InstLabelAF1CJ, \
+  &&InstLabelAF1PW, \
   &&InstLabelAFDEF, \
   &&InstLabelAFSSZ, \
   &&InstLabelAFGET, \
@@ -337,6 +468,8 @@ bool _GetFdStatus(int Fd,int MaxTimeInSeconds,FdStatus &Status);
   &&InstLabelAD1NX, \
   &&InstLabelAD1SJ, \
   &&InstLabelAD1CJ, \
+  &&InstLabelAD1PW, \
+  &&InstLabelAD1RV, \
   &&InstLabelADEMP, \
   &&InstLabelADDEF, \
   &&InstLabelADSET, \
@@ -346,6 +479,7 @@ bool _GetFdStatus(int Fd,int MaxTimeInSeconds,FdStatus &Status);
   &&InstLabelADIDX, \
   &&InstLabelADREF, \
   &&InstLabelADSIZ, \
+  &&InstLabelADSHR, \
   &&InstLabelAF2F, \
   &&InstLabelAF2D, \
   &&InstLabelAD2F, \
@@ -379,6 +513,11 @@ bool _GetFdStatus(int Fd,int MaxTimeInSeconds,FdStatus &Status);
   &&InstLabelSCALL, \
   &&InstLabelLCALL, \
   &&InstLabelSULOK, \
+  &&InstLabelGNNEW, \
+  &&InstLabelGNEND, \
+  &&InstLabelGNRES, \
+  &&InstLabelGNFRE, \
+  &&InstLabelYIELD, \
   &&InstLabelCUPPR, \
   &&InstLabelCLOWR, \
   &&InstLabelSEMP, \
@@ -411,6 +550,9 @@ bool _GetFdStatus(int Fd,int MaxTimeInSeconds,FdStatus &Status);
   &&InstLabelSISIN, \
   &&InstLabelSISLO, \
   &&InstLabelSISFL, \
+  &&InstLabelSRESV, \
+  &&InstLabelSSHRK, \
+  &&InstLabelSUNSH, \
   &&InstLabelBO2CH, \
   &&InstLabelBO2SH, \
   &&InstLabelBO2IN, \
@@ -685,6 +827,7 @@ INST_AF1FO; \
 INST_AF1NX; \
 INST_AF1SJ; \
 INST_AF1CJ; \
+INST_AF1PW; \
 INST_AFDEF; \
 INST_AFSSZ; \
 INST_AFGET; \
@@ -702,6 +845,8 @@ INST_AD1FO; \
 INST_AD1NX; \
 INST_AD1SJ; \
 INST_AD1CJ; \
+INST_AD1PW; \
+INST_AD1RV; \
 INST_ADEMP; \
 INST_ADDEF; \
 INST_ADSET; \
@@ -711,6 +856,7 @@ INST_ADRST; \
 INST_ADIDX; \
 INST_ADREF; \
 INST_ADSIZ; \
+INST_ADSHR; \
 INST_AF2F; \
 INST_AF2D; \
 INST_AD2F; \
@@ -744,6 +890,11 @@ INST_RETN; \
 INST_SCALL; \
 INST_LCALL; \
 INST_SULOK; \
+INST_GNNEW; \
+INST_GNEND; \
+INST_GNRES; \
+INST_GNFRE; \
+INST_YIELD; \
 INST_CUPPR; \
 INST_CLOWR; \
 INST_SEMP; \
@@ -776,6 +927,9 @@ INST_SISSH; \
 INST_SISIN; \
 INST_SISLO; \
 INST_SISFL; \
+INST_SRESV; \
+INST_SSHRK; \
+INST_SUNSH; \
 INST_BO2CH; \
 INST_BO2SH; \
 INST_BO2IN; \
@@ -840,6 +994,128 @@ INST_DALI3; \
 INST_DALI4; \
 INST_NOP; \
 
+//Define fused instruction labels (order must match _FusionRule[])
+#define FUSED_LABEL_TABLE \
+  const void *FusedAddress[_FusedInstNr]={ \
+  &&FusedLabelLESc_JMPFL, \
+  &&FusedLabelLESw_JMPFL, \
+  &&FusedLabelLESi_JMPFL, \
+  &&FusedLabelLESl_JMPFL, \
+  &&FusedLabelLESf_JMPFL, \
+  &&FusedLabelLEQc_JMPFL, \
+  &&FusedLabelLEQw_JMPFL, \
+  &&FusedLabelLEQi_JMPFL, \
+  &&FusedLabelLEQl_JMPFL, \
+  &&FusedLabelLEQf_JMPFL, \
+  &&FusedLabelGREc_JMPFL, \
+  &&FusedLabelGREw_JMPFL, \
+  &&FusedLabelGREi_JMPFL, \
+  &&FusedLabelGREl_JMPFL, \
+  &&FusedLabelGREf_JMPFL, \
+  &&FusedLabelGEQc_JMPFL, \
+  &&FusedLabelGEQw_JMPFL, \
+  &&FusedLabelGEQi_JMPFL, \
+  &&FusedLabelGEQl_JMPFL, \
+  &&FusedLabelGEQf_JMPFL, \
+  &&FusedLabelEQUc_JMPFL, \
+  &&FusedLabelEQUw_JMPFL, \
+  &&FusedLabelEQUi_JMPFL, \
+  &&FusedLabelEQUl_JMPFL, \
+  &&FusedLabelEQUf_JMPFL, \
+  &&FusedLabelDISc_JMPFL, \
+  &&FusedLabelDISw_JMPFL, \
+  &&FusedLabelDISi_JMPFL, \
+  &&FusedLabelDISl_JMPFL, \
+  &&FusedLabelDISf_JMPFL, \
+  &&FusedLabelINCi_JMP, \
+  &&FusedLabelINCl_JMP, \
+  &&FusedLabelMVi_ADDi, \
+  &&FusedLabelMVl_ADDl, \
+  &&FusedLabelMVf_ADDf \
+  }; \
+
+//Fused instruction switcher block
+#define FUSED_SWITCHER \
+FUSED_LESc_JMPFL; \
+FUSED_LESw_JMPFL; \
+FUSED_LESi_JMPFL; \
+FUSED_LESl_JMPFL; \
+FUSED_LESf_JMPFL; \
+FUSED_LEQc_JMPFL; \
+FUSED_LEQw_JMPFL; \
+FUSED_LEQi_JMPFL; \
+FUSED_LEQl_JMPFL; \
+FUSED_LEQf_JMPFL; \
+FUSED_GREc_JMPFL; \
+FUSED_GREw_JMPFL; \
+FUSED_GREi_JMPFL; \
+FUSED_GREl_JMPFL; \
+FUSED_GREf_JMPFL; \
+FUSED_GEQc_JMPFL; \
+FUSED_GEQw_JMPFL; \
+FUSED_GEQi_JMPFL; \
+FUSED_GEQl_JMPFL; \
+FUSED_GEQf_JMPFL; \
+FUSED_EQUc_JMPFL; \
+FUSED_EQUw_JMPFL; \
+FUSED_EQUi_JMPFL; \
+FUSED_EQUl_JMPFL; \
+FUSED_EQUf_JMPFL; \
+FUSED_DISc_JMPFL; \
+FUSED_DISw_JMPFL; \
+FUSED_DISi_JMPFL; \
+FUSED_DISl_JMPFL; \
+FUSED_DISf_JMPFL; \
+FUSED_INCi_JMP; \
+FUSED_INCl_JMP; \
+FUSED_MVi_ADDi; \
+FUSED_MVl_ADDl; \
+FUSED_MVf_ADDf; \
+
+//Define operand-mode specialized instruction labels (order must match _SpecInst[], unused combinations are null)
+#define SPEC_LABEL_TABLE \
+  const void *SpecAddress[_SpecInstNr*_SpecModeNr]={ \
+  SPEC_ADDRESS_2(MVi) \
+  SPEC_ADDRESS_2(MVl) \
+  SPEC_ADDRESS_2(MVf) \
+  SPEC_ADDRESS_3(ADDi) \
+  SPEC_ADDRESS_3(ADDl) \
+  SPEC_ADDRESS_3(ADDf) \
+  SPEC_ADDRESS_3(SUBi) \
+  SPEC_ADDRESS_3(SUBl) \
+  SPEC_ADDRESS_3(SUBf) \
+  SPEC_ADDRESS_3(MULi) \
+  SPEC_ADDRESS_3(MULl) \
+  SPEC_ADDRESS_3(MULf) \
+  SPEC_ADDRESS_3(LESi) \
+  SPEC_ADDRESS_3(LEQi) \
+  SPEC_ADDRESS_3(GREi) \
+  SPEC_ADDRESS_3(GEQi) \
+  SPEC_ADDRESS_3(EQUi) \
+  SPEC_ADDRESS_3(DISi) \
+  }; \
+
+//Operand-mode specialized instruction switcher block
+#define SPEC_SWITCHER \
+SPEC_COMBINATIONS_2(SPEC_HANDLER,MVi); \
+SPEC_COMBINATIONS_2(SPEC_HANDLER,MVl); \
+SPEC_COMBINATIONS_2(SPEC_HANDLER,MVf); \
+SPEC_COMBINATIONS_3(SPEC_HANDLER,ADDi); \
+SPEC_COMBINATIONS_3(SPEC_HANDLER,ADDl); \
+SPEC_COMBINATIONS_3(SPEC_HANDLER,ADDf); \
+SPEC_COMBINATIONS_3(SPEC_HANDLER,SUBi); \
+SPEC_COMBINATIONS_3(SPEC_HANDLER,SUBl); \
+SPEC_COMBINATIONS_3(SPEC_HANDLER,SUBf); \
+SPEC_COMBINATIONS_3(SPEC_HANDLER,MULi); \
+SPEC_COMBINATIONS_3(SPEC_HANDLER,MULl); \
+SPEC_COMBINATIONS_3(SPEC_HANDLER,MULf); \
+SPEC_COMBINATIONS_3(SPEC_HANDLER,LESi); \
+SPEC_COMBINATIONS_3(SPEC_HANDLER,LEQi); \
+SPEC_COMBINATIONS_3(SPEC_HANDLER,GREi); \
+SPEC_COMBINATIONS_3(SPEC_HANDLER,GEQi); \
+SPEC_COMBINATIONS_3(SPEC_HANDLER,EQUi); \
+SPEC_COMBINATIONS_3(SPEC_HANDLER,DISi); \
+
 //Define instruction labels
 #define SYSTEMCALL_LABEL_TABLE \
   const void *SysCallLabelPtr[_SystemCallNr]={ \
@@ -933,7 +1209,27 @@ INST_NOP; \
   &&SystemCallLabelGetDate, \
   &&SystemCallLabelGetTime, \
   &&SystemCallLabelDateDiff, \
-  &&SystemCallLabelTimeDiff \
+  &&SystemCallLabelTimeDiff, \
+  &&SystemCallLabelSpawn, \
+  &&SystemCallLabelJoin, \
+  &&SystemCallLabelChOpen, \
+  &&SystemCallLabelChClose, \
+  &&SystemCallLabelChSendStr, \
+  &&SystemCallLabelChSendInt, \
+  &&SystemCallLabelChSendLon, \
+  &&SystemCallLabelChSendFlo, \
+  &&SystemCallLabelChSendArr, \
+  &&SystemCallLabelChRecvStr, \
+  &&SystemCallLabelChRecvInt, \
+  &&SystemCallLabelChRecvLon, \
+  &&SystemCallLabelChRecvFlo, \
+  &&SystemCallLabelChRecvArr, \
+  &&SystemCallLabelReadAsync, \
+  &&SystemCallLabelReadAllAsync, \
+  &&SystemCallLabelWriteAsync, \
+  &&SystemCallLabelIoPoll, \
+  &&SystemCallLabelIoWait, \
+  &&SystemCallLabelIoWaitData \
 }; \
 
 #define SYSTEMCALL_SWITCHER \
@@ -1028,6 +1324,26 @@ SYSCALL_GETDATE; \
 SYSCALL_GETTIME; \
 SYSCALL_DATEDIFF; \
 SYSCALL_TIMEDIFF; \
+SYSCALL_SPAWN; \
+SYSCALL_JOIN; \
+SYSCALL_CHOPEN; \
+SYSCALL_CHCLOSE; \
+SYSCALL_CHSENDSTR; \
+SYSCALL_CHSENDINT; \
+SYSCALL_CHSENDLON; \
+SYSCALL_CHSENDFLO; \
+SYSCALL_CHSENDARR; \
+SYSCALL_CHRECVSTR; \
+SYSCALL_CHRECVINT; \
+SYSCALL_CHRECVLON; \
+SYSCALL_CHRECVFLO; \
+SYSCALL_CHRECVARR; \
+SYSCALL_READASYNC; \
+SYSCALL_READALLASYNC; \
+SYSCALL_WRITEASYNC; \
+SYSCALL_IOPOLL; \
+SYSCALL_IOWAIT; \
+SYSCALL_IOWAITDATA; \
 
 //Argument to string functions
 String Runtime::_ToStringCpuBol(CpuBol Arg){ return (Arg==0?"false":(Arg==1?"true":NZHEXFORMAT(Arg))); }
@@ -1156,6 +1472,7 @@ String Runtime::_ToStringCpuMbl(CpuMbl Arg){
 #define INSTDECODE_1_Z_A            DECODE_ADR(1,WRD,CpuWrd,AOFF_I); 
 #define INSTDECODE_1_Z_V            DECODE_LIT(1,WRD,CpuWrd,AOFF_I); 
 #define INSTDECODE_2_BA_AV          DECODE_ADR(1,BOL,CpuBol,AOFF_I); DECODE_LIT(2,ADR,CpuAdr,AOFF_IA); 
+#define INSTDECODE_2_ZA_AV          DECODE_ADR(1,WRD,CpuWrd,AOFF_I); DECODE_LIT(2,ADR,CpuAdr,AOFF_IA); 
 #define INSTDECODE_2_BB_AA          DECODE_ADR(1,BOL,CpuBol,AOFF_I); DECODE_ADR(2,BOL,CpuBol,AOFF_IA); 
 #define INSTDECODE_2_BB_AV          DECODE_ADR(1,BOL,CpuBol,AOFF_I); DECODE_LIT(2,BOL,CpuBol,AOFF_IA); 
 #define INSTDECODE_2_BC_AA          DECODE_ADR(1,BOL,CpuBol,AOFF_I); DECODE_ADR(2,CHR,CpuChr,AOFF_IA); 
@@ -1260,6 +1577,7 @@ String Runtime::_ToStringCpuMbl(CpuMbl Arg){
 #define INSTDECODE_3_MMM_AAA        DECODE_ADR(1,MBL,CpuMbl,AOFF_I); DECODE_ADR(2,MBL,CpuMbl,AOFF_IA); DECODE_ADR(3,MBL,CpuMbl,AOFF_IAA); 
 #define INSTDECODE_3_MMZ_AAA        DECODE_ADR(1,MBL,CpuMbl,AOFF_I); DECODE_ADR(2,MBL,CpuMbl,AOFF_IA); DECODE_ADR(3,WRD,CpuWrd,AOFF_IAA); 
 #define INSTDECODE_3_MWM_AAA        DECODE_ADR(1,MBL,CpuMbl,AOFF_I); DECODE_ADR(2,SHR,CpuShr,AOFF_IA); DECODE_ADR(3,MBL,CpuMbl,AOFF_IAA); 
+#define INSTDECODE_3_MZZ_AAV        DECODE_ADR(1,MBL,CpuMbl,AOFF_I); DECODE_ADR(2,WRD,CpuWrd,AOFF_IA); DECODE_LIT(3,WRD,CpuWrd,AOFF_IAA); 
 #define INSTDECODE_3_RBG_AVV        DECODE_ADR(1,REF,CpuRef,AOFF_I); DECODE_LIT(2,BOL,CpuBol,AOFF_IA); DECODE_LIT(3,AGX,CpuAgx,AOFF_IAB); 
 #define INSTDECODE_3_RDG_AAV        DECODE_ADR(1,REF,CpuRef,AOFF_I); DECODE_ADR(2,DAT,CpuDat,AOFF_IA); DECODE_LIT(3,AGX,CpuAgx,AOFF_IAA); 
 #define INSTDECODE_3_RDZ_AAV        DECODE_ADR(1,REF,CpuRef,AOFF_I); DECODE_ADR(2,DAT,CpuDat,AOFF_IA); DECODE_LIT(3,WRD,CpuWrd,AOFF_IAA); 
@@ -1394,6 +1712,7 @@ String Runtime::_ToStringCpuMbl(CpuMbl Arg){
 #define INSTEND_3_MMM_AAA       IP+=ISIZ_IAAA;  PROG_INST_DISPATCH;
 #define INSTEND_3_MMZ_AAA       IP+=ISIZ_IAAA;  PROG_INST_DISPATCH;
 #define INSTEND_3_MWM_AAA       IP+=ISIZ_IAAA;  PROG_INST_DISPATCH;
+#define INSTEND_3_MZZ_AAV       IP+=ISIZ_IAAZ;  PROG_INST_DISPATCH;
 #define INSTEND_3_RBG_AVV       IP+=ISIZ_IABG;  PROG_INST_DISPATCH;
 #define INSTEND_3_RDG_AAV       IP+=ISIZ_IAAG;  PROG_INST_DISPATCH;
 #define INSTEND_3_RDZ_AAV       IP+=ISIZ_IAAZ;  PROG_INST_DISPATCH;
@@ -1419,6 +1738,14 @@ String Runtime::_ToStringCpuMbl(CpuMbl Arg){
 #define JMP_INSTEND_2_BA_AV     PROG_INST_DISPATCH;
 #define JMP_INSTEND_3_RDG_AAV   PROG_INST_DISPATCH;
 #define JMP_INSTEND_2_RM_AA     PROG_INST_DISPATCH;
+#define INSTEND_1_Z_A           IP+=ISIZ_IA; PROG_INST_DISPATCH;
+#define INSTEND_2_ZA_AV         IP+=ISIZ_IAA; PROG_INST_DISPATCH;
+#define JMP_INSTEND_1_Z_A       PROG_INST_DISPATCH;
+#define JMP_INSTEND_2_ZA_AV     PROG_INST_DISPATCH;
+
+//Fused instruction endings (second instruction of the pair is a jump that is executed inline)
+#define FUSEDEND_IAAA_JMPFL     if(!(*BOL1)){ IP+=ISIZ_IAAA+(*(CpuAdr *)(CodePtr+IP+ISIZ_IAAA+AOFF_IA)); PROG_INST_DISPATCH; } IP+=ISIZ_IAAA+ISIZ_IAA; PROG_INST_DISPATCH;
+#define FUSEDEND_IA_JMP         IP+=ISIZ_IA+(*(CpuAdr *)(CodePtr+IP+ISIZ_IA+AOFF_I)); PROG_INST_DISPATCH;
 
 
 //Check division by zero
@@ -1514,16 +1841,16 @@ String Runtime::_ToStringCpuMbl(CpuMbl Arg){
 
 //Get stack parameter argument
 #define SCALLGETPARAMETER(argnr,argptr,datatype) { \
-  DebugAppend(DebugLevel::VrmRuntime,"SysCall: Input ParmSt["+HEXFORMAT(PST)+"] Value " #argptr #argnr); \
-  REG##argnr=(datatype *)&_ParmSt[PST]; \
+  DebugAppend(DebugLevel::VrmRuntime,"SysCall: Input Stack["+HEXFORMAT(PST)+"] Value " #argptr #argnr); \
+  REG##argnr=(datatype *)&_Stack[PST]; \
   PST+=sizeof(datatype); \
   DebugMessage(DebugLevel::VrmRuntime," = "+_ToString##datatype(*reinterpret_cast<datatype*>(REG##argnr))); \
 }
 
 //Get stack parameter argument through reference indirection
 #define SCALLGETREFRINDIR(argnr,argptr,datatype) { \
-  DebugAppend(DebugLevel::VrmRuntime,"SysCall: Input ParmSt["+HEXFORMAT(PST)+"] Indir " #argptr #argnr); \
-  DRF##argnr=*(CpuRef *)&_ParmSt[PST]; \
+  DebugAppend(DebugLevel::VrmRuntime,"SysCall: Input Stack["+HEXFORMAT(PST)+"] Indir " #argptr #argnr); \
+  DRF##argnr=*(CpuRef *)&_Stack[PST]; \
   DebugAppend(DebugLevel::VrmRuntime," "+_ToStringCpuRef(DRF##argnr)); \
   REFINDIRECTION(DRF##argnr,TPTR,DSO##argnr); \
   REG##argnr=(datatype *)TPTR; \
@@ -1739,6 +2066,9 @@ String Runtime::_ToStringCpuMbl(CpuMbl Arg){
 #define INST_SISIN InstLabelSISIN:; INSTDECODE_2_BM_AA;     if(!_StC.SISIN(BOL1,*MBL2)){ EXCP_EXIT; };             INSTEND_2_BM_AA;
 #define INST_SISLO InstLabelSISLO:; INSTDECODE_2_BM_AA;     if(!_StC.SISLO(BOL1,*MBL2)){ EXCP_EXIT; };             INSTEND_2_BM_AA;
 #define INST_SISFL InstLabelSISFL:; INSTDECODE_2_BM_AA;     if(!_StC.SISFL(BOL1,*MBL2)){ EXCP_EXIT; };             INSTEND_2_BM_AA;
+#define INST_SRESV InstLabelSRESV:; INSTDECODE_2_MZ_AA;     if(!_StC.SRESV(*MBL1,*WRD2)){ EXCP_EXIT; };            INSTEND_2_MZ_AA;
+#define INST_SSHRK InstLabelSSHRK:; INSTDECODE_1_M_A;       if(!_StC.SSHRK(*MBL1)){ EXCP_EXIT; };                  INSTEND_1_M_A;
+#define INST_SUNSH InstLabelSUNSH:; INSTDECODE_1_R_A;       if(!_StC.SUNSH(*REF1)){ EXCP_EXIT; };                  INSTEND_1_R_A;
 #define INST_SRGHT InstLabelSRGHT:; INSTDECODE_3_MMZ_AAA;   if(!_StC.SRGHT(MBL1,*MBL2,*WRD3)){ EXCP_EXIT; };       INSTEND_3_MMZ_AAA;
 #define INST_SLEFT InstLabelSLEFT:; INSTDECODE_3_MMZ_AAA;   if(!_StC.SLEFT(MBL1,*MBL2,*WRD3)){ EXCP_EXIT; };       INSTEND_3_MMZ_AAA;
 #define INST_SCUTR InstLabelSCUTR:; INSTDECODE_3_MMZ_AAA;   if(!_StC.SCUTR(MBL1,*MBL2,*WRD3)){ EXCP_EXIT; };       INSTEND_3_MMZ_AAA;
@@ -1840,11 +2170,27 @@ String Runtime::_ToStringCpuMbl(CpuMbl Arg){
 #define INST_AF1RW InstLabelAF1RW:; INSTDECODE_3_GAA_VVV;   if(!_ArC.AF1RW(*AGX1,*ADR2,DMOD2,IP+*ADR3)){ EXCP_EXIT; } if(*ADR2!=0){ GET_POINTER(*ADR2,DMOD2,CpuWrd,WRDP); (*WRDP)=0; } INSTEND_3_GAA_VVV;
 #define INST_AF1SJ InstLabelAF1SJ:; INSTDECODE_4_MDGM_AAVA; if(!_ArC.AF1SJ(MBL1,(char *)DAT2,*AGX3,*MBL4)){ EXCP_EXIT; }                                                               INSTEND_4_MDGM_AAVA;
 #define INST_AF1CJ InstLabelAF1CJ:; INSTDECODE_4_MDGM_AAVA; if(!_ArC.AF1CJ(MBL1,(char *)DAT2,*AGX3,*MBL4)){ EXCP_EXIT; }                                                               INSTEND_4_MDGM_AAVA;
-#define INST_AF1NX InstLabelAF1NX:; INSTDECODE_2_GA_VV;     if(!_ArC.AF1NX(*AGX1,&INDXADDR,&INDXDMOD)){ EXCP_EXIT; } \
+#define INST_AF1NX InstLabelAF1NX:; INSTDECODE_2_GA_VV;     if(PWCTX!=nullptr){ \
+                                                              if(_ParallelWalkNext()){ IP+=(*ADR2); RESTORE_HANDLER;                                                                    JMP_INSTEND_2_GA_VV; } \
+                                                              if(PWWORKER!=0){ goto RunProgExit; } \
+                                                              if(!_ParallelWalkEnd(false,&EXITADR)){ IP=EXITADR; EXCP_EXIT; } \
+                                                              IP=EXITADR; RESTORE_HANDLER;                                                                                              JMP_INSTEND_2_GA_VV; \
+                                                            } \
+                                                            if(!_ArC.AF1NX(*AGX1,&INDXADDR,&INDXDMOD)){ EXCP_EXIT; } \
                                                             if(INDXADDR!=0){ GET_POINTER(INDXADDR,INDXDMOD,CpuWrd,WRDP); (*WRDP)++; } IP+=(*ADR2); RESTORE_HANDLER;                    JMP_INSTEND_2_GA_VV;
-#define INST_AF1FO InstLabelAF1FO:; INSTDECODE_3_RDG_AAV;   if(!_ArC.AF1FO(*AGX3,&OFF,&EXITADR)){ EXCP_EXIT; } \
+#define INST_AF1FO InstLabelAF1FO:; INSTDECODE_3_RDG_AAV;   if(PWCTX!=nullptr){ \
+                                                              if(!_ArC.AF1OF(*AGX3,PWINDEX,&OFF)){ EXCP_EXIT; } GET_ARG_AS_REFERENCE(2,*REF1,AOFF_IA); (*REF1).Offset+=OFF; \
+                                                              if(PWCTX->IndexVarAddr!=0){ GET_POINTER(PWCTX->IndexVarAddr,PWCTX->IndexVarMode,CpuWrd,WRDP); (*WRDP)=PWINDEX; }       INSTEND_3_RDG_AAV; \
+                                                            } \
+                                                            if(!_ArC.AF1FO(*AGX3,&OFF,&EXITADR)){ EXCP_EXIT; } \
                                                             if(EXITADR!=0){ IP=EXITADR; RESTORE_HANDLER; RESTORE_DECODER(1); RESTORE_DECODER(2);                                       JMP_INSTEND_3_RDG_AAV; } \
                                                             else{ GET_ARG_AS_REFERENCE(2,*REF1,AOFF_IA); (*REF1).Offset+=OFF; }                                                        INSTEND_3_RDG_AAV;
+#define INST_AF1PW InstLabelAF1PW:; INSTDECODE_3_GAA_VVV;   if(!_ArC.AF1RW(*AGX1,*ADR2,DMOD2,IP+*ADR3)){ EXCP_EXIT; } if(*ADR2!=0){ GET_POINTER(*ADR2,DMOD2,CpuWrd,WRDP); (*WRDP)=0; } \
+                                                            if(!_ArC.AFGET(*AGX1,1,&PWLEN)){ EXCP_EXIT; } \
+                                                            if(_ParallelWalkEnabled(BenchMark,PWLEN)){ \
+                                                              if(!_ParallelWalkStart(IP+ISIZ_IGAA,IP+*ADR3,BP,*ADR2,DMOD2,PWLEN,CFIX,CUMULSC)){ EXCP_EXIT; } \
+                                                            } \
+                                                            INSTEND_3_GAA_VVV;
 
 //Instruction macros for fixed array operations
 #define INST_AFDEF InstLabelAFDEF:; INSTDECODE_3_GCZ_VVV; if(!_ArC.AFDEF(*AGX1,*CHR2,*WRD3)){ EXCP_EXIT; }                                                      INSTEND_3_GCZ_VVV;
@@ -1864,11 +2210,28 @@ String Runtime::_ToStringCpuMbl(CpuMbl Arg){
 #define INST_AD1RW InstLabelAD1RW:; INSTDECODE_3_MAA_AVV;   if(!_ArC.AD1RW(*MBL1,*ADR2,DMOD2,IP+*ADR3)){ EXCP_EXIT; } if(*ADR2!=0){ GET_POINTER(*ADR2,DMOD2,CpuWrd,WRDP); (*WRDP)=0; }  INSTEND_3_MAA_AVV;
 #define INST_AD1SJ InstLabelAD1SJ:; INSTDECODE_3_MMM_AAA;   if(!_ArC.AD1SJ(MBL1,*MBL2,*MBL3)){ EXCP_EXIT; }                                                                             INSTEND_3_MMM_AAA;
 #define INST_AD1CJ InstLabelAD1CJ:; INSTDECODE_3_MMM_AAA;   if(!_ArC.AD1CJ(MBL1,*MBL2,*MBL3)){ EXCP_EXIT; }                                                                             INSTEND_3_MMM_AAA;
-#define INST_AD1NX InstLabelAD1NX:; INSTDECODE_2_MA_AV;     if(!_ArC.AD1NX(*MBL1,&INDXADDR,&INDXDMOD)){ EXCP_EXIT; } \
+#define INST_AD1NX InstLabelAD1NX:; INSTDECODE_2_MA_AV;     if(PWCTX!=nullptr){ \
+                                                              if(_ParallelWalkNext()){ IP+=(*ADR2); RESTORE_HANDLER; RESTORE_DECODER(1);                                                JMP_INSTEND_2_MA_AV; } \
+                                                              if(PWWORKER!=0){ goto RunProgExit; } \
+                                                              if(!_ParallelWalkEnd(false,&EXITADR)){ IP=EXITADR; EXCP_EXIT; } \
+                                                              IP=EXITADR; RESTORE_HANDLER; RESTORE_DECODER(1);                                                                          JMP_INSTEND_2_MA_AV; \
+                                                            } \
+                                                            if(!_ArC.AD1NX(*MBL1,&INDXADDR,&INDXDMOD)){ EXCP_EXIT; } \
                                                             if(INDXADDR!=0){ GET_POINTER(INDXADDR,INDXDMOD,CpuWrd,WRDP); (*WRDP)++; } IP+=(*ADR2); RESTORE_HANDLER; RESTORE_DECODER(1); JMP_INSTEND_2_MA_AV;
-#define INST_AD1FO InstLabelAD1FO:; INSTDECODE_2_RM_AA;     if(!_ArC.AD1FO(*MBL2,&OFF,&EXITADR)){ EXCP_EXIT; } \
+#define INST_AD1FO InstLabelAD1FO:; INSTDECODE_2_RM_AA;     if(PWCTX!=nullptr){ \
+                                                              if(!_ArC.AD1OF(*MBL2,PWINDEX,&OFF)){ EXCP_EXIT; } (*REF1)=(CpuRef){ (CpuMbl)(BLOCKMASK80|(*MBL2)),OFF }; \
+                                                              if(PWCTX->IndexVarAddr!=0){ GET_POINTER(PWCTX->IndexVarAddr,PWCTX->IndexVarMode,CpuWrd,WRDP); (*WRDP)=PWINDEX; }       INSTEND_2_RM_AA; \
+                                                            } \
+                                                            if(!_ArC.AD1FO(*MBL2,&OFF,&EXITADR)){ EXCP_EXIT; } \
                                                             if(EXITADR!=0){ IP=EXITADR; RESTORE_HANDLER; RESTORE_DECODER(1); RESTORE_DECODER(2);                                        JMP_INSTEND_2_RM_AA; } \
                                                             else{ (*REF1)=(CpuRef){ (CpuMbl)(BLOCKMASK80|(*MBL2)),OFF }; }                                                              INSTEND_2_RM_AA;
+#define INST_AD1PW InstLabelAD1PW:; INSTDECODE_3_MAA_AVV;   if(!_ArC.AD1RW(*MBL1,*ADR2,DMOD2,IP+*ADR3)){ EXCP_EXIT; } if(*ADR2!=0){ GET_POINTER(*ADR2,DMOD2,CpuWrd,WRDP); (*WRDP)=0; } \
+                                                            if(!_ArC.ADGET(*MBL1,1,&PWLEN)){ EXCP_EXIT; } \
+                                                            if(_ParallelWalkEnabled(BenchMark,PWLEN)){ \
+                                                              if(!_ParallelWalkStart(IP+ISIZ_IAAA,IP+*ADR3,BP,*ADR2,DMOD2,PWLEN,CFIX,CUMULSC)){ EXCP_EXIT; } \
+                                                            } \
+                                                            INSTEND_3_MAA_AVV;
+#define INST_AD1RV InstLabelAD1RV:; INSTDECODE_3_MZZ_AAV;   if(!_ArC.AD1RV(*MBL1,*WRD2,*WRD3)){ EXCP_EXIT; }                                                                            INSTEND_3_MZZ_AAV;
 
 //Instruction macros for dynamic array operations
 #define INST_ADEMP InstLabelADEMP:; INSTDECODE_3_MCZ_AVV;   if(!_ArC.ADEMP(MBL1,*CHR2,*WRD3)){ EXCP_EXIT; }                                                  INSTEND_3_MCZ_AVV;
@@ -1879,6 +2242,7 @@ String Runtime::_ToStringCpuMbl(CpuMbl Arg){
 #define INST_ADRST InstLabelADRST:; INSTDECODE_1_M_A;       if(!_ArC.ADRST(MBL1)){ EXCP_EXIT; }                                                              INSTEND_1_M_A;
 #define INST_ADIDX InstLabelADIDX:; INSTDECODE_3_MCZ_AVA;   if(!_ArC.ADIDX(*MBL1,*CHR2,*WRD3)){ EXCP_EXIT; }                                                 INSTEND_3_MCZ_AVA;
 #define INST_ADSIZ InstLabelADSIZ:; INSTDECODE_2_MZ_AA;     if(!_ArC.ADSIZ(*MBL1,WRD2)){ EXCP_EXIT; }                                                        INSTEND_2_MZ_AA;
+#define INST_ADSHR InstLabelADSHR:; INSTDECODE_1_M_A;       if(!_ArC.ADSHR(*MBL1)){ EXCP_EXIT; }                                                             INSTEND_1_M_A;
 #define INST_ADREF InstLabelADREF:; INSTDECODE_2_RM_AA;     if(!_ArC.ADOFN(*MBL2,&OFF)){ EXCP_EXIT; } (*REF1)=(CpuRef){ (CpuMbl)(BLOCKMASK80|(*MBL2)),OFF }; INSTEND_2_RM_AA;
 #define INST_AF2F  InstLabelAF2F :; INSTDECODE_4_DGDG_AVAV; if(!_ArC.AF2F(DAT1,*AGX2,DAT3,*AGX4)){ EXCP_EXIT; }                                              INSTEND_4_DGDG_AVAV;
 #define INST_AF2D  InstLabelAF2D :; INSTDECODE_3_MDG_AAV;   if(!_ArC.AF2D(MBL1,DAT2,*AGX3)){ EXCP_EXIT; }                                                    INSTEND_3_MDG_AAV;
@@ -1888,6 +2252,111 @@ String Runtime::_ToStringCpuMbl(CpuMbl Arg){
 //No operation
 #define INST_NOP InstLabelNOP:; INSTDECODE_0; INSTEND_0;
 
+//Fused instruction macros (superinstructions, see _FusionRule[])
+#define FUSED_LESc_JMPFL  FusedLabelLESc_JMPFL :; INSTDECODE_3_BCC_AAA; (*BOL1)=(*CHR2)< (*CHR3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_LESw_JMPFL  FusedLabelLESw_JMPFL :; INSTDECODE_3_BWW_AAA; (*BOL1)=(*SHR2)< (*SHR3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_LESi_JMPFL  FusedLabelLESi_JMPFL :; INSTDECODE_3_BII_AAA; (*BOL1)=(*INT2)< (*INT3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_LESl_JMPFL  FusedLabelLESl_JMPFL :; INSTDECODE_3_BLL_AAA; (*BOL1)=(*LON2)< (*LON3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_LESf_JMPFL  FusedLabelLESf_JMPFL :; INSTDECODE_3_BFF_AAA; (*BOL1)=(*FLO2)< (*FLO3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_LEQc_JMPFL  FusedLabelLEQc_JMPFL :; INSTDECODE_3_BCC_AAA; (*BOL1)=(*CHR2)<=(*CHR3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_LEQw_JMPFL  FusedLabelLEQw_JMPFL :; INSTDECODE_3_BWW_AAA; (*BOL1)=(*SHR2)<=(*SHR3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_LEQi_JMPFL  FusedLabelLEQi_JMPFL :; INSTDECODE_3_BII_AAA; (*BOL1)=(*INT2)<=(*INT3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_LEQl_JMPFL  FusedLabelLEQl_JMPFL :; INSTDECODE_3_BLL_AAA; (*BOL1)=(*LON2)<=(*LON3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_LEQf_JMPFL  FusedLabelLEQf_JMPFL :; INSTDECODE_3_BFF_AAA; (*BOL1)=(*FLO2)<=(*FLO3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_GREc_JMPFL  FusedLabelGREc_JMPFL :; INSTDECODE_3_BCC_AAA; (*BOL1)=(*CHR2)> (*CHR3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_GREw_JMPFL  FusedLabelGREw_JMPFL :; INSTDECODE_3_BWW_AAA; (*BOL1)=(*SHR2)> (*SHR3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_GREi_JMPFL  FusedLabelGREi_JMPFL :; INSTDECODE_3_BII_AAA; (*BOL1)=(*INT2)> (*INT3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_GREl_JMPFL  FusedLabelGREl_JMPFL :; INSTDECODE_3_BLL_AAA; (*BOL1)=(*LON2)> (*LON3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_GREf_JMPFL  FusedLabelGREf_JMPFL :; INSTDECODE_3_BFF_AAA; (*BOL1)=(*FLO2)> (*FLO3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_GEQc_JMPFL  FusedLabelGEQc_JMPFL :; INSTDECODE_3_BCC_AAA; (*BOL1)=(*CHR2)>=(*CHR3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_GEQw_JMPFL  FusedLabelGEQw_JMPFL :; INSTDECODE_3_BWW_AAA; (*BOL1)=(*SHR2)>=(*SHR3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_GEQi_JMPFL  FusedLabelGEQi_JMPFL :; INSTDECODE_3_BII_AAA; (*BOL1)=(*INT2)>=(*INT3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_GEQl_JMPFL  FusedLabelGEQl_JMPFL :; INSTDECODE_3_BLL_AAA; (*BOL1)=(*LON2)>=(*LON3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_GEQf_JMPFL  FusedLabelGEQf_JMPFL :; INSTDECODE_3_BFF_AAA; (*BOL1)=(*FLO2)>=(*FLO3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_EQUc_JMPFL  FusedLabelEQUc_JMPFL :; INSTDECODE_3_BCC_AAA; (*BOL1)=(*CHR2)==(*CHR3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_EQUw_JMPFL  FusedLabelEQUw_JMPFL :; INSTDECODE_3_BWW_AAA; (*BOL1)=(*SHR2)==(*SHR3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_EQUi_JMPFL  FusedLabelEQUi_JMPFL :; INSTDECODE_3_BII_AAA; (*BOL1)=(*INT2)==(*INT3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_EQUl_JMPFL  FusedLabelEQUl_JMPFL :; INSTDECODE_3_BLL_AAA; (*BOL1)=(*LON2)==(*LON3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_EQUf_JMPFL  FusedLabelEQUf_JMPFL :; INSTDECODE_3_BFF_AAA; (*BOL1)=(*FLO2)==(*FLO3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_DISc_JMPFL  FusedLabelDISc_JMPFL :; INSTDECODE_3_BCC_AAA; (*BOL1)=(*CHR2)!=(*CHR3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_DISw_JMPFL  FusedLabelDISw_JMPFL :; INSTDECODE_3_BWW_AAA; (*BOL1)=(*SHR2)!=(*SHR3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_DISi_JMPFL  FusedLabelDISi_JMPFL :; INSTDECODE_3_BII_AAA; (*BOL1)=(*INT2)!=(*INT3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_DISl_JMPFL  FusedLabelDISl_JMPFL :; INSTDECODE_3_BLL_AAA; (*BOL1)=(*LON2)!=(*LON3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_DISf_JMPFL  FusedLabelDISf_JMPFL :; INSTDECODE_3_BFF_AAA; (*BOL1)=(*FLO2)!=(*FLO3); FUSEDEND_IAAA_JMPFL;
+#define FUSED_INCi_JMP    FusedLabelINCi_JMP   :; INSTDECODE_1_I_A;     (*INT1)++;                  FUSEDEND_IA_JMP;
+#define FUSED_INCl_JMP    FusedLabelINCl_JMP   :; INSTDECODE_1_L_A;     (*LON1)++;                  FUSEDEND_IA_JMP;
+#define FUSED_MVi_ADDi    FusedLabelMVi_ADDi   :; INSTDECODE_2_II_AA;   (*INT1)=(*INT2); IP+=ISIZ_IAA; INSTDECODE_3_III_AAA; (*INT1)=(*INT2)+(*INT3); INSTEND_3_III_AAA;
+#define FUSED_MVl_ADDl    FusedLabelMVl_ADDl   :; INSTDECODE_2_LL_AA;   (*LON1)=(*LON2); IP+=ISIZ_IAA; INSTDECODE_3_LLL_AAA; (*LON1)=(*LON2)+(*LON3); INSTEND_3_LLL_AAA;
+#define FUSED_MVf_ADDf    FusedLabelMVf_ADDf   :; INSTDECODE_2_FF_AA;   (*FLO1)=(*FLO2); IP+=ISIZ_IAA; INSTDECODE_3_FFF_AAA; (*FLO1)=(*FLO2)+(*FLO3); INSTEND_3_FFF_AAA;
+
+//Operand-mode specialized argument decoders (LV=LoclVar, GV=GlobVar, LI=LoclInd)
+//(global variable arguments keep their original address in the code buffer as no decoder instruction encodes them)
+#define SPECDECODE_LV(argnr,datatype,offset) REG##argnr=(datatype *)(*(CpuAdr *)(CodePtr+IP+(offset))+BP);
+#define SPECDECODE_GV(argnr,datatype,offset) REG##argnr=(datatype *)(GlobPnt+*(CpuAdr *)(CodePtr+IP+(offset)));
+#define SPECDECODE_LI(argnr,datatype,offset) \
+ADV##argnr=*(CpuAdr *)(CodePtr+IP+(offset)); \
+if(ADV##argnr+BP>=_Stack.Length()-1){ MAXADR=_Stack.Length()-1; System::Throw(SysExceptionCode::InvalidMemoryAddress,"stack memory",HEXFORMAT(ADV##argnr),HEXFORMAT(MAXADR)); return; } \
+DRF##argnr=*(CpuRef *)(StackPnt+BP+ADV##argnr); \
+REFINDIRECTION(DRF##argnr,TPTR,DSO##argnr); \
+REG##argnr=(datatype *)TPTR;
+
+//Number of decoder instructions in front of instruction for each argument mode
+#define SPEC_PREFIXES_LV 0
+#define SPEC_PREFIXES_GV 1
+#define SPEC_PREFIXES_LI 1
+
+//Argument mode combinations (argument 1 varies fastest, same order as index in SpecAddress[])
+#define SPEC_MODES_ARG1(X,name,m2,m3) X(name,LV,m2,m3) X(name,GV,m2,m3) X(name,LI,m2,m3)
+#define SPEC_MODES_ARG2(X,name,m3)    SPEC_MODES_ARG1(X,name,LV,m3) SPEC_MODES_ARG1(X,name,GV,m3) SPEC_MODES_ARG1(X,name,LI,m3)
+#define SPEC_COMBINATIONS_2(X,name)   SPEC_MODES_ARG2(X,name,LV)
+#define SPEC_COMBINATIONS_3(X,name)   SPEC_MODES_ARG2(X,name,LV) SPEC_MODES_ARG2(X,name,GV) SPEC_MODES_ARG2(X,name,LI)
+
+//Label table rows (instructions with 2 arguments only use the first 9 combinations)
+#define SPEC_ADDRESS_ITEM(name,m1,m2,m3) &&SpecLabel##name##_##m1##m2##m3,
+#define SPEC_ADDRESS_NULL9 nullptr,nullptr,nullptr,nullptr,nullptr,nullptr,nullptr,nullptr,nullptr,
+#define SPEC_ADDRESS_2(name) SPEC_COMBINATIONS_2(SPEC_ADDRESS_ITEM,name) SPEC_ADDRESS_NULL9 SPEC_ADDRESS_NULL9
+#define SPEC_ADDRESS_3(name) SPEC_COMBINATIONS_3(SPEC_ADDRESS_ITEM,name)
+
+//Specialized handler bodies (decoder instructions are skipped, then instruction is executed as usual)
+#define SPEC_HANDLER(name,m1,m2,m3) SPEC_##name(m1,m2,m3)
+#define SPEC_INST_2(name,m1,m2,m3,type1,type2,body) \
+SpecLabel##name##_##m1##m2##m3:; \
+IP+=(SPEC_PREFIXES_##m1+SPEC_PREFIXES_##m2)*ISIZ_IWW; \
+SPECDECODE_##m1(1,type1,AOFF_I); \
+SPECDECODE_##m2(2,type2,AOFF_IA); \
+body; \
+IP+=ISIZ_IAA; \
+PROG_INST_DISPATCH;
+#define SPEC_INST_3(name,m1,m2,m3,type1,type2,type3,body) \
+SpecLabel##name##_##m1##m2##m3:; \
+IP+=(SPEC_PREFIXES_##m1+SPEC_PREFIXES_##m2+SPEC_PREFIXES_##m3)*ISIZ_IWW; \
+SPECDECODE_##m1(1,type1,AOFF_I); \
+SPECDECODE_##m2(2,type2,AOFF_IA); \
+SPECDECODE_##m3(3,type3,AOFF_IAA); \
+body; \
+IP+=ISIZ_IAAA; \
+PROG_INST_DISPATCH;
+
+//Operand-mode specialized instruction macros (see _SpecInst[])
+#define SPEC_MVi(m1,m2,m3)   SPEC_INST_2(MVi,m1,m2,m3,CpuInt,CpuInt,(*INT1)=  (*INT2));
+#define SPEC_MVl(m1,m2,m3)   SPEC_INST_2(MVl,m1,m2,m3,CpuLon,CpuLon,(*LON1)=  (*LON2));
+#define SPEC_MVf(m1,m2,m3)   SPEC_INST_2(MVf,m1,m2,m3,CpuFlo,CpuFlo,(*FLO1)=  (*FLO2));
+#define SPEC_ADDi(m1,m2,m3)  SPEC_INST_3(ADDi,m1,m2,m3,CpuInt,CpuInt,CpuInt,(*INT1)=(*INT2)+(*INT3));
+#define SPEC_ADDl(m1,m2,m3)  SPEC_INST_3(ADDl,m1,m2,m3,CpuLon,CpuLon,CpuLon,(*LON1)=(*LON2)+(*LON3));
+#define SPEC_ADDf(m1,m2,m3)  SPEC_INST_3(ADDf,m1,m2,m3,CpuFlo,CpuFlo,CpuFlo,(*FLO1)=(*FLO2)+(*FLO3));
+#define SPEC_SUBi(m1,m2,m3)  SPEC_INST_3(SUBi,m1,m2,m3,CpuInt,CpuInt,CpuInt,(*INT1)=(*INT2)-(*INT3));
+#define SPEC_SUBl(m1,m2,m3)  SPEC_INST_3(SUBl,m1,m2,m3,CpuLon,CpuLon,CpuLon,(*LON1)=(*LON2)-(*LON3));
+#define SPEC_SUBf(m1,m2,m3)  SPEC_INST_3(SUBf,m1,m2,m3,CpuFlo,CpuFlo,CpuFlo,(*FLO1)=(*FLO2)-(*FLO3));
+#define SPEC_MULi(m1,m2,m3)  SPEC_INST_3(MULi,m1,m2,m3,CpuInt,CpuInt,CpuInt,(*INT1)=(*INT2)*(*INT3));
+#define SPEC_MULl(m1,m2,m3)  SPEC_INST_3(MULl,m1,m2,m3,CpuLon,CpuLon,CpuLon,(*LON1)=(*LON2)*(*LON3));
+#define SPEC_MULf(m1,m2,m3)  SPEC_INST_3(MULf,m1,m2,m3,CpuFlo,CpuFlo,CpuFlo,(*FLO1)=(*FLO2)*(*FLO3));
+#define SPEC_LESi(m1,m2,m3)  SPEC_INST_3(LESi,m1,m2,m3,CpuBol,CpuInt,CpuInt,(*BOL1)=(*INT2)< (*INT3));
+#define SPEC_LEQi(m1,m2,m3)  SPEC_INST_3(LEQi,m1,m2,m3,CpuBol,CpuInt,CpuInt,(*BOL1)=(*INT2)<=(*INT3));
+#define SPEC_GREi(m1,m2,m3)  SPEC_INST_3(GREi,m1,m2,m3,CpuBol,CpuInt,CpuInt,(*BOL1)=(*INT2)> (*INT3));
+#define SPEC_GEQi(m1,m2,m3)  SPEC_INST_3(GEQi,m1,m2,m3,CpuBol,CpuInt,CpuInt,(*BOL1)=(*INT2)>=(*INT3));
+#define SPEC_EQUi(m1,m2,m3)  SPEC_INST_3(EQUi,m1,m2,m3,CpuBol,CpuInt,CpuInt,(*BOL1)=(*INT2)==(*INT3));
+#define SPEC_DISi(m1,m2,m3)  SPEC_INST_3(DISi,m1,m2,m3,CpuBol,CpuInt,CpuInt,(*BOL1)=(*INT2)!=(*INT3));
+
 //Instruction macro INST_DAGV1
 #define INST_DAGV1 \
 InstLabelDAGV1:; \
@@ -2084,53 +2553,68 @@ DMOD4=CpuDecMode::LoclInd; \
 DebugMessage(DebugLevel::VrmRuntime,"Decode argument 4 as "+CpuDecModeName(DMOD4)); \
 CONST_INSTEND_2_WW_VV; 
 
+//Push parameter on top of stack, pushed parameters become the base of the next frame so calls do not copy them
+//(value is copied first as stack buffer can move when growing and operand could point inside it)
+#define PUSH_STACK(datatype,value) { \
+  datatype PushValue=(value); \
+  if(!_Stack.Append((const char *)&PushValue,sizeof(datatype))){ \
+    System::Throw(SysExceptionCode::StackOverflow,ToString((int)sizeof(datatype))); \
+    EXCP_EXIT; \
+  } \
+  if(StackPnt!=_Stack.Pnt()){ \
+    if(!_DecodeLocalVariables(false,CodePtr,StackPnt,_Stack.Pnt())){ EXCP_EXIT; } \
+    StackPnt=_Stack.Pnt(); \
+  } \
+  PSZ+=sizeof(datatype); \
+}
+
 //Instruction macro PUSHb
 #define INST_PUSHb \
 InstLabelPUSHb:; \
 INSTDECODE_1_B_A; \
-if(!_ParmSt.Append((const char *)BOL1,sizeof(CpuBol))){ System::Throw(SysExceptionCode::MemoryAllocationFailure,ToString((int)sizeof(CpuBol))); EXCP_EXIT; } \
+PUSH_STACK(CpuBol,*BOL1); \
 INSTEND_1_B_A;
 
 //Intruction macro PUSHc
 #define INST_PUSHc \
 InstLabelPUSHc:; \
 INSTDECODE_1_C_A; \
-if(!_ParmSt.Append((const char *)CHR1,sizeof(CpuChr))){ System::Throw(SysExceptionCode::MemoryAllocationFailure,ToString((int)sizeof(CpuChr))); EXCP_EXIT;} \
+PUSH_STACK(CpuChr,*CHR1); \
 INSTEND_1_C_A;
 
 //Intruction macro PUSHw
 #define INST_PUSHw \
 InstLabelPUSHw:; \
 INSTDECODE_1_W_A; \
-if(!_ParmSt.Append((const char *)SHR1,sizeof(CpuShr))){ System::Throw(SysExceptionCode::MemoryAllocationFailure,ToString((int)sizeof(CpuShr))); EXCP_EXIT;} \
+PUSH_STACK(CpuShr,*SHR1); \
 INSTEND_1_W_A;
 
 //Intruction macro PUSHi
 #define INST_PUSHi \
 InstLabelPUSHi:; \
 INSTDECODE_1_I_A; \
-if(!_ParmSt.Append((const char *)INT1,sizeof(CpuInt))){ System::Throw(SysExceptionCode::MemoryAllocationFailure,ToString((int)sizeof(CpuInt))); EXCP_EXIT;} \
+PUSH_STACK(CpuInt,*INT1); \
 INSTEND_1_I_A;
 
 //Intruction macro PUSHl
 #define INST_PUSHl \
 InstLabelPUSHl:; \
 INSTDECODE_1_L_A; \
-if(!_ParmSt.Append((const char *)LON1,sizeof(CpuLon))){ System::Throw(SysExceptionCode::MemoryAllocationFailure,ToString((int)sizeof(CpuLon))); EXCP_EXIT;} \
+PUSH_STACK(CpuLon,*LON1); \
 INSTEND_1_L_A;
 
 //Intruction macro PUSHf
 #define INST_PUSHf \
 InstLabelPUSHf:; \
 INSTDECODE_1_F_A; \
-if(!_ParmSt.Append((const char *)FLO1,sizeof(CpuFlo))){ System::Throw(SysExceptionCode::MemoryAllocationFailure,ToString((int)sizeof(CpuFlo))); EXCP_EXIT;} \
+PUSH_STACK(CpuFlo,*FLO1); \
 INSTEND_1_F_A;
 
 //Intruction macro PUSHr
 #define INST_PUSHr \
 InstLabelPUSHr:; \
 INSTDECODE_1_R_A; \
-if(!_ParmSt.Append((const char *)REF1,sizeof(CpuRef))){ System::Throw(SysExceptionCode::MemoryAllocationFailure,ToString((int)sizeof(CpuRef))); EXCP_EXIT;} \
+PUSH_STACK(CpuRef,*REF1); \
 INSTEND_1_R_A;
 
 //Instruction macro REFPU
@@ -2139,10 +2623,7 @@ InstLabelREFPU:;   \
   INSTDECODE_1_D_A;  \
   CpuRef Ref; \
   GET_ARG_AS_REFERENCE(1,Ref,AOFF_I) \
-  if(!_ParmSt.Append((const char *)&Ref,sizeof(CpuRef))){  \
-    System::Throw(SysExceptionCode::MemoryAllocationFailure,ToString((int)sizeof(CpuRef))); \
-    EXCP_EXIT;  \
-  } \
+  PUSH_STACK(CpuRef,Ref); \
   DebugMessage(DebugLevel::VrmRuntime,"Ref="+_ToStringCpuRef(Ref)); \
   INSTEND_1_D_A;
 
@@ -2224,6 +2705,9 @@ InstLabelLPUSr:; \
   /*Check block number is valid*/ \
   if(!_Aux.IsValid(*BLK)){ System::Throw(SysExceptionCode::InvalidStringBlock,ToString(*BLK)); EXCP_EXIT; } \
   \
+  /*String data must stay at same place until library call (inline strings move with handler table)*/ \
+  if(!_Aux.Pin(_ScopeId,_ScopeNr,*BLK)){ System::Throw(SysExceptionCode::StringAllocationError,ToString(_Aux.GetLen(*BLK))); EXCP_EXIT; } \
+  \
   /*Do block indirection*/\
   VPTR=_Aux.CharPtr(*BLK); \
   \
@@ -2347,8 +2831,12 @@ InstLabelLRPUS:;   \
       System::Throw(SysExceptionCode::StringAllocationError,ToString(1)); \
       EXCP_EXIT; \
     } \
+    _Aux.SetHolder(*BLK,BLK); \
   } \
   \
+  /*String data must stay at same place until library call (inline strings move with handler table)*/ \
+  if(!_Aux.Pin(_ScopeId,_ScopeNr,*BLK)){ System::Throw(SysExceptionCode::StringAllocationError,ToString(_Aux.GetLen(*BLK))); EXCP_EXIT; } \
+  \
   /*Do block indirection*/\
   VPTR=_Aux.CharPtr(*BLK); \
   \
@@ -2443,6 +2931,12 @@ InstLabelLRPAF:;   \
   /*Instruction end*/ \
   INSTEND_3_DBG_AVV;
 
+//Tell aux memory manager stack frames of current and calling functions (to find out blocks held on them)
+#define AUX_SET_FRAME { \
+  if(_CallSt.Length()!=0){ _Aux.SetFrame(BP,_ScopeNr,_CallSt[_CallSt.Length()-1].BasePointer,_CallSt[_CallSt.Length()-1].ScopeNr); } \
+  else{ _Aux.SetFrame(BP,_ScopeNr,BP,0); } \
+}
+
 //Instruction macro CALL
 #define INST_CALL \
 InstLabelCALL:;   \
@@ -2450,33 +2944,23 @@ InstLabelCALL:;   \
   /*Decode instruction*/ \
   INSTDECODE_1_A_V;  \
   \
-  /*Save return address and base pointer*/ \
-  if(!_CallSt.Push((CallStack){IP,(CpuAdr)(IP+AOFF_IA),BP,_Stack.Length(),_ScopeNr,_ArC.FixGetBP()})){ \
+  /*Save return address and base pointer (stack size excludes pushed parameters so they are released on return)*/ \
+  if(!_CallSt.Push((CallStack){IP,(CpuAdr)(IP+AOFF_IA),BP,_Stack.Length()-PSZ,_ScopeNr,_ArC.FixGetBP()})){ \
     System::Throw(SysExceptionCode::MemoryAllocationFailure,ToString((int)sizeof(CallStack))); \
     EXCP_EXIT; \
   } \
   \
-  /*Copy parameters into stack and calculate new base pointer*/ \
-  if(_ParmSt.Length()!=0){ \
-    if(!_Stack.Append((const char *)_ParmSt.Pnt(),_ParmSt.Length())){ \
-      System::Throw(SysExceptionCode::StackOverflow,ToString(_ParmSt.Length())); \
-      EXCP_EXIT; \
-    } \
-    if(StackPnt!=_Stack.Pnt()){ \
-      if(!_DecodeLocalVariables(false,CodePtr,StackPnt,_Stack.Pnt())){ EXCP_EXIT; } \
-      StackPnt=_Stack.Pnt(); \
-    } \
-  } \
-  BP=_Stack.Length()-_ParmSt.Length(); \
+  /*Parameters are already on top of stack, new base pointer is where they start*/ \
+  BP=_Stack.Length()-PSZ; \
   \
-  /*Change istruction pointer, clear parameter stack*/ \
+  /*Change istruction pointer, reset pushed parameter size*/ \
   IP=(*ADR1); \
-  _ParmSt.Empty(); \
+  PSZ=0; \
   \
-  /*Change scope if not locked*/ \
+  /*Change scope if not locked (generators get scope number assigned on GNNEW)*/ \
   if(_ScopeUnlock){ \
     _ScopeId++; \
-    _ScopeNr=(++CUMULSC); \
+    if(_GenStart){ _ScopeNr=_Gen[_GenCurrent].ScopeNr; _GenStart=false; } else { _ScopeNr=(++CUMULSC); } \
     if(_ScopeId==_GlobalScopeId){ \
       System::Throw(SysExceptionCode::SubroutineMaxNestingLevelReached,ToString(_GlobalScopeId)); \
       EXCP_EXIT; \
@@ -2484,6 +2968,7 @@ InstLabelCALL:;   \
     _StC.SetScope(_ScopeId,_ScopeNr); \
     _ArC.DynSetScope(_ScopeId,_ScopeNr); \
   } \
+  AUX_SET_FRAME; \
   \
   /*Restore decoding*/ \
   RESTORE_HANDLER; \
@@ -2519,13 +3004,15 @@ InstLabelRET:; \
   BP=RETADR.BasePointer; \
   _ArC.FixSetBP(RETADR.AFBasePointer); \
   \
-  /*Change scope if not locked*/ \
+  /*Change scope if not locked (blocks held on stack frame of returning function are released)*/ \
   if(_ScopeUnlock){ \
+    _Aux.ReleaseFrame(_ScopeId,_ScopeNr); \
     _ScopeNr=RETADR.ScopeNr; \
     _ScopeId--; \
     _StC.SetScope(_ScopeId,_ScopeNr); \
     _ArC.DynSetScope(_ScopeId,_ScopeNr); \
   } \
+  AUX_SET_FRAME; \
   \
   /*Restore decoding*/ \
   RESTORE_HANDLER; \
@@ -2541,26 +3028,14 @@ InstLabelCALLN:;   \
   INSTDECODE_1_A_V;  \
   \
   /*Save return address and base pointer*/ \
-  if(!_CallSt.Push((CallStack){IP,(CpuAdr)(IP+AOFF_IA),BP,_Stack.Length(),_ScopeNr,_ArC.FixGetBP()})){ \
+  if(!_CallSt.Push((CallStack){IP,(CpuAdr)(IP+AOFF_IA),BP,_Stack.Length()-PSZ,_ScopeNr,_ArC.FixGetBP()})){ \
     System::Throw(SysExceptionCode::MemoryAllocationFailure,ToString((int)sizeof(CallStack))); \
     EXCP_EXIT; \
   } \
   \
-  /*Copy parameters into stack*/ \
-  if(_ParmSt.Length()!=0){ \
-    if(!_Stack.Append((const char *)_ParmSt.Pnt(),_ParmSt.Length())){ \
-      System::Throw(SysExceptionCode::StackOverflow,ToString(_ParmSt.Length())); \
-      EXCP_EXIT; \
-    } \
-    if(StackPnt!=_Stack.Pnt()){ \
-      if(!_DecodeLocalVariables(false,CodePtr,StackPnt,_Stack.Pnt())){ EXCP_EXIT; } \
-      StackPnt=_Stack.Pnt(); \
-    } \
-  } \
-  \
-  /*Change istruction pointer, clear parameter stack and increase scope counter*/ \
+  /*Change istruction pointer, parameters stay on top of stack*/ \
   IP=(*ADR1); \
-  _ParmSt.Empty(); \
+  PSZ=0; \
   \
   /*Change scope if not locked*/ \
   if(_ScopeUnlock){ \
@@ -2573,6 +3048,7 @@ InstLabelCALLN:;   \
     _StC.SetScope(_ScopeId,_ScopeNr); \
     _ArC.DynSetScope(_ScopeId,_ScopeNr); \
   } \
+  AUX_SET_FRAME; \
   \
   /*Restore decoding*/ \
   RESTORE_HANDLER; \
@@ -2603,6 +3079,7 @@ InstLabelRETN:;   \
     _StC.SetScope(_ScopeId,_ScopeNr); \
     _ArC.DynSetScope(_ScopeId,_ScopeNr); \
   } \
+  AUX_SET_FRAME; \
   \
   /*Restore decoding*/ \
   RESTORE_HANDLER; \
@@ -2614,9 +3091,193 @@ InstLabelRETN:;   \
 #define INST_SULOK \
 InstLabelSULOK:;   \
   INSTDECODE_0;  \
+  if(_SnapSave){ \
+    if(!_SaveSnapshot(IP,STR)){ \
+      System::Throw(SysExceptionCode::SnapshotSaveFailure,String(_SnapFile),STR); \
+      EXCP_EXIT; \
+    } \
+    if(!_ServeInit){ goto RunProgExit; } \
+  } \
+  if(_ServeInit){ \
+    if(!_KeepInitState(IP,STR)){ \
+      System::Throw(SysExceptionCode::ServeInitFailure,STR); \
+      EXCP_EXIT; \
+    } \
+    goto RunProgExit; \
+  } \
   _ScopeUnlock=true; \
   INSTEND_0;
 
+//Get generator from handler
+#define GET_GENERATOR(hnd) { \
+  if((hnd)<0 || (hnd)>=_Gen.Length()){ \
+    System::Throw(SysExceptionCode::InvalidGeneratorHandler,ToString(hnd)); \
+    EXCP_EXIT; \
+  } \
+  GNPTR=&_Gen[hnd]; \
+}
+
+//Instruction macro GNNEW
+//(generator frame starts where next call frame will start, that is where pushed parameters begin)
+#define INST_GNNEW \
+InstLabelGNNEW:; \
+  \
+  /*Decode instruction*/ \
+  INSTDECODE_1_Z_A; \
+  \
+  /*Create generator*/ \
+  if(_Gen.Length()==AUXMAN_MAXGEN){ \
+    System::Throw(SysExceptionCode::GeneratorMaxNestingReached,ToString(AUXMAN_MAXGEN)); \
+    EXCP_EXIT; \
+  } \
+  _GenSerial++; \
+  TLON=-(_GenSerial*AUXMAN_MAXGEN+_Gen.Length()+1); \
+  if(!_Gen.Push((GeneratorState){GeneratorStatus::Running,*(CpuAdr *)(CodePtr+IP+ISIZ_IA+AOFF_I),0,0,_Stack.Length()-PSZ,_CallSt.Length(),TLON,0,_GenCurrent})){ \
+    System::Throw(SysExceptionCode::MemoryAllocationFailure,ToString((int)sizeof(GeneratorState))); \
+    EXCP_EXIT; \
+  } \
+  _Aux.SetLiveGen(_Gen.Length()-1,TLON); \
+  \
+  /*Next call starts generator*/ \
+  _GenCurrent=_Gen.Length()-1; \
+  _GenStart=_ScopeUnlock; \
+  (*WRD1)=_GenCurrent; \
+  \
+  /*Instruction end*/ \
+  INSTEND_1_Z_A;
+
+//Instruction macro GNEND
+//(generator returned when it is found running after coming back from it)
+#define INST_GNEND \
+InstLabelGNEND:; \
+  INSTDECODE_2_ZA_AV; \
+  GET_GENERATOR(*WRD1); \
+  if(GNPTR->State!=GeneratorStatus::Suspended){ \
+    if(GNPTR->State==GeneratorStatus::Running){ GNPTR->State=GeneratorStatus::Finished; _GenCurrent=GNPTR->Resumer; } \
+    IP+=(*ADR2); \
+    RESTORE_HANDLER; \
+    RESTORE_DECODER(1); \
+    JMP_INSTEND_2_ZA_AV; \
+  } \
+  INSTEND_2_ZA_AV;
+
+//Instruction macro GNRES
+//(resume is a call that jumps into saved generator frame instead of creating a new one)
+#define INST_GNRES \
+InstLabelGNRES:; \
+  \
+  /*Decode instruction*/ \
+  INSTDECODE_1_Z_A; \
+  \
+  /*Get generator*/ \
+  GET_GENERATOR(*WRD1); \
+  if(GNPTR->State!=GeneratorStatus::Suspended){ \
+    System::Throw(SysExceptionCode::InvalidGeneratorHandler,ToString(*WRD1)); \
+    EXCP_EXIT; \
+  } \
+  \
+  /*Save return address and base pointer (stack is released up to generator frame if it returns)*/ \
+  if(_CallTimEnabled){ _CallTimEnter(GNPTR->FunAddress); } \
+  if(!_CallSt.Push((CallStack){IP,(CpuAdr)(IP+ISIZ_IA),BP,GNPTR->StackBase,_ScopeNr,_ArC.FixGetBP()})){ \
+    System::Throw(SysExceptionCode::MemoryAllocationFailure,ToString((int)sizeof(CallStack))); \
+    EXCP_EXIT; \
+  } \
+  \
+  /*Switch to generator frame*/ \
+  GNPTR->State=GeneratorStatus::Running; \
+  GNPTR->Resumer=_GenCurrent; \
+  _GenCurrent=(int)(*WRD1); \
+  IP=GNPTR->ResumeAddress; \
+  BP=GNPTR->BasePointer; \
+  _ArC.FixSetBP(GNPTR->AFBasePointer); \
+  \
+  /*Change scope if not locked*/ \
+  if(_ScopeUnlock){ \
+    _ScopeId++; \
+    _ScopeNr=GNPTR->ScopeNr; \
+    _StC.SetScope(_ScopeId,_ScopeNr); \
+    _ArC.DynSetScope(_ScopeId,_ScopeNr); \
+  } \
+  AUX_SET_FRAME; \
+  \
+  /*Restore decoding*/ \
+  RESTORE_HANDLER; \
+  RESTORE_DECODER(1); \
+  \
+  /*Instruction end*/ \
+  JMP_INSTEND_1_Z_A;
+
+//Instruction macro GNFRE
+//(generators created after this one are freed as well, stack is released up to generator frame)
+#define INST_GNFRE \
+InstLabelGNFRE:; \
+  INSTDECODE_1_Z_A; \
+  GET_GENERATOR(*WRD1); \
+  TLON=GNPTR->StackBase; \
+  for(int i=(int)(*WRD1);i<_Gen.Length();i++){ _Aux.SetLiveGen(i,0); } \
+  if(!_Gen.Resize(*WRD1)){ \
+    System::Throw(SysExceptionCode::MemoryAllocationFailure,ToString((int)sizeof(GeneratorState))); \
+    EXCP_EXIT; \
+  } \
+  if(_Stack.Length()>TLON){ \
+    if(!_Stack.Resize(TLON)){ \
+      System::Throw(SysExceptionCode::StackUnderflow); \
+      EXCP_EXIT; \
+    } \
+    if(StackPnt!=_Stack.Pnt()){ \
+      if(!_DecodeLocalVariables(false,CodePtr,StackPnt,_Stack.Pnt())){ EXCP_EXIT; } \
+      StackPnt=_Stack.Pnt(); \
+    } \
+  } \
+  INSTEND_1_Z_A;
+
+//Instruction macro YIELD
+//(it is a return that keeps generator frame on stack)
+#define INST_YIELD \
+InstLabelYIELD:; \
+  \
+  /*Null decoder*/ \
+  INSTDECODE_0; \
+  \
+  /*Yield can only happen on generator frame*/ \
+  if(_GenCurrent==-1 || _CallSt.Length()!=_Gen[_GenCurrent].CallDepth+1){ \
+    System::Throw(SysExceptionCode::YieldOutsideGenerator); \
+    EXCP_EXIT; \
+  } \
+  \
+  /*Save generator state*/ \
+  GNPTR=&_Gen[_GenCurrent]; \
+  GNPTR->State=GeneratorStatus::Suspended; \
+  GNPTR->ResumeAddress=IP+ISIZ_I; \
+  GNPTR->BasePointer=BP; \
+  GNPTR->AFBasePointer=_ArC.FixGetBP(); \
+  _GenCurrent=GNPTR->Resumer; \
+  \
+  /*Retrieve return address and base pointer (stack is not released)*/ \
+  if(_CallTimEnabled){ _CallTimLeave(); } \
+  if(!_CallSt.Pop(RETADR)){ \
+    System::Throw(SysExceptionCode::CallStackUnderflow); \
+    EXCP_EXIT; \
+  } \
+  IP=RETADR.RetAddress; \
+  BP=RETADR.BasePointer; \
+  _ArC.FixSetBP(RETADR.AFBasePointer); \
+  \
+  /*Change scope if not locked*/ \
+  if(_ScopeUnlock){ \
+    _ScopeNr=RETADR.ScopeNr; \
+    _ScopeId--; \
+    _StC.SetScope(_ScopeId,_ScopeNr); \
+    _ArC.DynSetScope(_ScopeId,_ScopeNr); \
+  } \
+  AUX_SET_FRAME; \
+  \
+  /*Restore decoding*/ \
+  RESTORE_HANDLER; \
+  \
+  /*Return*/ \
+  JMP_INSTEND_0;
+
 //Instruction macro RPBEG
 #define INST_RPBEG \
 InstLabelRPBEG:;  \
@@ -2829,8 +3490,8 @@ InstLabelSCALL:;   \
   /*Instruction decoder*/ \
   INSTDECODE_1_I_V; \
   \
-  /*Init parameter stack pointer*/ \
-  PST=0; \
+  /*Init parameter stack pointer (parameters were pushed on top of stack)*/ \
+  PST=_Stack.Length()-PSZ; \
   \
   /*Save system call (used for timming)*/ \
   SCNR=*INT1; \
@@ -2844,8 +3505,18 @@ InstLabelSCALL:;   \
   /*System call will end here*/ \
   SystemCallEndLabel:; \
   \
-  /*Reset parameter stack*/ \
-  _ParmSt.Empty(); \
+  /*Release pushed parameters*/ \
+  if(PSZ!=0){ \
+    if(!_Stack.Free(PSZ)){ \
+      System::Throw(SysExceptionCode::StackUnderflow); \
+      EXCP_EXIT; \
+    } \
+    if(StackPnt!=_Stack.Pnt()){ \
+      if(!_DecodeLocalVariables(false,CodePtr,StackPnt,_Stack.Pnt())){ EXCP_EXIT; } \
+      StackPnt=_Stack.Pnt(); \
+    } \
+    PSZ=0; \
+  } \
   \
   /*Instruction end*/ \
   INSTEND_1_I_V;
@@ -3833,112 +4504,331 @@ SCALLGETPARAMETER(3,LON,CpuLon); \
 SCALLOUTPARAMETER(1,LON,CpuLon); \
 goto SystemCallEndLabel; \
 
-//Get library id
-int Runtime::_GetLibraryId(char *DlName){
-  int LibId=-1;
-  for(int i=0;i<_DynLib.Length();i++){ 
-    if(strcmp((char *)_DynLib[i].DlName,DlName)==0){
-      LibId=i;
-      break;
-    }
-  }
-  if(LibId==-1){
-    _DynLib.Push((DynLibDef){"",nullptr,nullptr,nullptr,nullptr});
-    LibId=_DynLib.Length()-1;
-    strncpy((char *)_DynLib[LibId].DlName,DlName,_MaxIdLen);
-  }
-  return LibId;
-}
+//systemcall<spawn> int spawn(string execfile,string[] arg)
+#define SYSCALL_SPAWN \
+SystemCallLabelSpawn:; \
+SCALLGETREFRINDIR(1,INT,CpuInt); \
+SCALLGETREFRINDIR(2,MBL,CpuMbl); \
+SCALLGETREFRINDIR(3,MBL,CpuMbl); \
+if(!_Aux.IsValid(*MBL2)){ \
+  System::Throw(SysExceptionCode::InvalidStringBlock,ToString(*MBL2));  \
+  EXCP_EXIT; \
+} \
+if(!_ArC.STAGET(*MBL3,STRA)){ EXCP_EXIT; } \
+*INT1=TaskManager::Spawn(String(_StC.CharPtr(*MBL2)),STRA,_JitEnabled,String(_DynLibPath),String(_TmpLibPath)); \
+SCALLOUTPARAMETER(1,INT,CpuInt); \
+goto SystemCallEndLabel; \
 
-//Get current process
-int Runtime::GetCurrentProcess(){
-  return _ProcessId;
-}
+//systemcall<join> bool join(int task)
+#define SYSCALL_JOIN \
+SystemCallLabelJoin:; \
+SCALLGETREFRINDIR(1,BOL,CpuBol); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+*BOL1=TaskManager::Join(*INT2); \
+SCALLOUTPARAMETER(1,BOL,CpuBol); \
+goto SystemCallEndLabel; \
 
-//Executable file read wrapper: Open executable file
-bool Runtime::_OpenExecutable(const String& FileName,int& Hnd){
-  if(_RomBuffer==nullptr){
-    if(!_Stl->FileSystem.GetHandler(Hnd)){
-      SysMessage(304).Print(FileName);
-      return false;
-    }
-    if(!_Stl->FileSystem.OpenForRead(Hnd,FileName)){
-      SysMessage(305).Print(FileName,_Stl->LastError());
-      return false;
-    }
-  }
-  else{
-    _RomBuffReadNr=0;
-  }
-  return true;
-}
+//systemcall<chopen> int channel(string name)
+#define SYSCALL_CHOPEN \
+SystemCallLabelChOpen:; \
+SCALLGETREFRINDIR(1,INT,CpuInt); \
+SCALLGETREFRINDIR(2,MBL,CpuMbl); \
+if(!_Aux.IsValid(*MBL2)){ \
+  System::Throw(SysExceptionCode::InvalidStringBlock,ToString(*MBL2));  \
+  EXCP_EXIT; \
+} \
+*INT1=TaskManager::OpenChannel(String(_StC.CharPtr(*MBL2))); \
+SCALLOUTPARAMETER(1,INT,CpuInt); \
+goto SystemCallEndLabel; \
 
-//Executable file read wrapper: Close executable file
-bool Runtime::_CloseExecutable(const String& FileName,int Hnd){
-  if(_RomBuffer==nullptr){
-    if(!_Stl->FileSystem.CloseFile(Hnd)){ 
-      SysMessage(307).Print(FileName,_Stl->LastError());
-      return false; 
-    }
-    if(!_Stl->FileSystem.FreeHandler(Hnd)){ 
-      SysMessage(308).Print(FileName,_Stl->LastError());
-      return false; 
-    }
-  }
-  return true;
-}
+//systemcall<chclose> bool closechannel(int channel)
+#define SYSCALL_CHCLOSE \
+SystemCallLabelChClose:; \
+SCALLGETREFRINDIR(1,BOL,CpuBol); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+*BOL1=TaskManager::CloseChannel(*INT2); \
+SCALLOUTPARAMETER(1,BOL,CpuBol); \
+goto SystemCallEndLabel; \
 
-//Executable file read wrapper: Read executable file
-bool Runtime::_ReadExecutable(const String& FileName,int Hnd,const char *Part,int Index,int SubIndex,Buffer& Buff,long Length){
-  if(_RomBuffer==nullptr){
-    if(!_Stl->FileSystem.Read(Hnd,Buff,Length)){ SysMessage(306).Print(FileName,Part,ToString(Index)+(SubIndex!=0?"."+ToString(SubIndex):""),_Stl->LastError()); return false; }
-  }
-  else{
-    if(_RomBuffReadNr+Length>_RomBuffer->Length){
-      SysMessage(356).Print(FileName,ToString(_RomBuffReadNr+Length),ToString(_RomBuffer->Length)); return false;
-    }
-    Buff.Copy(&_RomBuffer->Buff[_RomBuffReadNr],Length);
-    _RomBuffReadNr+=Length;
-  }
-  return true;
-}
+//systemcall<chsendstr> bool send(int channel,string message)
+#define SYSCALL_CHSENDSTR \
+SystemCallLabelChSendStr:; \
+SCALLGETREFRINDIR(1,BOL,CpuBol); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+SCALLGETREFRINDIR(3,MBL,CpuMbl); \
+if(!_Aux.IsValid(*MBL3)){ \
+  System::Throw(SysExceptionCode::InvalidStringBlock,ToString(*MBL3));  \
+  EXCP_EXIT; \
+} \
+*BOL1=TaskManager::Send(*INT2,String(_StC.CharPtr(*MBL3))); \
+SCALLOUTPARAMETER(1,BOL,CpuBol); \
+goto SystemCallEndLabel; \
 
-//Executable file read wrapper: Read executable file
-bool Runtime::_ReadExecutable(const String& FileName,int Hnd,const char *Part,int Index,int SubIndex,char *Pnt,long Length){
-  if(_RomBuffer==nullptr){
-    if(!_Stl->FileSystem.Read(Hnd,Pnt,Length)){ SysMessage(306).Print(FileName,Part,ToString(Index)+(SubIndex!=0?"."+ToString(SubIndex):""),_Stl->LastError()); return false; }
-  }
-  else{
-    if(_RomBuffReadNr+Length>_RomBuffer->Length){
-      SysMessage(356).Print(FileName,ToString(_RomBuffReadNr+Length),ToString(_RomBuffer->Length)); return false;
-    }
-    MemCpy(Pnt,&_RomBuffer->Buff[_RomBuffReadNr],Length);
-    _RomBuffReadNr+=Length;
-  }
-  return true;
-}
+//systemcall<chsendint> bool send(int channel,int message)
+#define SYSCALL_CHSENDINT \
+SystemCallLabelChSendInt:; \
+SCALLGETREFRINDIR(1,BOL,CpuBol); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+SCALLGETPARAMETER(3,INT,CpuInt); \
+*BOL1=TaskManager::Send(*INT2,ChannelMsgType::Integer,(CpuLon)*INT3); \
+SCALLOUTPARAMETER(1,BOL,CpuBol); \
+goto SystemCallEndLabel; \
 
-//Load program file (sets all program buffers)
-bool Runtime::LoadProgram(const String& FileName,int ProcessId,int ArgNr,char *Arg[],int ArgStart){
+//systemcall<chsendlon> bool send(int channel,long message)
+#define SYSCALL_CHSENDLON \
+SystemCallLabelChSendLon:; \
+SCALLGETREFRINDIR(1,BOL,CpuBol); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+SCALLGETPARAMETER(3,LON,CpuLon); \
+*BOL1=TaskManager::Send(*INT2,ChannelMsgType::Long,*LON3); \
+SCALLOUTPARAMETER(1,BOL,CpuBol); \
+goto SystemCallEndLabel; \
 
-  //Variables
-  int i;
-  int Hnd;
-  Buffer Buff;
-  CpuWrd Length;
-  CpuWrd DimIndex;
-  ArrayFixDef ArrFixDef;
-  ArrayDynDef ArrDynDef;
-  BlockDef Blk;
-  DlCallDef DlCall;
-  String Error;
-  
-  //Open executable file
-  if(!_OpenExecutable(FileName,Hnd)){ return false; }
+//systemcall<chsendflo> bool send(int channel,float message)
+#define SYSCALL_CHSENDFLO \
+SystemCallLabelChSendFlo:; \
+SCALLGETREFRINDIR(1,BOL,CpuBol); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+SCALLGETPARAMETER(3,FLO,CpuFlo); \
+*BOL1=TaskManager::Send(*INT2,*FLO3); \
+SCALLOUTPARAMETER(1,BOL,CpuBol); \
+goto SystemCallEndLabel; \
 
+//systemcall<chsendarr> bool send(int channel,string[] message)
+#define SYSCALL_CHSENDARR \
+SystemCallLabelChSendArr:; \
+SCALLGETREFRINDIR(1,BOL,CpuBol); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+SCALLGETREFRINDIR(3,MBL,CpuMbl); \
+if(!_ArC.STAGET(*MBL3,STRA)){ EXCP_EXIT; } \
+*BOL1=TaskManager::Send(*INT2,STRA); \
+SCALLOUTPARAMETER(1,BOL,CpuBol); \
+goto SystemCallEndLabel; \
+
+//systemcall<chrecvstr> bool receive(int channel,ref string message)
+#define SYSCALL_CHRECVSTR \
+SystemCallLabelChRecvStr:; \
+SCALLGETREFRINDIR(1,BOL,CpuBol); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+SCALLGETREFRINDIR(3,MBL,CpuMbl); \
+*BOL1=TaskManager::Receive(*INT2,STR); \
+if(*BOL1){ _StC.SCOPY(MBL3,STR.CharPnt(),STR.Length()); } \
+SCALLOUTPARAMETER(1,BOL,CpuBol); \
+SCALLOUTPARAMETER(3,MBL,CpuMbl); \
+goto SystemCallEndLabel; \
+
+//systemcall<chrecvint> bool receive(int channel,ref int message)
+#define SYSCALL_CHRECVINT \
+SystemCallLabelChRecvInt:; \
+SCALLGETREFRINDIR(1,BOL,CpuBol); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+SCALLGETREFRINDIR(3,INT,CpuInt); \
+*BOL1=TaskManager::Receive(*INT2,ChannelMsgType::Integer,TLON); \
+if(*BOL1){ *INT3=(CpuInt)TLON; } \
+SCALLOUTPARAMETER(1,BOL,CpuBol); \
+SCALLOUTPARAMETER(3,INT,CpuInt); \
+goto SystemCallEndLabel; \
+
+//systemcall<chrecvlon> bool receive(int channel,ref long message)
+#define SYSCALL_CHRECVLON \
+SystemCallLabelChRecvLon:; \
+SCALLGETREFRINDIR(1,BOL,CpuBol); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+SCALLGETREFRINDIR(3,LON,CpuLon); \
+*BOL1=TaskManager::Receive(*INT2,ChannelMsgType::Long,TLON); \
+if(*BOL1){ *LON3=TLON; } \
+SCALLOUTPARAMETER(1,BOL,CpuBol); \
+SCALLOUTPARAMETER(3,LON,CpuLon); \
+goto SystemCallEndLabel; \
+
+//systemcall<chrecvflo> bool receive(int channel,ref float message)
+#define SYSCALL_CHRECVFLO \
+SystemCallLabelChRecvFlo:; \
+SCALLGETREFRINDIR(1,BOL,CpuBol); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+SCALLGETREFRINDIR(3,FLO,CpuFlo); \
+*BOL1=TaskManager::Receive(*INT2,TFLO); \
+if(*BOL1){ *FLO3=TFLO; } \
+SCALLOUTPARAMETER(1,BOL,CpuBol); \
+SCALLOUTPARAMETER(3,FLO,CpuFlo); \
+goto SystemCallEndLabel; \
+
+//systemcall<chrecvarr> bool receive(int channel,ref string[] message)
+#define SYSCALL_CHRECVARR \
+SystemCallLabelChRecvArr:; \
+SCALLGETREFRINDIR(1,BOL,CpuBol); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+SCALLGETREFRINDIR(3,MBL,CpuMbl); \
+*BOL1=TaskManager::Receive(*INT2,STRA); \
+if(*BOL1){ if(!_ArC.STASET(MBL3,STRA)){ EXCP_EXIT; } } \
+SCALLOUTPARAMETER(1,BOL,CpuBol); \
+SCALLOUTPARAMETER(3,MBL,CpuMbl); \
+goto SystemCallEndLabel; \
+
+//systemcall<readasync> int readasync(int hnd,long length)
+#define SYSCALL_READASYNC \
+SystemCallLabelReadAsync:; \
+SCALLGETREFRINDIR(1,INT,CpuInt); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+SCALLGETPARAMETER(3,LON,CpuLon); \
+*INT1=AsyncIoManager::Read(*INT2,*LON3); \
+SCALLOUTPARAMETER(1,INT,CpuInt); \
+goto SystemCallEndLabel; \
+
+//systemcall<readallasync> int readasync(int hnd)
+#define SYSCALL_READALLASYNC \
+SystemCallLabelReadAllAsync:; \
+SCALLGETREFRINDIR(1,INT,CpuInt); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+*INT1=AsyncIoManager::ReadAll(*INT2); \
+SCALLOUTPARAMETER(1,INT,CpuInt); \
+goto SystemCallEndLabel; \
+
+//systemcall<writeasync> int writeasync(int hnd,char[] buffer,long length)
+#define SYSCALL_WRITEASYNC \
+SystemCallLabelWriteAsync:; \
+SCALLGETREFRINDIR(1,INT,CpuInt); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+SCALLGETREFRINDIR(3,MBL,CpuMbl); \
+SCALLGETPARAMETER(4,LON,CpuLon); \
+if(!_ArC.CHAPNT(*MBL3,*LON4,&TPTR)){ EXCP_EXIT; } \
+*INT1=AsyncIoManager::Write(*INT2,TPTR,*LON4); \
+SCALLOUTPARAMETER(1,INT,CpuInt); \
+goto SystemCallEndLabel; \
+
+//systemcall<iopoll> bool poll(int req,ref bool done)
+#define SYSCALL_IOPOLL \
+SystemCallLabelIoPoll:; \
+SCALLGETREFRINDIR(1,BOL,CpuBol); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+SCALLGETREFRINDIR(3,BOL,CpuBol); \
+*BOL1=AsyncIoManager::Poll(*INT2,TBOL); \
+if(*BOL1){ *BOL3=TBOL; } \
+SCALLOUTPARAMETER(1,BOL,CpuBol); \
+SCALLOUTPARAMETER(3,BOL,CpuBol); \
+goto SystemCallEndLabel; \
+
+//systemcall<iowait> bool wait(int req)
+#define SYSCALL_IOWAIT \
+SystemCallLabelIoWait:; \
+SCALLGETREFRINDIR(1,BOL,CpuBol); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+*BOL1=AsyncIoManager::Wait(*INT2,TBUF); \
+TBUF.Reset(); \
+SCALLOUTPARAMETER(1,BOL,CpuBol); \
+goto SystemCallEndLabel; \
+
+//systemcall<iowaitdata> bool wait(int req,ref char[] buffer)
+#define SYSCALL_IOWAITDATA \
+SystemCallLabelIoWaitData:; \
+SCALLGETREFRINDIR(1,BOL,CpuBol); \
+SCALLGETPARAMETER(2,INT,CpuInt); \
+SCALLGETREFRINDIR(3,MBL,CpuMbl); \
+*BOL1=AsyncIoManager::Wait(*INT2,TBUF); \
+if(!_ArC.CHASET(MBL3,TBUF)){ TBUF.Reset(); EXCP_EXIT; } \
+TBUF.Reset(); \
+SCALLOUTPARAMETER(1,BOL,CpuBol); \
+SCALLOUTPARAMETER(3,MBL,CpuMbl); \
+goto SystemCallEndLabel; \
+
+//Get library id
+int Runtime::_GetLibraryId(char *DlName){
+  int LibId=-1;
+  for(int i=0;i<_DynLib.Length();i++){ 
+    if(strcmp((char *)_DynLib[i].DlName,DlName)==0){
+      LibId=i;
+      break;
+    }
+  }
+  if(LibId==-1){
+    _DynLib.Push((DynLibDef){"",nullptr,nullptr,nullptr,nullptr});
+    LibId=_DynLib.Length()-1;
+    strncpy((char *)_DynLib[LibId].DlName,DlName,_MaxIdLen);
+  }
+  return LibId;
+}
+
+//Get current process
+int Runtime::GetCurrentProcess(){
+  return _ProcessId;
+}
+
+//Executable file image: Map executable file into memory (rom buffer is used directly as file image)
+bool Runtime::_MapExecutable(const String& FileName){
+  String Error;
+  if(_RomBuffer==nullptr){
+    if((_ExeImage=MemoryManager::MapFile(FileName,_ExeImageLen,Error))==nullptr){
+      SysMessage(305).Print(FileName,Error);
+      return false;
+    }
+  }
+  else{
+    _ExeImage=_RomBuffer->Buff;
+    _ExeImageLen=_RomBuffer->Length;
+  }
+  return true;
+}
+
+//Executable file image: Release executable file image
+void Runtime::_UnmapExecutable(){
+  if(_RomBuffer==nullptr && _ExeImage!=nullptr){
+    MemoryManager::UnmapFile((char *)_ExeImage,_ExeImageLen);
+  }
+  _ExeImage=nullptr;
+  _ExeImageLen=0;
+}
+
+//Executable file image: Get section pointer from section directory
+//(checks section is inside file image, it is preceded by its file mark and has the expected length when records are fixed size)
+bool Runtime::_ExecutableSection(const String& FileName,BinSection Section,CpuWrd RecLength,CpuWrd RecNr,const char **Pnt){
+  const char *Mark=BinSectionMark(Section);
+  CpuLon Offset=BinHdr.Section[(int)Section].Offset;
+  CpuLon Length=BinHdr.Section[(int)Section].Length;
+  if(Offset<(CpuLon)(sizeof(BinaryHeader)+strlen(Mark)) || Length<0 || Offset+Length>_ExeImageLen
+  || memcmp(_ExeImage+Offset-strlen(Mark),Mark,strlen(Mark))!=0 || (RecLength!=0 && Length!=RecLength*RecNr)){
+    SysMessage(593).Print(FileName,Mark,ToString(Offset),ToString(Length));
+    return false;
+  }
+  *Pnt=_ExeImage+Offset;
+  return true;
+}
+
+//Load program file (sets all program buffers)
+//(executable file is mapped into memory and sections are located through section directory in header)
+bool Runtime::LoadProgram(const String& FileName,int ProcessId,int ArgNr,char *Arg[],int ArgStart){
+  bool Result;
+  if(!_MapExecutable(FileName)){ return false; }
+  Result=_LoadExecutable(FileName,ProcessId,ArgNr,Arg,ArgStart);
+  _UnmapExecutable();
+  return Result;
+}
+
+//Load program buffers from executable file image
+bool Runtime::_LoadExecutable(const String& FileName,int ProcessId,int ArgNr,char *Arg[],int ArgStart){
+
+  //Variables
+  int i;
+  const char *Pnt;
+  const char *EndPnt;
+  CpuWrd Length;
+  CpuWrd DimIndex;
+  ArrayFixDef ArrFixDef;
+  ArrayDynDef ArrDynDef;
+  DlCallDef DlCall;
+  String Error;
+  
   //Read program header
-  if(!_ReadExecutable(FileName,Hnd,"HEAD",0,0,Buff,sizeof(BinHdr))){ return false; }
-  BinHdr=*reinterpret_cast<const BinaryHeader *>(Buff.BuffPnt());
+  //(executables of old binary formats have a shorter header, so format is checked before header length)
+  if(_ExeImageLen<(CpuWrd)sizeof(BinHdr)){
+    if(_ExeImageLen>=(CpuWrd)(offsetof(BinaryHeader,BinFormat)+sizeof(BinHdr.BinFormat))
+    && (*(const CpuInt *)(_ExeImage+offsetof(BinaryHeader,BinFormat)))!=BINARY_FORMAT){
+      SysMessage(592).Print(FileName,ToString(*(const CpuInt *)(_ExeImage+offsetof(BinaryHeader,BinFormat))));
+      return false;
+    }
+    SysMessage(593).Print(FileName,"HEAD","0",ToString(_ExeImageLen));
+    return false;
+  }
+  MemCpy((char *)&BinHdr,_ExeImage,sizeof(BinHdr));
 
   //Print program header
   DebugMessage(DebugLevel::VrmRuntime,"Loaded binary header");
@@ -3980,6 +4870,9 @@ bool Runtime::LoadProgram(const String& FileName,int ProcessId,int ArgNr,char *A
   DebugMessage(DebugLevel::VrmRuntime,"DbgSymParNr  : "+ToString(BinHdr.DbgSymParNr));
   DebugMessage(DebugLevel::VrmRuntime,"DbgSymLinNr  : "+ToString(BinHdr.DbgSymLinNr));
   DebugMessage(DebugLevel::VrmRuntime,"SuperInitAdr : "+HEXFORMAT(BinHdr.SuperInitAdr));
+  for(i=0;i<_BinSectionNr;i++){
+    DebugMessage(DebugLevel::VrmRuntime,"Section "+String(BinSectionMark((BinSection)i))+" : offset="+ToString(BinHdr.Section[i].Offset)+" length="+ToString(BinHdr.Section[i].Length));
+  }
 
   //Check architecture matches
   if(BinHdr.Arquitecture!=GetArchitecture()){
@@ -3987,6 +4880,12 @@ bool Runtime::LoadProgram(const String& FileName,int ProcessId,int ArgNr,char *A
     return false;
   }
 
+  //Check binary format matches (section directory is only present from binary format 1)
+  if(BinHdr.BinFormat!=BINARY_FORMAT){
+    SysMessage(592).Print(FileName,ToString(BinHdr.BinFormat));
+    return false;
+  }
+
   //Set program name
   _Stl->FileSystem.GetFileNameNoExt(FileName).Copy(_ProgName,_MaxIdLen);
 
@@ -4000,7 +4899,7 @@ bool Runtime::LoadProgram(const String& FileName,int ProcessId,int ArgNr,char *A
   _Stack.Init(ProcessId,DEFAULT_CHUNKSIZE_STACK,(char *)"_Stack");
   _Code.Init(ProcessId,DEFAULT_CHUNKSIZE_CODE,(char *)"_Code");
   _CallSt.Init(ProcessId,DEFAULT_CHUNKSIZE_CALLST,(char *)"_CallSt");
-  _ParmSt.Init(ProcessId,DEFAULT_CHUNKSIZE_PARMST,(char *)"_ParmSt");
+  _Gen.Init(ProcessId,DEFAULT_CHUNKSIZE_GEN,(char *)"_Gen");
   _DlParm.Init(ProcessId,DEFAULT_CHUNKSIZE_PARAM,(char *)"_DlParm");
   _DlVPtr.Init(ProcessId,DEFAULT_CHUNKSIZE_PARMPTR,(char *)"_DlVPtr");
   _RpRule.Init(ProcessId,DEFAULT_CHUNKSIZE_RPRULE,(char *)"_RpRule");
@@ -4018,6 +4917,7 @@ bool Runtime::LoadProgram(const String& FileName,int ProcessId,int ArgNr,char *A
      SysMessage(310).Print(FileName,Error);
      return false;
   }
+  _Aux.SetStack(&_Stack);
   _StC.Init(&_Aux);
   _ArC.FixInit(ProcessId,DEFAULT_CHUNKSIZE_ARRGEOM);
   _ArC.DynInit(ProcessId,DEFAULT_CHUNKSIZE_ARRMETA,&_Aux,&_StC);
@@ -4026,17 +4926,20 @@ bool Runtime::LoadProgram(const String& FileName,int ProcessId,int ArgNr,char *A
   if(!_Glob.Resize(BinHdr.GlobBufferNr)){ SysMessage(309).Print("global",FileName); return false; }
   if(!_Code.Resize(BinHdr.CodeBufferNr)){ SysMessage(309).Print("code",FileName); return false; }
 
-  //Read executable file
-  if(!_ReadExecutable(FileName,Hnd,FILEMARKGLOB,-1,0,Buff,strlen(FILEMARKGLOB))){ return false; } 
-  if(!_ReadExecutable(FileName,Hnd,FILEMARKGLOB,0,0,_Glob.Pnt(),BinHdr.GlobBufferNr)){ return false; } 
+
+  //Global and code buffers are copied as they are patched during execution
+  if(!_ExecutableSection(FileName,BinSection::Glob,1,BinHdr.GlobBufferNr,&Pnt)){ return false; }
+  MemCpy(_Glob.Pnt(),Pnt,BinHdr.GlobBufferNr);
   DebugMessage(DebugLevel::VrmRuntime,"Loaded glob buffer with "+ToString(BinHdr.GlobBufferNr)+" bytes");
-  if(!_ReadExecutable(FileName,Hnd,FILEMARKCODE,-1,0,Buff,strlen(FILEMARKCODE))){ return false; } 
-  if(!_ReadExecutable(FileName,Hnd,FILEMARKCODE,0,0,_Code.Pnt(),BinHdr.CodeBufferNr)){ return false; } 
+  if(!_ExecutableSection(FileName,BinSection::Code,1,BinHdr.CodeBufferNr,&Pnt)){ return false; }
+  MemCpy(_Code.Pnt(),Pnt,BinHdr.CodeBufferNr);
   DebugMessage(DebugLevel::VrmRuntime,"Loaded code buffer with "+ToString(BinHdr.CodeBufferNr)+" bytes");
-  if(!_ReadExecutable(FileName,Hnd,FILEMARKFARR,-1,0,Buff,strlen(FILEMARKFARR))){ return false; } 
-  for(i=0;i<BinHdr.ArrFixDefNr;i++){ 
-    if(!_ReadExecutable(FileName,Hnd,FILEMARKFARR,i,0,Buff,sizeof(ArrayFixDef))){ return false; } 
-    ArrFixDef=*reinterpret_cast<const ArrayFixDef *>(Buff.BuffPnt());
+
+  //Array definitions
+  //(records are copied to aligned variables as sections do not start at aligned offsets)
+  if(!_ExecutableSection(FileName,BinSection::ArrFixDef,sizeof(ArrayFixDef),BinHdr.ArrFixDefNr,&Pnt)){ return false; }
+  for(i=0;i<BinHdr.ArrFixDefNr;i++,Pnt+=sizeof(ArrayFixDef)){ 
+    MemCpy((char *)&ArrFixDef,Pnt,sizeof(ArrayFixDef));
     if(!_ArC.FixStoreGeom(ArrFixDef.DimNr,ArrFixDef.CellSize,ArrFixDef.DimSize)){ SysMessage(309).Print("fixed array geometries",FileName); return false; }
     #ifdef __DEV__
     String ArrIndexes="";
@@ -4044,10 +4947,9 @@ bool Runtime::LoadProgram(const String& FileName,int ProcessId,int ArgNr,char *A
     #endif
     DebugMessage(DebugLevel::VrmRuntime,"Loaded fix array metadata: index="+ToString(i)+" geomindex="+HEXFORMAT(ArrFixDef.GeomIndex)+" dimnr="+ToString(ArrFixDef.DimNr)+" cellsize="+ToString(ArrFixDef.CellSize)+" dimsize={"+ArrIndexes+"}");
   }
-  if(!_ReadExecutable(FileName,Hnd,FILEMARKDARR,-1,0,Buff,strlen(FILEMARKDARR))){ return false; } 
-  for(i=0;i<BinHdr.ArrDynDefNr;i++){ 
-    if(!_ReadExecutable(FileName,Hnd,FILEMARKDARR,i,0,Buff,sizeof(ArrayDynDef))){ return false; } 
-    ArrDynDef=*reinterpret_cast<const ArrayDynDef *>(Buff.BuffPnt());
+  if(!_ExecutableSection(FileName,BinSection::ArrDynDef,sizeof(ArrayDynDef),BinHdr.ArrDynDefNr,&Pnt)){ return false; }
+  for(i=0;i<BinHdr.ArrDynDefNr;i++,Pnt+=sizeof(ArrayDynDef)){ 
+    MemCpy((char *)&ArrDynDef,Pnt,sizeof(ArrayDynDef));
     if(!_ArC.DynStoreMeta(0,0,ArrDynDef.DimNr,ArrDynDef.CellSize,ArrDynDef.DimSize)){ SysMessage(309).Print("dynamic array definitions",FileName); return false; }
     #ifdef __DEV__
     String ArrIndexes="";
@@ -4055,90 +4957,124 @@ bool Runtime::LoadProgram(const String& FileName,int ProcessId,int ArgNr,char *A
     #endif
     DebugMessage(DebugLevel::VrmRuntime,"Loaded dyn array metadata: index="+ToString(i)+" dimnr="+ToString(ArrDynDef.DimNr)+" cellsize="+ToString(ArrDynDef.CellSize)+" dimsize={"+ArrIndexes+"}");
   }
-  if(!_ReadExecutable(FileName,Hnd,FILEMARKBLCK,-1,0,Buff,strlen(FILEMARKBLCK))){ return false; } 
+
+  //Memory blocks (variable length records: dimension index, length and block contents)
+  if(!_ExecutableSection(FileName,BinSection::Block,0,0,&Pnt)){ return false; }
+  EndPnt=Pnt+BinHdr.Section[(int)BinSection::Block].Length;
   for(i=0;i<BinHdr.BlockNr;i++){ 
-    if(!_ReadExecutable(FileName,Hnd,FILEMARKBLCK,i,1,Buff,sizeof(DimIndex))){ return false; } 
-    DimIndex=*reinterpret_cast<const CpuWrd *>(Buff.BuffPnt());
-    if(!_ReadExecutable(FileName,Hnd,FILEMARKBLCK,i,2,Buff,sizeof(Length))){ return false; } 
-    Length=*reinterpret_cast<const CpuWrd *>(Buff.BuffPnt());
-    if(!_ReadExecutable(FileName,Hnd,FILEMARKBLCK,i,3,Buff,Length)){ return false; } 
+    if(Pnt+sizeof(DimIndex)+sizeof(Length)>EndPnt){ SysMessage(593).Print(FileName,FILEMARKBLCK,ToString(i),ToString(BinHdr.Section[(int)BinSection::Block].Length)); return false; }
+    MemCpy((char *)&DimIndex,Pnt,sizeof(DimIndex)); Pnt+=sizeof(DimIndex);
+    MemCpy((char *)&Length,Pnt,sizeof(Length)); Pnt+=sizeof(Length);
+    if(Length<0 || Pnt+Length>EndPnt){ SysMessage(593).Print(FileName,FILEMARKBLCK,ToString(i),ToString(BinHdr.Section[(int)BinSection::Block].Length)); return false; }
     if(i>0){ //Avoid block 0, since it is a dummy block, inserted in block table so that block zero is avoided because it means no allocated block
       if(!_Aux.ForcedAlloc(0,0,Length,DimIndex,i)){ SysMessage(309).Print("block buffer",FileName); return false; }
-      _Aux.Copy(i,Buff.BuffPnt(),Length);
-      DebugMessage(DebugLevel::VrmRuntime,"Loaded memory block: index="+ToString(i)+" dimindex="+ToString(DimIndex)+" length="+ToString(Length)+" buffer=\""+String(Buff.BuffPnt(),Length)+"\"");
+      _Aux.Copy(i,(char *)Pnt,Length);
+      DebugMessage(DebugLevel::VrmRuntime,"Loaded memory block: index="+ToString(i)+" dimindex="+ToString(DimIndex)+" length="+ToString(Length)+" buffer=\""+String(Pnt,Length)+"\"");
     }
+    Pnt+=Length;
   }
-  if(!_ReadExecutable(FileName,Hnd,FILEMARKDLCA,-1,0,Buff,strlen(FILEMARKDLCA))){ return false; } 
-  for(i=0;i<BinHdr.DlCallNr;i++){ 
-    if(!_ReadExecutable(FileName,Hnd,FILEMARKDLCA,i,0,Buff,sizeof(DlCall))){ return false; } 
-    DlCall=*reinterpret_cast<const DlCallDef *>(Buff.BuffPnt());
-    if(!_DynFun.Reserve(1)){ SysMessage(309).Print("dynamic function table",FileName); return false; }
+
+  //Dynamic library calls
+  if(!_ExecutableSection(FileName,BinSection::DlCall,sizeof(DlCallDef),BinHdr.DlCallNr,&Pnt)){ return false; }
+  if(BinHdr.DlCallNr!=0 && !_DynFun.Reserve(BinHdr.DlCallNr)){ SysMessage(309).Print("dynamic function table",FileName); return false; }
+  for(i=0;i<BinHdr.DlCallNr;i++,Pnt+=sizeof(DlCallDef)){ 
+    MemCpy((char *)&DlCall,Pnt,sizeof(DlCallDef));
     strncpy((char *)_DynFun[i].DlFunction,(char *)DlCall.DlFunction,_MaxIdLen);
     _DynFun[i].LibIndex=_GetLibraryId((char *)DlCall.DlName);
     _DynFun[i].PhyFunId=-1;
   }
+
+  //Debug symbol tables are only checked here and they are loaded on first use by _LoadDebugSymbols()
+  //(most executions never print symbols, so executables with symbols do not pay load time and memory for them)
+  _DebugSymLoaded=false;
   if(BinHdr.DebugSymbols){
-    if(!_ReadExecutable(FileName,Hnd,FILEMARKDMOD,-1,0,Buff,strlen(FILEMARKDMOD))){ return false; } 
-    for(i=0;i<BinHdr.DbgSymModNr;i++){ 
-      if(!_ReadExecutable(FileName,Hnd,FILEMARKDMOD,i,0,Buff,sizeof(DbgSymModule))){ return false; } 
-      if(!_DebugSym.Mod.Reserve(1)){ SysMessage(309).Print("debug symbol module",FileName); return false; }
-      MemCpy((char *)&_DebugSym.Mod[i],Buff.BuffPnt(),Buff.Length());
-      DebugMessage(DebugLevel::VrmRuntime,"Loaded debug symbol MOD["+ToString(_DebugSym.Mod.Length()-1)+"]: "+System::GetDbgSymDebugStr(_DebugSym.Mod[i]));
-    }
-    if(!_ReadExecutable(FileName,Hnd,FILEMARKDTYP,-1,0,Buff,strlen(FILEMARKDTYP))){ return false; } 
-    for(i=0;i<BinHdr.DbgSymTypNr;i++){ 
-      if(!_ReadExecutable(FileName,Hnd,FILEMARKDTYP,i,0,Buff,sizeof(DbgSymType))){ return false; } 
-      if(!_DebugSym.Typ.Reserve(1)){ SysMessage(309).Print("debug symbol type",FileName); return false; }
-      MemCpy((char *)&_DebugSym.Typ[i],Buff.BuffPnt(),Buff.Length());
-      DebugMessage(DebugLevel::VrmRuntime,"Loaded debug symbol TYP["+ToString(_DebugSym.Typ.Length()-1)+"]: "+System::GetDbgSymDebugStr(_DebugSym.Typ[i]));
-    }
-    if(!_ReadExecutable(FileName,Hnd,FILEMARKDVAR,-1,0,Buff,strlen(FILEMARKDVAR))){ return false; } 
-    for(i=0;i<BinHdr.DbgSymVarNr;i++){ 
-      if(!_ReadExecutable(FileName,Hnd,FILEMARKDVAR,i,0,Buff,sizeof(DbgSymVariable))){ return false; } 
-      if(!_DebugSym.Var.Reserve(1)){ SysMessage(309).Print("debug symbol variable",FileName); return false; }
-      MemCpy((char *)&_DebugSym.Var[i],Buff.BuffPnt(),Buff.Length());
-      DebugMessage(DebugLevel::VrmRuntime,"Loaded debug symbol VAR["+ToString(_DebugSym.Var.Length()-1)+"]: "+System::GetDbgSymDebugStr(_DebugSym.Var[i]));
-    }
-    if(!_ReadExecutable(FileName,Hnd,FILEMARKDFLD,-1,0,Buff,strlen(FILEMARKDFLD))){ return false; } 
-    for(i=0;i<BinHdr.DbgSymFldNr;i++){ 
-      if(!_ReadExecutable(FileName,Hnd,FILEMARKDFLD,i,0,Buff,sizeof(DbgSymField))){ return false; } 
-      if(!_DebugSym.Fld.Reserve(1)){ SysMessage(309).Print("debug symbol field",FileName); return false; }
-      MemCpy((char *)&_DebugSym.Fld[i],Buff.BuffPnt(),Buff.Length());
-      DebugMessage(DebugLevel::VrmRuntime,"Loaded debug symbol FLD["+ToString(_DebugSym.Fld.Length()-1)+"]: "+System::GetDbgSymDebugStr(_DebugSym.Fld[i]));
-    }
-    if(!_ReadExecutable(FileName,Hnd,FILEMARKDFUN,-1,0,Buff,strlen(FILEMARKDFUN))){ return false; } 
-    for(i=0;i<BinHdr.DbgSymFunNr;i++){ 
-      if(!_ReadExecutable(FileName,Hnd,FILEMARKDFUN,i,0,Buff,sizeof(DbgSymFunction))){ return false; } 
-      if(!_DebugSym.Fun.Reserve(1)){ SysMessage(309).Print("debug symbol function",FileName); return false; }
-      MemCpy((char *)&_DebugSym.Fun[i],Buff.BuffPnt(),Buff.Length());
-      DebugMessage(DebugLevel::VrmRuntime,"Loaded debug symbol FUN["+ToString(_DebugSym.Fun.Length()-1)+"]: "+System::GetDbgSymDebugStr(_DebugSym.Fun[i]));
-    }
-    if(!_ReadExecutable(FileName,Hnd,FILEMARKDPAR,-1,0,Buff,strlen(FILEMARKDPAR))){ return false; } 
-    for(i=0;i<BinHdr.DbgSymParNr;i++){ 
-      if(!_ReadExecutable(FileName,Hnd,FILEMARKDPAR,i,0,Buff,sizeof(DbgSymParameter))){ return false; } 
-      if(!_DebugSym.Par.Reserve(1)){ SysMessage(309).Print("debug symbol parameter",FileName); return false; }
-      MemCpy((char *)&_DebugSym.Par[i],Buff.BuffPnt(),Buff.Length());
-      DebugMessage(DebugLevel::VrmRuntime,"Loaded debug symbol PAR["+ToString(_DebugSym.Par.Length()-1)+"]: "+System::GetDbgSymDebugStr(_DebugSym.Par[i]));
-    }
-    if(!_ReadExecutable(FileName,Hnd,FILEMARKDLIN,-1,0,Buff,strlen(FILEMARKDLIN))){ return false; } 
-    for(i=0;i<BinHdr.DbgSymLinNr;i++){ 
-      if(!_ReadExecutable(FileName,Hnd,FILEMARKDLIN,i,0,Buff,sizeof(DbgSymLine))){ return false; } 
-      if(!_DebugSym.Lin.Reserve(1)){ SysMessage(309).Print("debug symbol line",FileName); return false; }
-      MemCpy((char *)&_DebugSym.Lin[i],Buff.BuffPnt(),Buff.Length());
-      DebugMessage(DebugLevel::VrmRuntime,"Loaded debug symbol LIN["+ToString(_DebugSym.Lin.Length()-1)+"]: "+System::GetDbgSymDebugStr(_DebugSym.Lin[i]));
-    }
+    if(!_ExecutableSection(FileName,BinSection::DbgSymMod,sizeof(DbgSymModule),BinHdr.DbgSymModNr,&Pnt)){ return false; }
+    if(!_ExecutableSection(FileName,BinSection::DbgSymTyp,sizeof(DbgSymType),BinHdr.DbgSymTypNr,&Pnt)){ return false; }
+    if(!_ExecutableSection(FileName,BinSection::DbgSymVar,sizeof(DbgSymVariable),BinHdr.DbgSymVarNr,&Pnt)){ return false; }
+    if(!_ExecutableSection(FileName,BinSection::DbgSymFld,sizeof(DbgSymField),BinHdr.DbgSymFldNr,&Pnt)){ return false; }
+    if(!_ExecutableSection(FileName,BinSection::DbgSymFun,sizeof(DbgSymFunction),BinHdr.DbgSymFunNr,&Pnt)){ return false; }
+    if(!_ExecutableSection(FileName,BinSection::DbgSymPar,sizeof(DbgSymParameter),BinHdr.DbgSymParNr,&Pnt)){ return false; }
+    if(!_ExecutableSection(FileName,BinSection::DbgSymLin,sizeof(DbgSymLine),BinHdr.DbgSymLinNr,&Pnt)){ return false; }
+    FileName.Copy(_DebugSymFile,FILEPATHLEN);
   }
 
-  //Close file
-  if(!_CloseExecutable(FileName,Hnd)){
-    return false; 
+  //Return code
+  return true;
+
+}
+
+//Load debug symbol tables on first use (returns false when program has no debug symbols)
+//(executable file is mapped again and it must be the same file that was loaded, otherwise symbols are dropped)
+bool Runtime::_LoadDebugSymbols(){
+
+  //Variables
+  int i;
+  bool Result;
+  String FileName;
+
+  //Symbols are already loaded or program does not have them
+  if(_DebugSymLoaded || !BinHdr.DebugSymbols){ return BinHdr.DebugSymbols; }
+  _DebugSymLoaded=true;
+
+  //Map executable file and copy tables (records are stored in file with same layout as in memory, so they are copied in bulk)
+  FileName=String(_DebugSymFile);
+  if(!_MapExecutable(FileName)){
+    Result=false;
+  }
+  else if(_ExeImageLen<(CpuWrd)sizeof(BinaryHeader) || memcmp(_ExeImage,(const char *)&BinHdr,sizeof(BinaryHeader))!=0){
+    SysMessage(618).Print(FileName);
+    Result=false;
+  }
+  else{
+    Result=_LoadDebugSymTable(FileName,BinSection::DbgSymMod,_DebugSym.Mod,BinHdr.DbgSymModNr,"debug symbol module")
+    && _LoadDebugSymTable(FileName,BinSection::DbgSymTyp,_DebugSym.Typ,BinHdr.DbgSymTypNr,"debug symbol type")
+    && _LoadDebugSymTable(FileName,BinSection::DbgSymVar,_DebugSym.Var,BinHdr.DbgSymVarNr,"debug symbol variable")
+    && _LoadDebugSymTable(FileName,BinSection::DbgSymFld,_DebugSym.Fld,BinHdr.DbgSymFldNr,"debug symbol field")
+    && _LoadDebugSymTable(FileName,BinSection::DbgSymFun,_DebugSym.Fun,BinHdr.DbgSymFunNr,"debug symbol function")
+    && _LoadDebugSymTable(FileName,BinSection::DbgSymPar,_DebugSym.Par,BinHdr.DbgSymParNr,"debug symbol parameter")
+    && _LoadDebugSymTable(FileName,BinSection::DbgSymLin,_DebugSym.Lin,BinHdr.DbgSymLinNr,"debug symbol line");
+  }
+  _UnmapExecutable();
+
+  //Drop symbols when they could not be loaded (symbol lookups see empty tables)
+  if(!Result){
+    _DebugSym.Mod.Empty(); BinHdr.DbgSymModNr=0;
+    _DebugSym.Typ.Empty(); BinHdr.DbgSymTypNr=0;
+    _DebugSym.Var.Empty(); BinHdr.DbgSymVarNr=0;
+    _DebugSym.Fld.Empty(); BinHdr.DbgSymFldNr=0;
+    _DebugSym.Fun.Empty(); BinHdr.DbgSymFunNr=0;
+    _DebugSym.Par.Empty(); BinHdr.DbgSymParNr=0;
+    _DebugSym.Lin.Empty(); BinHdr.DbgSymLinNr=0;
+    BinHdr.DebugSymbols=false;
+    return false;
   }
 
+  //Debug messages
+  DebugMessage(DebugLevel::VrmRuntime,"Loaded debug symbol tables from "+FileName);
+  #ifdef __DEV__
+  for(i=0;i<_DebugSym.Mod.Length();i++){ DebugMessage(DebugLevel::VrmRuntime,"Loaded debug symbol MOD["+ToString(i)+"]: "+System::GetDbgSymDebugStr(_DebugSym.Mod[i])); }
+  for(i=0;i<_DebugSym.Typ.Length();i++){ DebugMessage(DebugLevel::VrmRuntime,"Loaded debug symbol TYP["+ToString(i)+"]: "+System::GetDbgSymDebugStr(_DebugSym.Typ[i])); }
+  for(i=0;i<_DebugSym.Var.Length();i++){ DebugMessage(DebugLevel::VrmRuntime,"Loaded debug symbol VAR["+ToString(i)+"]: "+System::GetDbgSymDebugStr(_DebugSym.Var[i])); }
+  for(i=0;i<_DebugSym.Fld.Length();i++){ DebugMessage(DebugLevel::VrmRuntime,"Loaded debug symbol FLD["+ToString(i)+"]: "+System::GetDbgSymDebugStr(_DebugSym.Fld[i])); }
+  for(i=0;i<_DebugSym.Fun.Length();i++){ DebugMessage(DebugLevel::VrmRuntime,"Loaded debug symbol FUN["+ToString(i)+"]: "+System::GetDbgSymDebugStr(_DebugSym.Fun[i])); }
+  for(i=0;i<_DebugSym.Par.Length();i++){ DebugMessage(DebugLevel::VrmRuntime,"Loaded debug symbol PAR["+ToString(i)+"]: "+System::GetDbgSymDebugStr(_DebugSym.Par[i])); }
+  for(i=0;i<_DebugSym.Lin.Length();i++){ DebugMessage(DebugLevel::VrmRuntime,"Loaded debug symbol LIN["+ToString(i)+"]: "+System::GetDbgSymDebugStr(_DebugSym.Lin[i])); }
+  #endif
+
   //Return code
   return true;
 
 }
 
+//Load debug symbol table from executable file image
+template <typename datatype>
+bool Runtime::_LoadDebugSymTable(const String& FileName,BinSection Section,RamBuffer<datatype>& Table,CpuInt RecNr,const char *TableName){
+  const char *Pnt;
+  if(!_ExecutableSection(FileName,Section,sizeof(datatype),RecNr,&Pnt)){ return false; }
+  if(RecNr!=0 && !Table.Append(reinterpret_cast<const datatype *>(Pnt),RecNr)){ SysMessage(309).Print(TableName,FileName); return false; }
+  return true;
+}
+
 //Instruction timming macros
 //Idea: Minimun measurable time is about 100ns on linux and 1mls on windows, difference is huge and on this interval either linux and windows go through several DS CPU cycles
 //Time is measured on the instructions when a change in the clock is detected, when this happens all executed instructions in that interval get a fraction of that time
@@ -4208,6 +5144,8 @@ void Runtime::_RunProgram(int BenchMark,CpuAdr& LastIP){
   
   //Instruction tables
   INST_LABEL_TABLE;                         
+  FUSED_LABEL_TABLE;
+  SPEC_LABEL_TABLE;
   
   //System call label table
   SYSTEMCALL_LABEL_TABLE;
@@ -4230,34 +5168,115 @@ void Runtime::_RunProgram(int BenchMark,CpuAdr& LastIP){
   //Instruction timming variables
   INST_TIMMING_DEF;
   
+  //If runtime debug level is enabled we need to force benchmark mode so execution loop goes through argument print
+  #ifdef __DEV__
+  if(DebugLevelEnabled(DebugLevel::VrmRuntime) && BenchMark<2){ BenchMark=2; }
+  #endif
+
+  //Parallel walk worker thread enters directly at loop body
+  //(code buffer and stack are already decoded by main thread, worker runs its own copies of loop code and stack frame)
+  if(PWCTX!=nullptr){
+    IP=PWCTX->LoopIP;
+    BP=PWCTX->MainBP+PWWORKER*PWCTX->FrameSize;
+    PST=0;
+    PSZ=0;
+    HPTR=nullptr;
+    CUMULSC=PWCTX->CumulSc;
+    CFIX=PWCTX->Cfix;
+    CodePtr=PWCTX->Code[PWWORKER]-PWCTX->LoopIP;
+    GlobPnt=_Glob.Pnt();
+    StackPnt=_Stack.Pnt();
+    DMOD1=CpuDecMode::LoclVar;
+    DMOD2=CpuDecMode::LoclVar;
+    DMOD3=CpuDecMode::LoclVar;
+    DMOD4=CpuDecMode::LoclVar;
+    InstAddressConstPtr=&InstAddress[0];
+    REAL_INST_DISPATCH;
+  }
+
+  //Fixed stack reservation (stack buffer never moves, so local variable addresses are never decoded again)
+  if(_StackReserve!=0){
+    if(!_Stack.FixedReserve(_StackReserve<DEFAULT_CHUNKSIZE_STACK?DEFAULT_CHUNKSIZE_STACK:_StackReserve)){
+      System::Throw(SysExceptionCode::StackReservationFailure,ToString(_StackReserve));
+      return;
+    }
+  }
+
   //Assign to stack a default size and do address decoding for first time
   if(!_Stack.Resize(DEFAULT_CHUNKSIZE_STACK)){ 
     System::Throw(SysExceptionCode::MemoryAllocationFailure);
     return; 
   }
-  if(!_DecodeLocalVariables(true,_Code.Pnt(),_Stack.Pnt(),_Stack.Pnt())){ return; }
-  _Stack.Empty();
   
-  //If runtime debug level is enabled we need to force benchmark mode so execution loop goes through argument print
-  #ifdef __DEV__
-  if(DebugLevelEnabled(DebugLevel::VrmRuntime) && BenchMark<2){ BenchMark=2; }
-  #endif
+  //Load decoded code image (only on fast execution)
+  //(when image is missing or stale code buffer is decoded as usual and decoding results are recorded to save a new image)
+  _CodeImgLoaded=false;
+  _CodeImgRecord=false;
+  if(_CodeImgEnabled && BenchMark<=1 && !_CodeDecoded){
+    _CodeImgLoaded=_LoadCodeImage();
+    _CodeImgRecord=!_CodeImgLoaded;
+  }
+
+  //Local variable address decoding
+  //(code decoded by a previous execution on same process only follows stack buffer when it moved)
+  if(_CodeDecoded){
+    if(StackPnt!=_Stack.Pnt()){
+      if(!_DecodeLocalVariables(false,_Code.Pnt(),StackPnt,_Stack.Pnt())){ return; }
+    }
+  }
+  else if(_CodeImgLoaded){
+    if(!_ApplyCodeImageLocals(_Code.Pnt(),_Stack.Pnt())){ return; }
+  }
+  else{
+    if(!_DecodeLocalVariables(true,_Code.Pnt(),_Stack.Pnt(),_Stack.Pnt())){ return; }
+  }
+  _Stack.Empty();
 
   //Set fake instruction table (for benchmark modes)
   void *InstEnd=nullptr;
   if(BenchMark>=2){
     if(BenchMark==2){ InstEnd=&&RunProgInstEnd2; }
     if(BenchMark==3){ InstEnd=&&RunProgInstEnd3; }
+    if(BenchMark==4){ InstEnd=&&RunProgInstEnd4; }
     for(int i=0;i<_InstructionNr;i++){ FakeInstAddress[i]=InstEnd; }
   }
   
-  //Do decoding of instructions in code buffer
-  _DecodeInstructionCodes(BenchMark,InstAddress,InstEnd,_Code.Pnt());
+  //Set call timming instruction table (only on fast execution)
+  //(call and return instructions go through timming handlers before being executed, rest of instructions keep their handlers)
+  if(_CallTimEnabled && BenchMark<2){
+    for(int i=0;i<_InstructionNr;i++){ CallTimInstAddress[i]=InstAddress[i]; }
+    CallTimInstAddress[(int)CpuInstCode::CALL]=&&RunProgCallTimCALL;
+    CallTimInstAddress[(int)CpuInstCode::CALLN]=&&RunProgCallTimCALLN;
+    CallTimInstAddress[(int)CpuInstCode::RET]=&&RunProgCallTimRET;
+    CallTimInstAddress[(int)CpuInstCode::RETN]=&&RunProgCallTimRETN;
+    _CallTimIndex.Resize(_Code.Length());
+    for(CpuAdr Adr=0;Adr<_Code.Length();Adr++){ _CallTimIndex[Adr]=-1; }
+    _CallTim.Reset();
+    _CallTimSt.Reset();
+  }
+  else{
+    _CallTimEnabled=false;
+  }
+
+  //Do decoding of instructions in code buffer (handlers are taken from decoded code image when it is loaded)
+  if(_CodeDecoded){
+    DebugMessage(DebugLevel::VrmRuntime,"Code buffer already decoded");
+  }
+  else if(_CodeImgLoaded){
+    _ApplyCodeImageHandlers((_CallTimEnabled?CallTimInstAddress:InstAddress),FusedAddress,SpecAddress,(_Jit.Compiled()?&&RunProgJitEntry:nullptr),(_AotEntry.Length()!=0?&&RunProgAotEntry:nullptr),_Code.Pnt());
+  }
+  else{
+    _DecodeInstructionCodes(BenchMark,(_CallTimEnabled?CallTimInstAddress:InstAddress),FusedAddress,SpecAddress,(_Jit.Compiled()?&&RunProgJitEntry:nullptr),(_AotEntry.Length()!=0?&&RunProgAotEntry:nullptr),InstEnd,_Code.Pnt());
+    if(_CodeImgRecord){ _SaveCodeImage(); }
+  }
+  _CodeDecoded=true;
   
-  //Init machine state
-  IP=0;
+  //Init machine state (restored process resumes where initialization routines ended)
+  IP=(_SnapRestored?_SnapResumeAdr:0);
   BP=0;
+  AUX_SET_FRAME;
   PST=0;
+  PSZ=0;
   HPTR=nullptr;
   CUMULSC=1;
   CFIX=-1;
@@ -4268,7 +5287,7 @@ void Runtime::_RunProgram(int BenchMark,CpuAdr& LastIP){
   DMOD2=CpuDecMode::LoclVar;
   DMOD3=CpuDecMode::LoclVar;
   DMOD4=CpuDecMode::LoclVar;
-  InstAddressConstPtr=(BenchMark<2?&InstAddress[0]:&FakeInstAddress[0]);
+  InstAddressConstPtr=(BenchMark<2?(_CallTimEnabled?&CallTimInstAddress[0]:&InstAddress[0]):&FakeInstAddress[0]);
   DebugMessage(DebugLevel::VrmRuntime,"Decoder mode for argument 1 as "+CpuDecModeName(DMOD1)); \
   DebugMessage(DebugLevel::VrmRuntime,"Decoder mode for argument 2 as "+CpuDecModeName(DMOD2)); \
   DebugMessage(DebugLevel::VrmRuntime,"Decoder mode for argument 3 as "+CpuDecModeName(DMOD3)); \
@@ -4277,6 +5296,30 @@ void Runtime::_RunProgram(int BenchMark,CpuAdr& LastIP){
   //Init instruction timmings (only for benchmark mode 3)
   if(BenchMark==3){ INST_TIMMING_INIT; }
   
+  //Init instruction sequence counters (only for benchmark mode 4)
+  if(BenchMark==4){ _InstSeqInit(); }
+
+  //Stack overflow detection through guard page (only for fixed stack reservation)
+  //(IP is not reliable after long jump, so exception is reported on the calling instruction of current function)
+  #ifndef __WIN__
+  if(_StackReserve!=0){
+    if(sigsetjmp(StackGuardJump,1)!=0){
+      IP=(_CallSt.Length()!=0?_CallSt.Fetch(_CallSt.Length()-1).OrgAddress:0);
+      System::Throw(SysExceptionCode::StackGuardPageHit,ToString(_Stack.Capacity()));
+      goto RunProgInstrExceptionHandler;
+    }
+    if(!_SetStackGuard(_Stack.GuardPnt(),MemoryManager::PageSize())){
+      System::Throw(SysExceptionCode::StackReservationFailure,ToString(_StackReserve));
+      return;
+    }
+  }
+  #endif
+
+  //Start sampling profiler (only on fast execution)
+  if(_ProfEnabled && BenchMark<2){
+    if(!_StartProfiler(&&RunProgProfSample)){ _ProfEnabled=false; }
+  }
+
   //Start execution (on fast exeucution enters disparcher loop otherwise enters instruction header)
   if(BenchMark<2){ REAL_INST_DISPATCH; }
 
@@ -4312,12 +5355,47 @@ void Runtime::_RunProgram(int BenchMark,CpuAdr& LastIP){
     //Instruction switcher
     INST_SWITCHER;
 
+    //Fused instruction switcher
+    FUSED_SWITCHER;
+
+    //Operand-mode specialized instruction switcher
+    SPEC_SWITCHER;
+
     //System call switcher
     SYSTEMCALL_SWITCHER;
 
     //Label to build expanded runtime
     //[$$EXPANSION_END]
 
+    //Native region entry (native code returns address of first instruction not translated)
+    RunProgJitEntry:;
+    IP=_Jit.Entry(IP)(StackPnt+BP);
+    PROG_INST_DISPATCH;
+
+    //Native library entry (ahead-of-time translated function returns address of first instruction not translated)
+    RunProgAotEntry:;
+    IP=_AotEntry[IP](StackPnt+BP,IP);
+    PROG_INST_DISPATCH;
+
+    //Profiler sample (reached on first dispatch after a timer tick, IP is the instruction about to be executed)
+    RunProgProfSample:;
+    _ProfilerSample(IP);
+    PROG_INST_DISPATCH;
+
+    //Call timming handlers (account function call or return and then execute instruction)
+    RunProgCallTimCALL:;
+    _CallTimEnter(*(CpuAdr *)(CodePtr+IP+AOFF_I));
+    goto *InstAddress[(int)CpuInstCode::CALL];
+    RunProgCallTimCALLN:;
+    _CallTimEnter(*(CpuAdr *)(CodePtr+IP+AOFF_I));
+    goto *InstAddress[(int)CpuInstCode::CALLN];
+    RunProgCallTimRET:;
+    _CallTimLeave();
+    goto *InstAddress[(int)CpuInstCode::RET];
+    RunProgCallTimRETN:;
+    _CallTimLeave();
+    goto *InstAddress[(int)CpuInstCode::RETN];
+
     //Instruction end to restore decoders
     RunProgInstEndRestore:;
     RESTORE_HANDLER;
@@ -4327,7 +5405,20 @@ void Runtime::_RunProgram(int BenchMark,CpuAdr& LastIP){
     RESTORE_DECODER(4);
     PROG_INST_DISPATCH;
 
-    //Instruction end handlers (only for benchmark modes 2 & 3)
+    //Instruction end handlers (only for benchmark modes 2, 3 & 4)
+    RunProgInstEnd4:;
+    _InstCount++;
+    _InstSeqCount(PREVIP,(CpuInstCode)*(CpuIcd *)(CodePtr+PREVIP+sizeof(CpuWrd)));
+    #ifdef __DEV__
+    if(DebugLevelEnabled(DebugLevel::VrmRuntime)){
+      _GetArguments(PREVIP,PREVBP,GlobPnt,StackPnt,CodePtr,(CpuDecMode)0,(CpuDecMode)0,(CpuDecMode)0,(CpuDecMode)0,2,&Arg[0]);
+      if(Arg[0].Length()!=0){ DebugMessage(DebugLevel::VrmRuntime,Arg[0]); }
+      if(Arg[1].Length()!=0){ DebugMessage(DebugLevel::VrmRuntime,Arg[1]); }
+      if(Arg[2].Length()!=0){ DebugMessage(DebugLevel::VrmRuntime,Arg[2]); }
+      if(Arg[3].Length()!=0){ DebugMessage(DebugLevel::VrmRuntime,Arg[3]); }
+    }
+    #endif
+    goto RunProgInstrHeader3;
     RunProgInstEnd3:;
     _InstCount++;
     ICODE=*(CpuIcd *)(CodePtr+PREVIP+sizeof(CpuWrd));
@@ -4361,8 +5452,12 @@ void Runtime::_RunProgram(int BenchMark,CpuAdr& LastIP){
   }
 
   //Exception handler exit
+  //(exception inside parallel walk makes main thread wait for workers and workers make the rest of them stop)
   RunProgInstrExceptionHandler:;
   LastIP=IP;
+  if(PWCTX!=nullptr){
+    if(PWWORKER==0){ _ParallelWalkEnd(true,nullptr); } else{ PWCTX->Abort=true; }
+  }
 
   //Program exit
   RunProgExit:;
@@ -4372,6 +5467,226 @@ void Runtime::_RunProgram(int BenchMark,CpuAdr& LastIP){
 
 }
 
+//Parallel walk loops run on worker threads only on fast execution and when there is something to split
+//(benchmark, profiler and call timming modes keep single thread accounting, nested parallel walks run sequentially)
+bool Runtime::_ParallelWalkEnabled(int BenchMark,CpuWrd Elements){
+  return BenchMark<2 && _ParWorkers>1 && Elements>=2 && PWCTX==nullptr && !_ProfEnabled && !_CallTimEnabled;
+}
+
+//Start parallel walk
+//(index range is split evenly among workers, main thread is worker zero and continues on original code and frame,
+//rest of workers get a copy of current stack frame placed after it and a copy of loop code)
+bool Runtime::_ParallelWalkStart(CpuAdr LoopIP,CpuAdr ExitIP,CpuAdr MainBP,CpuAdr IndexVarAddr,CpuDecMode IndexVarMode,CpuWrd Elements,int Cfix,CpuLon CumulSc){
+
+  //Variables
+  int i;
+  int WorkerNr;
+  CpuWrd FrameSize;
+  char *Code;
+  ParallelWalk *Walk;
+
+  //Number of workers and frame size
+  WorkerNr=(int)std::min((CpuWrd)_ParWorkers,Elements);
+  FrameSize=_Stack.Length()-MainBP;
+
+  //Reserve stack for worker frames (decode local variables again if stack buffer moved)
+  if(!_Stack.Reserve(FrameSize*(WorkerNr-1))){
+    System::Throw(SysExceptionCode::StackOverflow,ToString(FrameSize*(WorkerNr-1)));
+    return false;
+  }
+  if(StackPnt!=_Stack.Pnt()){
+    if(!_DecodeLocalVariables(false,_Code.Pnt(),StackPnt,_Stack.Pnt())){ return false; }
+    StackPnt=_Stack.Pnt();
+  }
+
+  //Create parallel walk
+  Walk=new ParallelWalk;
+  Walk->WorkerNr=WorkerNr;
+  Walk->Grain=std::max(Elements/(WorkerNr*PARALLEL_WALK_CHUNKS),(CpuWrd)1);
+  Walk->LoopIP=LoopIP;
+  Walk->ExitIP=ExitIP;
+  Walk->MainBP=MainBP;
+  Walk->FrameSize=FrameSize;
+  Walk->IndexVarAddr=IndexVarAddr;
+  Walk->IndexVarMode=IndexVarMode;
+  Walk->Cfix=Cfix;
+  Walk->CumulSc=CumulSc;
+  Walk->Abort=false;
+  Walk->Failed=false;
+  Walk->FailedIP=0;
+  Walk->Range=new ParallelRange[WorkerNr];
+
+  //Index ranges, stack frames and loop code for each worker
+  Walk->Code.Add(nullptr);
+  for(i=0;i<WorkerNr;i++){
+    Walk->Range[i].Beg=(Elements*i)/WorkerNr;
+    Walk->Range[i].End=(Elements*(i+1))/WorkerNr;
+    if(i!=0){
+      MemCpy(_Stack.Pnt()+MainBP+i*FrameSize,_Stack.Pnt()+MainBP,FrameSize);
+      Code=new char[ExitIP-LoopIP];
+      MemCpy(Code,_Code.Pnt()+LoopIP,ExitIP-LoopIP);
+      Walk->Code.Add(Code);
+    }
+  }
+
+  //Main thread takes its first index
+  PWCTX=Walk;
+  PWWORKER=0;
+  PWINDEX=-1;
+  PWCHKEND=0;
+  _ParallelWalkNext();
+
+  //Start worker threads
+  for(i=1;i<WorkerNr;i++){ Walk->Threads.Add(new std::thread(&Runtime::_ParallelWalkWorker,this,Walk,i)); }
+  DebugMessage(DebugLevel::VrmRuntime,"Parallel walk started on "+ToString(WorkerNr)+" workers for "+ToString(Elements)+" elements (grain="+ToString(Walk->Grain)+")");
+
+  //Return code
+  return true;
+
+}
+
+//Get next index of parallel walk for current thread
+//(indexes are taken in chunks from own range, when own range is exhausted upper half of biggest range of another worker is stolen)
+bool Runtime::_ParallelWalkNext(){
+
+  //Variables
+  int i;
+  int Victim;
+  CpuWrd Remain;
+  CpuWrd Largest;
+  CpuWrd StolenBeg;
+  CpuWrd StolenEnd;
+  ParallelWalk *Walk;
+  ParallelRange *Own;
+
+  //Next index on current chunk
+  if(++PWINDEX<PWCHKEND){ return true; }
+  Walk=PWCTX;
+  Own=&Walk->Range[PWWORKER];
+
+  //Take chunks from own range and steal when it is empty
+  while(!Walk->Abort){
+
+    //Next chunk from own range
+    {
+      std::lock_guard<std::mutex> Lock(Own->Mutex);
+      if(Own->Beg<Own->End){
+        PWINDEX=Own->Beg;
+        PWCHKEND=std::min(Own->Beg+Walk->Grain,Own->End);
+        Own->Beg=PWCHKEND;
+        return true;
+      }
+    }
+
+    //Find biggest range of other workers
+    Victim=-1;
+    Largest=0;
+    for(i=0;i<Walk->WorkerNr;i++){
+      if(i==PWWORKER){ continue; }
+      std::lock_guard<std::mutex> Lock(Walk->Range[i].Mutex);
+      Remain=Walk->Range[i].End-Walk->Range[i].Beg;
+      if(Remain>Largest){ Largest=Remain; Victim=i; }
+    }
+    if(Victim==-1){ return false; }
+
+    //Steal upper half (range might have been taken in between, in that case we search again)
+    {
+      std::lock_guard<std::mutex> Lock(Walk->Range[Victim].Mutex);
+      Remain=Walk->Range[Victim].End-Walk->Range[Victim].Beg;
+      if(Remain<=0){ continue; }
+      StolenEnd=Walk->Range[Victim].End;
+      StolenBeg=StolenEnd-(Remain+1)/2;
+      Walk->Range[Victim].End=StolenBeg;
+    }
+
+    //Stolen indexes become own range (so they can be stolen again)
+    {
+      std::lock_guard<std::mutex> Lock(Own->Mutex);
+      Own->Beg=StolenBeg;
+      Own->End=StolenEnd;
+    }
+
+  }
+
+  //Parallel walk aborted
+  return false;
+
+}
+
+//End parallel walk (called by main thread)
+//(waits for workers, releases worker frames and code copies and brings worker exceptions to current thread,
+//returns exit address or failed instruction address of workers)
+bool Runtime::_ParallelWalkEnd(bool Abort,CpuAdr *NextIP){
+
+  //Variables
+  int i;
+  bool Result;
+  ParallelWalk *Walk=PWCTX;
+
+  //Wait for workers
+  if(Abort){ Walk->Abort=true; }
+  for(i=0;i<Walk->Threads.Length();i++){ Walk->Threads[i]->join(); delete Walk->Threads[i]; }
+  PWCTX=nullptr;
+
+  //Release worker frames and code copies
+  for(i=1;i<Walk->Code.Length();i++){ delete[] Walk->Code[i]; }
+  _Stack.Free(Walk->FrameSize*(Walk->WorkerNr-1));
+
+  //Bring worker exceptions
+  for(i=0;i<Walk->Excp.Length();i++){ System::ExceptionAppend(Walk->Excp[i]); }
+  if(NextIP!=nullptr){ *NextIP=(Walk->Failed?Walk->FailedIP:Walk->ExitIP); }
+  Result=!Walk->Failed;
+  DebugMessage(DebugLevel::VrmRuntime,"Parallel walk finished on "+ToString(Walk->WorkerNr)+" workers"+(Walk->Failed?String(" with exceptions"):String("")));
+
+  //Release parallel walk
+  delete[] Walk->Range;
+  delete Walk;
+
+  //Return result
+  return Result;
+
+}
+
+//Parallel walk worker thread
+void Runtime::_ParallelWalkWorker(ParallelWalk *Walk,int Worker){
+
+  //Variables
+  CpuAdr LastIP;
+  SysExceptionRecord Excp;
+
+  //Worker belongs to same process as main thread
+  System::PushProcessId(_ProcessId);
+  System::ExceptionReset();
+  SetCurrentRuntime(this);
+
+  //Run loop body until there are no indexes left
+  PWCTX=Walk;
+  PWWORKER=Worker;
+  PWINDEX=-1;
+  PWCHKEND=0;
+  LastIP=Walk->LoopIP;
+  try{
+    if(_ParallelWalkNext()){ _RunProgram(0,LastIP); }
+  }
+  catch(BaseException& Ex){
+    System::Throw(SysExceptionCode::RuntimeBaseException,Ex.Description());
+  }
+  PWCTX=nullptr;
+
+  //Pass exceptions to main thread and make rest of workers stop
+  if(System::ExceptionFlag()){
+    std::lock_guard<std::mutex> Lock(Walk->Mutex);
+    for(int i=0;System::ExceptionRead(i,Excp);i++){ Walk->Excp.Add(Excp); }
+    if(!Walk->Failed){ Walk->Failed=true; Walk->FailedIP=LastIP; }
+    Walk->Abort=true;
+  }
+
+  //Release thread
+  SetCurrentRuntime(nullptr);
+  System::PopProcessId();
+
+}
+
 //Execute program
 bool Runtime::ExecProgram(int ProcessId,int BenchMark){
 
@@ -4384,12 +5699,21 @@ bool Runtime::ExecProgram(int ProcessId,int BenchMark){
   _ScopeId=1;
   _ScopeNr=1;
   _ScopeUnlock=false;
+  for(int i=0;i<_Gen.Length();i++){ _Aux.SetLiveGen(i,0); }
+  _Gen.Empty();
+  _GenCurrent=-1;
+  _GenStart=false;
   _RpSource=nullptr;
   _RpDestin=nullptr;
   _StC.SetScope(_ScopeId,_ScopeNr);
   _ArC.DynSetScope(_ScopeId,_ScopeNr);
   _ArC.FixSetBP(BinHdr.ArrFixDefNr);
 
+  //Arguments of current execution replace the ones of execution that saved restored snapshot
+  if(_SnapRestored){
+    if(!_RefreshSnapshotArgs()){ return false; }
+  }
+
   //Timed execution
   //(Wait for clock sync in order to get less varying timmings when clock has low resolution (i.e.: windows))
   if(BenchMark!=0){
@@ -4398,25 +5722,253 @@ bool Runtime::ExecProgram(int ProcessId,int BenchMark){
     _ProgStart=ClockGet();
   }
 
+  //Debug runtime prints symbols of every executed instruction
+  #ifdef __DEV__
+  if(DebugLevelEnabled(DebugLevel::VrmRuntime)){ _LoadDebugSymbols(); }
+  #endif
+
+  //Translate code buffer to native code
+  if(!_JitCompile(BenchMark)){ return false; }
+
   //Program execution
   _RunProgram(BenchMark,LastIP);
 
-  //Print call stack
-  if(System::ExceptionFlag()){
-    System::ExceptionPrint();
-    if(BinHdr.DebugSymbols){ _PrintCallStack(LastIP); }
+  //Finish parallel walk left running by instructions that exit program directly when they fail
+  //(they do not go through exception handler, so workers are joined and their frames and code copies released here)
+  if(PWCTX!=nullptr){ _ParallelWalkEnd(true,nullptr); }
+
+  //Remove stack guard page handler
+  #ifndef __WIN__
+  if(_StackReserve!=0){ _ClearStackGuard(); }
+  #endif
+
+  //Stop sampling profiler
+  if(_ProfEnabled){ _StopProfiler(); }
+
+  //Print call stack
+  if(System::ExceptionFlag()){
+    System::ExceptionPrint();
+    if(_LoadDebugSymbols()){ _PrintCallStack(LastIP); }
+  }
+
+  //Calculate benchmark
+  if(BenchMark!=0){
+    _ProgEnd=ClockGet();
+    _PrintBenchMark(BenchMark);
+  }
+
+  //Output instruction sequences
+  if(BenchMark==4){
+    if(!_PrintInstSequences()){ return false; }
+  }
+
+  //Output call timmings
+  if(_CallTimEnabled){ _PrintCallTimming(); }
+
+  //Output profile
+  if(_ProfEnabled){
+    if(!_PrintProfile()){ return false; }
+  }
+  
+  //Return code
+  return (System::ExceptionFlag()?false:true);
+
+}
+
+//Translate code buffer to native code
+//(must be done before code buffer decoding as jit reads original instruction codes and local variable offsets,
+//nothing is done when code buffer was already translated before forking on runtime server mode)
+bool Runtime::_JitCompile(int BenchMark){
+  if(_JitEnabled && BenchMark<=1 && !_Jit.Compiled()){
+    if(!_Jit.Compile(_Code.Pnt(),_Code.Length())){
+      SysMessage(580).Print();
+      return false;
+    }
+    DebugMessage(DebugLevel::VrmRuntime,"Jit compiler translated "+ToString(_Jit.InstNr())+" instructions into "+ToString(_Jit.RegionNr())+" native regions");
+  }
+  return true;
+}
+
+//Serve execution requests on local socket
+//(program is loaded and initialization routines are run once, for each request a child process is forked, which gets a copy on write
+//of the initialized program, takes client standard descriptors and arguments and executes main(), server runs until it gets SIGINT or SIGTERM)
+bool Runtime::ServeRequests(const String& SocketFile,const String& BinaryFile,int BenchMark){
+
+  //Not available on windows
+  #ifdef __WIN__
+  SysMessage(595).Print();
+  return false;
+
+  //Linux
+  #else
+
+  //Variables
+  int Listen;
+  int Conn;
+  pid_t Pid;
+  struct sockaddr_un Addr;
+  struct sigaction Action;
+  struct sigaction OldIntAction;
+  struct sigaction OldTermAction;
+
+  //Work done once for all requests: code translation, decoding and initialization routines (skipped when state is restored from snapshot)
+  //(snapshot is saved by this run when requested, requests do not save it again)
+  if(!_SnapRestored){
+    _ServeInit=true;
+    if(!ExecProgram(System::CurrentProcessId(),BenchMark)){ _ServeInit=false; return false; }
+    _ServeInit=false;
+    if(System::ExceptionFlag()){ return false; }
+    if(!_SnapRestored){ SysMessage(621).Print(BinaryFile); return false; }
+  }
+  else{
+    if(!_JitCompile(BenchMark)){ return false; }
+  }
+  _SnapSave=false;
+
+  //Create socket
+  if(SocketFile.Length()>=(long)sizeof(Addr.sun_path)){
+    SysMessage(596).Print(SocketFile,"socket path is too long");
+    return false;
+  }
+  if((Listen=socket(AF_UNIX,SOCK_STREAM,0))==-1){
+    SysMessage(596).Print(SocketFile,strerror(errno));
+    return false;
+  }
+  memset(&Addr,0,sizeof(Addr));
+  Addr.sun_family=AF_UNIX;
+  strncpy(Addr.sun_path,SocketFile.CharPnt(),sizeof(Addr.sun_path)-1);
+  unlink(Addr.sun_path);
+  if(bind(Listen,(struct sockaddr *)&Addr,sizeof(Addr))==-1 || listen(Listen,SOMAXCONN)==-1){
+    SysMessage(596).Print(SocketFile,strerror(errno));
+    close(Listen);
+    return false;
+  }
+
+  //Stop server on interrupt / terminate signals (accept() is not restarted so loop sees flag)
+  //Child processes are reaped automatically, their result is sent to clients
+  ServeStop=0;
+  memset(&Action,0,sizeof(Action));
+  Action.sa_handler=&_ServeStopHandler;
+  sigemptyset(&Action.sa_mask);
+  sigaction(SIGINT,&Action,&OldIntAction);
+  sigaction(SIGTERM,&Action,&OldTermAction);
+  signal(SIGCHLD,SIG_IGN);
+  DebugMessage(DebugLevel::VrmRuntime,"Runtime server for "+BinaryFile+" listening on "+SocketFile);
+
+  //Request loop
+  while(!ServeStop){
+    if((Conn=accept(Listen,nullptr,nullptr))==-1){ continue; }
+    std::cout.flush();
+    std::cerr.flush();
+    if((Pid=fork())==0){
+      close(Listen);
+      sigaction(SIGINT,&OldIntAction,nullptr);
+      sigaction(SIGTERM,&OldTermAction,nullptr);
+      signal(SIGCHLD,SIG_DFL);
+      _exit(_ServeRequest(Conn,BinaryFile,BenchMark));
+    }
+    if(Pid==-1){ DebugMessage(DebugLevel::VrmRuntime,"Runtime server unable to fork request process ("+String(strerror(errno))+")"); }
+    close(Conn);
+  }
+
+  //Close server
+  close(Listen);
+  unlink(Addr.sun_path);
+  sigaction(SIGINT,&OldIntAction,nullptr);
+  sigaction(SIGTERM,&OldTermAction,nullptr);
+  signal(SIGCHLD,SIG_DFL);
+  DebugMessage(DebugLevel::VrmRuntime,"Runtime server for "+BinaryFile+" stopped");
+
+  //Return code
+  return true;
+
+  #endif
+
+}
+
+//Serve one execution request (runs on forked child process, returns process exit code)
+#ifndef __WIN__
+int Runtime::_ServeRequest(int Conn,const String& BinaryFile,int BenchMark){
+
+  //Variables
+  int i;
+  int FdNr;
+  int Fd[3];
+  ssize_t Bytes;
+  CpuInt Pos;
+  bool Result;
+  ServeRequest Request;
+  ServeReply Reply;
+  Buffer ArgBuff;
+  Array<char *> ArgPtr;
+  struct msghdr Msg;
+  struct iovec Iov;
+  struct cmsghdr *Cmsg;
+  char Control[CMSG_SPACE(sizeof(Fd))];
+
+  //Receive request header together with client descriptors
+  memset(&Msg,0,sizeof(Msg));
+  Iov.iov_base=&Request;
+  Iov.iov_len=sizeof(Request);
+  Msg.msg_iov=&Iov;
+  Msg.msg_iovlen=1;
+  Msg.msg_control=Control;
+  Msg.msg_controllen=sizeof(Control);
+  while((Bytes=recvmsg(Conn,&Msg,MSG_WAITALL))==-1 && errno==EINTR){}
+  if(Bytes!=sizeof(Request) || memcmp(Request.FileMark,SERVE_REQUEST_MARK,4)!=0
+  || Request.ArgNr<0 || Request.ArgLength<0 || Request.ArgLength>SERVE_MAX_ARGLEN){ return 1; }
+  FdNr=0;
+  for(Cmsg=CMSG_FIRSTHDR(&Msg);Cmsg!=nullptr;Cmsg=CMSG_NXTHDR(&Msg,Cmsg)){
+    if(Cmsg->cmsg_level==SOL_SOCKET && Cmsg->cmsg_type==SCM_RIGHTS){
+      FdNr=(Cmsg->cmsg_len-CMSG_LEN(0))/sizeof(int);
+      memcpy(Fd,CMSG_DATA(Cmsg),(FdNr<3?FdNr:3)*sizeof(int));
+    }
+  }
+  if(FdNr!=3){ return 1; }
+
+  //Receive argument block
+  ArgBuff=Buffer((long)Request.ArgLength+1,(char)0);
+  for(Pos=0;Pos<Request.ArgLength;Pos+=Bytes){
+    if((Bytes=recv(Conn,ArgBuff.BuffPnt()+Pos,Request.ArgLength-Pos,0))<=0){
+      if(Bytes==-1 && errno==EINTR){ Bytes=0; continue; }
+      return 1;
+    }
+  }
+
+  //Client descriptors become standard input, output and error
+  for(i=0;i<3;i++){
+    while(dup2(Fd[i],i)==-1 && errno==EINTR){}
+    close(Fd[i]);
   }
 
-  //Calculate benchmark
-  if(BenchMark!=0){
-    _ProgEnd=ClockGet();
-    _PrintBenchMark(BenchMark);
+  //Program arguments (first argument is binary file as when it is run from command line)
+  ArgPtr.Add(BinaryFile.CharPnt());
+  for(i=0,Pos=0;i<Request.ArgNr && Pos<Request.ArgLength;i++){
+    ArgPtr.Add(ArgBuff.BuffPnt()+Pos);
+    Pos+=strlen(ArgBuff.BuffPnt()+Pos)+1;
   }
-  
+  _ArgNr=ArgPtr.Length();
+  _Arg=&ArgPtr[0];
+  _ArgStart=0;
+
+  //Execute program
+  DebugMessage(DebugLevel::VrmRuntime,"Runtime server executing request with "+ToString(_ArgNr)+" arguments");
+  Result=ExecProgram(System::CurrentProcessId(),BenchMark);
+  CloseAllFiles();
+  std::cout.flush();
+  std::cerr.flush();
+
+  //Send result to client
+  MemCpy(Reply.FileMark,SERVE_REPLY_MARK,4);
+  Reply.Result=(Result?0:1);
+  send(Conn,&Reply,sizeof(Reply),MSG_NOSIGNAL);
+  close(Conn);
+
   //Return code
-  return (System::ExceptionFlag()?false:true);
+  return (Result?0:1);
 
 }
+#endif
 
 //Reference indirection inside function (inner function)
 void Runtime::_InnerRefIndirection(char *GlobPnt,char *StackPnt,CpuRef Ref,char **Ptr,CpuMbl &Scope){
@@ -4431,14 +5983,25 @@ bool Runtime::_RefIndirection(char *GlobPnt,char *StackPnt,CpuRef Ref,char **Ptr
 }
 
 //Decode instruction codes
-bool Runtime::_DecodeInstructionCodes(int BenchMark,const void **InstAddress,const void *FakeInstHandler,char *CodePtr){
+bool Runtime::_DecodeInstructionCodes(int BenchMark,const void **InstAddress,const void **FusedAddress,const void **SpecAddress,const void *JitHandler,const void *AotHandler,const void *FakeInstHandler,char *CodePtr){
 
   //Variables
+  int i;
+  int FusedIndex;
+  int FusedCount;
+  int SpecCount;
+  int JitCount;
+  int AotCount;
+  int SpecIndex;
   bool Exit;
+  bool PrevDecoder;
   CpuAdr IP;
+  CpuAdr NextIP;
   CpuInstCode InstCode;
+  CpuInstCode NextCode;
   void **HandlerPtr;
   CpuIcd *InstCodePtr;
+  CodeImageHandler ImgHandler;
 
   //Debug message
   DebugMessage(DebugLevel::VrmRuntime,"Entered code buffer decoding (benchmark="+ToString(BenchMark)+" codeptr="+HEXFORMAT(CodePtr)+")");
@@ -4446,6 +6009,11 @@ bool Runtime::_DecodeInstructionCodes(int BenchMark,const void **InstAddress,con
   //Decoding loop
   IP=0;
   Exit=false;
+  FusedCount=0;
+  SpecCount=0;
+  JitCount=0;
+  AotCount=0;
+  PrevDecoder=false;
   do{
     
     //Get instruction code
@@ -4456,12 +6024,75 @@ bool Runtime::_DecodeInstructionCodes(int BenchMark,const void **InstAddress,con
     HandlerPtr=(void **)(CodePtr+IP);
     (*InstCodePtr)=(CpuIcd)InstCode;
     (*HandlerPtr)=(BenchMark<=1?(void *)InstAddress[(int)InstCode]:(void *)FakeInstHandler);
+    ImgHandler.Address=IP;
+    ImgHandler.Kind=CodeImgKind::Inst;
+    ImgHandler.Index=0;
+
+    //Superinstruction fusion (only on fast execution)
+    //Instruction pair is not fused when first instruction has decoder instructions in front, as they patch the handler
+    //of the second instruction to restore decoder modes. Second instruction keeps its own handler, so it can still be a jump target.
+    NextIP=IP+_Inst[(int)InstCode].Length;
+    if(BenchMark<=1 && !PrevDecoder && NextIP<_Code.Length()){
+      NextCode=(CpuInstCode)(*(CpuIcd *)(CodePtr+NextIP));
+      FusedIndex=-1;
+      for(i=0;i<_FusedInstNr;i++){
+        if(_FusionRule[i].First==InstCode && _FusionRule[i].Second==NextCode){ FusedIndex=i; break; }
+      }
+      if(FusedIndex!=-1 && _FusionRule[FusedIndex].SameArg1 && *(CpuAdr *)(CodePtr+IP+AOFF_I)!=*(CpuAdr *)(CodePtr+NextIP+AOFF_I)){
+        FusedIndex=-1;
+      }
+      if(FusedIndex!=-1){
+        (*HandlerPtr)=(void *)FusedAddress[FusedIndex];
+        ImgHandler.Kind=CodeImgKind::Fused;
+        ImgHandler.Index=FusedIndex;
+        FusedCount++;
+        DebugMessage(DebugLevel::VrmRuntime,HEXFORMAT(IP)+": Fused "+_Inst[(int)InstCode].Mnemonic+" with "+_Inst[(int)NextCode].Mnemonic);
+      }
+    }
+
+    //Operand-mode specialization (only on fast execution)
+    //First decoder instruction in front of a specialized instruction gets the handler variant for the decoder modes,
+    //rest of decoder instructions and the instruction itself keep their handlers as they are skipped by the variant
+    if(BenchMark<=1 && !PrevDecoder && InstCode>=CpuInstCode::DAGV1 && InstCode<=CpuInstCode::DALI4){
+      if((SpecIndex=_GetSpecIndex(CodePtr,IP))!=-1){
+        (*HandlerPtr)=(void *)SpecAddress[SpecIndex];
+        ImgHandler.Kind=CodeImgKind::Spec;
+        ImgHandler.Index=SpecIndex;
+        SpecCount++;
+        DebugMessage(DebugLevel::VrmRuntime,HEXFORMAT(IP)+": Specialized decoder modes for next instruction");
+      }
+    }
+
+    //Native region entry points (only on fast execution)
+    //Jit entry takes precedence over fused and specialized handlers as native region covers those instructions as well
+    if(BenchMark<=1 && JitHandler!=nullptr && _Jit.IsEntry(IP)){
+      (*HandlerPtr)=(void *)JitHandler;
+      ImgHandler.Kind=CodeImgKind::Jit;
+      ImgHandler.Index=0;
+      JitCount++;
+      DebugMessage(DebugLevel::VrmRuntime,HEXFORMAT(IP)+": Native region entry point");
+    }
+
+    //Native library entry points (only on fast execution, ahead-of-time translated code takes precedence over jit)
+    if(BenchMark<=1 && AotHandler!=nullptr && _AotEntry[IP]!=nullptr){
+      (*HandlerPtr)=(void *)AotHandler;
+      ImgHandler.Kind=CodeImgKind::Aot;
+      ImgHandler.Index=0;
+      AotCount++;
+      DebugMessage(DebugLevel::VrmRuntime,HEXFORMAT(IP)+": Native library entry point");
+    }
 
     //Message
     DebugMessage(DebugLevel::VrmRuntime,HEXFORMAT(IP)+": "+_Inst[(int)InstCode].Mnemonic+" code="+HEXFORMAT(*InstCodePtr)+" handler="+HEXFORMAT(*HandlerPtr));
 
+    //Record handler for decoded code image
+    if(_CodeImgRecord && ImgHandler.Kind!=CodeImgKind::Inst){ _CodeImgHnd.Add(ImgHandler); }
+
+    //Remember if instruction is a decoder instruction
+    PrevDecoder=(InstCode>=CpuInstCode::DAGV1 && InstCode<=CpuInstCode::DALI4);
+
     //Increase IP
-    IP+=_Inst[(int)InstCode].Length;
+    IP=NextIP;
 
     //Exit loop
     if(IP>=_Code.Length()){ Exit=true; }
@@ -4469,13 +6100,72 @@ bool Runtime::_DecodeInstructionCodes(int BenchMark,const void **InstAddress,con
   }while(!Exit);
 
   //Message
-  DebugMessage(DebugLevel::VrmRuntime,"Exited code buffer decoding");
+  DebugMessage(DebugLevel::VrmRuntime,"Exited code buffer decoding (fused instructions="+ToString(FusedCount)+" specialized instructions="+ToString(SpecCount)+" jit entry points="+ToString(JitCount)+" native library entry points="+ToString(AotCount)+")");
 
   //Return success
   return true;
 
 }
 
+//Get operand-mode specialized handler index for the decoder instructions starting at given address
+//(returns -1 when instruction after decoder instructions has no variant for their modes)
+int Runtime::_GetSpecIndex(char *CodePtr,CpuAdr IP){
+
+  //Variables
+  int i;
+  int ArgIndex;
+  int SpecIndex;
+  int Mode[_MaxInstructionArgs];
+  CpuAdr InstIP;
+  CpuAdr ArgAdr;
+  CpuInstCode Code;
+  CpuInstCode InstCode;
+
+  //Find instruction after decoder instructions (code buffer is not yet decoded from this point)
+  InstIP=IP;
+  while(InstIP<_Code.Length()){
+    Code=(CpuInstCode)(*(CpuIcd *)(CodePtr+InstIP));
+    if(Code<CpuInstCode::DAGV1 || Code>CpuInstCode::DALI4){ break; }
+    InstIP+=_Inst[(int)Code].Length;
+  }
+  if(InstIP>=_Code.Length()){ return -1; }
+  InstCode=(CpuInstCode)(*(CpuIcd *)(CodePtr+InstIP));
+
+  //Find specialized instruction
+  SpecIndex=-1;
+  for(i=0;i<_SpecInstNr;i++){
+    if(_SpecInst[i]==InstCode){ SpecIndex=i; break; }
+  }
+  if(SpecIndex==-1){ return -1; }
+
+  //Get argument modes from decoder instructions
+  for(i=0;i<_MaxInstructionArgs;i++){ Mode[i]=-1; }
+  for(;IP<InstIP;IP+=_Inst[(int)Code].Length){
+    Code=(CpuInstCode)(*(CpuIcd *)(CodePtr+IP));
+    ArgIndex=((int)Code-(int)CpuInstCode::DAGV1)%4;
+    if(ArgIndex>=_Inst[(int)InstCode].ArgNr || Mode[ArgIndex]!=-1){ return -1; }
+    if(*(CpuShr *)(CodePtr+IP+AOFF_I)!=InstIP+_Inst[(int)InstCode].Length-IP){ return -1; }
+    if(*(CpuShr *)(CodePtr+IP+AOFF_IW)!=InstIP+_Inst[(int)InstCode].Offset[ArgIndex]-IP){ return -1; }
+    ArgAdr=*(CpuAdr *)(CodePtr+InstIP+_Inst[(int)InstCode].Offset[ArgIndex]);
+    if(Code>=CpuInstCode::DAGV1 && Code<=CpuInstCode::DAGV4){
+      if(ArgAdr<0 || ArgAdr>=_Glob.Length()-1){ return -1; }
+      Mode[ArgIndex]=_SpecModeGlobVar;
+    }
+    else if(Code>=CpuInstCode::DALI1 && Code<=CpuInstCode::DALI4){
+      if(ArgAdr<0){ return -1; }
+      Mode[ArgIndex]=_SpecModeLoclInd;
+    }
+    else{
+      return -1;
+    }
+  }
+  for(i=0;i<_MaxInstructionArgs;i++){ if(Mode[i]==-1){ Mode[i]=_SpecModeLoclVar; } }
+
+  //Return handler index
+  return SpecIndex*_SpecModeNr+Mode[0]+3*Mode[1]+9*Mode[2];
+
+}
+
 //Decode local variables
 bool Runtime::_DecodeLocalVariables(bool FirstTime,char *CodePtr,const char *OldStackPtr,const char *NewStackPtr){
 
@@ -4525,6 +6215,7 @@ bool Runtime::_DecodeLocalVariables(bool FirstTime,char *CodePtr,const char *Old
           if(FirstTime){
             if((*ArgPtr)<0){ System::Throw(SysExceptionCode::InvalidMemoryAddress,"stack memory",HEXFORMAT(*ArgPtr),"unknown"); return false; }
             (*ArgPtr)=(CpuAdr)reinterpret_cast<CpuAdr>(NewStackPtr+(*ArgPtr));
+            if(_CodeImgRecord){ _CodeImgLoclVar.Add(IP+ArgOffset); }
           }
           else{
             ArgAdr=reinterpret_cast<char *>(*ArgPtr)-OldStackPtr;
@@ -4574,6 +6265,267 @@ bool Runtime::_DecodeLocalVariables(bool FirstTime,char *CodePtr,const char *Old
 
 }
 
+//Decoded code image: Handler sources available for code buffer decoding
+//(image is only valid when it was saved with same jit and native library state)
+CpuInt Runtime::_CodeImageFlags(){
+  return (_Jit.Compiled()?1:0)|(_AotEntry.Length()!=0?2:0);
+}
+
+//Decoded code image: Load image file and check it belongs to loaded code buffer and running runtime
+//(returns false when image is missing, stale or damaged, in that case code buffer is decoded as usual)
+bool Runtime::_LoadCodeImage(){
+
+  //Variables
+  int i;
+  CpuWrd Size;
+  CpuAdr PrevAddress;
+  String Error;
+  String Reason;
+  char *Image;
+  CodeImageHeader Hdr;
+  const CodeImageHandler *Handler;
+  const CpuAdr *LoclVar;
+
+  //Hash code buffer before it is decoded (needed to save image as well)
+  _CodeImgHash=CodeHash(_Code.Pnt(),_Code.Length());
+  _CodeImgHnd.Reset();
+  _CodeImgLoclVar.Reset();
+
+  //Map image file
+  if(!_Stl->FileSystem.FileExists(String(_CodeImgFile))){
+    DebugMessage(DebugLevel::VrmRuntime,"Decoded code image "+String(_CodeImgFile)+" not found");
+    return false;
+  }
+  if((Image=MemoryManager::MapFile(String(_CodeImgFile),Size,Error))==nullptr){
+    DebugMessage(DebugLevel::VrmRuntime,"Unable to map decoded code image "+String(_CodeImgFile)+" ("+Error+")");
+    return false;
+  }
+
+  //Check header
+  Reason="";
+  if(Size<(CpuWrd)sizeof(CodeImageHeader)){ Reason="truncated header"; }
+  else{
+    MemCpy((char *)&Hdr,Image,sizeof(CodeImageHeader));
+    if(memcmp(Hdr.FileMark,FILEMARKCIMG,4)!=0){ Reason="invalid file mark"; }
+    else if(strncmp(Hdr.BuildNr,BuildNumber(DUNR_APPID).CharPnt(),sizeof(Hdr.BuildNr))!=0){ Reason="different runtime build"; }
+    else if(Hdr.CodeHash!=_CodeImgHash || Hdr.CodeLength!=_Code.Length()){ Reason="different code buffer"; }
+    else if(Hdr.Flags!=_CodeImageFlags()){ Reason="different jit or native library state"; }
+    else if(Hdr.HandlerNr<0 || Hdr.LoclVarNr<0
+    || Size!=(CpuWrd)(sizeof(CodeImageHeader)+Hdr.HandlerNr*sizeof(CodeImageHandler)+Hdr.LoclVarNr*sizeof(CpuAdr))){ Reason="truncated file"; }
+  }
+
+  //Load handler table (addresses are ascending and indexes must be in range of handler tables)
+  if(Reason.Length()==0){
+    Handler=(const CodeImageHandler *)(Image+sizeof(CodeImageHeader));
+    PrevAddress=-1;
+    for(i=0;i<Hdr.HandlerNr;i++){
+      if(Handler[i].Address<=PrevAddress || Handler[i].Address>=_Code.Length()
+      || (Handler[i].Kind==CodeImgKind::Fused && (Handler[i].Index<0 || Handler[i].Index>=_FusedInstNr))
+      || (Handler[i].Kind==CodeImgKind::Spec && (Handler[i].Index<0 || Handler[i].Index>=_SpecInstNr*_SpecModeNr))
+      || (Handler[i].Kind==CodeImgKind::Jit && !_Jit.IsEntry(Handler[i].Address))
+      || (Handler[i].Kind==CodeImgKind::Aot && _AotEntry[Handler[i].Address]==nullptr)
+      || Handler[i].Kind<CodeImgKind::Fused || Handler[i].Kind>CodeImgKind::Aot){
+        Reason="invalid handler record";
+        break;
+      }
+      PrevAddress=Handler[i].Address;
+      _CodeImgHnd.Add(Handler[i]);
+    }
+  }
+
+  //Load local variable table
+  if(Reason.Length()==0){
+    LoclVar=(const CpuAdr *)(Image+sizeof(CodeImageHeader)+Hdr.HandlerNr*sizeof(CodeImageHandler));
+    for(i=0;i<Hdr.LoclVarNr;i++){
+      if(LoclVar[i]<0 || LoclVar[i]>_Code.Length()-(CpuAdr)sizeof(CpuAdr)){
+        Reason="invalid local variable record";
+        break;
+      }
+      _CodeImgLoclVar.Add(LoclVar[i]);
+    }
+  }
+
+  //Release image file
+  MemoryManager::UnmapFile(Image,Size);
+
+  //Stale image
+  if(Reason.Length()!=0){
+    DebugMessage(DebugLevel::VrmRuntime,"Decoded code image "+String(_CodeImgFile)+" is not valid ("+Reason+"), code buffer is decoded again");
+    _CodeImgHnd.Reset();
+    _CodeImgLoclVar.Reset();
+    return false;
+  }
+
+  //Return success
+  DebugMessage(DebugLevel::VrmRuntime,"Loaded decoded code image "+String(_CodeImgFile)+" ("+ToString(_CodeImgHnd.Length())+" handlers, "+ToString(_CodeImgLoclVar.Length())+" local variables)");
+  return true;
+
+}
+
+//Decoded code image: Set local variable addresses from image
+bool Runtime::_ApplyCodeImageLocals(char *CodePtr,const char *NewStackPtr){
+  CpuAdr *ArgPtr;
+  for(int i=0;i<_CodeImgLoclVar.Length();i++){
+    ArgPtr=(CpuAdr *)(CodePtr+_CodeImgLoclVar[i]);
+    if((*ArgPtr)<0){ System::Throw(SysExceptionCode::InvalidMemoryAddress,"stack memory",HEXFORMAT(*ArgPtr),"unknown"); return false; }
+    (*ArgPtr)=(CpuAdr)reinterpret_cast<CpuAdr>(NewStackPtr+(*ArgPtr));
+  }
+  _CodeImgLoclVar.Reset();
+  return true;
+}
+
+//Decoded code image: Set instruction codes and handlers from image
+//(every instruction gets its own handler and then handler table replaces fused, specialized and native entry handlers)
+void Runtime::_ApplyCodeImageHandlers(const void **InstAddress,const void **FusedAddress,const void **SpecAddress,const void *JitHandler,const void *AotHandler,char *CodePtr){
+  
+  //Variables
+  int i;
+  CpuAdr IP;
+  CpuInstCode InstCode;
+  const void *Handler;
+
+  //Instruction codes and own handlers
+  for(IP=0;IP<_Code.Length();IP+=_Inst[(int)InstCode].Length){
+    InstCode=(CpuInstCode)(*(CpuIcd *)(CodePtr+IP));
+    (*(CpuIcd *)(CodePtr+IP+sizeof(CpuWrd)))=(CpuIcd)InstCode;
+    (*(const void **)(CodePtr+IP))=InstAddress[(int)InstCode];
+  }
+
+  //Handlers from handler table
+  for(i=0;i<_CodeImgHnd.Length();i++){
+    switch(_CodeImgHnd[i].Kind){
+      case CodeImgKind::Fused: Handler=FusedAddress[_CodeImgHnd[i].Index]; break;
+      case CodeImgKind::Spec:  Handler=SpecAddress[_CodeImgHnd[i].Index]; break;
+      case CodeImgKind::Jit:   Handler=JitHandler; break;
+      case CodeImgKind::Aot:   Handler=AotHandler; break;
+      default:                 Handler=nullptr; break;
+    }
+    if(Handler!=nullptr){ (*(const void **)(CodePtr+_CodeImgHnd[i].Address))=Handler; }
+  }
+
+  //Message
+  DebugMessage(DebugLevel::VrmRuntime,"Code buffer decoded from decoded code image ("+ToString(_CodeImgHnd.Length())+" handlers)");
+  _CodeImgHnd.Reset();
+
+}
+
+//Decoded code image: Save decoding results recorded by _DecodeLocalVariables() and _DecodeInstructionCodes()
+//(failure to write image is not an error, program runs and image is tried to be saved again on next execution)
+void Runtime::_SaveCodeImage(){
+
+  //Variables
+  int i;
+  int Hnd;
+  Buffer Image;
+  CodeImageHeader Hdr;
+
+  //Stop recording
+  _CodeImgRecord=false;
+
+  //Header
+  memset((void *)&Hdr,0,sizeof(CodeImageHeader));
+  MemCpy(Hdr.FileMark,FILEMARKCIMG,4);
+  BuildNumber(DUNR_APPID).Copy(Hdr.BuildNr,sizeof(Hdr.BuildNr)-1);
+  Hdr.CodeHash=_CodeImgHash;
+  Hdr.CodeLength=_Code.Length();
+  Hdr.Flags=_CodeImageFlags();
+  Hdr.HandlerNr=_CodeImgHnd.Length();
+  Hdr.LoclVarNr=_CodeImgLoclVar.Length();
+
+  //Image contents
+  Image.Append((const char *)&Hdr,sizeof(CodeImageHeader));
+  for(i=0;i<_CodeImgHnd.Length();i++){ Image.Append((const char *)&_CodeImgHnd[i],sizeof(CodeImageHandler)); }
+  for(i=0;i<_CodeImgLoclVar.Length();i++){ Image.Append((const char *)&_CodeImgLoclVar[i],sizeof(CpuAdr)); }
+  _CodeImgHnd.Reset();
+  _CodeImgLoclVar.Reset();
+
+  //Write file
+  if(!_Stl->FileSystem.GetHandler(Hnd)){ SysMessage(594).Print(String(_CodeImgFile),_Stl->LastError()); return; }
+  if(!_Stl->FileSystem.OpenForWrite(Hnd,String(_CodeImgFile))){ SysMessage(594).Print(String(_CodeImgFile),_Stl->LastError()); _Stl->FileSystem.FreeHandler(Hnd); return; }
+  if(!_Stl->FileSystem.Write(Hnd,Image)){ SysMessage(594).Print(String(_CodeImgFile),_Stl->LastError()); _Stl->FileSystem.CloseFile(Hnd); _Stl->FileSystem.FreeHandler(Hnd); return; }
+  if(!_Stl->FileSystem.CloseFile(Hnd)){ SysMessage(594).Print(String(_CodeImgFile),_Stl->LastError()); _Stl->FileSystem.FreeHandler(Hnd); return; }
+  _Stl->FileSystem.FreeHandler(Hnd);
+  DebugMessage(DebugLevel::VrmRuntime,"Saved decoded code image "+String(_CodeImgFile)+" ("+ToString(Hdr.HandlerNr)+" handlers, "+ToString(Hdr.LoclVarNr)+" local variables)");
+
+}
+
+//Process snapshot: Save process state when initialization routines end
+//(global memory, memory blocks and array tables are saved, code buffer is not saved as it is decoded with handler
+//addresses of running process, files, dynamic libraries and tasks opened by initialization routines are not saved)
+bool Runtime::_SaveSnapshot(CpuAdr ResumeAdr,String& Error){
+
+  //Variables
+  int i;
+  int Hnd;
+  Buffer Image;
+  SnapshotHeader Hdr;
+
+  //Generators keep stack frames that are not saved
+  if(_Gen.Length()!=0){ Error="generators are alive"; return false; }
+
+  //Find arrays holding command line arguments
+  _FindSnapshotArgs();
+
+  //Header
+  memset((void *)&Hdr,0,sizeof(SnapshotHeader));
+  MemCpy(Hdr.FileMark,FILEMARKSNAP,4);
+  BuildNumber(DUNR_APPID).Copy(Hdr.BuildNr,sizeof(Hdr.BuildNr)-1);
+  Hdr.CodeHash=_SnapCodeHash;
+  Hdr.CodeLength=_Code.Length();
+  Hdr.GlobLength=_Glob.Length();
+  Hdr.ResumeAdr=ResumeAdr;
+  Hdr.ArgArrNr=_SnapArgArr.Length();
+
+  //Snapshot contents
+  Image.Append((const char *)&Hdr,sizeof(SnapshotHeader));
+  Image.Append(_Glob.Pnt(),_Glob.Length());
+  _Aux.SaveState(Image);
+  _ArC.SaveState(Image);
+  for(i=0;i<_SnapArgArr.Length();i++){ Image.Append((const char *)&_SnapArgArr[i],sizeof(CpuMbl)); }
+
+  //Write file
+  if(!_Stl->FileSystem.GetHandler(Hnd)){ Error=_Stl->LastError(); return false; }
+  if(!_Stl->FileSystem.OpenForWrite(Hnd,String(_SnapFile))){ Error=_Stl->LastError(); _Stl->FileSystem.FreeHandler(Hnd); return false; }
+  if(!_Stl->FileSystem.Write(Hnd,Image)){ Error=_Stl->LastError(); _Stl->FileSystem.CloseFile(Hnd); _Stl->FileSystem.FreeHandler(Hnd); return false; }
+  if(!_Stl->FileSystem.CloseFile(Hnd)){ Error=_Stl->LastError(); _Stl->FileSystem.FreeHandler(Hnd); return false; }
+  _Stl->FileSystem.FreeHandler(Hnd);
+  DebugMessage(DebugLevel::VrmRuntime,"Saved process snapshot "+String(_SnapFile)+" ("+ToString(Image.Length())+" bytes, resume address "+HEXFORMAT(ResumeAdr)+")");
+
+  //Return code
+  return true;
+
+}
+
+//Process snapshot: Find arrays holding command line arguments
+void Runtime::_FindSnapshotArgs(){
+  _SnapArgArr.Reset();
+  for(CpuMbl Block=1;Block<_Aux.GetBlockMax();Block++){
+    if(_ArC.ISARG(Block,_ArgNr,_Arg,_ArgStart)){ _SnapArgArr.Add(Block); }
+  }
+}
+
+//Process snapshot: Fill arrays holding command line arguments with arguments of current execution
+bool Runtime::_RefreshSnapshotArgs(){
+  for(int i=0;i<_SnapArgArr.Length();i++){
+    if(!_ArC.SETARG(_SnapArgArr[i],_ArgNr,_Arg,_ArgStart)){
+      System::ExceptionPrint();
+      return false;
+    }
+  }
+  return true;
+}
+
+//Runtime server: Keep process state when initialization routines end
+//(state stays in memory of server process, requests resume from it as restored snapshots do)
+bool Runtime::_KeepInitState(CpuAdr ResumeAdr,String& Error){
+  if(_Gen.Length()!=0){ Error="generators are alive"; return false; }
+  _FindSnapshotArgs();
+  _SnapRestored=true;
+  _SnapResumeAdr=ResumeAdr;
+  DebugMessage(DebugLevel::VrmRuntime,"Runtime server kept process state after initialization routines (resume address "+HEXFORMAT(_SnapResumeAdr)+")");
+  return true;
+}
+
 //Get funtion debug name
 String Runtime::_GetFunctionDebugName(int FunIndex){
 
@@ -4645,6 +6597,9 @@ bool Runtime::Disassemble(){
   CurrFunIndex=-1;
   FuncDebugName="";
 
+  //Load debug symbol tables
+  _LoadDebugSymbols();
+
   //Disassemble loop
   Exit=false;
   do{
@@ -5074,7 +7029,7 @@ bool Runtime::_GetArguments(CpuAdr IP,CpuAdr BP,char *GlobPnt,char *StackPnt,cha
   CpuMbl Scope;
   char *ArgPtr;
   String DecMode;
-  static CpuDecMode ArgDecMode[_MaxInstructionArgs];
+  static thread_local CpuDecMode ArgDecMode[_MaxInstructionArgs];
 
   //Argument attributes into arrays
   //(We get them in stage 1, as in stage 2 they might be modified)
@@ -5260,89 +7215,443 @@ String Runtime::_AddressInfoLine(CpuAdr CodeAddress){
 
 }
 
-//Get code address information
-String Runtime::_AddressInfo(CpuAdr CodeAddress,bool& MainFrame){
+//Get code address information
+String Runtime::_AddressInfo(CpuAdr CodeAddress,bool& MainFrame){
+
+  //Variables
+  int i;
+  int LinIndex;
+  int FunIndex;
+  String Info;
+  String FuncDebugName;
+
+  //Entry point address
+  if(CodeAddress==0){
+    MainFrame=false;
+    return HEXFORMAT(CodeAddress)+" (entry address)";
+  }
+
+  //Find source line index
+  LinIndex=-1;
+  for(i=0;i<BinHdr.DbgSymLinNr;i++){
+    if(CodeAddress>=_DebugSym.Lin[i].BegAddress && CodeAddress<=_DebugSym.Lin[i].EndAddress){ LinIndex=i; break; }
+  }
+
+  //Find function index
+  FunIndex=-1;
+  for(i=0;i<BinHdr.DbgSymFunNr;i++){
+    if(CodeAddress>=_DebugSym.Fun[i].BegAddress && CodeAddress<=_DebugSym.Fun[i].EndAddress){ FunIndex=i; break; }
+  }
+
+  //Get function debug name
+  FuncDebugName=_GetFunctionDebugName(FunIndex);
+
+  //Compose line
+  Info="";
+  Info+=(LinIndex!=-1 ? String((char *)_DebugSym.Mod[_DebugSym.Lin[LinIndex].ModIndex].Path)+":"+ToString(_DebugSym.Lin[LinIndex].LineNr) : HEXFORMAT(CodeAddress));
+  Info+=(FunIndex!=-1 ? " from "+FuncDebugName : "");
+
+  //Main frame
+  MainFrame=(FunIndex!=-1 && strcmp((const char *)&_DebugSym.Fun[FunIndex].Name[0],SYSTEM_NAMESPACE MAIN_FUNCTION)==0)?true:false;
+
+  //Return address information
+  return Info;
+  
+}
+
+//Print call stack
+void Runtime::_PrintCallStack(CpuAdr IP){
+  
+  //Variables
+  bool MainFrame;
+  int Frame;
+  CpuAdr Adr;
+  String Info;
+
+  //Print call stack
+  Frame=-1;
+  do{
+
+    //Begin with current instruction pointer
+    if(Frame==-1){
+      Adr=IP;
+    }
+    else{
+      Adr=_CallSt[Frame].OrgAddress;
+    }
+
+    //Get address information
+    Info=_AddressInfo(Adr,MainFrame);
+    
+    //Print origin of error
+    _Stl->Console.PrintErrorLine("["+ToString((Frame==-1?_CallSt.Length():Frame),"%02i")+"] -> At "+Info);
+
+    //Next frame
+    if(Frame==-1){
+      Frame=_CallSt.Length()-1;
+    }
+    else{
+      Frame--;
+    }
+
+    //Exit at last frame or when entry point is found
+    if(Frame==-1 || MainFrame){ break; }
+
+  }while(true);
+
+}
+
+//Start sampling profiler
+//(on each timer tick signal handler points handler slots of control transfer instructions to sample handler, so the next jump,
+//call or return lands on sample handler which records sample and gives original handlers back, fast dispatch path is not changed,
+//the instruction before each jump is also taken as it can be the first one of a fused instruction that dispatches the jump)
+bool Runtime::_StartProfiler(const void *SampleHandler){
+
+  //Profiler is not available on windows
+  #ifdef __WIN__
+  return false;
+
+  //Linux
+  #else
+
+  //Variables
+  long Slots;
+  CpuAdr IP;
+  CpuAdr PrevIP;
+  CpuInstCode InstCode;
+  struct sigaction Action;
+  struct itimerval Timer;
+
+  //Get handler slot of each control transfer instruction (instruction code is after handler once code buffer is decoded)
+  Slots=0;
+  for(IP=0;IP<_Code.Length();IP+=_Inst[(int)InstCode].Length){ InstCode=(CpuInstCode)(*(CpuIcd *)(_Code.Pnt()+IP+sizeof(CpuWrd))); Slots++; }
+  _ProfSlot=Buffer(Slots*sizeof(CpuWrd *),0);
+  _ProfSaved=Buffer(Slots*sizeof(CpuWrd),0);
+  Slots=0;
+  PrevIP=-1;
+  for(IP=0;IP<_Code.Length();IP+=_Inst[(int)InstCode].Length){ 
+    InstCode=(CpuInstCode)(*(CpuIcd *)(_Code.Pnt()+IP+sizeof(CpuWrd)));
+    switch(InstCode){
+      case CpuInstCode::JMP: 
+      case CpuInstCode::JMPTR: 
+      case CpuInstCode::JMPFL:
+        if(PrevIP!=-1 && (Slots==0 || ((CpuWrd **)_ProfSlot.BuffPnt())[Slots-1]!=(CpuWrd *)(_Code.Pnt()+PrevIP))){
+          ((CpuWrd **)_ProfSlot.BuffPnt())[Slots]=(CpuWrd *)(_Code.Pnt()+PrevIP);
+          Slots++;
+        }
+        ((CpuWrd **)_ProfSlot.BuffPnt())[Slots]=(CpuWrd *)(_Code.Pnt()+IP);
+        Slots++;
+        break;
+      case CpuInstCode::CALL: 
+      case CpuInstCode::CALLN: 
+      case CpuInstCode::RET: 
+      case CpuInstCode::RETN: 
+      case CpuInstCode::SCALL: 
+      case CpuInstCode::LCALL:
+        ((CpuWrd **)_ProfSlot.BuffPnt())[Slots]=(CpuWrd *)(_Code.Pnt()+IP);
+        Slots++;
+        break;
+      default:
+        break;
+    }
+    PrevIP=IP;
+  }
+  
+  //Init samples
+  _ProfSample=Array<CpuAdr>(DEFAULT_CHUNKSIZE_PROFSAMPLE);
+  _ProfSampleNr=0;
+
+  //Set signal handler data
+  ProfSlot=(CpuWrd **)_ProfSlot.BuffPnt();
+  ProfSaved=(CpuWrd *)_ProfSaved.BuffPnt();
+  ProfSlotNr=Slots;
+  ProfHandler=(CpuWrd)SampleHandler;
+  ProfArmed=0;
+
+  //Install signal handler
+  memset(&Action,0,sizeof(Action));
+  Action.sa_handler=&_ProfilerHandler;
+  Action.sa_flags=SA_RESTART;
+  sigemptyset(&Action.sa_mask);
+  if(sigaction(SIGPROF,&Action,&ProfOldAction)==-1){
+    SysMessage(588).Print(String(strerror(errno)));
+    ProfSlotNr=0;
+    return false;
+  }
+
+  //Start timer (measures cpu time of process)
+  Timer.it_interval.tv_sec=0;
+  Timer.it_interval.tv_usec=PROF_SAMPLE_USEC;
+  Timer.it_value=Timer.it_interval;
+  if(setitimer(ITIMER_PROF,&Timer,nullptr)==-1){
+    SysMessage(588).Print(String(strerror(errno)));
+    sigaction(SIGPROF,&ProfOldAction,nullptr);
+    ProfSlotNr=0;
+    return false;
+  }
+  DebugMessage(DebugLevel::VrmRuntime,"Sampling profiler started on "+ToString(Slots)+" instructions");
+
+  //Return code
+  return true;
+
+  #endif
+
+}
+
+//Stop sampling profiler
+void Runtime::_StopProfiler(){
+  #ifndef __WIN__
+  struct itimerval Timer;
+  memset(&Timer,0,sizeof(Timer));
+  setitimer(ITIMER_PROF,&Timer,nullptr);
+  sigaction(SIGPROF,&ProfOldAction,nullptr);
+  if(ProfArmed){ _ProfilerDisarm(); }
+  ProfSlotNr=0;
+  #endif
+}
+
+//Record profiler sample (current instruction address and calling instruction of each call stack frame)
+void Runtime::_ProfilerSample(CpuAdr IP){
+  #ifndef __WIN__
+  _ProfSample.Add((CpuAdr)(_CallSt.Length()+1));
+  _ProfSample.Add(IP);
+  for(int i=_CallSt.Length()-1;i>=0;i--){ _ProfSample.Add(_CallSt[i].OrgAddress); }
+  _ProfSampleNr++;
+  _ProfilerDisarm();
+  #endif
+}
+
+//Call timming on function call
+void Runtime::_CallTimEnter(CpuAdr FunAddress){
+  int Index;
+  CallTimmingTable Entry;
+  CallTimmingFrame Frame;
+  if(FunAddress<0 || FunAddress>=_CallTimIndex.Length()){ return; }
+  if((Index=_CallTimIndex[FunAddress])==-1){
+    Entry.FunAddress=FunAddress;
+    Entry.CallCount=0;
+    Entry.InclTime=0;
+    Entry.ExclTime=0;
+    Entry.ActiveCount=0;
+    _CallTim.Add(Entry);
+    Index=_CallTim.Length()-1;
+    _CallTimIndex[FunAddress]=Index;
+  }
+  _CallTim[Index].CallCount++;
+  _CallTim[Index].ActiveCount++;
+  Frame.Index=Index;
+  Frame.Depth=_CallSt.Length();
+  Frame.ChildTime=0;
+  Frame.Start=ClockGet();
+  _CallTimSt.Add(Frame);
+}
+
+//Call timming on function return
+//(returns that do not match last accounted call are ignored unless forced, this happens when call instruction was not accounted)
+void Runtime::_CallTimLeave(bool Force){
+  double Elapsed;
+  ClockPoint End=ClockGet();
+  CallTimmingFrame Frame;
+  if(_CallTimSt.Length()==0 || (!Force && _CallTimSt[_CallTimSt.Length()-1].Depth!=_CallSt.Length()-1)){ return; }
+  Frame=_CallTimSt[_CallTimSt.Length()-1];
+  _CallTimSt.Delete(_CallTimSt.Length()-1);
+  Elapsed=ClockIntervalNSec(End,Frame.Start);
+  _CallTim[Frame.Index].ExclTime+=Elapsed-Frame.ChildTime;
+  _CallTim[Frame.Index].ActiveCount--;
+  if(_CallTim[Frame.Index].ActiveCount==0){ _CallTim[Frame.Index].InclTime+=Elapsed; }
+  if(_CallTimSt.Length()!=0){ _CallTimSt[_CallTimSt.Length()-1].ChildTime+=Elapsed; }
+}
+
+//Print call timmings
+void Runtime::_PrintCallTimming(){
 
   //Variables
   int i;
-  int LinIndex;
+  int Index;
   int FunIndex;
-  String Info;
-  String FuncDebugName;
-
-  //Entry point address
-  if(CodeAddress==0){
-    MainFrame=false;
-    return HEXFORMAT(CodeAddress)+" (entry address)";
-  }
-
-  //Find source line index
-  LinIndex=-1;
-  for(i=0;i<BinHdr.DbgSymLinNr;i++){
-    if(CodeAddress>=_DebugSym.Lin[i].BegAddress && CodeAddress<=_DebugSym.Lin[i].EndAddress){ LinIndex=i; break; }
-  }
+  double MaxTime;
+  double TotalTime;
+  String Headings;
+  Array<String> Rows;
+  Array<bool> Printed;
 
-  //Find function index
-  FunIndex=-1;
-  for(i=0;i<BinHdr.DbgSymFunNr;i++){
-    if(CodeAddress>=_DebugSym.Fun[i].BegAddress && CodeAddress<=_DebugSym.Fun[i].EndAddress){ FunIndex=i; break; }
-  }
+  //Close calls that did not return (program ended inside them)
+  while(_CallTimSt.Length()!=0){ _CallTimLeave(true); }
 
-  //Get function debug name
-  FuncDebugName=_GetFunctionDebugName(FunIndex);
+  //Measured time is the sum of exclusive times
+  TotalTime=0;
+  for(i=0;i<_CallTim.Length();i++){ TotalTime+=_CallTim[i].ExclTime; }
 
-  //Compose line
-  Info="";
-  Info+=(LinIndex!=-1 ? String((char *)_DebugSym.Mod[_DebugSym.Lin[LinIndex].ModIndex].Path)+":"+ToString(_DebugSym.Lin[LinIndex].LineNr) : HEXFORMAT(CodeAddress));
-  Info+=(FunIndex!=-1 ? " from "+FuncDebugName : "");
+  //Load debug symbol tables
+  _LoadDebugSymbols();
 
-  //Main frame
-  MainFrame=(FunIndex!=-1 && strcmp((const char *)&_DebugSym.Fun[FunIndex].Name[0],SYSTEM_NAMESPACE MAIN_FUNCTION)==0)?true:false;
+  //Output functions ordered by inclusive time
+  Printed.Resize(_CallTim.Length());
+  for(i=0;i<_CallTim.Length();i++){ Printed[i]=false; }
+  Headings="Nr.~Function~Calls~Inclusive time~Exclusive time~Average time";
+  do{
+    Index=-1;
+    MaxTime=-1;
+    for(i=0;i<_CallTim.Length();i++){
+      if(!Printed[i] && _CallTim[i].InclTime>MaxTime){ MaxTime=_CallTim[i].InclTime; Index=i; }
+    }
+    if(Index==-1){ break; }
+    Printed[Index]=true;
+    FunIndex=-1;
+    for(i=0;i<BinHdr.DbgSymFunNr;i++){
+      if(_DebugSym.Fun[i].BegAddress==_CallTim[Index].FunAddress){ FunIndex=i; break; }
+    }
+    Rows.Add(ToString(Rows.Length()+1)+"~"+(FunIndex!=-1?_GetFunctionDebugName(FunIndex):HEXFORMAT(_CallTim[Index].FunAddress))+"~"+ToString(_CallTim[Index].CallCount)+"~"
+    +_GetScaledTime(_CallTim[Index].InclTime)+"  "+("["+ToString(((double)100)*_CallTim[Index].InclTime/(TotalTime!=0?TotalTime:1),"%0.2f%%")+"]").RJust(9)+"~"
+    +_GetScaledTime(_CallTim[Index].ExclTime)+"  "+("["+ToString(((double)100)*_CallTim[Index].ExclTime/(TotalTime!=0?TotalTime:1),"%0.2f%%")+"]").RJust(9)+"~"
+    +_GetScaledTime(_CallTim[Index].InclTime/(double)_CallTim[Index].CallCount));
+  }while(true);
+  _Stl->Console.PrintTable(Headings,Rows,"~","RLRLLL");
+  _Stl->Console.PrintLine("DS Call timming: "+ToString(_CallTim.Length())+" functions called, measured time: "+_GetScaledTime(TotalTime));
 
-  //Return address information
-  return Info;
-  
 }
 
-//Print call stack
-void Runtime::_PrintCallStack(CpuAdr IP){
-  
+//Print profiler tables and write folded call stacks file
+bool Runtime::_PrintProfile(){
+
   //Variables
-  bool MainFrame;
-  int Frame;
+  int i;
+  int Index;
+  int FunIndex;
+  int LinIndex;
+  int UnknownFun;
+  int FrameNr;
+  long Pos;
+  long MaxCount;
+  long Sample;
   CpuAdr Adr;
-  String Info;
+  CpuAdr Beg;
+  CpuAdr End;
+  String Stack;
+  String Name;
+  String Headings;
+  Array<String> Rows;
+  Array<String> Lines;
+  Array<int> FunAt;
+  Array<int> LinAt;
+  Array<long> SelfCount;
+  Array<long> TotalCount;
+  Array<long> LastSample;
+  Array<long> LineCount;
+  Array<String> FunName;
+  Array<bool> Printed;
+  SortedArray<ProfStack,const String&> Folded;
+  ProfStack Item;
+  int Hnd;
 
-  //Print call stack
-  Frame=-1;
-  do{
+  //Load debug symbol tables
+  _LoadDebugSymbols();
+
+  //Function and source line index for each code address
+  FunAt.Resize(_Code.Length());
+  LinAt.Resize(_Code.Length());
+  for(Adr=0;Adr<_Code.Length();Adr++){ FunAt[Adr]=-1; LinAt[Adr]=-1; }
+  for(i=BinHdr.DbgSymFunNr-1;i>=0;i--){
+    Beg=std::max((CpuAdr)0,(CpuAdr)_DebugSym.Fun[i].BegAddress);
+    End=std::min((CpuAdr)_Code.Length()-1,(CpuAdr)_DebugSym.Fun[i].EndAddress);
+    for(Adr=Beg;Adr<=End;Adr++){ FunAt[Adr]=i; }
+  }
+  for(i=BinHdr.DbgSymLinNr-1;i>=0;i--){
+    Beg=std::max((CpuAdr)0,(CpuAdr)_DebugSym.Lin[i].BegAddress);
+    End=std::min((CpuAdr)_Code.Length()-1,(CpuAdr)_DebugSym.Lin[i].EndAddress);
+    for(Adr=Beg;Adr<=End;Adr++){ LinAt[Adr]=i; }
+  }
 
-    //Begin with current instruction pointer
-    if(Frame==-1){
-      Adr=IP;
+  //Function names (last entry is for code without debug symbols)
+  UnknownFun=BinHdr.DbgSymFunNr;
+  for(i=0;i<BinHdr.DbgSymFunNr;i++){ FunName.Add(String((char *)_DebugSym.Fun[i].Name)); }
+  FunName.Add("(unknown)");
+
+  //Init counters
+  SelfCount.Resize(UnknownFun+1);
+  TotalCount.Resize(UnknownFun+1);
+  LastSample.Resize(UnknownFun+1);
+  LineCount.Resize(BinHdr.DbgSymLinNr);
+  for(i=0;i<=UnknownFun;i++){ SelfCount[i]=0; TotalCount[i]=0; LastSample[i]=-1; }
+  for(i=0;i<BinHdr.DbgSymLinNr;i++){ LineCount[i]=0; }
+
+  //Accumulate samples
+  //(total count is incremented once per sample for each function in call stack, so recursion is not counted twice)
+  Pos=0;
+  for(Sample=0;Sample<_ProfSampleNr;Sample++){
+    FrameNr=(int)_ProfSample[Pos++];
+    Stack="";
+    for(i=0;i<FrameNr;i++){
+      Adr=_ProfSample[Pos+i];
+      FunIndex=(Adr>=0 && Adr<_Code.Length() && FunAt[Adr]!=-1?FunAt[Adr]:UnknownFun);
+      if(i==0){
+        SelfCount[FunIndex]++;
+        LinIndex=(Adr>=0 && Adr<_Code.Length()?LinAt[Adr]:-1);
+        if(LinIndex!=-1){ LineCount[LinIndex]++; }
+      }
+      if(LastSample[FunIndex]!=Sample){ TotalCount[FunIndex]++; LastSample[FunIndex]=Sample; }
+      Name=(FunIndex!=UnknownFun?FunName[FunIndex]:HEXFORMAT(Adr));
+      Stack=(i==0?Name:Name+";"+Stack);
+    }
+    Pos+=FrameNr;
+    if((Index=Folded.Search(Stack))!=-1){
+      Folded[Index].Count++;
     }
     else{
-      Adr=_CallSt[Frame].OrgAddress;
+      Item.Stack=Stack;
+      Item.Count=1;
+      Folded.Add(Item);
     }
+  }
 
-    //Get address information
-    Info=_AddressInfo(Adr,MainFrame);
-    
-    //Print origin of error
-    _Stl->Console.PrintErrorLine("["+ToString((Frame==-1?_CallSt.Length():Frame),"%02i")+"] -> At "+Info);
-
-    //Next frame
-    if(Frame==-1){
-      Frame=_CallSt.Length()-1;
+  //Print function table ordered by self samples
+  Printed.Resize(UnknownFun+1);
+  for(i=0;i<=UnknownFun;i++){ Printed[i]=false; }
+  Headings="Nr.~Function~Self samples~Self time~Total samples~Total time";
+  Rows.Reset();
+  do{
+    Index=-1;
+    MaxCount=0;
+    for(i=0;i<=UnknownFun;i++){
+      if(!Printed[i] && SelfCount[i]>MaxCount){ MaxCount=SelfCount[i]; Index=i; }
     }
-    else{
-      Frame--;
+    if(Index==-1 || Rows.Length()>=PROF_MAX_ROWS){ break; }
+    Printed[Index]=true;
+    Rows.Add(ToString(Rows.Length()+1)+"~"+(Index!=UnknownFun?_GetFunctionDebugName(Index):FunName[Index])+"~"+ToString(SelfCount[Index])+"~"
+    +ToString(((double)100)*SelfCount[Index]/(double)std::max(_ProfSampleNr,1L),"%0.2f%%")+"~"+ToString(TotalCount[Index])+"~"
+    +ToString(((double)100)*TotalCount[Index]/(double)std::max(_ProfSampleNr,1L),"%0.2f%%"));
+  }while(true);
+  _Stl->Console.PrintTable(Headings,Rows,"~","RLRRRR");
+
+  //Print source line table ordered by samples
+  Printed.Resize(BinHdr.DbgSymLinNr);
+  for(i=0;i<BinHdr.DbgSymLinNr;i++){ Printed[i]=false; }
+  Headings="Nr.~Source line~Samples~Time";
+  Rows.Reset();
+  do{
+    Index=-1;
+    MaxCount=0;
+    for(i=0;i<BinHdr.DbgSymLinNr;i++){
+      if(!Printed[i] && LineCount[i]>MaxCount){ MaxCount=LineCount[i]; Index=i; }
     }
+    if(Index==-1 || Rows.Length()>=PROF_MAX_ROWS){ break; }
+    Printed[Index]=true;
+    Rows.Add(ToString(Rows.Length()+1)+"~"+String((char *)_DebugSym.Mod[_DebugSym.Lin[Index].ModIndex].Path)+":"+ToString(_DebugSym.Lin[Index].LineNr)+"~"
+    +ToString(LineCount[Index])+"~"+ToString(((double)100)*LineCount[Index]/(double)std::max(_ProfSampleNr,1L),"%0.2f%%"));
+  }while(true);
+  if(Rows.Length()!=0){ _Stl->Console.PrintTable(Headings,Rows,"~","RLRR"); }
+  _Stl->Console.PrintLine("DS Profiler: "+ToString(_ProfSampleNr)+" samples every "+ToString(PROF_SAMPLE_USEC)+"us of cpu time, folded call stacks written to "+String(_ProfFile));
 
-    //Exit at last frame or when entry point is found
-    if(Frame==-1 || MainFrame){ break; }
+  //Write folded call stacks file (one line per distinct call stack with its sample count, as flame graph tools expect)
+  for(i=0;i<Folded.Length();i++){ Lines.Add(Folded[i].Stack+" "+ToString(Folded[i].Count)+"\n"); }
+  if(!_Stl->FileSystem.GetHandler(Hnd)){ SysMessage(237).Print(String(_ProfFile)); return false; }
+  if(!_Stl->FileSystem.OpenForWrite(Hnd,String(_ProfFile))){ SysMessage(589).Print(String(_ProfFile),_Stl->LastError()); return false; }
+  if(!_Stl->FileSystem.WriteArray(Hnd,Lines)){ SysMessage(589).Print(String(_ProfFile),_Stl->LastError()); return false; }
+  if(!_Stl->FileSystem.CloseFile(Hnd)){ SysMessage(238).Print(String(_ProfFile),_Stl->LastError()); return false; }
+  if(!_Stl->FileSystem.FreeHandler(Hnd)){ SysMessage(239).Print(String(_ProfFile),_Stl->LastError()); return false; }
 
-  }while(true);
+  //Return code
+  return true;
 
 }
 
@@ -5353,7 +7662,9 @@ void Runtime::SetLibPaths(const String& DynLibPath,const String& TmpLibPath){
 }
 
 //Closed all open files
+//(asynchronous requests of process are completed first as they can be still using its files)
 void Runtime::CloseAllFiles(){
+  AsyncIoManager::Release();
   _Stl->FileSystem.CloseAll();
 }
 
@@ -5365,6 +7676,11 @@ void Runtime::UnloadLibraries(){
       _CloseDynLibrary(_DynLib[i].Handler);
     }
   }
+  if(_AotHandler!=nullptr){
+    _AotEntry.Reset();
+    _CloseDynLibrary(_AotHandler);
+    _AotHandler=nullptr;
+  }
 }
 
 //Set rom buffer pointer
@@ -5372,6 +7688,193 @@ void Runtime::SetRomBuffer(RomFileBuffer *Ptr){
   _RomBuffer=Ptr;
 }
 
+//Set fixed stack reservation
+void Runtime::SetStackReserve(CpuWrd Bytes){
+  _StackReserve=Bytes;
+}
+
+//Set jit compiler
+void Runtime::SetJit(bool Enable){
+  _JitEnabled=Enable;
+}
+
+//Set call timming mode
+void Runtime::SetCallTimming(bool Enable){
+  _CallTimEnabled=Enable;
+}
+
+//Set instruction sequence output file (benchmark mode 4)
+void Runtime::SetInstSequenceFile(const String& SeqFile){
+  SeqFile.Copy(_InstSeqFile,FILEPATHLEN);
+}
+
+//Set decoded code image cache
+void Runtime::SetCodeImage(bool Enable,const String& ImageFile){
+  _CodeImgEnabled=Enable;
+  ImageFile.Copy(_CodeImgFile,FILEPATHLEN);
+}
+
+//Set worker threads for parallel walk loops (zero means one for each cpu core)
+void Runtime::SetParallelWorkers(int Workers){
+  _ParWorkers=(Workers==0?std::max((int)std::thread::hardware_concurrency(),1):Workers);
+}
+
+//Set process snapshot (must be called before code buffer is decoded)
+void Runtime::SetSnapshot(const String& SnapshotFile){
+  _SnapSave=true;
+  _SnapCodeHash=CodeHash(_Code.Pnt(),_Code.Length());
+  SnapshotFile.Copy(_SnapFile,FILEPATHLEN);
+}
+
+//Restore process state from snapshot (must be called after program is loaded and before code buffer is decoded)
+bool Runtime::RestoreSnapshot(const String& SnapshotFile){
+
+  //Variables
+  int i;
+  CpuWrd Size;
+  CpuWrd Offset;
+  String Error;
+  char *Image;
+  SnapshotHeader Hdr;
+
+  //Map snapshot file
+  if(!_Stl->FileSystem.FileExists(SnapshotFile)){
+    SysMessage(617).Print(SnapshotFile,"file does not exist");
+    return false;
+  }
+  if((Image=MemoryManager::MapFile(SnapshotFile,Size,Error))==nullptr){
+    SysMessage(617).Print(SnapshotFile,Error);
+    return false;
+  }
+
+  //Check header (resume address must point to scope unlock instruction of start code)
+  Error="";
+  if(Size<(CpuWrd)sizeof(SnapshotHeader)){ Error="truncated header"; }
+  else{
+    MemCpy((char *)&Hdr,Image,sizeof(SnapshotHeader));
+    if(memcmp(Hdr.FileMark,FILEMARKSNAP,4)!=0){ Error="invalid file mark"; }
+    else if(strncmp(Hdr.BuildNr,BuildNumber(DUNR_APPID).CharPnt(),sizeof(Hdr.BuildNr))!=0){ Error="saved by different runtime build"; }
+    else if(Hdr.CodeHash!=CodeHash(_Code.Pnt(),_Code.Length()) || Hdr.CodeLength!=_Code.Length()){ Error="saved by different executable"; }
+    else if(Hdr.GlobLength!=_Glob.Length()){ Error="different global memory size"; }
+    else if(Hdr.ResumeAdr<0 || Hdr.ResumeAdr>_Code.Length()-(CpuAdr)sizeof(CpuIcd)
+    || (CpuInstCode)(*(CpuIcd *)(_Code.Pnt()+Hdr.ResumeAdr))!=CpuInstCode::SULOK){ Error="invalid resume address"; }
+    else if(Hdr.ArgArrNr<0){ Error="invalid argument array table"; }
+  }
+
+  //Global memory
+  Offset=sizeof(SnapshotHeader);
+  if(Error.Length()==0){
+    if(Offset+Hdr.GlobLength>Size){ Error="truncated global memory"; }
+    else{ MemCpy(_Glob.Pnt(),Image+Offset,Hdr.GlobLength); Offset+=Hdr.GlobLength; }
+  }
+
+  //Memory blocks and array tables
+  if(Error.Length()==0){ _Aux.LoadState(Image,Size,Offset,Error); }
+  if(Error.Length()==0){ _ArC.LoadState(Image,Size,Offset,Error); }
+
+  //Arrays holding command line arguments
+  if(Error.Length()==0){
+    if(Offset+Hdr.ArgArrNr*(CpuWrd)sizeof(CpuMbl)!=Size){ Error="truncated argument array table"; }
+    else{
+      _SnapArgArr.Reset();
+      for(i=0;i<Hdr.ArgArrNr;i++){
+        _SnapArgArr.Add(((const CpuMbl *)(Image+Offset))[i]);
+        if(!_Aux.IsValid(_SnapArgArr[i]) || _Aux.GetArrIndex(_SnapArgArr[i])<0){ Error="invalid argument array table"; break; }
+      }
+    }
+  }
+
+  //Release snapshot file
+  MemoryManager::UnmapFile(Image,Size);
+  if(Error.Length()!=0){
+    SysMessage(617).Print(SnapshotFile,Error);
+    return false;
+  }
+
+  //Execution resumes at end of initialization routines
+  _SnapRestored=true;
+  _SnapResumeAdr=Hdr.ResumeAdr;
+  DebugMessage(DebugLevel::VrmRuntime,"Restored process snapshot "+SnapshotFile+" ("+ToString(Size)+" bytes, resume address "+HEXFORMAT(_SnapResumeAdr)+")");
+
+  //Return code
+  return true;
+
+}
+
+//Set sampling profiler
+void Runtime::SetProfiler(bool Enable,const String& FoldedFile){
+  _ProfEnabled=Enable;
+  FoldedFile.Copy(_ProfFile,FILEPATHLEN);
+}
+
+//Load native library generated by ahead-of-time translator
+//(program runs on interpreter when library is missing or does not match loaded code)
+bool Runtime::LoadNativeLibrary(const String& BinaryFile){
+
+  //Variables
+  int i;
+  int TableId;
+  CpuInt EntryNr;
+  CpuLon Hash;
+  String LibFile;
+  String DirName;
+  DlFuncPtr FuncPtr;
+  const AotEntry *Table;
+  void *Params[3];
+
+  //Get library file name (dlopen() requires a path to not search in system library paths)
+  DirName=_Stl->FileSystem.GetDirName(BinaryFile);
+  if(DirName.Length()==0){ DirName="."+_Stl->FileSystem.Delimiter(); }
+  LibFile=DirName+_Stl->FileSystem.GetFileNameNoExt(BinaryFile)+AOT_LIBRARY_TAG+DYNLIB_EXT;
+  if(!_Stl->FileSystem.FileExists(LibFile)){
+    SysMessage(584).Print(LibFile);
+    return true;
+  }
+
+  //Open library and check architecture
+  if(!_OpenDynLibrary(LibFile,&_AotHandler,&FuncPtr)){ _AotHandler=nullptr; return false; }
+  if(GetArchitecture()!=FuncPtr.LibArchitecture()){
+    System::Throw(SysExceptionCode::DynLibArchMissmatch,LibFile,ToString(FuncPtr.LibArchitecture()),ToString(GetArchitecture()));
+    _CloseDynLibrary(_AotHandler);
+    _AotHandler=nullptr;
+    return false;
+  }
+
+  //Get entry point table
+  Table=nullptr;
+  EntryNr=0;
+  Hash=0;
+  Params[0]=(void *)&Table;
+  Params[1]=(void *)&EntryNr;
+  Params[2]=(void *)&Hash;
+  if((TableId=FuncPtr.SearchFunction((char *)AOT_TABLE_FUNCTION))==-1 || !FuncPtr.CallFunction(TableId,Params) || Table==nullptr){
+    System::Throw(SysExceptionCode::MissingLibraryFunc,AOT_TABLE_FUNCTION,LibFile);
+    _CloseDynLibrary(_AotHandler);
+    _AotHandler=nullptr;
+    return false;
+  }
+
+  //Library must be generated from same code that is loaded
+  if(Hash!=CodeHash(_Code.Pnt(),_Code.Length())){
+    SysMessage(585).Print(LibFile);
+    _CloseDynLibrary(_AotHandler);
+    _AotHandler=nullptr;
+    return true;
+  }
+
+  //Set native function for each entry point
+  _AotEntry.Resize(_Code.Length());
+  for(i=0;i<_AotEntry.Length();i++){ _AotEntry[i]=nullptr; }
+  for(i=0;i<EntryNr && Table[i].Function!=nullptr;i++){
+    if(Table[i].Address>=0 && Table[i].Address<_Code.Length()){ _AotEntry[Table[i].Address]=Table[i].Function; }
+  }
+  DebugMessage(DebugLevel::VrmRuntime,"Loaded native library "+LibFile+" with "+ToString(EntryNr)+" entry points");
+
+  //Return code
+  return true;
+
+}
+
 //Measure minimun clock tick
 double Runtime::_MinimunClockTick(){
   int Measures=0;
@@ -5524,9 +8027,198 @@ void Runtime::_PrintBenchMark(int BenchMark){
 
   //Output total benchmark
   _Stl->Console.PrintLine("DS Benchmark: "+Measure);
+
+  //Output peak memory used by strings and dynamic arrays
+  _Stl->Console.PrintLine("DS Memory: peak "+ToString(_Aux.PeakMemory()/1024.0,"%0.2f")+"KB on strings and dynamic arrays, "+ToString(_Aux.ReleasedBlocks())+" blocks released on function return");
   
 }
 
+//Init instruction sequence counters
+void Runtime::_InstSeqInit(){
+  int i;
+  _InstSeq.Resize(INST_SEQ_SLOTS);
+  for(i=0;i<_InstSeq.Length();i++){ _InstSeq[i].Key=0; _InstSeq[i].Count=0; }
+  for(i=0;i<_MaxInstructionArgs;i++){ _InstSeqDecMode[i]=CpuDecMode::LoclVar; }
+  _InstSeqUsed=0;
+  _InstSeqDepth=0;
+  _InstSeqJump=false;
+  _InstSeqBreak=false;
+  _InstSeqNextIP=0;
+}
+
+//Add count to instruction sequence
+//(open addressing hash table with linear probing that doubles its size when it gets half full)
+void Runtime::_InstSeqAdd(CpuLon Key,CpuLon Count){
+  int i;
+  int Slot;
+  int Mask;
+  Mask=_InstSeq.Length()-1;
+  Slot=(int)((((uint64_t)Key)*0x9E3779B97F4A7C15ULL)>>32)&Mask;
+  while(_InstSeq[Slot].Key!=0 && _InstSeq[Slot].Key!=Key){ Slot=(Slot+1)&Mask; }
+  if(_InstSeq[Slot].Key==0){ _InstSeq[Slot].Key=Key; _InstSeqUsed++; }
+  _InstSeq[Slot].Count+=Count;
+  if(2*_InstSeqUsed>_InstSeq.Length()){
+    Array<InstSequenceTable> Prev;
+    Prev=_InstSeq;
+    _InstSeq.Resize(2*Prev.Length());
+    for(i=0;i<_InstSeq.Length();i++){ _InstSeq[i].Key=0; _InstSeq[i].Count=0; }
+    _InstSeqUsed=0;
+    for(i=0;i<Prev.Length();i++){
+      if(Prev[i].Key!=0){ _InstSeqAdd(Prev[i].Key,Prev[i].Count); }
+    }
+  }
+}
+
+//Account executed instruction on instruction sequences
+//(decoder instructions are not accounted by themselves, the decoder modes they set become part of next instruction key,
+//so sequences are the same ones the code buffer decoder sees when fusing instructions and selecting specialized handlers)
+void Runtime::_InstSeqCount(CpuAdr IP,CpuInstCode InstCode){
+
+  //Variables
+  int i;
+  bool Jump;
+  CpuLon Key;
+
+  //Detect control flow jumps
+  if(IP!=_InstSeqNextIP){ _InstSeqBreak=true; }
+  _InstSeqNextIP=IP+_Inst[(int)InstCode].Length;
+
+  //Decoder instructions only set decoder mode for next instruction
+  if(InstCode>=CpuInstCode::DAGV1 && InstCode<=CpuInstCode::DALI4){
+    i=((int)InstCode-(int)CpuInstCode::DAGV1)%4;
+    if(InstCode<=CpuInstCode::DAGV4){ _InstSeqDecMode[i]=CpuDecMode::GlobVar; }
+    else if(InstCode<=CpuInstCode::DAGI4){ _InstSeqDecMode[i]=CpuDecMode::GlobInd; }
+    else{ _InstSeqDecMode[i]=CpuDecMode::LoclInd; }
+    return;
+  }
+
+  //Calculate instruction key
+  Key=((CpuLon)InstCode)<<8;
+  for(i=0;i<_MaxInstructionArgs;i++){
+    Key|=((CpuLon)((int)_InstSeqDecMode[i]-1))<<(2*i);
+    _InstSeqDecMode[i]=CpuDecMode::LoclVar;
+  }
+  Jump=_InstSeqBreak;
+  _InstSeqBreak=false;
+
+  //Count instruction, pair and triplet ending on this instruction
+  _InstSeqAdd(Key|(((CpuLon)1)<<INST_SEQ_LENSHIFT),1);
+  if(_InstSeqDepth>=1){
+    _InstSeqAdd(_InstSeqLast[1]|(Key<<INST_SEQ_KEYBITS)|(((CpuLon)Jump)<<INST_SEQ_JMPSHIFT)|(((CpuLon)2)<<INST_SEQ_LENSHIFT),1);
+  }
+  if(_InstSeqDepth>=2){
+    _InstSeqAdd(_InstSeqLast[0]|(_InstSeqLast[1]<<INST_SEQ_KEYBITS)|(Key<<(2*INST_SEQ_KEYBITS))
+    |(((CpuLon)_InstSeqJump)<<INST_SEQ_JMPSHIFT)|(((CpuLon)Jump)<<(INST_SEQ_JMPSHIFT+1))|(((CpuLon)3)<<INST_SEQ_LENSHIFT),1);
+  }
+
+  //Shift sequence
+  _InstSeqLast[0]=_InstSeqLast[1];
+  _InstSeqLast[1]=Key;
+  _InstSeqJump=Jump;
+  if(_InstSeqDepth<2){ _InstSeqDepth++; }
+
+}
+
+//Instruction sequence name
+//(instruction mnemonics joined by " + " when they are consecutive in code buffer or by " => " when control flow jumped,
+//decoder modes of arguments are shown only when some of them is not a local variable)
+String Runtime::_InstSeqName(CpuLon Key){
+  int i;
+  int j;
+  int Length;
+  int InstCode;
+  CpuLon InstKey;
+  String Modes;
+  String Name;
+  Length=(int)(Key>>INST_SEQ_LENSHIFT);
+  for(i=0;i<Length;i++){
+    InstKey=(Key>>(i*INST_SEQ_KEYBITS))&INST_SEQ_KEYMASK;
+    InstCode=(int)(InstKey>>8);
+    Modes="";
+    if((InstKey&0xFF)!=0){
+      for(j=0;j<_Inst[InstCode].ArgNr && j<_MaxInstructionArgs;j++){
+        Modes+=String(j!=0?",":"")+CpuDecModeName((CpuDecMode)(((InstKey>>(2*j))&3)+1));
+      }
+    }
+    if(i!=0){ Name+=(((Key>>(INST_SEQ_JMPSHIFT+i-1))&1)!=0?" => ":" + "); }
+    Name+=_Inst[InstCode].Mnemonic+(Modes.Length()!=0?"["+Modes+"]":"");
+  }
+  return Name;
+}
+
+//Print instruction sequence tables and write instruction sequence file
+bool Runtime::_PrintInstSequences(){
+
+  //Variables
+  int i;
+  int Hnd;
+  int Index;
+  int Length;
+  int Jumps;
+  int Distinct[4];
+  CpuLon Total[4];
+  CpuLon MaxCount;
+  String Headings;
+  Array<String> Rows;
+  Array<String> Lines;
+  Array<bool> Printed;
+  const char *Title[4]={"","Instruction","Instruction pair","Instruction triplet"};
+
+  //Calculate totals for each sequence length
+  for(Length=0;Length<=3;Length++){ Total[Length]=0; Distinct[Length]=0; }
+  for(i=0;i<_InstSeq.Length();i++){
+    if(_InstSeq[i].Key!=0){
+      Length=(int)(_InstSeq[i].Key>>INST_SEQ_LENSHIFT);
+      Total[Length]+=_InstSeq[i].Count;
+      Distinct[Length]++;
+    }
+  }
+
+  //Print most executed sequences for each length
+  Printed.Resize(_InstSeq.Length());
+  for(i=0;i<_InstSeq.Length();i++){ Printed[i]=false; }
+  for(Length=1;Length<=3;Length++){
+    Headings="Nr.~"+String(Title[Length])+"~Exec.Count~Share";
+    Rows.Reset();
+    do{
+      Index=-1;
+      MaxCount=0;
+      for(i=0;i<_InstSeq.Length();i++){
+        if(!Printed[i] && _InstSeq[i].Key!=0 && (int)(_InstSeq[i].Key>>INST_SEQ_LENSHIFT)==Length && _InstSeq[i].Count>MaxCount){ 
+          MaxCount=_InstSeq[i].Count; 
+          Index=i; 
+        }
+      }
+      if(Index==-1 || Rows.Length()>=INST_SEQ_MAX_ROWS){ break; }
+      Printed[Index]=true;
+      Rows.Add(ToString(Rows.Length()+1)+"~"+_InstSeqName(_InstSeq[Index].Key)+"~"+ToString(_InstSeq[Index].Count)+"~"
+      +ToString(((double)100)*(double)_InstSeq[Index].Count/(double)(Total[Length]!=0?Total[Length]:1),"%0.2f%%"));
+    }while(true);
+    if(Rows.Length()!=0){ _Stl->Console.PrintTable(Headings,Rows,"~","RLRR"); }
+  }
+  _Stl->Console.PrintLine("DS Instruction sequences: "+ToString(Distinct[1])+" instructions, "+ToString(Distinct[2])+" pairs, "+ToString(Distinct[3])+" triplets, "
+  +"all sequences written to "+String(_InstSeqFile));
+
+  //Write instruction sequence file (one line per distinct sequence with length, execution count, control flow jumps inside sequence and name)
+  Lines.Add("Length;Count;Jumps;Sequence\n");
+  for(i=0;i<_InstSeq.Length();i++){
+    if(_InstSeq[i].Key!=0){
+      Length=(int)(_InstSeq[i].Key>>INST_SEQ_LENSHIFT);
+      Jumps=(int)((_InstSeq[i].Key>>INST_SEQ_JMPSHIFT)&1)+(int)((_InstSeq[i].Key>>(INST_SEQ_JMPSHIFT+1))&1);
+      Lines.Add(ToString(Length)+";"+ToString(_InstSeq[i].Count)+";"+ToString(Jumps)+";"+_InstSeqName(_InstSeq[i].Key)+"\n");
+    }
+  }
+  if(!_Stl->FileSystem.GetHandler(Hnd)){ SysMessage(237).Print(String(_InstSeqFile)); return false; }
+  if(!_Stl->FileSystem.OpenForWrite(Hnd,String(_InstSeqFile))){ SysMessage(591).Print(String(_InstSeqFile),_Stl->LastError()); return false; }
+  if(!_Stl->FileSystem.WriteArray(Hnd,Lines)){ SysMessage(591).Print(String(_InstSeqFile),_Stl->LastError()); return false; }
+  if(!_Stl->FileSystem.CloseFile(Hnd)){ SysMessage(238).Print(String(_InstSeqFile),_Stl->LastError()); return false; }
+  if(!_Stl->FileSystem.FreeHandler(Hnd)){ SysMessage(239).Print(String(_InstSeqFile),_Stl->LastError()); return false; }
+
+  //Return code
+  return true;
+
+}
+
 //Print replication rule
 String Runtime::_RpRulePrint(int Rule){
   String RuleDesc;
@@ -5860,6 +8552,69 @@ bool _GetFdStatus(int Fd,int MaxTimeInSeconds,FdStatus &Status){
   return true;
 
 }
+
+//Stack guard page signal handler
+//(faults outside guard page are given back to previous handler by restoring it and returning, so faulting instruction is retried)
+void _StackGuardHandler(int Signal,siginfo_t *Info,void *Context){
+  char *Addr=(char *)Info->si_addr;
+  if(StackGuardPnt!=nullptr && Addr>=StackGuardPnt && Addr<StackGuardPnt+StackGuardSize){
+    siglongjmp(StackGuardJump,1);
+  }
+  sigaction(SIGSEGV,&StackGuardOldAction,nullptr);
+}
+
+//Install stack guard page signal handler
+//(handler is installed by first thread only, so previous handler saved is never our own one)
+bool _SetStackGuard(char *GuardPnt,CpuWrd GuardSize){
+  struct sigaction Action;
+  std::lock_guard<std::mutex> Lock(StackGuardMutex);
+  if(StackGuardUsers==0){
+    memset(&Action,0,sizeof(Action));
+    Action.sa_sigaction=&_StackGuardHandler;
+    Action.sa_flags=SA_SIGINFO;
+    sigemptyset(&Action.sa_mask);
+    if(sigaction(SIGSEGV,&Action,&StackGuardOldAction)==-1){ return false; }
+  }
+  StackGuardUsers++;
+  StackGuardPnt=GuardPnt;
+  StackGuardSize=GuardSize;
+  return true;
+}
+
+//Remove stack guard page signal handler
+//(previous handler is restored when last thread removes its guard page)
+void _ClearStackGuard(){
+  if(StackGuardPnt==nullptr){ return; }
+  std::lock_guard<std::mutex> Lock(StackGuardMutex);
+  StackGuardUsers--;
+  if(StackGuardUsers==0){ sigaction(SIGSEGV,&StackGuardOldAction,nullptr); }
+  StackGuardPnt=nullptr;
+  StackGuardSize=0;
+}
+
+//Profiler timer signal handler (points handler slots of control transfer instructions to sample handler)
+void _ProfilerHandler(int Signal){
+  if(ProfArmed || ProfSlotNr==0){ return; }
+  for(long i=0;i<ProfSlotNr;i++){
+    ProfSaved[i]=*ProfSlot[i];
+    *ProfSlot[i]=ProfHandler;
+  }
+  ProfArmed=1;
+}
+
+//Give original handlers back
+//(slots that were changed after signal, like handlers patched by decoder instructions, are kept)
+void _ProfilerDisarm(){
+  for(long i=0;i<ProfSlotNr;i++){
+    if(*ProfSlot[i]==ProfHandler){ *ProfSlot[i]=ProfSaved[i]; }
+  }
+  ProfArmed=0;
+}
+
+//Runtime server stop signal handler
+void _ServeStopHandler(int Signal){
+  ServeStop=1;
+}
 #endif
 
 //Execute external program
@@ -6409,6 +9164,8 @@ void Runtime::_DlCallHandler(CpuInt DlCallId){
   bool Result;
   void *VoidPtr;
   char **Error;
+  CpuWrd Length;
+  String DlStr;
 
   //Find physical function id if it is not located already
   if(_DynFun[DlCallId].PhyFunId==-1){
@@ -6489,7 +9246,15 @@ void Runtime::_DlCallHandler(CpuInt DlCallId){
     if(_DlParm[i].Update){
       if(_DlParm[i].IsString){
         DebugMessage(DebugLevel::SysDynLib,"Parameter "+ToString(i)+": Updating string block "+ToString(*_DlParm[i].Blk)+" from string \""+_DlParm[i].CharPtr+"\"");
-        _StC.SCOPY(_DlParm[i].Blk,_DlParm[i].CharPtr);
+        if(_DlParm[i].CharPtr==_Aux.CharPtr(*_DlParm[i].Blk)){
+          //String was updated in place, data is taken out first as re-allocation of block can release it (short strings go inline)
+          Length=strnlen(_DlParm[i].CharPtr,_Aux.GetCapacity(*_DlParm[i].Blk));
+          DlStr=String(_DlParm[i].CharPtr,Length);
+          _StC.SCOPY(_DlParm[i].Blk,DlStr.CharPnt(),Length);
+        }
+        else{
+          _StC.SCOPY(_DlParm[i].Blk,_DlParm[i].CharPtr);
+        }
       }
       else if(_DlParm[i].IsDynArray){
         DebugMessage(DebugLevel::SysDynLib,"Parameter "+ToString(i)+": Updating array block "+ToString(*_DlParm[i].Blk)+" for "+ToString(*_DlParm[i].DArray.len)+" elements");
@@ -6501,8 +9266,8 @@ void Runtime::_DlCallHandler(CpuInt DlCallId){
 }
 
 //Main
-bool CallRuntime(const String& BinaryFile,CpuWrd MemoryUnitKB,CpuWrd StartUnits,CpuWrd ChunkUnits,bool LockMemory,int BenchMark,
-                 const String& DynLibPath,const String& TmpLibPath,int ArgNr,char *Arg[],int ArgStart,RomFileBuffer *RomBuffer){
+bool CallRuntime(const String& BinaryFile,CpuWrd MemoryUnitKB,CpuWrd StartUnits,CpuWrd ChunkUnits,bool LockMemory,CpuWrd StackReserveKB,bool Jit,bool Aot,int BenchMark,bool Profiler,bool CallTimming,bool ImageCache,int Workers,const String& ServeSocket,
+                 const String& SnapshotFile,const String& RestoreFile,const String& DynLibPath,const String& TmpLibPath,int ArgNr,char *Arg[],int ArgStart,RomFileBuffer *RomBuffer){
 
   //On windows redirection command is seen as additional argument 
   //We remove it to align with linux and only if appears in last place, because we assume it was added by _ExecuteExternal()
@@ -6510,6 +9275,9 @@ bool CallRuntime(const String& BinaryFile,CpuWrd MemoryUnitKB,CpuWrd StartUnits,
   if(strcmp(Arg[ArgNr-1],REDIRCOMMAND)==0){ ArgNr--; }
   #endif
 
+  //Variables
+  bool Result;
+
   //Catch exceptions
   try{
 
@@ -6538,11 +9306,61 @@ bool CallRuntime(const String& BinaryFile,CpuWrd MemoryUnitKB,CpuWrd StartUnits,
       //Set dynamic library path
       Prog.SetLibPaths(DynLibPath,TmpLibPath);
 
+      //Set fixed stack reservation
+      Prog.SetStackReserve(StackReserveKB*1024);
+
+      //Set jit compiler (falls back to interpreter on platforms without jit)
+      if(Jit && !JitCompiler::Supported()){ SysMessage(581).Print(); }
+      Prog.SetJit(Jit && JitCompiler::Supported());
+
+      //Set call timming mode
+      Prog.SetCallTimming(CallTimming);
+
+      //Set worker threads for parallel walk loops
+      Prog.SetParallelWorkers(Workers);
+
+      //Set instruction sequence file (written next to executable on benchmark mode 4)
+      Prog.SetInstSequenceFile(_Stl->FileSystem.GetDirName(BinaryFile)+_Stl->FileSystem.GetFileNameNoExt(BinaryFile)+INST_SEQ_EXT);
+
+      //Set decoded code image cache (image is written next to executable, not used when running from rom buffer)
+      Prog.SetCodeImage(ImageCache && RomBuffer==nullptr,_Stl->FileSystem.GetDirName(BinaryFile)+_Stl->FileSystem.GetFileNameNoExt(BinaryFile)+CODE_IMAGE_EXT);
+
+      //Set sampling profiler (folded call stacks file is written next to executable)
+      #ifdef __WIN__
+      if(Profiler){ SysMessage(587).Print(); }
+      Prog.SetProfiler(false,"");
+      #else
+      Prog.SetProfiler(Profiler,_Stl->FileSystem.GetDirName(BinaryFile)+_Stl->FileSystem.GetFileNameNoExt(BinaryFile)+PROF_FOLDED_EXT);
+      #endif
+
+      //Load ahead-of-time translated native library
+      if(Aot){
+        if(!Prog.LoadNativeLibrary(BinaryFile)){ DebugClose(); return false; }
+      }
+
+      //Save process snapshot when initialization routines end or restore process state saved on snapshot
+      if(SnapshotFile.Length()!=0){
+        Prog.SetSnapshot(SnapshotFile);
+      }
+      if(RestoreFile.Length()!=0){
+        if(!Prog.RestoreSnapshot(RestoreFile)){ DebugClose(); return false; }
+      }
+
       //Set pointer to current runtime instance
       SetCurrentRuntime(&Prog);
 
-      //Execute program
-      if(!Prog.ExecProgram(System::CurrentProcessId(),BenchMark)){ DebugClose(); return false; }
+      //Serve execution requests (program stays loaded and a copy of the process runs it for each request)
+      if(ServeSocket.Length()!=0){
+        if(!Prog.ServeRequests(ServeSocket,BinaryFile,BenchMark)){ DebugClose(); return false; }
+      }
+
+      //Execute program (spawned tasks that program did not join are waited for before leaving)
+      else{
+        Result=Prog.ExecProgram(System::CurrentProcessId(),BenchMark);
+        TaskManager::Terminate();
+        AsyncIoManager::Terminate();
+        if(!Result){ DebugClose(); return false; }
+      }
 
       //Close all files and unload dynamic libraries
       Prog.CloseAllFiles();
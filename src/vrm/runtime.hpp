@@ -16,6 +16,56 @@ struct CallStack{
   CpuLon ScopeNr;       //Current scope nr
   CpuAgx AFBasePointer; //Fixed geometries base pointer
 };
+
+//Generator status
+enum class GeneratorStatus:char{
+  Running=1,   //Generator is running (or it returned when status is checked from consumer)
+  Suspended=2, //Generator yielded a value and waits to be resumed
+  Finished=3   //Generator returned
+};
+
+//Generator (stack frame of generator function stays parked on stack while it is suspended)
+struct GeneratorState{
+  GeneratorStatus State; //Generator status
+  CpuAdr FunAddress;     //Generator function address
+  CpuAdr ResumeAddress;  //Address on which execution continues when generator is resumed
+  CpuAdr BasePointer;    //Base pointer of generator stack frame
+  CpuLon StackBase;      //Stack size before generator was called (stack is released up to here when generator is freed)
+  long CallDepth;        //Call stack depth of consumer
+  CpuLon ScopeNr;        //Scope number of generator (negative, so memory blocks of suspended generators are not zombies)
+  CpuAgx AFBasePointer;  //Fixed geometries base pointer
+  int Resumer;           //Generator that resumed this one (-1 if it was not resumed by other generator)
+};
+
+//Parallel walk index range (indexes pending to be taken by a worker, other workers steal from range end)
+struct ParallelRange{
+  std::mutex Mutex; //Protects range limits
+  CpuWrd Beg;       //First pending index
+  CpuWrd End;       //End of range (not included)
+};
+
+//Parallel walk (shared by main thread and worker threads while a parallel walk loop runs)
+//(every worker runs loop on its own copy of current stack frame and of loop code, as decoder instructions patch code)
+struct ParallelWalk{
+  int WorkerNr;                       //Number of workers (main thread is worker zero)
+  CpuWrd Grain;                       //Number of indexes taken at once from a range
+  CpuAdr LoopIP;                      //Loop body begin address
+  CpuAdr ExitIP;                      //Loop exit address
+  CpuAdr MainBP;                      //Base pointer of main thread (worker n frame is at MainBP+n*FrameSize)
+  CpuWrd FrameSize;                   //Stack frame size
+  CpuAdr IndexVarAddr;                //Index variable address (zero if loop has no index variable)
+  CpuDecMode IndexVarMode;            //Index variable decoder mode
+  int Cfix;                           //Current function index
+  CpuLon CumulSc;                     //Acumulated scope number
+  std::atomic<bool> Abort;            //Workers stop taking indexes
+  ParallelRange *Range;               //Index range of each worker
+  Array<char *> Code;                 //Loop code copy of each worker (null for main thread)
+  Array<std::thread *> Threads;       //Worker threads
+  std::mutex Mutex;                   //Protects worker exception list
+  bool Failed;                        //Some worker ended with exceptions
+  CpuAdr FailedIP;                    //Instruction on which first failed worker stopped
+  Array<SysExceptionRecord> Excp;     //Worker exceptions
+};
     
 //Runtime class
 class Runtime{  
@@ -72,6 +122,29 @@ class Runtime{
       double Measured;
     };
 
+    //Instruction sequence table (benchmark mode 4)
+    struct InstSequenceTable{
+      CpuLon Key;           //Sequence key (zero when table slot is empty)
+      CpuLon Count;         //Execution count
+    };
+
+    //Function call timming table (call timming mode)
+    struct CallTimmingTable{
+      CpuAdr FunAddress;    //Function address
+      CpuLon CallCount;     //Number of calls
+      double InclTime;      //Inclusive time (nanoseconds)
+      double ExclTime;      //Exclusive time (nanoseconds)
+      int ActiveCount;      //Active calls (recursion level, inclusive time is only added on outermost call)
+    };
+
+    //Function call timming frame (call timming mode)
+    struct CallTimmingFrame{
+      int Index;            //Index in call timming table
+      CpuWrd Depth;         //Call stack depth before call
+      ClockPoint Start;     //Call start time
+      double ChildTime;     //Time spent on called functions (nanoseconds)
+    };
+
     //Dynamic library table
     struct DynLibDef{
       CpuChr DlName[_MaxIdLen+1];
@@ -117,6 +190,58 @@ class Runtime{
       FunPtrCloseDispatcher CloseDispatcher;
     };
 
+    //Native library entry point (layout must match table generated by ahead-of-time translator)
+    typedef CpuAdr (*AotFunction)(char *FramePnt,CpuAdr IP);
+    struct AotEntry{
+      CpuAdr Address;       //Code address
+      AotFunction Function; //Native function that executes from this address
+    };
+
+    //Decoded code image header (file written next to executable with option -ic)
+    struct CodeImageHeader{
+      char FileMark[4];   //File mark (DSCI)
+      char BuildNr[64];   //Runtime build number that decoded the code buffer
+      CpuLon CodeHash;    //Hash of code buffer before decoding
+      CpuLon CodeLength;  //Code buffer length
+      CpuInt Flags;       //Handler sources available when code buffer was decoded (jit, native library)
+      CpuLon HandlerNr;   //Records in handler table
+      CpuLon LoclVarNr;   //Records in local variable table
+    };
+
+    //Process snapshot header (file written with option -snapshot)
+    struct SnapshotHeader{
+      char FileMark[4];   //File mark (DSSN)
+      char BuildNr[64];   //Runtime build number that saved snapshot
+      CpuLon CodeHash;    //Hash of code buffer before decoding
+      CpuLon CodeLength;  //Code buffer length
+      CpuLon GlobLength;  //Global memory buffer length
+      CpuAdr ResumeAdr;   //Code address where execution resumes (end of initialization routines)
+      CpuLon ArgArrNr;    //Records in command line argument array table
+    };
+
+    //Decoded code image handler kinds (instructions not in handler table get their own instruction handler)
+    enum class CodeImgKind:CpuInt{
+      Inst=0,  //Own instruction handler (not stored on handler table)
+      Fused=1, //Fused instruction handler (index on fused handler table)
+      Spec=2,  //Operand-mode specialized handler (index on specialized handler table)
+      Jit=3,   //Native region entry point
+      Aot=4    //Native library entry point
+    };
+
+    //Decoded code image handler table
+    struct CodeImageHandler{
+      CpuAdr Address;   //Instruction address
+      CodeImgKind Kind; //Handler kind
+      CpuInt Index;     //Handler index
+    };
+
+    //Profiler folded call stack
+    struct ProfStack{
+      String Stack; //Function names from outermost to innermost frame separated by semicolons
+      long Count;   //Sample count
+      const String& SortKey() const { return Stack; }
+    };
+
     //Struct Debug symbol tables
     struct DbgSymTables{
       RamBuffer<DbgSymModule> Mod;    //Modules
@@ -145,7 +270,6 @@ class Runtime{
     RamBuffer<char> _Glob;            //Global memory buffer
     RamBuffer<char> _Stack;           //Stack memory buffer
     RamBuffer<char> _Code;            //Code memory buffer
-    RamBuffer<char> _ParmSt;          //Parameter stack
     RamBuffer<CallStack> _CallSt;     //Call stack
     RamBuffer<DlParmDef> _DlParm;     //Parameter definition (only for dynamic library calls)
     RamBuffer<void *> _DlVPtr;        //Parameter pointers (only for dynamic library calls)
@@ -166,8 +290,27 @@ class Runtime{
     int _ArgStart;                    //Option at which application options start
     char **_Arg;                      //Program command line arguments passed
     RomFileBuffer *_RomBuffer;        //Pointer to rombuffer
-    CpuLon _RomBuffReadNr;            //Rom buffer read counter
+    const char *_ExeImage;            //Executable file image (mapped executable file or rom buffer)
+    CpuWrd _ExeImageLen;              //Executable file image length
     DbgSymTables _DebugSym;           //Debug symbol tables
+    bool _DebugSymLoaded;             //Debug symbol tables were loaded (they are loaded on first use)
+    char _DebugSymFile[FILEPATHLEN+1];//Executable file debug symbol tables are loaded from
+    CpuWrd _StackReserve;             //Fixed stack reservation in bytes (zero means growable stack)
+    bool _JitEnabled;                 //Translate code buffer to native code before execution
+    JitCompiler _Jit;                 //Jit compiler instance
+    void *_AotHandler;                //Native library handler (ahead-of-time translated code)
+    Array<AotFunction> _AotEntry;     //Native function for each code address (null if not an entry point)
+    bool _ProfEnabled;                //Sampling profiler enabled
+    char _ProfFile[FILEPATHLEN+1];    //Profiler folded call stacks output file
+    Buffer _ProfSlot;                 //Profiler handler slot pointers (one per instruction)
+    Buffer _ProfSaved;                //Profiler saved handlers while sample is armed
+    Array<CpuAdr> _ProfSample;        //Profiler samples (frame count followed by code addresses from innermost to outermost frame)
+    long _ProfSampleNr;               //Profiler sample count
+    int _ParWorkers;                  //Worker threads for parallel walk loops (one means parallel walks run sequentially)
+    RamBuffer<GeneratorState> _Gen;   //Live generators (handler is table index, generators are freed in reverse order of creation)
+    int _GenCurrent;                  //Generator that is currently running (-1 if none)
+    bool _GenStart;                   //Next function call starts generator created by last GNNEW
+    CpuLon _GenSerial;                //Generator serial number (makes generator scope numbers unique)
 
     //Benchmark variables
     CpuLon _InstCount;                                             //Instruction execution counter
@@ -175,12 +318,52 @@ class Runtime{
     std::chrono::time_point<std::chrono::steady_clock> _ProgStart; //Program start time
     std::chrono::time_point<std::chrono::steady_clock> _ProgEnd;   //Program end time
 
+    //Instruction sequence variables (benchmark mode 4)
+    Array<InstSequenceTable> _InstSeq;                             //Instruction sequence hash table
+    int _InstSeqUsed;                                              //Used slots in instruction sequence hash table
+    CpuLon _InstSeqLast[2];                                        //Instruction keys of last two accounted instructions
+    int _InstSeqDepth;                                             //Accounted instructions on current sequence (up to 3)
+    bool _InstSeqJump;                                             //Control flow jumped between last two accounted instructions
+    bool _InstSeqBreak;                                            //Control flow jumped since last accounted instruction
+    CpuAdr _InstSeqNextIP;                                         //Address following last executed instruction
+    CpuDecMode _InstSeqDecMode[_MaxInstructionArgs];               //Decoder modes set by decoder instructions for next instruction
+    char _InstSeqFile[FILEPATHLEN+1];                              //Instruction sequence output file
+
+    //Decoded code image variables
+    bool _CodeImgEnabled;                                          //Decoded code image cache enabled
+    bool _CodeImgLoaded;                                           //Decoded code image loaded and valid for code buffer
+    bool _CodeImgRecord;                                           //Record decoding results to save decoded code image
+    CpuLon _CodeImgHash;                                           //Hash of code buffer before decoding
+    char _CodeImgFile[FILEPATHLEN+1];                              //Decoded code image file
+    Array<CodeImageHandler> _CodeImgHnd;                           //Handler table (instructions not using its own instruction handler)
+    Array<CpuAdr> _CodeImgLoclVar;                                 //Code addresses of local variable arguments
+
+    //Process snapshot variables
+    bool _SnapSave;                                                //Save snapshot when initialization routines end
+    bool _SnapRestored;                                            //Process state was restored from snapshot
+    char _SnapFile[FILEPATHLEN+1];                                 //Snapshot file
+    CpuLon _SnapCodeHash;                                          //Hash of code buffer before decoding
+    CpuAdr _SnapResumeAdr;                                         //Code address where restored execution resumes
+    Array<CpuMbl> _SnapArgArr;                                     //Arrays holding command line arguments (refreshed on each restored execution)
+
+    //Runtime server variables
+    bool _ServeInit;                                               //Server runs initialization routines (execution stops when they end)
+    bool _CodeDecoded;                                             //Code buffer is already decoded (requests resume on decoded code)
+
+    //Call timming variables
+    bool _CallTimEnabled;                                          //Call timming mode enabled
+    Array<int> _CallTimIndex;                                      //Call timming table index for each code address (-1 if function not called yet)
+    Array<CallTimmingTable> _CallTim;                              //Call timming table
+    Array<CallTimmingFrame> _CallTimSt;                            //Call timming frames (one for each active call)
+
     //Private functions
     int _GetLibraryId(char *DlName);
-    bool _OpenExecutable(const String& FileName,int& Hnd);
-    bool _CloseExecutable(const String& FileName,int Hnd);
-    bool _ReadExecutable(const String& FileName,int Hnd,const char *Part,int Index,int SubIndex,Buffer& Buff,long Length);
-    bool _ReadExecutable(const String& FileName,int Hnd,const char *Part,int Index,int SubIndex,char *Pnt,long Length);
+    bool _MapExecutable(const String& FileName);
+    void _UnmapExecutable();
+    bool _ExecutableSection(const String& FileName,BinSection Section,CpuWrd RecLength,CpuWrd RecNr,const char **Pnt);
+    bool _LoadExecutable(const String& FileName,int ProcessId,int ArgNr,char *Arg[],int ArgStart);
+    bool _LoadDebugSymbols();
+    template <typename datatype> bool _LoadDebugSymTable(const String& FileName,BinSection Section,RamBuffer<datatype>& Table,CpuInt RecNr,const char *TableName);
     String _DlCallStr(CpuInt DlCallId);
     bool _OpenDynLibrary(const String& LibFile,void **Handler,DlFuncPtr *FuncPtr);
     bool _ScanDynLibrary(void *Handler,const String& LibFile,DlFuncPtr *FuncPtr);
@@ -196,9 +379,19 @@ class Runtime{
     bool _InnerBlockInitialization(CpuWrd Offset,bool ForString,bool ForArray,int DimNr,CpuWrd CellSize);
     bool _ExecuteExternal(CpuMbl ExecutableFile,CpuMbl Arguments,CpuMbl *SdOut,CpuMbl *StdErr,bool Redirect,bool ArgIsArray);
     void _RunProgram(int BenchMark,CpuAdr& LastIP);
+    bool _ParallelWalkEnabled(int BenchMark,CpuWrd Elements);
+    bool _ParallelWalkStart(CpuAdr LoopIP,CpuAdr ExitIP,CpuAdr MainBP,CpuAdr IndexVarAddr,CpuDecMode IndexVarMode,CpuWrd Elements,int Cfix,CpuLon CumulSc);
+    bool _ParallelWalkNext();
+    bool _ParallelWalkEnd(bool Abort,CpuAdr *NextIP);
+    void _ParallelWalkWorker(ParallelWalk *Walk,int Worker);
     double _MinimunClockTick();
     String _GetScaledTime(double NanoSecs);
     void _PrintBenchMark(int BenchMark);
+    void _InstSeqInit();
+    void _InstSeqAdd(CpuLon Key,CpuLon Count);
+    void _InstSeqCount(CpuAdr IP,CpuInstCode InstCode);
+    String _InstSeqName(CpuLon Key);
+    bool _PrintInstSequences();
     String _ToStringCpuBol(CpuBol Arg);
     String _ToStringCpuChr(CpuChr Arg);
     String _ToStringCpuShr(CpuShr Arg);
@@ -213,8 +406,18 @@ class Runtime{
     String _ToStringCpuDat(CpuDat Arg);
     void _InnerRefIndirection(char *GlobPnt,char *StackPnt,CpuRef Ref,char **Ptr,CpuMbl &Scope);
     bool _RefIndirection(char *GlobPnt,char *StackPnt,CpuRef Ref,char **Ptr,CpuMbl &Scope);
-    bool _DecodeInstructionCodes(int BenchMark,const void **InstAddress,const void *FakeInstHandler,char *CodePtr);
+    bool _DecodeInstructionCodes(int BenchMark,const void **InstAddress,const void **FusedAddress,const void **SpecAddress,const void *JitHandler,const void *AotHandler,const void *FakeInstHandler,char *CodePtr);
+    int _GetSpecIndex(char *CodePtr,CpuAdr IP);
     bool _DecodeLocalVariables(bool FirstTime,char *CodePtr,const char *OldStackPtr,const char *NewStackPtr);
+    CpuInt _CodeImageFlags();
+    bool _LoadCodeImage();
+    bool _ApplyCodeImageLocals(char *CodePtr,const char *NewStackPtr);
+    void _ApplyCodeImageHandlers(const void **InstAddress,const void **FusedAddress,const void **SpecAddress,const void *JitHandler,const void *AotHandler,char *CodePtr);
+    void _SaveCodeImage();
+    bool _SaveSnapshot(CpuAdr ResumeAdr,String& Error);
+    void _FindSnapshotArgs();
+    bool _RefreshSnapshotArgs();
+    bool _KeepInitState(CpuAdr ResumeAdr,String& Error);
     String _GetFunctionDebugName(int FunIndex);
     bool _DumpDisassembledLines(CpuAdr FuncAddress,const String& FuncDebugName,const Array<DisAsmLine>& Lines);
     bool _DisassembleLine(char *CodePtr,char *StackPtr,CpuAdr IP,CpuDecMode DecMode1,CpuDecMode DecMode2,CpuDecMode DecMode3,CpuDecMode DecMode4,CpuAdr Adv1,CpuAdr Adv2,CpuAdr Adv3,CpuAdr Adv4,int CurrFunIndex,bool RuntimeMode,String& Hex, String& Asm,String& Symbols);
@@ -222,6 +425,15 @@ class Runtime{
     String _AddressInfoLine(CpuAdr CodeAddress);
     String _AddressInfo(CpuAdr CodeAddress,bool& MainFrame);
     void _PrintCallStack(CpuAdr IP);
+    bool _StartProfiler(const void *SampleHandler);
+    void _StopProfiler();
+    void _ProfilerSample(CpuAdr IP);
+    bool _PrintProfile();
+    void _CallTimEnter(CpuAdr FunAddress);
+    void _CallTimLeave(bool Force=false);
+    void _PrintCallTimming();
+    bool _JitCompile(int BenchMark);
+    int _ServeRequest(int Conn,const String& BinaryFile,int BenchMark);
 
     //System call pointer table
     const void *_SysCallFunPtr[_SystemCallNr];
@@ -236,14 +448,25 @@ class Runtime{
     int GetCurrentProcess();
     bool LoadProgram(const String& FileName,int ProcessId,int ArgNr,char *Arg[],int ArgStart);
     bool ExecProgram(int ProcessId,int BenchMark);
+    bool ServeRequests(const String& SocketFile,const String& BinaryFile,int BenchMark);
     bool Disassemble();
     void SetLibPaths(const String& DynLibPath,const String& TmpLibPath);
     void CloseAllFiles();
     void UnloadLibraries();
     void SetRomBuffer(RomFileBuffer *Ptr);
+    void SetStackReserve(CpuWrd Bytes);
+    void SetJit(bool Enable);
+    bool LoadNativeLibrary(const String& BinaryFile);
+    void SetProfiler(bool Enable,const String& FoldedFile);
+    void SetCallTimming(bool Enable);
+    void SetInstSequenceFile(const String& SeqFile);
+    void SetCodeImage(bool Enable,const String& ImageFile);
+    void SetParallelWorkers(int Workers);
+    void SetSnapshot(const String& SnapshotFile);
+    bool RestoreSnapshot(const String& SnapshotFile);
 
     //Constructor / Destructor
-    Runtime(){};
+    Runtime(){ _ExeImage=nullptr; _ExeImageLen=0; _DebugSymLoaded=false; _DebugSymFile[0]=0; _StackReserve=0; _JitEnabled=false; _AotHandler=nullptr; _ProfEnabled=false; _ProfFile[0]=0; _ProfSampleNr=0; _CallTimEnabled=false; _InstSeqFile[0]=0; _CodeImgEnabled=false; _CodeImgLoaded=false; _CodeImgRecord=false; _CodeImgHash=0; _CodeImgFile[0]=0; _ParWorkers=1; _GenCurrent=-1; _GenStart=false; _GenSerial=0; _SnapSave=false; _SnapRestored=false; _SnapFile[0]=0; _SnapCodeHash=0; _SnapResumeAdr=0; _ServeInit=false; _CodeDecoded=false; };
     ~Runtime(){};
 
 };
@@ -252,8 +475,11 @@ class Runtime{
 bool CallDisassembleFile(const String& BinaryFile,CpuWrd MemoryUnitKB,CpuWrd StartUnits,CpuWrd ChunkUnits,int ArgNr,char *Arg[],int ArgStart);
 
 //Runtime entry point
-bool CallRuntime(const String& BinaryFile,CpuWrd MemoryUnitKB,CpuWrd StartUnits,CpuWrd ChunkUnits,bool LockMemory,int BenchMark,
-                 const String& DynLibPath,const String& TmpLibPath,int ArgNr,char *Arg[],int ArgStart,RomFileBuffer *RomBuffer);
+bool CallRuntime(const String& BinaryFile,CpuWrd MemoryUnitKB,CpuWrd StartUnits,CpuWrd ChunkUnits,bool LockMemory,CpuWrd StackReserveKB,bool Jit,bool Aot,int BenchMark,bool Profiler,bool CallTimming,bool ImageCache,int Workers,const String& ServeSocket,
+                 const String& SnapshotFile,const String& RestoreFile,const String& DynLibPath,const String& TmpLibPath,int ArgNr,char *Arg[],int ArgStart,RomFileBuffer *RomBuffer);
+
+//Set current runtime instance (kept for each thread that runs a process)
+void SetCurrentRuntime(Runtime *Rt);
 
 //Debug message interface
 void LibDebugMessage(char *Msg);
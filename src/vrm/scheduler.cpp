@@ -0,0 +1,276 @@
+//scheduler.cpp: Multi-process scheduler
+#include "bas/basedefs.hpp"
+#include "bas/allocator.hpp"
+#include "bas/array.hpp"
+#include "bas/sortedarray.hpp"
+#include "bas/stack.hpp"
+#include "bas/queue.hpp"
+#include "bas/buffer.hpp"
+#include "bas/string.hpp"
+#include "sys/sysdefs.hpp"
+#include "sys/system.hpp"
+#include "sys/stl.hpp"
+#include "sys/msgout.hpp"
+#include "vrm/pool.hpp"
+#include "vrm/memman.hpp"
+#include "vrm/auxmem.hpp"
+#include "vrm/strcomp.hpp"
+#include "vrm/arrcomp.hpp"
+#include "vrm/jit.hpp"
+#include "vrm/runtime.hpp"
+#include "vrm/tasks.hpp"
+#include "vrm/asyncio.hpp"
+#include "vrm/scheduler.hpp"
+
+//Batch file comment mark
+#define BATCH_COMMENT '#'
+
+//Load jobs from batch file
+//(one job per line with executable file and its arguments separated by blanks, empty lines and lines starting by # are ignored)
+bool Scheduler::LoadBatch(const String& BatchFile){
+
+  //Variables
+  int i;
+  int Hnd;
+  String Line;
+  Array<String> Lines;
+  Array<String> Parts;
+  SchedulerJob Job;
+
+  //Read batch file
+  if(!_Stl->FileSystem.FileExists(BatchFile)){ SysMessage(600).Print(BatchFile,"file does not exist"); return false; }
+  if(!_Stl->FileSystem.GetHandler(Hnd)){ SysMessage(237).Print(BatchFile); return false; }
+  if(!_Stl->FileSystem.OpenForRead(Hnd,BatchFile)){ SysMessage(600).Print(BatchFile,_Stl->LastError()); return false; }
+  if(!_Stl->FileSystem.FullRead(Hnd,Lines)){ SysMessage(600).Print(BatchFile,_Stl->LastError()); return false; }
+  if(!_Stl->FileSystem.CloseFile(Hnd)){ SysMessage(238).Print(BatchFile,_Stl->LastError()); return false; }
+  if(!_Stl->FileSystem.FreeHandler(Hnd)){ SysMessage(239).Print(BatchFile,_Stl->LastError()); return false; }
+
+  //Parse jobs
+  _Job.Reset();
+  for(i=0;i<Lines.Length();i++){
+    Line=Lines[i].TrimRight('\r').Trim();
+    if(Line.Length()==0 || Line[0]==BATCH_COMMENT){ continue; }
+    Parts=Line.Split(" ");
+    Job.Arg.Reset();
+    for(int j=0;j<Parts.Length();j++){
+      if(Parts[j].Length()!=0){ Job.Arg.Add(Parts[j]); }
+    }
+    if(_Stl->FileSystem.GetFileExtension(Job.Arg[0])!=EXECUTABLE_EXT){
+      SysMessage(601).Print(ToString(i+1),BatchFile,EXECUTABLE_EXT);
+      return false;
+    }
+    Job.BinaryFile=Job.Arg[0];
+    Job.LineNr=i+1;
+    Job.ProcessId=System::NewProcessId();
+    Job.Worker=-1;
+    Job.Loaded=false;
+    Job.Result=false;
+    Job.LoadNSec=0;
+    Job.ExecNSec=0;
+    _Job.Add(Job);
+  }
+  if(_Job.Length()==0){ SysMessage(600).Print(BatchFile,"no jobs found"); return false; }
+
+  //Debug message
+  DebugMessage(DebugLevel::VrmRuntime,"Scheduler loaded "+ToString(_Job.Length())+" jobs from batch file "+BatchFile);
+
+  //Return code
+  return true;
+
+}
+
+//Set jit compiler
+void Scheduler::SetJit(bool Enable){
+  _Jit=Enable;
+}
+
+//Set dynamic library paths
+void Scheduler::SetLibPaths(const String& DynLibPath,const String& TmpLibPath){
+  _DynLibPath=DynLibPath;
+  _TmpLibPath=TmpLibPath;
+}
+
+//Run all jobs
+//(primary memory manager and console are shared by all worker threads while batch runs)
+void Scheduler::Run(int WorkerNr){
+
+  //Variables
+  int i;
+  ClockPoint Start;
+  Array<std::thread *> Threads;
+
+  //Number of worker threads (never more than jobs)
+  if(WorkerNr==0){ WorkerNr=std::max((int)std::thread::hardware_concurrency(),1); }
+  _WorkerNr=std::min(WorkerNr,_Job.Length());
+  DebugMessage(DebugLevel::VrmRuntime,"Scheduler starts "+ToString(_WorkerNr)+" worker threads for "+ToString(_Job.Length())+" jobs");
+
+  //Start workers and wait for them
+  Start=ClockGet();
+  _NextJob=0;
+  MemoryManager::SetThreadSafe(true);
+  _Stl->Console.SetShared(true);
+  for(i=0;i<_WorkerNr;i++){ Threads.Add(new std::thread(&Scheduler::_Worker,this,i)); }
+  for(i=0;i<Threads.Length();i++){ Threads[i]->join(); delete Threads[i]; }
+  TaskManager::Terminate();
+  AsyncIoManager::Terminate();
+  _Stl->Console.SetShared(false);
+  MemoryManager::SetThreadSafe(false);
+  _WallNSec=ClockIntervalNSec(ClockGet(),Start);
+
+}
+
+//Worker thread main loop
+void Scheduler::_Worker(int WorkerId){
+  int JobIndex;
+  while((JobIndex=_NextJob.fetch_add(1))<_Job.Length()){
+    _RunJob(_Job[JobIndex],WorkerId);
+  }
+}
+
+//Run one job on current thread
+void Scheduler::_RunJob(SchedulerJob& Job,int WorkerId){
+
+  //Variables
+  int i;
+  ClockPoint Start;
+  Array<char *> ArgPtr;
+
+  //Job process becomes current process of this thread
+  Job.Worker=WorkerId;
+  System::PushProcessId(Job.ProcessId);
+  System::ExceptionReset();
+  DebugMessage(DebugLevel::VrmRuntime,"Scheduler worker "+ToString(WorkerId)+" starts job "+ToString(Job.ProcessId)+" ("+Job.BinaryFile+")");
+
+  //Program arguments
+  for(i=0;i<Job.Arg.Length();i++){ ArgPtr.Add(Job.Arg[i].CharPnt()); }
+
+  //Catch exceptions
+  try{
+
+    //Open scope here to force program destructor being called at scope end
+    {
+
+      //Variables
+      Runtime Prog;
+
+      //Load program
+      Start=ClockGet();
+      Prog.SetRomBuffer(nullptr);
+      Job.Loaded=Prog.LoadProgram(Job.BinaryFile,Job.ProcessId,ArgPtr.Length(),&ArgPtr[0],0);
+      Job.LoadNSec=ClockIntervalNSec(ClockGet(),Start);
+
+      //Execute program
+      if(Job.Loaded){
+        Prog.SetLibPaths(_DynLibPath,_TmpLibPath);
+        Prog.SetJit(_Jit);
+        SetCurrentRuntime(&Prog);
+        Start=ClockGet();
+        Job.Result=Prog.ExecProgram(Job.ProcessId,0);
+        Job.ExecNSec=ClockIntervalNSec(ClockGet(),Start);
+        Prog.CloseAllFiles();
+        Prog.UnloadLibraries();
+        SetCurrentRuntime(nullptr);
+      }
+
+    }
+
+  }
+
+  //Exception handler
+  catch(BaseException& Ex){
+    _Stl->Console.PrintLine(Ex.Description());
+    Job.Result=false;
+  }
+
+  //Release process
+  System::PopProcessId();
+
+}
+
+//Number of failed jobs
+int Scheduler::FailedJobs() const{
+  int Failed=0;
+  for(int i=0;i<_Job.Length();i++){ if(!_Job[i].Result){ Failed++; } }
+  return Failed;
+}
+
+//Print job statistics
+void Scheduler::PrintStats(){
+
+  //Variables
+  int i;
+  double ExecNSec;
+  String Headings;
+  Array<String> Rows;
+
+  //Job table
+  ExecNSec=0;
+  Headings="Job~Line~Executable file~Worker~Load time~Exec time~Result";
+  for(i=0;i<_Job.Length();i++){
+    ExecNSec+=_Job[i].LoadNSec+_Job[i].ExecNSec;
+    Rows.Add(ToString(_Job[i].ProcessId)+"~"+ToString(_Job[i].LineNr)+"~"+_Job[i].BinaryFile+"~"+ToString(_Job[i].Worker)+"~"
+    +ToString(_Job[i].LoadNSec/1000000.0,"%0.2fms")+"~"+ToString(_Job[i].ExecNSec/1000000.0,"%0.2fms")+"~"
+    +(!_Job[i].Loaded?"load error":(_Job[i].Result?"ok":"error")));
+  }
+  _Stl->Console.PrintTable(Headings,Rows,"~","RRLRRRL");
+
+  //Summary
+  _Stl->Console.PrintLine("DS Scheduler: "+ToString(_Job.Length())+" jobs ("+ToString(FailedJobs())+" failed) on "+ToString(_WorkerNr)+" workers, "
+  +"elapsed time: "+ToString(_WallNSec/1000000.0,"%0.2fms")+", job time: "+ToString(ExecNSec/1000000.0,"%0.2fms")
+  +", speedup: "+ToString(ExecNSec/(_WallNSec!=0?_WallNSec:1),"%0.2fx"));
+
+}
+
+//Batch execution entry point
+bool CallScheduler(const String& BatchFile,int WorkerNr,CpuWrd MemoryUnitKB,CpuWrd StartUnits,CpuWrd ChunkUnits,bool LockMemory,bool Jit,const String& DynLibPath,const String& TmpLibPath){
+
+  //Variables
+  bool Result;
+
+  //Catch exceptions
+  try{
+
+    //Init memory manager (shared by all processes)
+    if(!MemoryManager::Init(StartUnits,ChunkUnits,MemoryUnitKB*1024,LockMemory)){
+      SysMessage(312).Print();
+      return false;
+    }
+
+    //Open scope here to force scheduler destructor being called at scope end
+    {
+
+      //Variables
+      Scheduler Sched;
+
+      //Load jobs
+      if(!Sched.LoadBatch(BatchFile)){ MemoryManager::Terminate(); return false; }
+
+      //Set jit compiler (falls back to interpreter on platforms without jit)
+      if(Jit && !JitCompiler::Supported()){ SysMessage(581).Print(); }
+      Sched.SetJit(Jit && JitCompiler::Supported());
+
+      //Set dynamic library path
+      Sched.SetLibPaths(DynLibPath,TmpLibPath);
+
+      //Run jobs and print statistics
+      Sched.Run(WorkerNr);
+      Sched.PrintStats();
+      Result=(Sched.FailedJobs()==0);
+
+    }
+
+    //Terminate memory manager
+    MemoryManager::Terminate();
+
+  }
+
+  //Exception handler
+  catch(BaseException& Ex){
+    _Stl->Console.PrintLine(Ex.Description());
+    return false;
+  }
+
+  //Return code
+  return Result;
+
+}
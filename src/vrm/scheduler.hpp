@@ -0,0 +1,61 @@
+//scheduler.hpp: Multi-process scheduler
+
+//Wrap include
+#ifndef _SCHEDULER_HPP
+#define _SCHEDULER_HPP
+
+//Scheduler job (one execution of an executable file)
+struct SchedulerJob{
+  String BinaryFile;   //Executable file
+  Array<String> Arg;   //Program arguments (first one is executable file as when it is run from command line)
+  int LineNr;          //Line number in batch file
+  int ProcessId;       //Process id assigned to job
+  int Worker;          //Worker thread that executed job
+  bool Loaded;         //Executable file was loaded
+  bool Result;         //Program ended without errors
+  double LoadNSec;     //Load time in nanoseconds
+  double ExecNSec;     //Execution time in nanoseconds
+};
+
+//Multi-process scheduler class
+//(runs jobs concurrently on a pool of worker threads, every job is a process with its own runtime instance and memory
+//managers, worker threads take next pending job when they finish the previous one)
+class Scheduler{
+
+  //Private members
+  private:
+
+    //Internal data
+    Array<SchedulerJob> _Job;     //Jobs
+    std::atomic<int> _NextJob;    //Next pending job
+    int _WorkerNr;                //Number of worker threads
+    bool _Jit;                    //Jit compiler enabled
+    String _DynLibPath;           //Dynamic library path
+    String _TmpLibPath;           //Temporary dynamic library path
+    double _WallNSec;             //Elapsed time of whole batch
+
+    //Internal methods
+    void _Worker(int WorkerId);
+    void _RunJob(SchedulerJob& Job,int WorkerId);
+
+  //Public members
+  public:
+
+    //Methods
+    bool LoadBatch(const String& BatchFile);
+    void Run(int WorkerNr);
+    void PrintStats();
+    int FailedJobs() const;
+    void SetJit(bool Enable);
+    void SetLibPaths(const String& DynLibPath,const String& TmpLibPath);
+
+    //Constructor / Destructor
+    Scheduler(){ _NextJob=0; _WorkerNr=0; _Jit=false; _WallNSec=0; }
+    ~Scheduler(){}
+
+};
+
+//Batch execution entry point
+bool CallScheduler(const String& BatchFile,int WorkerNr,CpuWrd MemoryUnitKB,CpuWrd StartUnits,CpuWrd ChunkUnits,bool LockMemory,bool Jit,const String& DynLibPath,const String& TmpLibPath);
+
+#endif
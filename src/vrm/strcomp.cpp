@@ -136,6 +136,14 @@ bool StringComputer::SCOPY(CpuMbl *Des,CpuMbl Src){
   //Check inputs
   if(!IsValid(Src,true)){ return false; }
   
+  //Share data of source string (short strings are inline and they are copied, strings detached by SUNSH are never shared)
+  if(*Des!=Src && _Aux->IsShareable(Src) && !(IsAllocated(*Des) && _Aux->IsDetached(*Des))){
+    if(IsAllocated(*Des)){ _Aux->Clear(*Des); }
+    else{ if(!_EmptyAlloc(Des)){ return false; } }
+    _Aux->Share(*Des,Src);
+    return true;
+  }
+
   //Get source length
   Length=_Aux->GetLen(Src);
 
@@ -180,15 +188,9 @@ bool StringComputer::SSWCP(CpuMbl *Des,CpuMbl Src){
     if(!_EmptyAlloc(Des)){ return false; } 
   }
 
-  //Set pointer and length from source string
-  _Aux->SetPtr(*Des,_Aux->CharPtr(Src));
-  _Aux->SetLen(*Des,_Aux->GetLen(Src));
-  _Aux->SetSize(*Des,_Aux->GetSize(Src));
-
-  //Free resources
+  //Move string data from source string (source string is released)
   if(*Des!=Src){
-    _Aux->SetPtr(Src,nullptr);
-    _Aux->Free(Src);
+    _Aux->Move(*Des,Src);
   }
 
   //Get result
@@ -362,7 +364,7 @@ bool StringComputer::SAPPN(CpuMbl *Des,char *Src){
 
   //Prepare destination string
   if(IsAllocated(*Des)){
-    if(!_Allocate(*Des,Len)){ return false; }
+    if(!_Extend(*Des,Len)){ return false; }
   }
   else{ 
     if(!_NewString(Des,Len)){ return false; } 
@@ -400,7 +402,7 @@ bool StringComputer::SAPPN(CpuMbl *Des,char *Src,CpuWrd Length){
 
   //Prepare destination string
   if(IsAllocated(*Des)){
-    if(!_Allocate(*Des,Len)){ return false; }
+    if(!_Extend(*Des,Len)){ return false; }
   }
   else{ 
     if(!_NewString(Des,Len)){ return false; } 
@@ -439,7 +441,7 @@ bool StringComputer::SAPPN(CpuMbl *Des,CpuMbl Str){
 
   //Prepare destination string
   if(IsAllocated(*Des)){
-    if(!_Allocate(*Des,Len)){ return false; }
+    if(!_Extend(*Des,Len)){ return false; }
   }
   else{ 
     if(!_NewString(Des,Len)){ return false; } 
@@ -681,8 +683,12 @@ bool StringComputer::SSUBS(CpuMbl *Res,CpuMbl Str,CpuMbl Old,CpuMbl New){
     return false; 
   }
 
-  //Init return string
+  //Init return string (replacements are done in place, so it cannot share data of source string)
   if(!SCOPY(Res,Str)){ return false; }
+  if(!_Aux->Unshare(_ScopeId,_ScopeNr,*Res)){
+    System::Throw(SysExceptionCode::StringAllocationError,ToString(_Aux->GetLen(*Res))); 
+    return false; 
+  }
   
   //Exit if Old string is empty
   if(_Aux->GetLen(Old)==0){ return true; }
@@ -699,7 +705,7 @@ bool StringComputer::SSUBS(CpuMbl *Res,CpuMbl Str,CpuMbl Old,CpuMbl New){
     if(!SFIND(&Position,*Res,Old,SearchPos)){ return false; }
     if(Position==-1){ break; }
     Length=_Aux->GetLen(*Res)-LenOld+LenNew;
-    if(Length>_Aux->GetLen(*Res)){ if(!_Allocate(*Res,Length)){ return false; } }
+    if(Length>_Aux->GetLen(*Res)){ if(!_Extend(*Res,Length)){ return false; } }
     PtrRes=_Aux->CharPtr(*Res);
     MemMove(PtrRes+Position+LenNew,PtrRes+Position+LenOld,Length-Position-LenNew+1);
     MemCpy(PtrRes+Position,PtrNew,LenNew);
@@ -1226,7 +1232,41 @@ bool StringComputer::SISFL(CpuBol *Res,CpuMbl Str){
   return true;
 }
 
-//String to boolean conversion
+//String operation SRESV (reserves memory for given length, string does not change)
+bool StringComputer::SRESV(CpuMbl Str,CpuWrd Length){
+  if(!IsValid(Str,true)){ return false; }
+  if(Length<=0){ return true; }
+  if(!_Aux->Reserve(_ScopeId,_ScopeNr,Str,Length+1)){ 
+    System::Throw(SysExceptionCode::StringAllocationError,ToString(Length)); 
+    return false; 
+  }
+  return true;
+}
+
+//String operation SSHRK (releases memory reserved beyond string length)
+bool StringComputer::SSHRK(CpuMbl Str){
+  if(!IsValid(Str,true)){ return false; }
+  if(!_Aux->Shrink(_ScopeId,_ScopeNr,Str)){ 
+    System::Throw(SysExceptionCode::StringAllocationError,ToString(_Aux->GetLen(Str))); 
+    return false; 
+  }
+  return true;
+}
+
+//String operation SUNSH (string referenced gets its own data before it is written through char reference)
+//(reference is resolved on every access, so string must not share its data again while reference is alive)
+bool StringComputer::SUNSH(CpuRef Ref){
+  CpuMbl Str;
+  if((Ref.Id&BLOCKMASK80)==0){ return true; }
+  Str=Ref.Id&(~BLOCKMASK80);
+  if(!IsValid(Str,true)){ return false; }
+  if(!_Aux->Detach(_ScopeId,_ScopeNr,Str)){ 
+    System::Throw(SysExceptionCode::StringAllocationError,ToString(_Aux->GetLen(Str))); 
+    return false; 
+  }
+  return true;
+}
+
 bool StringComputer::SST2B(CpuBol *Res,CpuMbl Str){
   if(!IsValid(Str,true)){ return false; }
   if(strcmp(_Aux->CharPtr(Str),"1")==0 
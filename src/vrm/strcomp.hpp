@@ -22,6 +22,7 @@ class StringComputer{
         System::Throw(SysExceptionCode::NullStringAllocationError); 
         return false; 
       }
+      _Aux->SetHolder(*Str,Str);
       return true;
     }
     inline bool _NewString(CpuMbl *Str,CpuWrd Length){
@@ -29,10 +30,18 @@ class StringComputer{
         System::Throw(SysExceptionCode::StringAllocationError,ToString(Length)); 
         return false; 
       }
+      _Aux->SetHolder(*Str,Str);
       return true;
     }
-    inline bool _Allocate(CpuMbl Str,CpuWrd Length){
-      if(!_Aux->Realloc(_ScopeId,_ScopeNr,Str,Length+1)){ 
+    inline bool _Allocate(CpuMbl Str,CpuWrd Length){ //Contents are overwritten by caller (shared data is not copied)
+      if(!_Aux->Realloc(_ScopeId,_ScopeNr,Str,Length+1,false)){ 
+        System::Throw(SysExceptionCode::StringAllocationError,ToString(Length)); 
+        return false; 
+      }
+      return true;
+    }
+    inline bool _Extend(CpuMbl Str,CpuWrd Length){ //Contents are kept
+      if(!_Aux->Realloc(_ScopeId,_ScopeNr,Str,Length+1,true)){ 
         System::Throw(SysExceptionCode::StringAllocationError,ToString(Length)); 
         return false; 
       }
@@ -92,6 +101,9 @@ class StringComputer{
     bool SISIN(CpuBol *Res,CpuMbl Str);
     bool SISLO(CpuBol *Res,CpuMbl Str);
     bool SISFL(CpuBol *Res,CpuMbl Str);
+    bool SRESV(CpuMbl Str,CpuWrd Length);
+    bool SSHRK(CpuMbl Str);
+    bool SUNSH(CpuRef Ref);
     bool SST2B(CpuBol *Res,CpuMbl Str);
     bool SST2C(CpuChr *Res,CpuMbl Str);
     bool SST2W(CpuShr *Res,CpuMbl Str);
@@ -0,0 +1,334 @@
+//tasks.cpp: Language level tasks and channels
+#include "bas/basedefs.hpp"
+#include "bas/allocator.hpp"
+#include "bas/array.hpp"
+#include "bas/sortedarray.hpp"
+#include "bas/stack.hpp"
+#include "bas/queue.hpp"
+#include "bas/buffer.hpp"
+#include "bas/string.hpp"
+#include "sys/sysdefs.hpp"
+#include "sys/system.hpp"
+#include "sys/stl.hpp"
+#include "sys/msgout.hpp"
+#include "vrm/pool.hpp"
+#include "vrm/memman.hpp"
+#include "vrm/auxmem.hpp"
+#include "vrm/strcomp.hpp"
+#include "vrm/arrcomp.hpp"
+#include "vrm/jit.hpp"
+#include "vrm/runtime.hpp"
+#include "vrm/tasks.hpp"
+
+//Define static variables
+std::mutex TaskManager::_Mutex;
+Array<TaskEntry *> TaskManager::_Task;
+Array<TaskChannel *> TaskManager::_Channel;
+
+//Spawn task
+//(returns task id or -1 when executable file does not exist)
+int TaskManager::Spawn(const String& BinaryFile,Array<String>& Arg,bool Jit,const String& DynLibPath,const String& TmpLibPath){
+
+  //Variables
+  int TaskId;
+  TaskEntry *Task;
+
+  //Check executable file exists
+  if(!_Stl->FileSystem.FileExists(BinaryFile)){
+    _Stl->SetError(StlErrorCode::ExecFileNotExists,BinaryFile);
+    return -1;
+  }
+
+  //Create task
+  Task=new TaskEntry;
+  Task->BinaryFile=BinaryFile;
+  Task->Arg.Add(BinaryFile);
+  for(int i=0;i<Arg.Length();i++){ Task->Arg.Add(Arg[i]); }
+  Task->ProcessId=System::NewProcessId();
+  Task->Jit=Jit;
+  Task->DynLibPath=DynLibPath;
+  Task->TmpLibPath=TmpLibPath;
+  Task->Joined=false;
+  Task->Result=false;
+  Task->Thread=nullptr;
+
+  //From now on several runtime instances share memory manager and console
+  MemoryManager::SetThreadSafe(true);
+  _Stl->Console.SetShared(true);
+
+  //Register task and start its thread
+  {
+    std::lock_guard<std::mutex> Lock(_Mutex);
+    _Task.Add(Task);
+    TaskId=_Task.Length();
+    Task->Thread=new std::thread(&TaskManager::_RunTask,Task);
+  }
+
+  //Debug message
+  DebugMessage(DebugLevel::VrmRuntime,"Spawned task "+ToString(TaskId)+" (pid="+ToString(Task->ProcessId)+") for executable "+BinaryFile);
+
+  //Return task id
+  return TaskId;
+
+}
+
+//Run task on current thread
+void TaskManager::_RunTask(TaskEntry *Task){
+
+  //Variables
+  Array<char *> ArgPtr;
+
+  //Task process becomes current process of this thread
+  System::PushProcessId(Task->ProcessId);
+  System::ExceptionReset();
+
+  //Program arguments
+  for(int i=0;i<Task->Arg.Length();i++){ ArgPtr.Add(Task->Arg[i].CharPnt()); }
+
+  //Catch exceptions
+  try{
+
+    //Open scope here to force program destructor being called at scope end
+    {
+
+      //Variables
+      Runtime Prog;
+
+      //Load and execute program
+      Prog.SetRomBuffer(nullptr);
+      if(Prog.LoadProgram(Task->BinaryFile,Task->ProcessId,ArgPtr.Length(),&ArgPtr[0],0)){
+        Prog.SetLibPaths(Task->DynLibPath,Task->TmpLibPath);
+        Prog.SetJit(Task->Jit);
+        SetCurrentRuntime(&Prog);
+        Task->Result=Prog.ExecProgram(Task->ProcessId,0);
+        Prog.CloseAllFiles();
+        Prog.UnloadLibraries();
+        SetCurrentRuntime(nullptr);
+      }
+
+    }
+
+  }
+
+  //Exception handler
+  catch(BaseException& Ex){
+    _Stl->Console.PrintLine(Ex.Description());
+    Task->Result=false;
+  }
+
+  //Release process
+  System::PopProcessId();
+
+}
+
+//Join task (waits until task ends and returns its result)
+bool TaskManager::Join(int TaskId){
+
+  //Variables
+  TaskEntry *Task;
+
+  //Get task
+  {
+    std::lock_guard<std::mutex> Lock(_Mutex);
+    if(TaskId<1 || TaskId>_Task.Length()){
+      _Stl->SetError(StlErrorCode::InvalidTask,ToString(TaskId));
+      return false;
+    }
+    Task=_Task[TaskId-1];
+    if(Task->Joined){
+      _Stl->SetError(StlErrorCode::TaskAlreadyJoined,ToString(TaskId));
+      return false;
+    }
+    Task->Joined=true;
+  }
+
+  //Wait for task thread
+  Task->Thread->join();
+  delete Task->Thread;
+  Task->Thread=nullptr;
+  DebugMessage(DebugLevel::VrmRuntime,"Joined task "+ToString(TaskId)+" (pid="+ToString(Task->ProcessId)+") result="+(Task->Result?String("ok"):String("error")));
+
+  //Return task result
+  return Task->Result;
+
+}
+
+//Open channel (channel is created when it does not exist yet, returns channel id)
+int TaskManager::OpenChannel(const String& Name){
+
+  //Variables
+  TaskChannel *Channel;
+  std::lock_guard<std::mutex> Lock(_Mutex);
+
+  //Find channel by name
+  for(int i=0;i<_Channel.Length();i++){
+    if(_Channel[i]->Name==Name){ return i+1; }
+  }
+
+  //Create channel
+  Channel=new TaskChannel;
+  Channel->Name=Name;
+  Channel->Closed=false;
+  _Channel.Add(Channel);
+  DebugMessage(DebugLevel::VrmRuntime,"Created channel "+ToString(_Channel.Length())+" ("+Name+")");
+  return _Channel.Length();
+
+}
+
+//Get channel (must be called with mutex locked)
+TaskChannel *TaskManager::_GetChannel(int ChannelId){
+  if(ChannelId<1 || ChannelId>_Channel.Length()){
+    _Stl->SetError(StlErrorCode::InvalidChannel,ToString(ChannelId));
+    return nullptr;
+  }
+  return _Channel[ChannelId-1];
+}
+
+//Close channel (pending messages can still be received, receivers are woken up when channel is empty)
+bool TaskManager::CloseChannel(int ChannelId){
+  TaskChannel *Channel;
+  std::lock_guard<std::mutex> Lock(_Mutex);
+  if((Channel=_GetChannel(ChannelId))==nullptr){ return false; }
+  Channel->Closed=true;
+  Channel->Ready.notify_all();
+  return true;
+}
+
+//Send message (message is owned by channel after this call)
+bool TaskManager::_Send(int ChannelId,ChannelMessage *Msg){
+  TaskChannel *Channel;
+  std::lock_guard<std::mutex> Lock(_Mutex);
+  if((Channel=_GetChannel(ChannelId))==nullptr){ delete Msg; return false; }
+  if(Channel->Closed){
+    _Stl->SetError(StlErrorCode::ChannelClosed,Channel->Name);
+    delete Msg;
+    return false;
+  }
+  Channel->Messages.Enqueue(Msg);
+  Channel->Ready.notify_one();
+  return true;
+}
+
+//Receive message (waits until a message arrives, returns null when channel is closed and empty or message is of different type)
+ChannelMessage *TaskManager::_Receive(int ChannelId,ChannelMsgType Type){
+  TaskChannel *Channel;
+  std::unique_lock<std::mutex> Lock(_Mutex);
+  if((Channel=_GetChannel(ChannelId))==nullptr){ return nullptr; }
+  Channel->Ready.wait(Lock,[Channel]{ return Channel->Messages.Length()!=0 || Channel->Closed; });
+  if(Channel->Messages.Length()==0){
+    _Stl->SetError(StlErrorCode::ChannelClosed,Channel->Name);
+    return nullptr;
+  }
+  if(Channel->Messages.Bottom()->Type!=Type){
+    _Stl->SetError(StlErrorCode::ChannelTypeMismatch,Channel->Name);
+    return nullptr;
+  }
+  return Channel->Messages.Dequeue();
+}
+
+//Send string
+bool TaskManager::Send(int ChannelId,const String& Str){
+  ChannelMessage *Msg=new ChannelMessage;
+  Msg->Type=ChannelMsgType::String;
+  Msg->Str=Str;
+  return _Send(ChannelId,Msg);
+}
+
+//Send integer or long
+bool TaskManager::Send(int ChannelId,ChannelMsgType Type,CpuLon Lon){
+  ChannelMessage *Msg=new ChannelMessage;
+  Msg->Type=Type;
+  Msg->Lon=Lon;
+  return _Send(ChannelId,Msg);
+}
+
+//Send float
+bool TaskManager::Send(int ChannelId,CpuFlo Flo){
+  ChannelMessage *Msg=new ChannelMessage;
+  Msg->Type=ChannelMsgType::Float;
+  Msg->Flo=Flo;
+  return _Send(ChannelId,Msg);
+}
+
+//Send string array
+bool TaskManager::Send(int ChannelId,Array<String>& Arr){
+  ChannelMessage *Msg=new ChannelMessage;
+  Msg->Type=ChannelMsgType::StrArray;
+  Msg->Arr=Arr;
+  return _Send(ChannelId,Msg);
+}
+
+//Receive string
+bool TaskManager::Receive(int ChannelId,String& Str){
+  ChannelMessage *Msg;
+  if((Msg=_Receive(ChannelId,ChannelMsgType::String))==nullptr){ return false; }
+  Str=Msg->Str;
+  delete Msg;
+  return true;
+}
+
+//Receive integer or long
+bool TaskManager::Receive(int ChannelId,ChannelMsgType Type,CpuLon& Lon){
+  ChannelMessage *Msg;
+  if((Msg=_Receive(ChannelId,Type))==nullptr){ return false; }
+  Lon=Msg->Lon;
+  delete Msg;
+  return true;
+}
+
+//Receive float
+bool TaskManager::Receive(int ChannelId,CpuFlo& Flo){
+  ChannelMessage *Msg;
+  if((Msg=_Receive(ChannelId,ChannelMsgType::Float))==nullptr){ return false; }
+  Flo=Msg->Flo;
+  delete Msg;
+  return true;
+}
+
+//Receive string array
+bool TaskManager::Receive(int ChannelId,Array<String>& Arr){
+  ChannelMessage *Msg;
+  if((Msg=_Receive(ChannelId,ChannelMsgType::StrArray))==nullptr){ return false; }
+  Arr=Msg->Arr;
+  delete Msg;
+  return true;
+}
+
+//Wait for all tasks and release tables
+//(called when main program ends, tasks not joined by program are waited for here)
+void TaskManager::Terminate(){
+
+  //Variables
+  int i;
+  int TaskNr;
+  TaskEntry *Task;
+
+  //Join pending tasks (tasks can spawn more tasks while we wait)
+  i=0;
+  while(true){
+    {
+      std::lock_guard<std::mutex> Lock(_Mutex);
+      TaskNr=_Task.Length();
+      if(i>=TaskNr){ break; }
+      Task=_Task[i];
+      if(Task->Joined){ Task=nullptr; } else { Task->Joined=true; }
+    }
+    if(Task!=nullptr){
+      Task->Thread->join();
+      delete Task->Thread;
+      Task->Thread=nullptr;
+    }
+    i++;
+  }
+
+  //Release tables
+  std::lock_guard<std::mutex> Lock(_Mutex);
+  for(i=0;i<_Task.Length();i++){ delete _Task[i]; }
+  for(i=0;i<_Channel.Length();i++){
+    while(_Channel[i]->Messages.Length()!=0){ delete _Channel[i]->Messages.Dequeue(); }
+    delete _Channel[i];
+  }
+  _Task.Reset();
+  _Channel.Reset();
+
+}
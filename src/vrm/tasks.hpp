@@ -0,0 +1,91 @@
+//tasks.hpp: Language level tasks and channels
+
+//Wrap include
+#ifndef _TASKS_HPP
+#define _TASKS_HPP
+
+//Channel message types
+enum class ChannelMsgType:int{
+  String=1,   //string
+  Integer=2,  //int
+  Long=3,     //long
+  Float=4,    //float
+  StrArray=5  //string[]
+};
+
+//Channel message
+//(values are deep copied out of the memory managers of sending runtime, so they can be copied into the memory managers
+//of the receiving runtime)
+struct ChannelMessage{
+  ChannelMsgType Type; //Message type
+  String Str;          //String value
+  Array<String> Arr;   //String array value
+  CpuLon Lon;          //Integer and long values
+  CpuFlo Flo;          //Float value
+};
+
+//Channel (named message queue shared by all tasks)
+struct TaskChannel{
+  String Name;                      //Channel name
+  bool Closed;                      //Channel is closed for sending
+  Queue<ChannelMessage *> Messages; //Pending messages
+  std::condition_variable Ready;    //Signaled when a message arrives or channel is closed
+};
+
+//Task (executable file run by its own runtime instance on its own thread)
+struct TaskEntry{
+  String BinaryFile;   //Executable file
+  Array<String> Arg;   //Program arguments (first one is executable file as when it is run from command line)
+  int ProcessId;       //Process id of task
+  bool Jit;            //Jit compiler enabled
+  String DynLibPath;   //Dynamic library path
+  String TmpLibPath;   //Temporary dynamic library path
+  bool Joined;         //Task was joined
+  bool Result;         //Program ended without errors
+  std::thread *Thread; //Thread running the task
+};
+
+//Task manager class
+//(tasks and channels are process wide, task ids and channel ids start at 1, first spawn switches memory manager and
+//console into shared mode as from that moment several runtime instances run concurrently)
+class TaskManager{
+
+  //Private members
+  private:
+
+    //Internal data
+    static std::mutex _Mutex;            //Protects task and channel tables
+    static Array<TaskEntry *> _Task;     //Tasks
+    static Array<TaskChannel *> _Channel; //Channels
+
+    //Internal methods
+    static void _RunTask(TaskEntry *Task);
+    static TaskChannel *_GetChannel(int ChannelId);
+    static bool _Send(int ChannelId,ChannelMessage *Msg);
+    static ChannelMessage *_Receive(int ChannelId,ChannelMsgType Type);
+
+  //Public members
+  public:
+
+    //Tasks
+    static int Spawn(const String& BinaryFile,Array<String>& Arg,bool Jit,const String& DynLibPath,const String& TmpLibPath);
+    static bool Join(int TaskId);
+
+    //Channels
+    static int OpenChannel(const String& Name);
+    static bool CloseChannel(int ChannelId);
+    static bool Send(int ChannelId,const String& Str);
+    static bool Send(int ChannelId,ChannelMsgType Type,CpuLon Lon);
+    static bool Send(int ChannelId,CpuFlo Flo);
+    static bool Send(int ChannelId,Array<String>& Arr);
+    static bool Receive(int ChannelId,String& Str);
+    static bool Receive(int ChannelId,ChannelMsgType Type,CpuLon& Lon);
+    static bool Receive(int ChannelId,CpuFlo& Flo);
+    static bool Receive(int ChannelId,Array<String>& Arr);
+
+    //Wait for all tasks and release tables
+    static void Terminate();
+
+};
+
+#endif